@@ -308,6 +308,15 @@
     MSDK_STATIC_ASSERT_STRUCT_SIZE(mfxFrameAllocator  ,40)
 #endif
 
+//mfxdispatcher.h
+#if defined(_x86_64) && defined(ONEVPL_EXPERIMENTAL)
+    MSDK_STATIC_ASSERT_STRUCT_SIZE(mfxLibraryTiming   ,144)
+    MSDK_STATIC_ASSERT_STRUCT_SIZE(mfxLoaderTiming    ,176)
+    MSDK_STATIC_ASSERT_STRUCT_SIZE(mfxFunctionCallStats,320)
+    MSDK_STATIC_ASSERT_STRUCT_SIZE(mfxSessionCallStats,80)
+    MSDK_STATIC_ASSERT_STRUCT_SIZE(mfxRuntimeFunctions,272)
+#endif
+
 //mfxvp8.h
 #if defined(_x86_64)
     MSDK_STATIC_ASSERT_STRUCT_SIZE(mfxExtVP8CodingOption        ,516  )
@@ -463,6 +472,77 @@
     MSDK_STATIC_COMPARE(MFX_VARIANT_TYPE_FP16                           , 12)
 #endif
 
+//mfxdispatcher.h
+#ifdef ONEVPL_EXPERIMENTAL
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_IMPL                               , 0)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_ACCELERATION_MODE                  , 1)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_API_VERSION                        , 2)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_API_VERSION_MAJOR                  , 3)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_API_VERSION_MINOR                  , 4)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_IMPL_NAME                          , 5)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_LICENSE                            , 6)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_KEYWORDS                           , 7)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_VENDOR_ID                          , 8)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_VENDOR_IMPL_ID                     , 9)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_SURFACE_POOL_MODE                  , 10)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DEVICE_ID                          , 11)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_MEDIA_ADAPTER_TYPE                 , 12)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DEC_CODEC_ID                       , 13)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DEC_MAX_CODEC_LEVEL                , 14)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DEC_PROFILE                        , 15)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DEC_MEM_HANDLE_TYPE                , 16)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DEC_WIDTH                          , 17)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DEC_HEIGHT                         , 18)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DEC_COLOR_FORMAT                   , 19)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_ENC_CODEC_ID                       , 20)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_ENC_MAX_CODEC_LEVEL                , 21)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_ENC_BIDIRECTIONAL_PREDICTION       , 22)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_ENC_PROFILE                        , 23)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_ENC_MEM_HANDLE_TYPE                , 24)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_ENC_WIDTH                          , 25)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_ENC_HEIGHT                         , 26)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_ENC_COLOR_FORMAT                   , 27)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_VPP_FILTER_FOURCC                  , 28)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_VPP_MAX_DELAY_IN_FRAMES            , 29)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_VPP_MEM_HANDLE_TYPE                , 30)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_VPP_WIDTH                          , 31)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_VPP_HEIGHT                         , 32)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_VPP_IN_FORMAT                      , 33)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_VPP_OUT_FORMAT                     , 34)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_VENDOR_ID                   , 35)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_DEVICE_ID                   , 36)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_PCI_DOMAIN                  , 37)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_PCI_BUS                     , 38)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_PCI_DEVICE                  , 39)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_PCI_FUNCTION                , 40)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_DEVICE_LUID                 , 41)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_LUID_DEVICE_NODE_MASK       , 42)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_DRM_RENDER_NODE_NUM         , 43)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_DRM_PRIMARY_NODE_NUM        , 44)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_REVISION_ID                 , 45)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXTDEV_DEVICE_NAME                 , 46)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_SURFACE_TYPE                       , 47)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_SURFACE_COMPONENT                  , 48)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_SURFACE_FLAGS                      , 49)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_HANDLE_TYPE                        , 50)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_HANDLE                             , 51)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_NUM_THREAD                         , 52)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DEVICE_COPY                        , 53)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_EXT_BUFFER                         , 54)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_DXGI_ADAPTER_INDEX                 , 55)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_FUNCTION_NAME                      , 56)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_QUERY_IMPL                         , 57)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_QUERY_DEC                          , 58)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_QUERY_ENC                          , 59)
+    MSDK_STATIC_COMPARE(MFX_CFG_PROP_QUERY_VPP                          , 60)
+
+    MSDK_STATIC_COMPARE(MFX_LOADER_PHASE_SEARCH                         , 0)
+    MSDK_STATIC_COMPARE(MFX_LOADER_PHASE_LOAD                           , 1)
+    MSDK_STATIC_COMPARE(MFX_LOADER_PHASE_QUERY                          , 2)
+    MSDK_STATIC_COMPARE(MFX_LOADER_PHASE_FILTER                         , 3)
+    MSDK_STATIC_COMPARE(MFX_LOADER_PHASE_INIT                           , 4)
+#endif
+
 //mfxstructures.h
 #if defined(_x86_64)
     MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxFrameId                         ,TemporalId                    ,0    )
@@ -2077,6 +2157,50 @@
     MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxFrameAllocator                  ,Free                         ,36   )
 #endif
 
+//mfxdispatcher.h
+#if defined(_x86_64) && defined(ONEVPL_EXPERIMENTAL)
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLibraryTiming                   ,LibPath                      ,0    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLibraryTiming                   ,StartTime                    ,8    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLibraryTiming                   ,PhaseTime                    ,16   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLibraryTiming                   ,PhaseCount                   ,80   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLibraryTiming                   ,Valid                        ,112  )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLibraryTiming                   ,CapsCached                   ,114  )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLibraryTiming                   ,reserved                     ,116  )
+
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLoaderTiming                    ,Version                      ,0    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLoaderTiming                    ,NumLibraries                 ,4    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLoaderTiming                    ,PhaseTime                    ,8    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLoaderTiming                    ,PhaseCount                   ,72   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLoaderTiming                    ,Libraries                    ,104  )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxLoaderTiming                    ,reserved                     ,112  )
+
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxFunctionCallStats               ,FunctionName                 ,0    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxFunctionCallStats               ,NumCalls                     ,8    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxFunctionCallStats               ,TotalTime                    ,16   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxFunctionCallStats               ,MaxTime                      ,24   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxFunctionCallStats               ,Histogram                    ,32   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxFunctionCallStats               ,reserved                     ,288  )
+
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxSessionCallStats                ,Version                      ,0    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxSessionCallStats                ,NumFunctions                 ,4    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxSessionCallStats                ,Functions                    ,8    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxSessionCallStats                ,reserved                     ,16   )
+
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,Version                      ,0    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,RuntimeSession               ,8    )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,SyncOperation                ,16   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,DecodeFrameAsync             ,24   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,EncodeFrameAsync             ,32   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,RunFrameVPPAsync             ,40   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,ProcessFrameAsync            ,48   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,DecodeVPPFrameAsync          ,56   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,GetSurfaceForVPP             ,64   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,GetSurfaceForVPPOut          ,72   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,GetSurfaceForEncode          ,80   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,GetSurfaceForDecode          ,88   )
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRuntimeFunctions                ,reserved                     ,96   )
+#endif
+
 //mfxjpeg.h
 #if defined(_x86_64)
     MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxExtJPEGQuantTables              ,Header                        ,0    )
@@ -2297,6 +2421,13 @@ MSDK_STATIC_ASSERT_STRUCT_SIZE(mfxRange32U ,12)
     MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRange32U, Max  ,4)
     MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxRange32U, Step ,8)
 
+#if defined(_x86_64) && defined(ONEVPL_EXPERIMENTAL)
+MSDK_STATIC_ASSERT_STRUCT_SIZE(mfxSet32U ,24)
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxSet32U, NumValues ,0)
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxSet32U, reserved  ,4)
+    MSDK_STATIC_ASSERT_STRUCT_OFFSET(mfxSet32U, Values    ,16)
+#endif
+
 // mfxcommon.h
 
 #if defined(_x86_64)
@@ -211,6 +211,8 @@ typedef enum {
 
 #ifdef ONEVPL_EXPERIMENTAL
     MFX_VARIANT_TYPE_QUERY = 0x00000100,                                 /*!< Bitmask to OR with other variant types when using property-based query API */
+    MFX_VARIANT_TYPE_SET   = 0x00000200,                                 /*!< Bitmask to OR with an integer variant type to pass a set of accepted filter values. Data.Ptr points to mfxSet32U. */
+    MFX_VARIANT_TYPE_RANGE = 0x00000400,                                 /*!< Bitmask to OR with an integer variant type to pass a range of accepted filter values. Data.Ptr points to mfxRange32U. */
 #endif
 } mfxVariantType;
 
@@ -246,6 +248,17 @@ typedef struct {
 } mfxRange32U;
 MFX_PACK_END()
 
+#ifdef ONEVPL_EXPERIMENTAL
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+/*! Represents a set of unsigned values. */
+typedef struct {
+    mfxU32  NumValues;   /*!< Number of values in the set. */
+    mfxU32  reserved[3]; /*!< Reserved for future use. */
+    mfxU32* Values;      /*!< Pointer to the array of values. */
+} mfxSet32U;
+MFX_PACK_END()
+#endif
+
 MFX_PACK_BEGIN_USUAL_STRUCT()
 /*! Represents a pair of numbers of type mfxI16. */
 typedef struct {
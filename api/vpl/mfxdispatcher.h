@@ -10,6 +10,7 @@
 #include "mfxdefs.h"
 #include "mfxcommon.h"
 #include "mfxsession.h"
+#include "mfxstructures.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,6 +63,8 @@ mfxConfig MFX_CDECL MFXCreateConfig(mfxLoader loader);
 /*!
    @brief Adds additional filter properties (any fields of the mfxImplDescription structure) to the configuration of the loader object.
           @note Each new call with the same parameter name will overwrite the previously set value. This may invalidate other properties.
+          @note Experimental: integer properties which are compared for equality may be passed with MFX_VARIANT_TYPE_SET or MFX_VARIANT_TYPE_RANGE
+                OR'd into value.Type, in which case value.Data.Ptr points to an mfxSet32U or mfxRange32U of accepted values.
 
    @param[in] config Config handle.
    @param[in] name Name of the parameter (see mfxImplDescription structure and example).
@@ -77,6 +80,102 @@ mfxConfig MFX_CDECL MFXCreateConfig(mfxLoader loader);
 */
 mfxStatus MFX_CDECL MFXSetConfigFilterProperty(mfxConfig config, const mfxU8* name, mfxVariant value);
 
+#ifdef ONEVPL_EXPERIMENTAL
+/*! MFX_CFG_PROP_LIST(X) expands X(id, value, name) for every filter property which can be set with
+    MFXSetConfigFilterPropertyById, where name is the equivalent property name for MFXSetConfigFilterProperty.
+    Values will not change in future versions of the API, new properties are added at the end. */
+#define MFX_CFG_PROP_LIST(X) \
+    X(MFX_CFG_PROP_IMPL,                         0,  "mfxImplDescription.Impl")                                                              \
+    X(MFX_CFG_PROP_ACCELERATION_MODE,            1,  "mfxImplDescription.AccelerationMode")                                                  \
+    X(MFX_CFG_PROP_API_VERSION,                  2,  "mfxImplDescription.ApiVersion.Version")                                                \
+    X(MFX_CFG_PROP_API_VERSION_MAJOR,            3,  "mfxImplDescription.ApiVersion.Major")                                                  \
+    X(MFX_CFG_PROP_API_VERSION_MINOR,            4,  "mfxImplDescription.ApiVersion.Minor")                                                  \
+    X(MFX_CFG_PROP_IMPL_NAME,                    5,  "mfxImplDescription.ImplName")                                                          \
+    X(MFX_CFG_PROP_LICENSE,                      6,  "mfxImplDescription.License")                                                           \
+    X(MFX_CFG_PROP_KEYWORDS,                     7,  "mfxImplDescription.Keywords")                                                          \
+    X(MFX_CFG_PROP_VENDOR_ID,                    8,  "mfxImplDescription.VendorID")                                                          \
+    X(MFX_CFG_PROP_VENDOR_IMPL_ID,               9,  "mfxImplDescription.VendorImplID")                                                      \
+    X(MFX_CFG_PROP_SURFACE_POOL_MODE,            10, "mfxImplDescription.mfxSurfacePoolMode")                                                \
+    X(MFX_CFG_PROP_DEVICE_ID,                    11, "mfxImplDescription.mfxDeviceDescription.DeviceID")                                     \
+    X(MFX_CFG_PROP_MEDIA_ADAPTER_TYPE,           12, "mfxImplDescription.mfxDeviceDescription.MediaAdapterType")                             \
+    X(MFX_CFG_PROP_DEC_CODEC_ID,                 13, "mfxImplDescription.mfxDecoderDescription.decoder.CodecID")                             \
+    X(MFX_CFG_PROP_DEC_MAX_CODEC_LEVEL,          14, "mfxImplDescription.mfxDecoderDescription.decoder.MaxcodecLevel")                       \
+    X(MFX_CFG_PROP_DEC_PROFILE,                  15, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.Profile")                  \
+    X(MFX_CFG_PROP_DEC_MEM_HANDLE_TYPE,          16, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.MemHandleType") \
+    X(MFX_CFG_PROP_DEC_WIDTH,                    17, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.Width")         \
+    X(MFX_CFG_PROP_DEC_HEIGHT,                   18, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.Height")        \
+    X(MFX_CFG_PROP_DEC_COLOR_FORMAT,             19, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.ColorFormats")  \
+    X(MFX_CFG_PROP_ENC_CODEC_ID,                 20, "mfxImplDescription.mfxEncoderDescription.encoder.CodecID")                             \
+    X(MFX_CFG_PROP_ENC_MAX_CODEC_LEVEL,          21, "mfxImplDescription.mfxEncoderDescription.encoder.MaxcodecLevel")                       \
+    X(MFX_CFG_PROP_ENC_BIDIRECTIONAL_PREDICTION, 22, "mfxImplDescription.mfxEncoderDescription.encoder.BiDirectionalPrediction")             \
+    X(MFX_CFG_PROP_ENC_PROFILE,                  23, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.Profile")                  \
+    X(MFX_CFG_PROP_ENC_MEM_HANDLE_TYPE,          24, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.MemHandleType") \
+    X(MFX_CFG_PROP_ENC_WIDTH,                    25, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.Width")         \
+    X(MFX_CFG_PROP_ENC_HEIGHT,                   26, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.Height")        \
+    X(MFX_CFG_PROP_ENC_COLOR_FORMAT,             27, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.ColorFormats")  \
+    X(MFX_CFG_PROP_VPP_FILTER_FOURCC,            28, "mfxImplDescription.mfxVPPDescription.filter.FilterFourCC")                             \
+    X(MFX_CFG_PROP_VPP_MAX_DELAY_IN_FRAMES,      29, "mfxImplDescription.mfxVPPDescription.filter.MaxDelayInFrames")                         \
+    X(MFX_CFG_PROP_VPP_MEM_HANDLE_TYPE,          30, "mfxImplDescription.mfxVPPDescription.filter.memdesc.MemHandleType")                    \
+    X(MFX_CFG_PROP_VPP_WIDTH,                    31, "mfxImplDescription.mfxVPPDescription.filter.memdesc.Width")                            \
+    X(MFX_CFG_PROP_VPP_HEIGHT,                   32, "mfxImplDescription.mfxVPPDescription.filter.memdesc.Height")                           \
+    X(MFX_CFG_PROP_VPP_IN_FORMAT,                33, "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.InFormat")                  \
+    X(MFX_CFG_PROP_VPP_OUT_FORMAT,               34, "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.OutFormat")                 \
+    X(MFX_CFG_PROP_EXTDEV_VENDOR_ID,             35, "mfxExtendedDeviceId.VendorID")                                                         \
+    X(MFX_CFG_PROP_EXTDEV_DEVICE_ID,             36, "mfxExtendedDeviceId.DeviceID")                                                         \
+    X(MFX_CFG_PROP_EXTDEV_PCI_DOMAIN,            37, "mfxExtendedDeviceId.PCIDomain")                                                        \
+    X(MFX_CFG_PROP_EXTDEV_PCI_BUS,               38, "mfxExtendedDeviceId.PCIBus")                                                           \
+    X(MFX_CFG_PROP_EXTDEV_PCI_DEVICE,            39, "mfxExtendedDeviceId.PCIDevice")                                                        \
+    X(MFX_CFG_PROP_EXTDEV_PCI_FUNCTION,          40, "mfxExtendedDeviceId.PCIFunction")                                                      \
+    X(MFX_CFG_PROP_EXTDEV_DEVICE_LUID,           41, "mfxExtendedDeviceId.DeviceLUID")                                                       \
+    X(MFX_CFG_PROP_EXTDEV_LUID_DEVICE_NODE_MASK, 42, "mfxExtendedDeviceId.LUIDDeviceNodeMask")                                               \
+    X(MFX_CFG_PROP_EXTDEV_DRM_RENDER_NODE_NUM,   43, "mfxExtendedDeviceId.DRMRenderNodeNum")                                                 \
+    X(MFX_CFG_PROP_EXTDEV_DRM_PRIMARY_NODE_NUM,  44, "mfxExtendedDeviceId.DRMPrimaryNodeNum")                                                \
+    X(MFX_CFG_PROP_EXTDEV_REVISION_ID,           45, "mfxExtendedDeviceId.RevisionID")                                                       \
+    X(MFX_CFG_PROP_EXTDEV_DEVICE_NAME,           46, "mfxExtendedDeviceId.DeviceName")                                                       \
+    X(MFX_CFG_PROP_SURFACE_TYPE,                 47, "mfxSurfaceTypesSupported.surftype.SurfaceType")                                        \
+    X(MFX_CFG_PROP_SURFACE_COMPONENT,            48, "mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceComponent")                          \
+    X(MFX_CFG_PROP_SURFACE_FLAGS,                49, "mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceFlags")                              \
+    X(MFX_CFG_PROP_HANDLE_TYPE,                  50, "mfxHandleType")                                                                        \
+    X(MFX_CFG_PROP_HANDLE,                       51, "mfxHDL")                                                                               \
+    X(MFX_CFG_PROP_NUM_THREAD,                   52, "NumThread")                                                                            \
+    X(MFX_CFG_PROP_DEVICE_COPY,                  53, "DeviceCopy")                                                                           \
+    X(MFX_CFG_PROP_EXT_BUFFER,                   54, "ExtBuffer")                                                                            \
+    X(MFX_CFG_PROP_DXGI_ADAPTER_INDEX,           55, "DXGIAdapterIndex")                                                                     \
+    X(MFX_CFG_PROP_FUNCTION_NAME,                56, "mfxImplementedFunctions.FunctionsName")                                                \
+    X(MFX_CFG_PROP_QUERY_IMPL,                   57, "mfxImplDescription")                                                                   \
+    X(MFX_CFG_PROP_QUERY_DEC,                    58, "mfxImplDescription.mfxDecoderDescription")                                             \
+    X(MFX_CFG_PROP_QUERY_ENC,                    59, "mfxImplDescription.mfxEncoderDescription")                                             \
+    X(MFX_CFG_PROP_QUERY_VPP,                    60, "mfxImplDescription.mfxVPPDescription")
+
+/*! Helper for MFX_CFG_PROP_LIST which generates one entry of mfxConfigPropertyId. */
+#define MFX_CFG_PROP_ENUM_ENTRY(id, value, name) id = value,
+
+/*! The mfxConfigPropertyId enumerator itemizes the filter properties which can be set with MFXSetConfigFilterPropertyById.
+    See MFX_CFG_PROP_LIST for the value and equivalent property name of each ID. */
+typedef enum {
+    MFX_CFG_PROP_LIST(MFX_CFG_PROP_ENUM_ENTRY)
+} mfxConfigPropertyId;
+
+/*!
+   @brief Adds a filter property to the configuration of the loader object, like MFXSetConfigFilterProperty, but identifies the
+          property by a numeric ID instead of its name. This avoids parsing the name when many configurations are set up.
+          @note Each new call with the same property will overwrite the previously set value. A property set by ID and the same
+          property set by name are interchangeable.
+
+   @param[in] config Config handle.
+   @param[in] propId Property ID, one of the values of mfxConfigPropertyId.
+   @param[in] value  Value of the parameter. MFX_CFG_PROP_DEVICE_ID accepts mfxU16 or a string, like the equivalent property name.
+   @return
+      MFX_ERR_NONE The function completed successfully. \n
+      MFX_ERR_NULL_PTR    If config is NULL. \n
+      MFX_ERR_NOT_FOUND   If propId is not a known property ID, or the property is not supported on this platform. \n
+      MFX_ERR_UNSUPPORTED If value data type does not equal the parameter with provided ID.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXSetConfigFilterPropertyById(mfxConfig config, mfxU32 propId, mfxVariant value);
+#endif
+
 /*!
    @brief Iterates over filtered out implementations to gather their details. This function allocates memory to store
           a structure or string corresponding to the type specified by format. For example, if format is set to
@@ -147,6 +246,358 @@ mfxStatus MFX_CDECL MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession* ses
 */
 mfxStatus MFX_CDECL MFXDispReleaseImplDescription(mfxLoader loader, mfxHDL hdl);
 
+#ifdef ONEVPL_EXPERIMENTAL
+/*! Session pool handle. */
+typedef struct _mfxSessionPool *mfxSessionPool;
+
+/*!
+   @brief
+      Creates a pool of initialized sessions for one implementation.
+   @details The first minSessions sessions are created before this function returns. After that the dispatcher creates new
+            sessions in the background whenever fewer than minSessions idle sessions are left in the pool, so that
+            MFXSessionPoolAcquire does not wait for the implementation to be initialized.
+
+            The pool is destroyed by MFXDestroySessionPool or MFXUnload. Configuration filters should not be changed while a pool
+            exists, since they may change the implementation selected by index i.
+
+   @param[in]  loader      Loader handle.
+   @param[in]  i           Index of the implementation, as for MFXCreateSession.
+   @param[in]  minSessions Number of idle sessions to keep in the pool. Can be equal to 0.
+   @param[in]  maxSessions Maximum number of idle sessions kept in the pool when sessions are released. Must be at least minSessions.
+   @param[out] pool        Pointer to the pool handle.
+
+   @return
+      MFX_ERR_NONE                The function completed successfully. The pool contains minSessions idle sessions. \n
+      MFX_ERR_NULL_PTR            If loader or pool is NULL. \n
+      MFX_ERR_INVALID_VIDEO_PARAM If maxSessions is less than minSessions or equal to 0. \n
+      Any status returned by MFXCreateSession for implementation i.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXCreateSessionPool(mfxLoader loader, mfxU32 i, mfxU32 minSessions, mfxU32 maxSessions, mfxSessionPool* pool);
+
+/*!
+   @brief
+      Takes a session from the pool, or creates a new one if the pool is empty.
+      The session may be closed with MFXClose, or returned to the pool with MFXSessionPoolRelease.
+
+   @param[in]  pool    Pool handle.
+   @param[out] session Pointer to the session handle.
+
+   @return
+      MFX_ERR_NONE     The function completed successfully. \n
+      MFX_ERR_NULL_PTR If pool or session is NULL. \n
+      Any status returned by MFXCreateSession if the pool was empty.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXSessionPoolAcquire(mfxSessionPool pool, mfxSession* session);
+
+/*!
+   @brief
+      Returns a session to the pool it was taken from.
+      Any decode, encode, or VPP components which are still initialized are closed, so the next user of the session starts
+      from a clean state. Handles and allocators set with MFXVideoCORE functions are not reset. If the pool already contains
+      maxSessions idle sessions, the session is closed.
+
+   @param[in] pool    Pool handle.
+   @param[in] session Session handle returned by MFXSessionPoolAcquire for this pool.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If pool or session is NULL. \n
+      MFX_ERR_INVALID_HANDLE If session was not acquired from this pool, or was already released.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXSessionPoolRelease(mfxSessionPool pool, mfxSession session);
+
+/*!
+   @brief
+      Closes all idle sessions and destroys the pool.
+      Sessions which were acquired from the pool and not released remain valid, and must be closed with MFXClose.
+
+   @param[in] pool Pool handle.
+
+   @return
+      MFX_ERR_NONE     The function completed successfully. \n
+      MFX_ERR_NULL_PTR If pool is NULL.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXDestroySessionPool(mfxSessionPool pool);
+
+/*! The mfxLoaderPhase enumerator itemizes the phases of loader startup reported by MFXQueryLoaderTiming. */
+typedef enum {
+    MFX_LOADER_PHASE_SEARCH = 0, /*!< Searching directories for candidate runtime libraries. */
+    MFX_LOADER_PHASE_LOAD   = 1, /*!< Loading runtime libraries and resolving exported functions. */
+    MFX_LOADER_PHASE_QUERY  = 2, /*!< Querying the capabilities of the implementations in each library. */
+    MFX_LOADER_PHASE_FILTER = 3, /*!< Updating and sorting the list of valid implementations after filter properties change. */
+    MFX_LOADER_PHASE_INIT   = 4, /*!< Initializing sessions in the runtime during MFXCreateSession. */
+} mfxLoaderPhase;
+
+/*! Number of entries in the PhaseTime and PhaseCount arrays of mfxLoaderTiming and mfxLibraryTiming. */
+#define MFX_LOADER_MAX_PHASES 8
+
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+/*! Startup timing of one candidate runtime library, reported in mfxLoaderTiming. */
+typedef struct {
+    const mfxChar *LibPath;                   /*!< Null-terminated string with the full path to the library. */
+    mfxU64 StartTime;                         /*!< Time in nanoseconds from MFXLoad until the first phase for this library started. */
+    mfxU64 PhaseTime[MFX_LOADER_MAX_PHASES];  /*!< Total time in nanoseconds spent on this library in each phase, indexed by mfxLoaderPhase. */
+    mfxU32 PhaseCount[MFX_LOADER_MAX_PHASES]; /*!< Number of times each phase ran for this library, indexed by mfxLoaderPhase. */
+    mfxU16 Valid;                             /*!< Non-zero if the library is currently loaded as a valid runtime, 0 if it was rejected or unloaded. */
+    mfxU16 CapsCached;                        /*!< Non-zero if the capabilities were taken from the persistent caps cache or the runtime registry
+                                                   instead of loading and querying the library. */
+    mfxU32 reserved[7];                       /*!< Reserved for future use. */
+} mfxLibraryTiming;
+MFX_PACK_END()
+
+#define MFX_LOADERTIMING_VERSION MFX_STRUCT_VERSION(1, 0)
+
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+/*! Startup timing of a loader, returned by MFXQueryLoaderTiming. All times are measured with a monotonic clock. */
+typedef struct {
+    mfxStructVersion Version;                 /*!< Version of the structure. */
+    mfxU16 reserved1;                         /*!< Reserved for future use. */
+    mfxU32 NumLibraries;                      /*!< Number of entries in the Libraries array. */
+    mfxU64 PhaseTime[MFX_LOADER_MAX_PHASES];  /*!< Total time in nanoseconds spent by the loader in each phase, indexed by mfxLoaderPhase.
+                                                   When libraries are loaded or queried in parallel this is less than the sum over all libraries. */
+    mfxU32 PhaseCount[MFX_LOADER_MAX_PHASES]; /*!< Number of times each phase ran for the loader, indexed by mfxLoaderPhase. */
+    mfxLibraryTiming *Libraries;              /*!< Array with one entry for each candidate library, in the order in which they were first processed. */
+    mfxU32 reserved[16];                      /*!< Reserved for future use. */
+} mfxLoaderTiming;
+MFX_PACK_END()
+
+/*!
+   @brief
+      Returns the time spent in each phase of loader startup, for the loader as a whole and for each candidate library.
+   @details Timing is recorded from MFXLoad, and includes every call to MFXEnumImplementations and MFXCreateSession which loaded,
+            queried, or initialized libraries. The returned structure is a snapshot and is not updated by later calls.
+
+   @param[in]  loader Loader handle.
+   @param[out] timing Pointer to the timing structure allocated by the dispatcher. Must be released with MFXReleaseLoaderTiming.
+
+   @return
+      MFX_ERR_NONE     The function completed successfully. \n
+      MFX_ERR_NULL_PTR If loader or timing is NULL.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXQueryLoaderTiming(mfxLoader loader, mfxLoaderTiming **timing);
+
+/*!
+   @brief
+      Releases the timing structure returned by MFXQueryLoaderTiming.
+
+   @param[in] loader Loader handle.
+   @param[in] timing Pointer returned by MFXQueryLoaderTiming for this loader.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If loader or timing is NULL. \n
+      MFX_ERR_INVALID_HANDLE If timing was not returned by MFXQueryLoaderTiming for this loader, or was already released.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXReleaseLoaderTiming(mfxLoader loader, mfxLoaderTiming *timing);
+
+/*! Number of latency buckets in mfxFunctionCallStats. */
+#define MFX_CALLSTATS_NUM_BUCKETS 32
+
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+/*! Call count and latency histogram of one function, reported in mfxSessionCallStats. */
+typedef struct {
+    const mfxChar *FunctionName;                  /*!< Null-terminated string with the name of the API function, for example "MFXVideoCORE_SyncOperation". */
+    mfxU64 NumCalls;                              /*!< Number of calls which were passed to the runtime. */
+    mfxU64 TotalTime;                             /*!< Total time in nanoseconds spent in the runtime for all calls. */
+    mfxU64 MaxTime;                               /*!< Longest single call in nanoseconds. */
+    mfxU64 Histogram[MFX_CALLSTATS_NUM_BUCKETS];  /*!< Number of calls in each latency bucket. Bucket i counts calls which took from 2^i to 2^(i+1)-1 nanoseconds.
+                                                       Bucket 0 also counts calls under 1 nanosecond, and the last bucket counts all longer calls. */
+    mfxU32 reserved[8];                           /*!< Reserved for future use. */
+} mfxFunctionCallStats;
+MFX_PACK_END()
+
+#define MFX_SESSIONCALLSTATS_VERSION MFX_STRUCT_VERSION(1, 0)
+
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+/*! Per-function call statistics of a session, returned by MFXQuerySessionCallStats. */
+typedef struct {
+    mfxStructVersion Version;         /*!< Version of the structure. */
+    mfxU16 reserved1;                 /*!< Reserved for future use. */
+    mfxU32 NumFunctions;              /*!< Number of entries in the Functions array. */
+    mfxFunctionCallStats *Functions;  /*!< Array with one entry for each function which was called at least once. */
+    mfxU32 reserved[16];              /*!< Reserved for future use. */
+} mfxSessionCallStats;
+MFX_PACK_END()
+
+/*!
+   @brief
+      Returns call counts and latency histograms for each API function called on a session.
+   @details Statistics are only collected if the ONEVPL_SESSION_STATS environment variable was set to "ON" when the session was
+            created, and only for sessions created by the dispatcher on Linux. If the ONEVPL_SESSION_STATS_FILE environment variable
+            is also set, the statistics are appended to that file by MFXClose.
+            The returned structure is a snapshot and is not updated by later calls.
+
+   @param[in]  session Session handle.
+   @param[out] stats   Pointer to the statistics structure allocated by the dispatcher. Must be released with MFXReleaseSessionCallStats.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If stats is NULL. \n
+      MFX_ERR_INVALID_HANDLE If session is not a valid handle. \n
+      MFX_ERR_UNSUPPORTED    If statistics are not collected for this session.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXQuerySessionCallStats(mfxSession session, mfxSessionCallStats **stats);
+
+/*!
+   @brief
+      Releases the statistics structure returned by MFXQuerySessionCallStats.
+
+   @param[in] session Session handle.
+   @param[in] stats   Pointer returned by MFXQuerySessionCallStats for this session.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If stats is NULL. \n
+      MFX_ERR_INVALID_HANDLE If session is not a valid handle, or stats was not returned by MFXQuerySessionCallStats for this session,
+                             or was already released. \n
+      MFX_ERR_UNSUPPORTED    If statistics are not collected for this session.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXReleaseSessionCallStats(mfxSession session, mfxSessionCallStats *stats);
+
+#define MFX_RUNTIMEFUNCTIONS_VERSION MFX_STRUCT_VERSION(1, 0)
+
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+/*!
+   Runtime functions which may be called directly, without going through the dispatcher, returned by MFXGetRuntimeFunctions.
+   Each function takes RuntimeSession instead of the dispatcher session handle, and is NULL if the runtime does not export it.
+*/
+typedef struct {
+    mfxStructVersion Version;  /*!< Version of the structure. Must be set by the application before calling MFXGetRuntimeFunctions. */
+    mfxU16 reserved1;          /*!< Reserved for future use. */
+    mfxU32 reserved2;          /*!< Reserved for future use. */
+    mfxSession RuntimeSession; /*!< Runtime session handle to pass as the first argument of every function in this structure. */
+    mfxStatus (MFX_CDECL *SyncOperation)(mfxSession session, mfxSyncPoint syncp, mfxU32 wait);                      /*!< Runtime MFXVideoCORE_SyncOperation. */
+    mfxStatus (MFX_CDECL *DecodeFrameAsync)(mfxSession session, mfxBitstream *bs, mfxFrameSurface1 *surface_work,
+                                            mfxFrameSurface1 **surface_out, mfxSyncPoint *syncp);                  /*!< Runtime MFXVideoDECODE_DecodeFrameAsync. */
+    mfxStatus (MFX_CDECL *EncodeFrameAsync)(mfxSession session, mfxEncodeCtrl *ctrl, mfxFrameSurface1 *surface,
+                                            mfxBitstream *bs, mfxSyncPoint *syncp);                                /*!< Runtime MFXVideoENCODE_EncodeFrameAsync. */
+    mfxStatus (MFX_CDECL *RunFrameVPPAsync)(mfxSession session, mfxFrameSurface1 *in, mfxFrameSurface1 *out,
+                                            mfxExtVppAuxData *aux, mfxSyncPoint *syncp);                           /*!< Runtime MFXVideoVPP_RunFrameVPPAsync. */
+    mfxStatus (MFX_CDECL *ProcessFrameAsync)(mfxSession session, mfxFrameSurface1 *in, mfxFrameSurface1 **out);     /*!< Runtime MFXVideoVPP_ProcessFrameAsync. */
+    mfxStatus (MFX_CDECL *DecodeVPPFrameAsync)(mfxSession session, mfxBitstream *bs, mfxU32 *skip_channels,
+                                               mfxU32 num_skip_channels, mfxSurfaceArray **surf_array_out);        /*!< Runtime MFXVideoDECODE_VPP_DecodeFrameAsync. */
+    mfxStatus (MFX_CDECL *GetSurfaceForVPP)(mfxSession session, mfxFrameSurface1 **surface);                        /*!< Runtime MFXMemory_GetSurfaceForVPP. */
+    mfxStatus (MFX_CDECL *GetSurfaceForVPPOut)(mfxSession session, mfxFrameSurface1 **surface);                     /*!< Runtime MFXMemory_GetSurfaceForVPPOut. */
+    mfxStatus (MFX_CDECL *GetSurfaceForEncode)(mfxSession session, mfxFrameSurface1 **surface);                     /*!< Runtime MFXMemory_GetSurfaceForEncode. */
+    mfxStatus (MFX_CDECL *GetSurfaceForDecode)(mfxSession session, mfxFrameSurface1 **surface);                     /*!< Runtime MFXMemory_GetSurfaceForDecode. */
+    mfxHDL reserved[22];       /*!< Reserved for future use. */
+} mfxRuntimeFunctions;
+MFX_PACK_END()
+
+/*!
+   @brief
+      Returns pointers to the runtime functions used by a session for the per-frame calls, so that they may be called directly
+      without going through the dispatcher.
+   @details The function pointers and RuntimeSession stay valid until the session is closed with MFXClose. RuntimeSession may only be
+            passed to the functions in this structure; all other calls, including MFXClose, must use the dispatcher session handle.
+            Direct calls are not included in the statistics returned by MFXQuerySessionCallStats.
+
+   @param[in]     session   Session handle.
+   @param[in,out] functions Structure to fill. Version must be set to MFX_RUNTIMEFUNCTIONS_VERSION.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If functions is NULL. \n
+      MFX_ERR_INVALID_HANDLE If session is not a valid handle. \n
+      MFX_ERR_UNSUPPORTED    If the structure version is not supported, or the dispatcher does not support direct calls.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXGetRuntimeFunctions(mfxSession session, mfxRuntimeFunctions *functions);
+
+/*! The mfxPlacementPolicy enumerator specifies how MFXCreateSessionPlaced selects an implementation. */
+typedef enum {
+    MFX_PLACEMENT_POLICY_NONE         = 0, /*!< Always select the implementation with index 0, as MFXCreateSession(loader, 0, session). */
+    MFX_PLACEMENT_POLICY_ROUND_ROBIN  = 1, /*!< Select each valid implementation in turn. */
+    MFX_PLACEMENT_POLICY_LEAST_ACTIVE = 2, /*!< Select the implementation with the fewest open sessions. */
+    MFX_PLACEMENT_POLICY_WEIGHTED     = 3, /*!< Select the implementation with the fewest open sessions relative to its weight. */
+} mfxPlacementPolicy;
+
+/*!
+   @brief
+      Sets the policy used by MFXCreateSessionPlaced to spread sessions over the valid implementations of a loader,
+      for example over several adapters.
+   @details Once a placement policy is set or MFXCreateSessionPlaced is called, open sessions are counted for every
+            implementation of the loader, including sessions created with MFXCreateSession or taken from a session pool, and
+            are no longer counted once closed with MFXClose. Sessions created before that are not counted. Ties are resolved
+            in favor of the implementation with the lower index.
+
+            With MFX_PLACEMENT_POLICY_WEIGHTED, weights[i] is the share of sessions for the implementation with index i, so
+            an implementation with weight 2 receives twice as many sessions as one with weight 1. Implementations with weight 0
+            are never selected, and implementations with index numWeights or higher have weight 1. Weights are only used by
+            this policy. Indices are the same as for MFXEnumImplementations, so weights should be set again if configuration
+            filters are changed.
+
+   @param[in] loader     Loader handle.
+   @param[in] policy     Placement policy.
+   @param[in] weights    Array of weights, indexed by implementation. May be NULL unless policy is MFX_PLACEMENT_POLICY_WEIGHTED.
+   @param[in] numWeights Number of elements in weights.
+
+   @return
+      MFX_ERR_NONE        The function completed successfully. \n
+      MFX_ERR_NULL_PTR    If loader is NULL, or policy is MFX_PLACEMENT_POLICY_WEIGHTED and weights is NULL. \n
+      MFX_ERR_UNSUPPORTED If policy is not supported.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXSetPlacementPolicy(mfxLoader loader, mfxPlacementPolicy policy, const mfxU32 *weights, mfxU32 numWeights);
+
+/*!
+   @brief
+      Creates a session with the implementation selected by the placement policy of the loader.
+   @details Several threads may call this function at the same time. A selected implementation is counted as having one more
+            open session while it is being initialized, so concurrent calls with MFX_PLACEMENT_POLICY_LEAST_ACTIVE do not all
+            select the same implementation.
+
+   @param[in]  loader  Loader handle.
+   @param[out] session Pointer to the session handle.
+   @param[out] implIdx Optional pointer to the index of the selected implementation, as for MFXCreateSession. May be NULL.
+
+   @return
+      MFX_ERR_NONE      The function completed successfully. \n
+      MFX_ERR_NULL_PTR  If loader or session is NULL. \n
+      MFX_ERR_NOT_FOUND If no implementation is valid, or all valid implementations have weight 0. \n
+      Any status returned by MFXCreateSession for the selected implementation.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXCreateSessionPlaced(mfxLoader loader, mfxSession *session, mfxU32 *implIdx);
+
+/*!
+   @brief
+      Returns the number of open sessions created with one implementation of the loader.
+
+   @param[in]  loader     Loader handle.
+   @param[in]  i          Index of the implementation, as for MFXCreateSession.
+   @param[out] numActive  Number of sessions which were created with this implementation and not yet closed, counted from the
+                          first call to MFXSetPlacementPolicy or MFXCreateSessionPlaced.
+
+   @return
+      MFX_ERR_NONE      The function completed successfully. \n
+      MFX_ERR_NULL_PTR  If loader or numActive is NULL. \n
+      MFX_ERR_NOT_FOUND If there is no valid implementation with index i.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXQueryImplSessionCount(mfxLoader loader, mfxU32 i, mfxU32 *numActive);
+#endif
+
 /*!
    @brief
       Macro help to return UUID in the common oneAPI format.
@@ -151,4 +151,9 @@
 #define MFXQueryImplsProperties          disp_MFXQueryImplsProperties
 #endif
 
+// API 2.17 functions
+#ifdef ONEVPL_EXPERIMENTAL
+#define MFXQueryImplsAPIVersion          disp_MFXQueryImplsAPIVersion
+#endif
+
 #endif
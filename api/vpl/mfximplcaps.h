@@ -68,6 +68,23 @@ mfxStatus MFX_CDECL MFXReleaseImplDescription(mfxHDL hdl);
    @since This function is available since API version 2.15.
 */
 mfxHDL* MFX_CDECL MFXQueryImplsProperties(mfxQueryProperty** properties, mfxU32 num_properties, mfxU32* num_impls);
+
+/*!
+   @brief
+      Returns the API version supported by the implementation, without creating a session.
+      The dispatcher calls this function in low-latency mode, where the implementation capabilities are not queried.
+      If the runtime does not export this function, the dispatcher creates a test session and calls MFXQueryVersion instead.
+      Calling this function directly is not recommended.
+
+   @param[out] version  Pointer to the API version.
+
+   @return
+      MFX_ERR_NONE The function completed successfully. \n
+      MFX_ERR_NULL_PTR If version is NULL.
+
+   @since This function is available since API version 2.17.
+*/
+mfxStatus MFX_CDECL MFXQueryImplsAPIVersion(mfxVersion* version);
 #endif
 
 
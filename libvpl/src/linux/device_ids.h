@@ -12,12 +12,13 @@
 //   https://github.com/Intel-Media-SDK/MediaSDK/blob/master/_studio/shared/include/mfxstructures-int.h
 
 #include <algorithm>
-#include <fstream>
-#include <string>
+#include <memory>
 #include <vector>
 
 #include "vpl/mfxvideo.h"
 
+#include "src/linux/drm_topology.h"
+
 enum eMFXHWType {
     MFX_HW_UNKNOWN = 0,
     MFX_HW_SNB     = 0x300000,
@@ -381,54 +382,25 @@ static inline eMFXHWType get_platform(unsigned int device_id) {
 }
 
 static mfxStatus get_devices(std::vector<Device> &allDevices) {
-    const char *dir            = "/sys/class/drm";
-    const char *device_id_file = "/device/device";
-    const char *vendor_id_file = "/device/vendor";
-
-    int i = 0;
-    for (; i < 64; ++i) {
-        Device device;
-        std::string path = std::string(dir) + "/renderD" + std::to_string(128 + i) + vendor_id_file;
-        std::string line;
-        std::ifstream dev_str;
+    // render nodes are read once per process, see drm_topology.h
+    std::shared_ptr<const DRMTopology> topology = GetDRMTopology();
 
-        dev_str.open(path);
-        if (!dev_str.is_open()) {
-            continue;
-        }
-        std::getline(dev_str, line);
-        dev_str.close();
-        try {
-            device.vendor_id = std::stoul(line, 0, 16);
-        }
-        catch (std::invalid_argument &) {
-            continue;
-        }
-        catch (std::out_of_range &) {
+    for (const DRMRenderNode &node : *topology) {
+        // renderD128 - renderD191
+        if (node.nodeNum < 128 || node.nodeNum >= 128 + 64)
             continue;
-        }
 
         // Filter out non-Intel devices
-        if (device.vendor_id != 0x8086)
+        if (node.vendorID != 0x8086)
             continue;
 
-        path = std::string(dir) + "/renderD" + std::to_string(128 + i) + device_id_file;
-        dev_str.open(path);
-        if (!dev_str.is_open()) {
-            continue;
-        }
-        std::getline(dev_str, line);
-        dev_str.close();
-        try {
-            device.device_id = std::stoul(line, 0, 16);
-        }
-        catch (std::invalid_argument &) {
+        // device attribute missing or unreadable
+        if (node.deviceID == 0)
             continue;
-        }
-        catch (std::out_of_range &) {
-            continue;
-        }
 
+        Device device;
+        device.vendor_id = node.vendorID;
+        device.device_id = node.deviceID;
         device.platform = get_platform(device.device_id);
 
         allDevices.emplace_back(device);
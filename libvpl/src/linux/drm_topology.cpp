@@ -0,0 +1,221 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/linux/drm_topology.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+
+#define DEFAULT_SYSFS_ROOT "/sys"
+#define RENDER_NODE_PREFIX "renderD"
+
+// snapshot shared by all loaders in the process
+struct DRMTopologyCache {
+    std::mutex lock;
+    std::shared_ptr<const DRMTopology> topology;
+    std::string sysfsRoot;
+};
+
+static DRMTopologyCache &GetTopologyCache() {
+    static DRMTopologyCache cache;
+    return cache;
+}
+
+static std::string GetSysfsRoot() {
+    const char *envRoot = getenv("ONEVPL_SYSFS_ROOT");
+    if (envRoot && envRoot[0])
+        return envRoot;
+
+    return DEFAULT_SYSFS_ROOT;
+}
+
+// read a sysfs attribute in hex format (e.g. "0x8086"), return 0 on error
+static mfxU32 ReadHexAttr(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return 0;
+
+    char buf[32];
+    ssize_t len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+
+    if (len <= 0)
+        return 0;
+    buf[len] = 0;
+
+    return (mfxU32)strtoul(buf, nullptr, 16);
+}
+
+// read the target of the <node>/device symlink, return empty string on error
+static std::string ReadDeviceLink(const std::string &deviceDir) {
+    char buf[1024];
+    ssize_t len = readlink(deviceDir.c_str(), buf, sizeof(buf) - 1);
+    if (len <= 0)
+        return std::string();
+    buf[len] = 0;
+
+    return buf;
+}
+
+// parse the node number from a renderD<N> directory entry, return false for other entries
+static bool ParseRenderNodeName(const char *name, mfxU32 &nodeNum) {
+    const size_t prefixLen = strlen(RENDER_NODE_PREFIX);
+    if (strncmp(name, RENDER_NODE_PREFIX, prefixLen))
+        return false;
+
+    char *end = nullptr;
+    nodeNum   = (mfxU32)strtoul(name + prefixLen, &end, 10);
+    if (end == name + prefixLen || *end)
+        return false;
+
+    return true;
+}
+
+static void ReadRenderNode(const std::string &nodeDir, DRMRenderNode &node) {
+    std::string deviceDir = nodeDir + "/device";
+
+    node.deviceLink = ReadDeviceLink(deviceDir);
+
+    node.vendorID   = ReadHexAttr(deviceDir + "/vendor");
+    node.deviceID   = ReadHexAttr(deviceDir + "/device");
+    node.revisionID = ReadHexAttr(deviceDir + "/revision");
+
+    // device is a symlink to the PCI device, e.g. .../pci0000:00/0000:03:00.0
+    char *devicePath = realpath(deviceDir.c_str(), nullptr);
+    if (!devicePath)
+        return;
+
+    node.devicePath = devicePath;
+    free(devicePath);
+
+    const char *slot = strrchr(node.devicePath.c_str(), '/');
+    unsigned int domain, bus, device, function;
+    if (slot && sscanf(slot + 1, "%x:%x:%x.%x", &domain, &bus, &device, &function) == 4) {
+        node.bPCIValid   = true;
+        node.pciDomain   = domain;
+        node.pciBus      = bus;
+        node.pciDevice   = device;
+        node.pciFunction = function;
+    }
+}
+
+static std::shared_ptr<const DRMTopology> ReadDRMTopology(const std::string &sysfsRoot) {
+    auto topology = std::make_shared<DRMTopology>();
+
+    std::string drmDir = sysfsRoot + "/class/drm";
+    DIR *pDir          = opendir(drmDir.c_str());
+    if (!pDir)
+        return topology;
+
+    struct dirent *ent;
+    while ((ent = readdir(pDir)) != nullptr) {
+        mfxU32 nodeNum;
+        if (!ParseRenderNodeName(ent->d_name, nodeNum))
+            continue;
+
+        DRMRenderNode node = {};
+        node.nodeNum       = nodeNum;
+        ReadRenderNode(drmDir + "/" + ent->d_name, node);
+
+        topology->push_back(node);
+    }
+    closedir(pDir);
+
+    // readdir() order is not defined
+    std::sort(topology->begin(),
+              topology->end(),
+              [](const DRMRenderNode &a, const DRMRenderNode &b) {
+                  return a.nodeNum < b.nodeNum;
+              });
+
+    return topology;
+}
+
+std::shared_ptr<const DRMTopology> GetDRMTopology() {
+    std::string sysfsRoot = GetSysfsRoot();
+
+    DRMTopologyCache &cache = GetTopologyCache();
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    if (!cache.topology || cache.sysfsRoot != sysfsRoot) {
+        cache.topology  = ReadDRMTopology(sysfsRoot);
+        cache.sysfsRoot = sysfsRoot;
+    }
+
+    return cache.topology;
+}
+
+void RefreshDRMTopology() {
+    DRMTopologyCache &cache = GetTopologyCache();
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    cache.topology.reset();
+}
+
+void CheckDRMTopology() {
+    std::string sysfsRoot = GetSysfsRoot();
+
+    std::shared_ptr<const DRMTopology> topology;
+    {
+        DRMTopologyCache &cache = GetTopologyCache();
+        std::lock_guard<std::mutex> lock(cache.lock);
+
+        // nothing read yet, or a different root which GetDRMTopology() re-reads anyway
+        if (!cache.topology || cache.sysfsRoot != sysfsRoot)
+            return;
+
+        topology = cache.topology;
+    }
+
+    std::string drmDir = sysfsRoot + "/class/drm";
+    DIR *pDir          = opendir(drmDir.c_str());
+
+    // compare node numbers and device links with the snapshot, which is sorted by node number
+    bool bChanged   = false;
+    size_t numNodes = 0;
+    if (pDir) {
+        struct dirent *ent;
+        while (!bChanged && (ent = readdir(pDir)) != nullptr) {
+            mfxU32 nodeNum;
+            if (!ParseRenderNodeName(ent->d_name, nodeNum))
+                continue;
+
+            const DRMRenderNode *node = FindDRMRenderNode(*topology, nodeNum);
+            if (!node ||
+                node->deviceLink != ReadDeviceLink(drmDir + "/" + ent->d_name + "/device"))
+                bChanged = true;
+
+            numNodes++;
+        }
+        closedir(pDir);
+    }
+
+    if (!bChanged && numNodes == topology->size())
+        return;
+
+    DRMTopologyCache &cache = GetTopologyCache();
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    // another thread may have installed a newer snapshot in the meantime
+    if (cache.topology == topology)
+        cache.topology.reset();
+}
+
+const DRMRenderNode *FindDRMRenderNode(const DRMTopology &topology, mfxU32 nodeNum) {
+    for (const DRMRenderNode &node : topology) {
+        if (node.nodeNum == nodeNum)
+            return &node;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,60 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#ifndef LIBVPL_SRC_LINUX_DRM_TOPOLOGY_H_
+#define LIBVPL_SRC_LINUX_DRM_TOPOLOGY_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vpl/mfxdefs.h"
+
+// sysfs description of one DRM render node (/dev/dri/renderD<NodeNum>)
+// IDs are 0 if the attribute could not be read
+struct DRMRenderNode {
+    mfxU32 nodeNum;
+    mfxU32 vendorID;
+    mfxU32 deviceID;
+    mfxU32 revisionID;
+
+    // PCI address, parsed from the name of the device directory (e.g. 0000:03:00.0)
+    bool bPCIValid;
+    mfxU32 pciDomain;
+    mfxU32 pciBus;
+    mfxU32 pciDevice;
+    mfxU32 pciFunction;
+
+    // resolved path of the device directory, empty if unavailable
+    std::string devicePath;
+
+    // target of the <node>/device symlink as read, used to detect changes cheaply
+    std::string deviceLink;
+};
+
+typedef std::vector<DRMRenderNode> DRMTopology;
+
+// Return all DRM render nodes, sorted by node number.
+// The first call reads every node with a single pass over <sysfs root>/class/drm, then the same
+//   snapshot is returned for the life of the process until CheckDRMTopology() finds a change
+//   or RefreshDRMTopology() is called.
+// The sysfs root is /sys unless overridden with the ONEVPL_SYSFS_ROOT environment variable
+//   (e.g. to point at a fake tree in tests). Changing the override also re-reads the nodes.
+// Thread-safe. A returned snapshot stays valid after a refresh.
+std::shared_ptr<const DRMTopology> GetDRMTopology();
+
+// discard the current snapshot so the next call to GetDRMTopology() reads sysfs again
+void RefreshDRMTopology();
+
+// Discard the current snapshot only if render nodes were added, removed, or bound to a different
+//   device since it was read. Costs one readdir() plus one readlink() per node, so it is cheap
+//   enough to call on every MFXLoad(). Attributes of a node which did not move are not re-read.
+void CheckDRMTopology();
+
+// return the node with the given number, or nullptr if not present
+const DRMRenderNode *FindDRMRenderNode(const DRMTopology &topology, mfxU32 nodeNum);
+
+#endif // LIBVPL_SRC_LINUX_DRM_TOPOLOGY_H_
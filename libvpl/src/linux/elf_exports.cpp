@@ -0,0 +1,337 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/linux/elf_exports.h"
+
+#include <elf.h>
+#include <fcntl.h>
+#include <link.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if __SIZEOF_POINTER__ == 8
+    #define ELF_NATIVE_CLASS ELFCLASS64
+#else
+    #define ELF_NATIVE_CLASS ELFCLASS32
+#endif
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #define ELF_NATIVE_DATA ELFDATA2LSB
+#else
+    #define ELF_NATIVE_DATA ELFDATA2MSB
+#endif
+
+// read-only view of a mapped ELF file, all accesses are bounds-checked
+class ElfImage {
+public:
+    ElfImage() : m_data(nullptr), m_size(0), m_phdr(nullptr), m_phnum(0) {}
+
+    ~ElfImage() {
+        if (m_data)
+            munmap((void *)m_data, m_size);
+    }
+
+    mfxStatus Open(const std::string &fileName) {
+        int fd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return MFX_ERR_NOT_FOUND;
+
+        struct stat st;
+        if (fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size < (off_t)sizeof(ElfW(Ehdr))) {
+            close(fd);
+            return MFX_ERR_UNSUPPORTED;
+        }
+
+        void *data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+            return MFX_ERR_UNSUPPORTED;
+
+        m_data = (const mfxU8 *)data;
+        m_size = (size_t)st.st_size;
+
+        // only native shared libraries can be loaded by this process
+        const ElfW(Ehdr) *ehdr = At<ElfW(Ehdr)>(0);
+        if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG) || ehdr->e_ident[EI_CLASS] != ELF_NATIVE_CLASS ||
+            ehdr->e_ident[EI_DATA] != ELF_NATIVE_DATA || ehdr->e_type != ET_DYN ||
+            ehdr->e_phentsize != sizeof(ElfW(Phdr)))
+            return MFX_ERR_UNSUPPORTED;
+
+        m_phnum = ehdr->e_phnum;
+        m_phdr  = At<ElfW(Phdr)>(ehdr->e_phoff, m_phnum);
+        if (!m_phdr)
+            return MFX_ERR_UNSUPPORTED;
+
+        return MFX_ERR_NONE;
+    }
+
+    // return pointer to count objects at file offset, or nullptr if out of range
+    template <typename T>
+    const T *At(size_t offset, size_t count = 1) const {
+        if (offset > m_size || count > (m_size - offset) / sizeof(T))
+            return nullptr;
+        return (const T *)(m_data + offset);
+    }
+
+    // convert virtual address to file offset using PT_LOAD segments
+    bool AddrToOffset(ElfW(Addr) addr, size_t &offset) const {
+        for (size_t i = 0; i < m_phnum; i++) {
+            const ElfW(Phdr) &phdr = m_phdr[i];
+            if (phdr.p_type == PT_LOAD && addr >= phdr.p_vaddr &&
+                addr - phdr.p_vaddr < phdr.p_filesz) {
+                offset = (size_t)(addr - phdr.p_vaddr + phdr.p_offset);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const ElfW(Phdr) *FindSegment(ElfW(Word) type) const {
+        for (size_t i = 0; i < m_phnum; i++) {
+            if (m_phdr[i].p_type == type)
+                return &m_phdr[i];
+        }
+        return nullptr;
+    }
+
+private:
+    const mfxU8 *m_data;
+    size_t m_size;
+    const ElfW(Phdr) *m_phdr;
+    size_t m_phnum;
+
+    ElfImage(const ElfImage &other);
+    ElfImage &operator=(const ElfImage &other);
+};
+
+class ElfSymbolTable {
+public:
+    explicit ElfSymbolTable(const ElfImage &image)
+            : m_image(image),
+              m_symOffset(0),
+              m_strOffset(0),
+              m_strSize(0),
+              m_gnuHashOffset(0),
+              m_hashOffset(0),
+              m_bGnuHash(false),
+              m_bHash(false) {}
+
+    mfxStatus Init() {
+        const ElfW(Phdr) *dynSeg = m_image.FindSegment(PT_DYNAMIC);
+        if (!dynSeg)
+            return MFX_ERR_UNSUPPORTED;
+
+        size_t numDyn        = dynSeg->p_filesz / sizeof(ElfW(Dyn));
+        const ElfW(Dyn) *dyn = m_image.At<ElfW(Dyn)>(dynSeg->p_offset, numDyn);
+        if (!dyn)
+            return MFX_ERR_UNSUPPORTED;
+
+        bool bSym = false, bStr = false;
+        for (size_t i = 0; i < numDyn && dyn[i].d_tag != DT_NULL; i++) {
+            ElfW(Addr) ptr = dyn[i].d_un.d_ptr;
+            switch (dyn[i].d_tag) {
+                case DT_SYMTAB:
+                    bSym = m_image.AddrToOffset(ptr, m_symOffset);
+                    break;
+                case DT_STRTAB:
+                    bStr = m_image.AddrToOffset(ptr, m_strOffset);
+                    break;
+                case DT_STRSZ:
+                    m_strSize = (size_t)dyn[i].d_un.d_val;
+                    break;
+                case DT_SYMENT:
+                    if (dyn[i].d_un.d_val != sizeof(ElfW(Sym)))
+                        return MFX_ERR_UNSUPPORTED;
+                    break;
+                case DT_GNU_HASH:
+                    m_bGnuHash = m_image.AddrToOffset(ptr, m_gnuHashOffset);
+                    break;
+                case DT_HASH:
+                    m_bHash = m_image.AddrToOffset(ptr, m_hashOffset);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        if (!bSym || !bStr || !m_strSize || !m_image.At<char>(m_strOffset, m_strSize))
+            return MFX_ERR_UNSUPPORTED;
+
+        if (!m_bGnuHash && !m_bHash)
+            return MFX_ERR_UNSUPPORTED;
+
+        return MFX_ERR_NONE;
+    }
+
+    // return MFX_ERR_NONE and set bFound, or an error if the hash table is malformed
+    mfxStatus Lookup(const char *name, bool &bFound) const {
+        bFound = false;
+        return (m_bGnuHash ? LookupGnuHash(name, bFound) : LookupHash(name, bFound));
+    }
+
+private:
+    bool IsMatch(mfxU32 symIdx, const char *name, bool &bValid) const {
+        bValid               = false;
+        const ElfW(Sym) *sym = m_image.At<ElfW(Sym)>(m_symOffset + symIdx * sizeof(ElfW(Sym)));
+        if (!sym || sym->st_name >= m_strSize)
+            return false;
+        bValid = true;
+
+        // string table was validated in Init(), but individual strings may not be terminated
+        const char *symName = m_image.At<char>(m_strOffset) + sym->st_name;
+        size_t maxLen       = m_strSize - sym->st_name;
+        size_t nameLen      = strlen(name);
+        if (nameLen >= maxLen || strncmp(symName, name, nameLen + 1))
+            return false;
+
+        // must be defined in this library and visible to dlsym()
+        return (sym->st_shndx != SHN_UNDEF && ELF64_ST_BIND(sym->st_info) != STB_LOCAL);
+    }
+
+    mfxStatus LookupGnuHash(const char *name, bool &bFound) const {
+        const mfxU32 *hdr = m_image.At<mfxU32>(m_gnuHashOffset, 4);
+        if (!hdr)
+            return MFX_ERR_UNSUPPORTED;
+
+        mfxU32 nBuckets   = hdr[0];
+        mfxU32 symOffset  = hdr[1];
+        mfxU32 bloomSize  = hdr[2];
+        mfxU32 bloomShift = hdr[3];
+        if (!nBuckets || !bloomSize)
+            return MFX_ERR_UNSUPPORTED;
+
+        size_t bloomOffset      = m_gnuHashOffset + 4 * sizeof(mfxU32);
+        const ElfW(Addr) *bloom = m_image.At<ElfW(Addr)>(bloomOffset, bloomSize);
+
+        size_t bucketOffset   = bloomOffset + bloomSize * sizeof(ElfW(Addr));
+        const mfxU32 *buckets = m_image.At<mfxU32>(bucketOffset, nBuckets);
+
+        size_t chainOffset = bucketOffset + nBuckets * sizeof(mfxU32);
+        if (!bloom || !buckets)
+            return MFX_ERR_UNSUPPORTED;
+
+        mfxU32 h = 5381;
+        for (const unsigned char *c = (const unsigned char *)name; *c; c++)
+            h = (h << 5) + h + *c;
+
+        // bloom filter rejects most missing symbols without touching the symbol table
+        const mfxU32 wordBits = sizeof(ElfW(Addr)) * 8;
+        ElfW(Addr) word       = bloom[(h / wordBits) % bloomSize];
+        ElfW(Addr) mask       = ((ElfW(Addr))1 << (h % wordBits)) |
+                          ((ElfW(Addr))1 << ((h >> bloomShift) % wordBits));
+        if ((word & mask) != mask)
+            return MFX_ERR_NONE;
+
+        mfxU32 symIdx = buckets[h % nBuckets];
+        if (symIdx < symOffset)
+            return MFX_ERR_NONE;
+
+        while (1) {
+            const mfxU32 *chain =
+                m_image.At<mfxU32>(chainOffset + (size_t)(symIdx - symOffset) * sizeof(mfxU32));
+            if (!chain)
+                return MFX_ERR_UNSUPPORTED;
+
+            if ((h | 1) == (*chain | 1)) {
+                bool bValid = false;
+                if (IsMatch(symIdx, name, bValid)) {
+                    bFound = true;
+                    return MFX_ERR_NONE;
+                }
+                if (!bValid)
+                    return MFX_ERR_UNSUPPORTED;
+            }
+
+            // last entry in this bucket
+            if (*chain & 1)
+                return MFX_ERR_NONE;
+
+            symIdx++;
+        }
+    }
+
+    mfxStatus LookupHash(const char *name, bool &bFound) const {
+        const mfxU32 *hdr = m_image.At<mfxU32>(m_hashOffset, 2);
+        if (!hdr)
+            return MFX_ERR_UNSUPPORTED;
+
+        mfxU32 nBuckets = hdr[0];
+        mfxU32 nChain   = hdr[1];
+
+        const mfxU32 *buckets = m_image.At<mfxU32>(m_hashOffset + 2 * sizeof(mfxU32), nBuckets);
+        const mfxU32 *chain =
+            m_image.At<mfxU32>(m_hashOffset + (2 + (size_t)nBuckets) * sizeof(mfxU32), nChain);
+        if (!nBuckets || !buckets || !chain)
+            return MFX_ERR_UNSUPPORTED;
+
+        mfxU32 h = 0;
+        for (const unsigned char *c = (const unsigned char *)name; *c; c++) {
+            h        = (h << 4) + *c;
+            mfxU32 g = h & 0xf0000000;
+            if (g)
+                h ^= g >> 24;
+            h &= ~g;
+        }
+
+        // chain length is bounded by nChain to guard against loops in a corrupt table
+        mfxU32 symIdx = buckets[h % nBuckets];
+        for (mfxU32 n = 0; symIdx != STN_UNDEF && n < nChain; n++) {
+            if (symIdx >= nChain)
+                return MFX_ERR_UNSUPPORTED;
+
+            bool bValid = false;
+            if (IsMatch(symIdx, name, bValid)) {
+                bFound = true;
+                return MFX_ERR_NONE;
+            }
+            if (!bValid)
+                return MFX_ERR_UNSUPPORTED;
+
+            symIdx = chain[symIdx];
+        }
+
+        return MFX_ERR_NONE;
+    }
+
+    const ElfImage &m_image;
+
+    size_t m_symOffset;
+    size_t m_strOffset;
+    size_t m_strSize;
+    size_t m_gnuHashOffset;
+    size_t m_hashOffset;
+    bool m_bGnuHash;
+    bool m_bHash;
+};
+
+mfxStatus CheckElfExports(const std::string &fileName,
+                          const std::vector<const char *> &names,
+                          std::vector<bool> &found) {
+    found.assign(names.size(), false);
+
+    ElfImage image;
+    mfxStatus sts = image.Open(fileName);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    ElfSymbolTable symTable(image);
+    sts = symTable.Init();
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    for (size_t i = 0; i < names.size(); i++) {
+        bool bFound = false;
+        sts         = symTable.Lookup(names[i], bFound);
+        if (sts != MFX_ERR_NONE)
+            return sts;
+
+        found[i] = bFound;
+    }
+
+    return MFX_ERR_NONE;
+}
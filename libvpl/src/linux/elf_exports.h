@@ -0,0 +1,27 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#ifndef LIBVPL_SRC_LINUX_ELF_EXPORTS_H_
+#define LIBVPL_SRC_LINUX_ELF_EXPORTS_H_
+
+#include <string>
+#include <vector>
+
+#include "vpl/mfxdefs.h"
+
+// Check whether a shared library defines each symbol in names[], without loading it.
+// The dynamic symbol table is located through PT_DYNAMIC and searched using
+//   DT_GNU_HASH (or DT_HASH), the same way the runtime linker resolves symbols.
+// Only symbols defined in the library itself are found, not those in its dependencies.
+//
+// Returns MFX_ERR_NONE and sets found[i] for each name if the symbol table could be read.
+// Returns an error if the file is not a native ELF shared library or has an unsupported layout,
+//   in which case the caller should fall back to dlopen()/dlsym().
+mfxStatus CheckElfExports(const std::string &fileName,
+                          const std::vector<const char *> &names,
+                          std::vector<bool> &found);
+
+#endif // LIBVPL_SRC_LINUX_ELF_EXPORTS_H_
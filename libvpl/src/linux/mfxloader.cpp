@@ -6,16 +6,22 @@
 
 #include <assert.h>
 #include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "vpl/mfxdispatcher.h"
 #include "vpl/mfxvideo.h"
 
 // internal implementation of mfxConfigInterface
@@ -23,6 +29,8 @@
 
 #include "src/linux/device_ids.h"
 #include "src/linux/mfxloader.h"
+#include "src/mfx_dispatcher_vpl_placement.h"
+#include "src/mfx_dispatcher_vpl_pool.h"
 
 namespace MFX {
 
@@ -126,13 +134,233 @@ static const FunctionsTable2 g_mfxFuncTable2[] = {
     { eMFXVideoVPP_ProcessFrameAsync, "MFXVideoVPP_ProcessFrameAsync", VERSION(2, 1) },
 };
 
+// runtime functions resolved from a single library handle
+// immutable once created, so may be shared by any number of sessions
+struct RuntimeFuncTable {
+    std::shared_ptr<void> dlh;
+    void *table[eFunctionsNum];
+    void *table2[eFunctionsNum2];
+    std::string libPath;
+
+    // MFXCloneSession is optional for all API versions, so it is not part of table2
+    void *cloneSession;
+};
+
+// latency bucket i counts calls taking [2^i, 2^(i+1)) ns, the last bucket counts all longer calls
+#define CALL_STATS_NUM_BUCKETS 32
+
+#ifdef ONEVPL_EXPERIMENTAL
+static_assert(CALL_STATS_NUM_BUCKETS == MFX_CALLSTATS_NUM_BUCKETS,
+              "internal and public number of buckets must match");
+#endif
+
+// functions from both tables share one array of stats, entries for Function2 follow Function
+#define CALL_STATS_NUM_FUNCTIONS (eFunctionsNum + eFunctionsNum2)
+
+inline mfxU32 GetCallStatsIndex(Function func) {
+    return (mfxU32)func;
+}
+
+inline mfxU32 GetCallStatsIndex(Function2 func) {
+    return (mfxU32)eFunctionsNum + (mfxU32)func;
+}
+
+static const char *GetCallStatsName(mfxU32 idx) {
+    if (idx < (mfxU32)eFunctionsNum)
+        return g_mfxFuncTable[idx].name;
+
+    return g_mfxFuncTable2[idx - eFunctionsNum].name;
+}
+
+inline mfxU64 GetCallTime() {
+    return (mfxU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// counters may be updated by several threads calling into the same session
+struct FunctionCallStats {
+    std::atomic<mfxU64> numCalls;
+    std::atomic<mfxU64> totalTime;
+    std::atomic<mfxU64> maxTime;
+    std::atomic<mfxU64> histogram[CALL_STATS_NUM_BUCKETS];
+};
+
+// per-session call counts and latency histograms
+// only allocated if enabled with the ONEVPL_SESSION_STATS environment variable
+class SessionCallStats {
+public:
+    explicit SessionCallStats(const char *dumpFileName);
+
+    void Record(mfxU32 idx, mfxU64 startTime);
+
+    // append a table of all called functions to the dump file, if one was set
+    void Dump(mfxSession session, const char *libPath) const;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxStatus Query(mfxSessionCallStats **stats);
+    mfxStatus Release(mfxSessionCallStats *stats);
+#endif
+
+private:
+    FunctionCallStats m_calls[CALL_STATS_NUM_FUNCTIONS];
+    std::string m_dumpFileName;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    // copy returned to the application, freed by Release or with the session
+    struct Snapshot {
+        mfxSessionCallStats stats;
+        std::vector<mfxFunctionCallStats> functions;
+    };
+
+    std::mutex m_snapshotLock;
+    std::list<std::unique_ptr<Snapshot>> m_snapshots;
+#endif
+
+    SessionCallStats(const SessionCallStats &other);
+    SessionCallStats &operator=(const SessionCallStats &other);
+};
+
+SessionCallStats::SessionCallStats(const char *dumpFileName)
+        : m_calls(),
+          m_dumpFileName(dumpFileName ? dumpFileName : "") {
+    for (FunctionCallStats &calls : m_calls) {
+        calls.numCalls  = 0;
+        calls.totalTime = 0;
+        calls.maxTime   = 0;
+        for (auto &count : calls.histogram)
+            count = 0;
+    }
+}
+
+void SessionCallStats::Record(mfxU32 idx, mfxU64 startTime) {
+    mfxU64 callTime = GetCallTime() - startTime;
+
+    mfxU32 bucket = 0;
+    if (callTime > 1)
+        bucket = std::min((mfxU32)(63 - __builtin_clzll(callTime)),
+                          (mfxU32)(CALL_STATS_NUM_BUCKETS - 1));
+
+    FunctionCallStats &calls = m_calls[idx];
+    calls.numCalls.fetch_add(1, std::memory_order_relaxed);
+    calls.totalTime.fetch_add(callTime, std::memory_order_relaxed);
+    calls.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    mfxU64 maxTime = calls.maxTime.load(std::memory_order_relaxed);
+    while (callTime > maxTime &&
+           !calls.maxTime.compare_exchange_weak(maxTime, callTime, std::memory_order_relaxed))
+        ;
+}
+
+void SessionCallStats::Dump(mfxSession session, const char *libPath) const {
+    if (m_dumpFileName.empty())
+        return;
+
+    FILE *dumpFile = fopen(m_dumpFileName.c_str(), "a");
+    if (!dumpFile)
+        return;
+
+    // one write per session so that tables from several processes are not interleaved
+    flockfile(dumpFile);
+
+    fprintf(dumpFile, "session %p (%s)\n", (void *)session, libPath);
+    fprintf(dumpFile,
+            "%-40s %10s %14s %12s %12s  histogram (log2 ns: calls)\n",
+            "function",
+            "calls",
+            "total (us)",
+            "mean (us)",
+            "max (us)");
+
+    for (mfxU32 idx = 0; idx < CALL_STATS_NUM_FUNCTIONS; idx++) {
+        const FunctionCallStats &calls = m_calls[idx];
+
+        mfxU64 numCalls = calls.numCalls.load(std::memory_order_relaxed);
+        if (!numCalls)
+            continue;
+
+        mfxU64 totalTime = calls.totalTime.load(std::memory_order_relaxed);
+        fprintf(dumpFile,
+                "%-40s %10llu %14.1f %12.3f %12.1f ",
+                GetCallStatsName(idx),
+                (unsigned long long)numCalls,
+                totalTime / 1000.0,
+                totalTime / 1000.0 / numCalls,
+                calls.maxTime.load(std::memory_order_relaxed) / 1000.0);
+
+        for (mfxU32 bucket = 0; bucket < CALL_STATS_NUM_BUCKETS; bucket++) {
+            mfxU64 count = calls.histogram[bucket].load(std::memory_order_relaxed);
+            if (count)
+                fprintf(dumpFile, " %u:%llu", bucket, (unsigned long long)count);
+        }
+        fprintf(dumpFile, "\n");
+    }
+
+    funlockfile(dumpFile);
+    fclose(dumpFile);
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+mfxStatus SessionCallStats::Query(mfxSessionCallStats **stats) {
+    std::unique_ptr<Snapshot> snapshot(new Snapshot{});
+
+    for (mfxU32 idx = 0; idx < CALL_STATS_NUM_FUNCTIONS; idx++) {
+        const FunctionCallStats &calls = m_calls[idx];
+        if (!calls.numCalls.load(std::memory_order_relaxed))
+            continue;
+
+        mfxFunctionCallStats functionStats = {};
+        functionStats.FunctionName         = GetCallStatsName(idx);
+        functionStats.NumCalls             = calls.numCalls.load(std::memory_order_relaxed);
+        functionStats.TotalTime            = calls.totalTime.load(std::memory_order_relaxed);
+        functionStats.MaxTime              = calls.maxTime.load(std::memory_order_relaxed);
+        for (mfxU32 bucket = 0; bucket < CALL_STATS_NUM_BUCKETS; bucket++)
+            functionStats.Histogram[bucket] =
+                calls.histogram[bucket].load(std::memory_order_relaxed);
+
+        snapshot->functions.push_back(functionStats);
+    }
+
+    snapshot->stats.Version.Version = MFX_SESSIONCALLSTATS_VERSION;
+    snapshot->stats.NumFunctions    = (mfxU32)snapshot->functions.size();
+    snapshot->stats.Functions = snapshot->functions.empty() ? nullptr : snapshot->functions.data();
+
+    *stats = &snapshot->stats;
+
+    std::lock_guard<std::mutex> lock(m_snapshotLock);
+    m_snapshots.push_back(std::move(snapshot));
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus SessionCallStats::Release(mfxSessionCallStats *stats) {
+    std::lock_guard<std::mutex> lock(m_snapshotLock);
+
+    for (auto it = m_snapshots.begin(); it != m_snapshots.end(); it++) {
+        if (&(*it)->stats == stats) {
+            m_snapshots.erase(it);
+            return MFX_ERR_NONE;
+        }
+    }
+
+    return MFX_ERR_INVALID_HANDLE;
+}
+#endif
+
 class LoaderCtx {
 public:
     mfxStatus Init(mfxInitParam &par,
                    mfxInitializationParam &vplParam,
                    mfxU16 *pDeviceID,
-                   char *dllName,
-                   bool bCloneSession = false);
+                   char *dllName);
+    mfxStatus Init(mfxInitParam &par,
+                   mfxInitializationParam &vplParam,
+                   const std::shared_ptr<const RuntimeFuncTable> &funcs);
+
+    // initialize as a clone of parent, for a runtime session created by MFXCloneSession
+    // shares the library handle and function table of the parent (no dlopen or dlsym)
+    void InitClone(const LoaderCtx &parent, mfxSession cloneSession);
+
     mfxStatus Close();
 
     inline void *getFunction(Function func) const {
@@ -155,25 +383,29 @@ public:
         return m_version;
     }
 
-    inline void *getHandle() const {
-        return m_dlh.get();
+    inline const std::shared_ptr<const RuntimeFuncTable> &getFuncTable() const {
+        return m_funcs;
     }
 
     inline const char *getLibPath() const {
         return m_libToLoad.c_str();
     }
 
-    // special operations to set session pointer and version from MFXCloneSession()
-    inline void setSession(const mfxSession session) {
-        m_session = session;
-    }
-
+    // special operation to set version from MFXCloneSession()
     inline void setVersion(const mfxVersion version) {
         m_version = version;
     }
 
+    // nullptr unless call stats are enabled for this session
+    inline SessionCallStats *getCallStats() const {
+        return m_callStats.get();
+    }
+
 private:
-    std::shared_ptr<void> m_dlh;
+    void InitCallStats();
+
+    std::unique_ptr<SessionCallStats> m_callStats;
+    std::shared_ptr<const RuntimeFuncTable> m_funcs;
     mfxVersion m_version{};
     mfxIMPL m_implementation{};
     mfxSession m_session = nullptr;
@@ -182,6 +414,35 @@ private:
     std::string m_libToLoad;
 };
 
+// time one call into the runtime if call stats are enabled for the session
+// declare right before the call, the time is recorded when leaving the scope
+class CallStatsTimer {
+public:
+    template <typename FuncId>
+    CallStatsTimer(const LoaderCtx *loader, FuncId func)
+            : m_callStats(loader->getCallStats()),
+              m_idx(0),
+              m_startTime(0) {
+        if (m_callStats) {
+            m_idx       = GetCallStatsIndex(func);
+            m_startTime = GetCallTime();
+        }
+    }
+
+    ~CallStatsTimer() {
+        if (m_callStats)
+            m_callStats->Record(m_idx, m_startTime);
+    }
+
+private:
+    SessionCallStats *m_callStats;
+    mfxU32 m_idx;
+    mfxU64 m_startTime;
+
+    CallStatsTimer(const CallStatsTimer &other);
+    CallStatsTimer &operator=(const CallStatsTimer &other);
+};
+
 std::shared_ptr<void> make_dlopen(const char *filename, int flags) {
     return std::shared_ptr<void>(dlopen(filename, flags), [](void *handle) {
         if (handle)
@@ -189,11 +450,29 @@ std::shared_ptr<void> make_dlopen(const char *filename, int flags) {
     });
 }
 
+static void ResolveFunctions(const std::shared_ptr<void> &hdl,
+                             const std::string &libPath,
+                             RuntimeFuncTable &funcs) {
+    funcs.dlh     = hdl;
+    funcs.libPath = libPath;
+
+    for (int i = 0; i < eFunctionsNum; ++i) {
+        assert(i == g_mfxFuncTable[i].id);
+        funcs.table[i] = dlsym(hdl.get(), g_mfxFuncTable[i].name);
+    }
+
+    for (int i = 0; i < eFunctionsNum2; ++i) {
+        assert(i == g_mfxFuncTable2[i].id);
+        funcs.table2[i] = dlsym(hdl.get(), g_mfxFuncTable2[i].name);
+    }
+
+    funcs.cloneSession = dlsym(hdl.get(), "MFXCloneSession");
+}
+
 mfxStatus LoaderCtx::Init(mfxInitParam &par,
                           mfxInitializationParam &vplParam,
                           mfxU16 *pDeviceID,
-                          char *dllName,
-                          bool bCloneSession) {
+                          char *dllName) {
     mfxStatus mfx_res = MFX_ERR_NONE;
 
     std::vector<std::string> libs;
@@ -256,101 +535,134 @@ mfxStatus LoaderCtx::Init(mfxInitParam &par,
     for (auto &lib : libs) {
         std::shared_ptr<void> hdl = make_dlopen(lib.c_str(), RTLD_LOCAL | RTLD_NOW);
         if (hdl) {
-            do {
-                /* Loading functions table */
-                bool wrong_version = false;
-                for (int i = 0; i < eFunctionsNum; ++i) {
-                    assert(i == g_mfxFuncTable[i].id);
-                    m_table[i] = dlsym(hdl.get(), g_mfxFuncTable[i].name);
-                    if (!m_table[i] && ((g_mfxFuncTable[i].version <= par.Version))) {
-                        wrong_version = true;
-                        break;
-                    }
-                }
+            std::shared_ptr<RuntimeFuncTable> funcs = std::make_shared<RuntimeFuncTable>();
+            ResolveFunctions(hdl, lib, *funcs);
 
-                // if version >= 2.0, load these functions as well
-                if (par.Version.Major >= 2) {
-                    for (int i = 0; i < eFunctionsNum2; ++i) {
-                        assert(i == g_mfxFuncTable2[i].id);
-                        m_table2[i] = dlsym(hdl.get(), g_mfxFuncTable2[i].name);
-                        if (!m_table2[i] && (g_mfxFuncTable2[i].version <= par.Version)) {
-                            wrong_version = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (wrong_version) {
-                    mfx_res = MFX_ERR_UNSUPPORTED;
-                    break;
-                }
-
-                if (bCloneSession == true) {
-                    // success - exit loop since caller will create session with MFXCloneSession()
-                    mfx_res = MFX_ERR_NONE;
-                    break;
-                }
+            mfx_res = Init(par, vplParam, funcs);
+            if (MFX_ERR_NONE == mfx_res)
+                break;
+        }
+    }
 
-                if (par.Version.Major >= 2) {
-                    // for API >= 2.0 call MFXInitialize instead of MFXInitEx
-                    mfx_res =
-                        ((decltype(MFXInitialize) *)m_table2[eMFXInitialize])(vplParam, &m_session);
-                }
-                else {
-                    if (m_table[eMFXInitEx]) {
-                        // initialize with MFXInitEx if present (API >= 1.14)
-                        mfx_res = ((decltype(MFXInitEx) *)m_table[eMFXInitEx])(par, &m_session);
-                    }
-                    else {
-                        // initialize with MFXInit for API < 1.14
-                        mfx_res = ((decltype(MFXInit) *)m_table[eMFXInit])(par.Implementation,
-                                                                           &(par.Version),
-                                                                           &m_session);
-                    }
-                }
+    return mfx_res;
+}
 
-                if (MFX_ERR_NONE != mfx_res) {
-                    break;
-                }
+// initialize session from a table of already resolved functions (no dlopen or dlsym)
+mfxStatus LoaderCtx::Init(mfxInitParam &par,
+                          mfxInitializationParam &vplParam,
+                          const std::shared_ptr<const RuntimeFuncTable> &funcs) {
+    mfxStatus mfx_res = MFX_ERR_NONE;
 
-                // Below we just get some data and double check that we got what we have expected
-                // to get. Some of these checks are done inside mediasdk init function
-                mfx_res =
-                    ((decltype(MFXQueryVersion) *)m_table[eMFXQueryVersion])(m_session, &m_version);
-                if (MFX_ERR_NONE != mfx_res) {
-                    break;
-                }
+    do {
+        /* Loading functions table */
+        bool wrong_version = false;
+        for (int i = 0; i < eFunctionsNum; ++i) {
+            m_table[i] = funcs->table[i];
+            if (!m_table[i] && ((g_mfxFuncTable[i].version <= par.Version))) {
+                wrong_version = true;
+                break;
+            }
+        }
 
-                if (m_version < par.Version) {
-                    mfx_res = MFX_ERR_UNSUPPORTED;
+        // if version >= 2.0, load these functions as well
+        if (par.Version.Major >= 2) {
+            for (int i = 0; i < eFunctionsNum2; ++i) {
+                m_table2[i] = funcs->table2[i];
+                if (!m_table2[i] && (g_mfxFuncTable2[i].version <= par.Version)) {
+                    wrong_version = true;
                     break;
                 }
+            }
+        }
 
-                mfx_res = ((decltype(MFXQueryIMPL) *)m_table[eMFXQueryIMPL])(m_session,
-                                                                             &m_implementation);
-                if (MFX_ERR_NONE != mfx_res) {
-                    mfx_res = MFX_ERR_UNSUPPORTED;
-                    break;
-                }
-            } while (false);
+        if (wrong_version) {
+            mfx_res = MFX_ERR_UNSUPPORTED;
+            break;
+        }
 
-            if (MFX_ERR_NONE == mfx_res) {
-                m_dlh = std::move(hdl);
-                break;
+        if (par.Version.Major >= 2) {
+            // for API >= 2.0 call MFXInitialize instead of MFXInitEx
+            mfx_res = ((decltype(MFXInitialize) *)m_table2[eMFXInitialize])(vplParam, &m_session);
+        }
+        else {
+            if (m_table[eMFXInitEx]) {
+                // initialize with MFXInitEx if present (API >= 1.14)
+                mfx_res = ((decltype(MFXInitEx) *)m_table[eMFXInitEx])(par, &m_session);
             }
             else {
-                Close();
+                // initialize with MFXInit for API < 1.14
+                mfx_res = ((decltype(MFXInit) *)m_table[eMFXInit])(par.Implementation,
+                                                                   &(par.Version),
+                                                                   &m_session);
             }
         }
+
+        if (MFX_ERR_NONE != mfx_res) {
+            break;
+        }
+
+        // Below we just get some data and double check that we got what we have expected
+        // to get. Some of these checks are done inside mediasdk init function
+        mfx_res = ((decltype(MFXQueryVersion) *)m_table[eMFXQueryVersion])(m_session, &m_version);
+        if (MFX_ERR_NONE != mfx_res) {
+            break;
+        }
+
+        if (m_version < par.Version) {
+            mfx_res = MFX_ERR_UNSUPPORTED;
+            break;
+        }
+
+        mfx_res =
+            ((decltype(MFXQueryIMPL) *)m_table[eMFXQueryIMPL])(m_session, &m_implementation);
+        if (MFX_ERR_NONE != mfx_res) {
+            mfx_res = MFX_ERR_UNSUPPORTED;
+            break;
+        }
+    } while (false);
+
+    if (MFX_ERR_NONE == mfx_res) {
+        m_funcs     = funcs;
+        m_libToLoad = funcs->libPath;
+        InitCallStats();
+    }
+    else {
+        Close();
     }
 
     return mfx_res;
 }
 
+void LoaderCtx::InitClone(const LoaderCtx &parent, mfxSession cloneSession) {
+    std::copy(std::begin(parent.m_table), std::end(parent.m_table), std::begin(m_table));
+    std::copy(std::begin(parent.m_table2), std::end(parent.m_table2), std::begin(m_table2));
+
+    m_funcs          = parent.m_funcs;
+    m_libToLoad      = parent.m_libToLoad;
+    m_implementation = parent.m_implementation;
+    m_version        = parent.m_version;
+    m_session        = cloneSession;
+
+    InitCallStats();
+}
+
+void LoaderCtx::InitCallStats() {
+    const char *statsEnabled = getenv("ONEVPL_SESSION_STATS");
+    if (!statsEnabled || strcmp(statsEnabled, "ON"))
+        return;
+
+    m_callStats.reset(new SessionCallStats(getenv("ONEVPL_SESSION_STATS_FILE")));
+}
+
 mfxStatus LoaderCtx::Close() {
     auto proc         = (decltype(MFXClose) *)m_table[eMFXClose];
     mfxStatus mfx_res = (proc) ? (*proc)(m_session) : MFX_ERR_NONE;
 
+    if (m_callStats) {
+        m_callStats->Dump((mfxSession)this, m_libToLoad.c_str());
+        m_callStats.reset();
+    }
+
     m_implementation = {};
     m_version        = {};
     m_session        = nullptr;
@@ -360,22 +672,13 @@ mfxStatus LoaderCtx::Close() {
 
 } // namespace MFX
 
-// internal function - load a specific DLL, return unsupported if it fails
-// vplParam is required for API >= 2.0 (load via MFXInitialize)
-mfxStatus MFXInitEx2(mfxVersion version,
-                     mfxInitializationParam vplParam,
-                     mfxIMPL hwImpl,
-                     mfxSession *session,
-                     mfxU16 *deviceID,
-                     char *dllName) {
-    if (!session)
-        return MFX_ERR_NULL_PTR;
-
-    *deviceID = 0;
-
-    // fill minimal 1.x parameters for Init to choose correct initialization path
-    mfxInitParam par = {};
-    par.Version      = version;
+// fill minimal 1.x parameters for Init to choose correct initialization path
+static void SetInitParam(mfxVersion version,
+                         mfxInitializationParam &vplParam,
+                         mfxIMPL hwImpl,
+                         mfxInitParam &par) {
+    par         = {};
+    par.Version = version;
 
     // select first adapter if not specified
     // only relevant for MSDK-via-MFXLoad path
@@ -409,6 +712,23 @@ mfxStatus MFXInitEx2(mfxVersion version,
     //   flag in mfxInitParam for legacy RTs
     par.GPUCopy = vplParam.DeviceCopy;
 #endif
+}
+
+// internal function - load a specific DLL, return unsupported if it fails
+// vplParam is required for API >= 2.0 (load via MFXInitialize)
+mfxStatus MFXInitEx2(mfxVersion version,
+                     mfxInitializationParam vplParam,
+                     mfxIMPL hwImpl,
+                     mfxSession *session,
+                     mfxU16 *deviceID,
+                     char *dllName) {
+    if (!session)
+        return MFX_ERR_NULL_PTR;
+
+    *deviceID = 0;
+
+    mfxInitParam par;
+    SetInitParam(version, vplParam, hwImpl, par);
 
     try {
         std::unique_ptr<MFX::LoaderCtx> loader;
@@ -430,6 +750,66 @@ mfxStatus MFXInitEx2(mfxVersion version,
     }
 }
 
+// internal function - resolve the function table of a library which is already loaded
+// the library is not opened again: RTLD_NOLOAD takes another reference on the existing
+//   handle, which keeps the library loaded for as long as any session uses the table
+mfxStatus MFXCreateRuntimeFuncTable(void *hModule,
+                                    const char *libNameFull,
+                                    std::shared_ptr<const MFX::RuntimeFuncTable> &funcTable) {
+    if (!hModule || !libNameFull)
+        return MFX_ERR_NULL_PTR;
+
+    try {
+        std::shared_ptr<void> hdl =
+            MFX::make_dlopen(libNameFull, RTLD_LOCAL | RTLD_NOW | RTLD_NOLOAD);
+        if (hdl.get() != hModule)
+            return MFX_ERR_NOT_FOUND;
+
+        std::shared_ptr<MFX::RuntimeFuncTable> funcs = std::make_shared<MFX::RuntimeFuncTable>();
+        MFX::ResolveFunctions(hdl, libNameFull, *funcs);
+
+        funcTable = funcs;
+
+        return MFX_ERR_NONE;
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+}
+
+// internal function - create session using a table from MFXCreateRuntimeFuncTable()
+// vplParam is required for API >= 2.0 (load via MFXInitialize)
+mfxStatus MFXInitWithFuncTable(mfxVersion version,
+                               mfxInitializationParam vplParam,
+                               mfxIMPL hwImpl,
+                               mfxSession *session,
+                               const std::shared_ptr<const MFX::RuntimeFuncTable> &funcTable) {
+    if (!session || !funcTable)
+        return MFX_ERR_NULL_PTR;
+
+    mfxInitParam par;
+    SetInitParam(version, vplParam, hwImpl, par);
+
+    try {
+        std::unique_ptr<MFX::LoaderCtx> loader;
+
+        loader.reset(new MFX::LoaderCtx{});
+
+        mfxStatus mfx_res = loader->Init(par, vplParam, funcTable);
+        if (MFX_ERR_NONE == mfx_res) {
+            *session = (mfxSession)loader.release();
+        }
+        else {
+            *session = nullptr;
+        }
+
+        return mfx_res;
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -494,6 +874,10 @@ mfxStatus MFXClose(mfxSession session) {
             // Can't unload library in this case.
             loader.release();
         }
+        else {
+            UntrackPlacedSession(session);
+            UntrackPooledSession(session);
+        }
         return mfx_res;
     }
     catch (...) {
@@ -514,6 +898,7 @@ mfxStatus MFXMemory_GetSurfaceForVPP(mfxSession session, mfxFrameSurface1 **surf
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXMemory_GetSurfaceForVPP);
     return (*proc)(loader->getSession(), surface);
 }
 
@@ -529,6 +914,7 @@ mfxStatus MFXMemory_GetSurfaceForVPPOut(mfxSession session, mfxFrameSurface1 **s
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXMemory_GetSurfaceForVPPOut);
     return (*proc)(loader->getSession(), surface);
 }
 
@@ -544,6 +930,7 @@ mfxStatus MFXMemory_GetSurfaceForEncode(mfxSession session, mfxFrameSurface1 **s
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXMemory_GetSurfaceForEncode);
     return (*proc)(loader->getSession(), surface);
 }
 
@@ -559,6 +946,7 @@ mfxStatus MFXMemory_GetSurfaceForDecode(mfxSession session, mfxFrameSurface1 **s
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXMemory_GetSurfaceForDecode);
     return (*proc)(loader->getSession(), surface);
 }
 
@@ -577,6 +965,7 @@ mfxStatus MFXVideoDECODE_VPP_Init(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXVideoDECODE_VPP_Init);
     return (*proc)(loader->getSession(), decode_par, vpp_par_array, num_vpp_par);
 }
 
@@ -596,6 +985,7 @@ mfxStatus MFXVideoDECODE_VPP_DecodeFrameAsync(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXVideoDECODE_VPP_DecodeFrameAsync);
     return (*proc)(loader->getSession(), bs, skip_channels, num_skip_channels, surf_array_out);
 }
 
@@ -614,6 +1004,7 @@ mfxStatus MFXVideoDECODE_VPP_Reset(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXVideoDECODE_VPP_Reset);
     return (*proc)(loader->getSession(), decode_par, vpp_par_array, num_vpp_par);
 }
 
@@ -631,6 +1022,7 @@ mfxStatus MFXVideoDECODE_VPP_GetChannelParam(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXVideoDECODE_VPP_GetChannelParam);
     return (*proc)(loader->getSession(), par, channel_id);
 }
 
@@ -646,6 +1038,7 @@ mfxStatus MFXVideoDECODE_VPP_Close(mfxSession session) {
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXVideoDECODE_VPP_Close);
     return (*proc)(loader->getSession());
 }
 
@@ -663,6 +1056,7 @@ mfxStatus MFXVideoVPP_ProcessFrameAsync(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXVideoVPP_ProcessFrameAsync);
     return (*proc)(loader->getSession(), in, out);
 }
 
@@ -690,6 +1084,7 @@ mfxStatus MFXVideoCORE_GetHandle(mfxSession session, mfxHandleType type, mfxHDL
         return MFX_ERR_INVALID_HANDLE;
     }
 
+    MFX::CallStatsTimer callTimer(loader, MFX::eMFXVideoCORE_GetHandle);
     return (*proc)(loader->getSession(), type, hdl);
 }
 
@@ -710,111 +1105,179 @@ mfxStatus MFXJoinSession(mfxSession session, mfxSession child_session) {
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), child_loader->getSession());
-}
+    mfxStatus mfx_res = (*proc)(loader->getSession(), child_loader->getSession());
+    if (mfx_res == MFX_ERR_NONE)
+        JoinPooledSession(session);
 
-static mfxStatus AllocateCloneLoader(MFX::LoaderCtx *parentLoader, MFX::LoaderCtx **cloneLoader) {
-    // initialization param structs are not used when bCloneSession == true
-    mfxInitParam par                = {};
-    mfxInitializationParam vplParam = {};
-    mfxU16 deviceID                 = 0;
+    return mfx_res;
+}
 
-    // initialization extBufs are not saved at this level
-    // the RT should save these when the parent session is created and may use
-    //   them when creating the cloned session
-    par.NumExtParam = 0;
+mfxStatus MFXCloneSession(mfxSession session, mfxSession *clone) {
+    if (!session || !clone)
+        return MFX_ERR_INVALID_HANDLE;
 
-    try {
-        std::unique_ptr<MFX::LoaderCtx> cl;
+    MFX::LoaderCtx *loader = (MFX::LoaderCtx *)session;
+    mfxVersion version     = loader->getVersion();
+    *clone                 = nullptr;
 
-        cl.reset(new MFX::LoaderCtx{});
+    // the clone uses the library handle and function table of the parent session,
+    //   so the library is not opened again and no symbols are resolved
+    const std::shared_ptr<const MFX::RuntimeFuncTable> &funcs = loader->getFuncTable();
+    if (!funcs)
+        return MFX_ERR_INVALID_HANDLE;
 
-        mfxStatus mfx_res =
-            cl->Init(par, vplParam, &deviceID, (char *)parentLoader->getLibPath(), true);
-        if (MFX_ERR_NONE == mfx_res) {
-            *cloneLoader = cl.release();
+    try {
+        std::unique_ptr<MFX::LoaderCtx> cloneLoader(new MFX::LoaderCtx{});
+
+        // initialize the clone session
+        // for runtimes with 1.x API, call MFXInitEx followed by MFXJoinSession
+        // for runtimes with 2.x API, use RT implementation of MFXCloneSession (passthrough)
+        if (version.Major == 1) {
+            mfxInitParam par                = {};
+            mfxInitializationParam vplParam = {};
+
+            par.Implementation = loader->getImpl();
+            par.Version        = version;
+
+            mfxStatus mfx_res = cloneLoader->Init(par, vplParam, funcs);
+            if (MFX_ERR_NONE != mfx_res)
+                return mfx_res;
+
+            // join the sessions
+            mfx_res = MFXJoinSession(session, (mfxSession)cloneLoader.get());
+            if (MFX_ERR_NONE != mfx_res) {
+                MFXClose((mfxSession)cloneLoader.release());
+                return mfx_res;
+            }
+        }
+        else if (version.Major == 2) {
+            // MFXCloneSession is optional, fail gracefully if the RT does not export it
+            auto proc = (decltype(MFXCloneSession) *)funcs->cloneSession;
+            if (!proc)
+                return MFX_ERR_UNSUPPORTED;
+
+            // call RT implementation of MFXCloneSession
+            mfxSession cloneRT = nullptr;
+            mfxStatus mfx_res  = (*proc)(loader->getSession(), &cloneRT);
+            if (mfx_res != MFX_ERR_NONE || cloneRT == NULL)
+                return MFX_ERR_UNSUPPORTED;
+
+            // copy state from parent session (function pointer tables, impl type, etc.)
+            cloneLoader->InitClone(*loader, cloneRT);
+
+            // get version of cloned session
+            mfxVersion cloneVersion = {};
+            mfx_res = MFXQueryVersion((mfxSession)cloneLoader.get(), &cloneVersion);
+            if (mfx_res != MFX_ERR_NONE) {
+                MFXClose((mfxSession)cloneLoader.release());
+                return mfx_res;
+            }
+            cloneLoader->setVersion(cloneVersion);
         }
         else {
-            *cloneLoader = nullptr;
+            return MFX_ERR_UNSUPPORTED;
         }
 
-        return mfx_res;
+        *clone = (mfxSession)cloneLoader.release();
     }
     catch (...) {
         return MFX_ERR_MEMORY_ALLOC;
     }
+
+    return MFX_ERR_NONE;
 }
 
-mfxStatus MFXCloneSession(mfxSession session, mfxSession *clone) {
-    if (!session || !clone)
+#ifdef ONEVPL_EXPERIMENTAL
+mfxStatus MFXQuerySessionCallStats(mfxSession session, mfxSessionCallStats **stats) {
+    if (!session)
         return MFX_ERR_INVALID_HANDLE;
 
-    MFX::LoaderCtx *loader = (MFX::LoaderCtx *)session;
-    mfxVersion version     = loader->getVersion();
-    *clone                 = nullptr;
-
-    // initialize the clone session
-    // for runtimes with 1.x API, call MFXInit followed by MFXJoinSession
-    // for runtimes with 2.x API, use RT implementation of MFXCloneSession (passthrough)
-    if (version.Major == 1) {
-        mfxStatus mfx_res = MFXInit(loader->getImpl(), &version, clone);
-        if (MFX_ERR_NONE != mfx_res) {
-            return mfx_res;
-        }
+    if (!stats)
+        return MFX_ERR_NULL_PTR;
 
-        // join the sessions
-        mfx_res = MFXJoinSession(session, *clone);
-        if (MFX_ERR_NONE != mfx_res) {
-            MFXClose(*clone);
-            *clone = nullptr;
-            return mfx_res;
-        }
-    }
-    else if (version.Major == 2) {
+    try {
         MFX::LoaderCtx *loader = (MFX::LoaderCtx *)session;
 
-        // MFXCloneSession not included in function pointer search during init
-        // for bwd-compat, check for it here and fail gracefully if missing
-        void *libHandle = loader->getHandle();
-        auto proc       = (decltype(MFXCloneSession) *)(dlsym(libHandle, "MFXCloneSession"));
-        if (!proc)
+        MFX::SessionCallStats *callStats = loader->getCallStats();
+        if (!callStats)
             return MFX_ERR_UNSUPPORTED;
 
-        // allocate new dispatcher-level session object and copy
-        //   state from parent session (function pointer tables, impl type, etc.)
-        MFX::LoaderCtx *cloneLoader;
-        mfxStatus mfx_res = AllocateCloneLoader(loader, &cloneLoader);
-        if (mfx_res != MFX_ERR_NONE)
-            return mfx_res;
+        return callStats->Query(stats);
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+}
+
+mfxStatus MFXReleaseSessionCallStats(mfxSession session, mfxSessionCallStats *stats) {
+    if (!session)
+        return MFX_ERR_INVALID_HANDLE;
 
-        // call RT implementation of MFXCloneSession
-        mfxSession cloneRT;
-        mfx_res = (*proc)(loader->getSession(), &cloneRT);
+    if (!stats)
+        return MFX_ERR_NULL_PTR;
 
-        if (mfx_res != MFX_ERR_NONE || cloneRT == NULL) {
-            // RT call failed, delete cloned loader (no valid session created)
-            delete cloneLoader;
+    try {
+        MFX::LoaderCtx *loader = (MFX::LoaderCtx *)session;
+
+        MFX::SessionCallStats *callStats = loader->getCallStats();
+        if (!callStats)
             return MFX_ERR_UNSUPPORTED;
-        }
-        cloneLoader->setSession(cloneRT);
-
-        // get version of cloned session
-        mfxVersion cloneVersion = {};
-        mfx_res                 = MFXQueryVersion((mfxSession)cloneLoader, &cloneVersion);
-        cloneLoader->setVersion(cloneVersion);
-        if (mfx_res != MFX_ERR_NONE) {
-            MFXClose((mfxSession)cloneLoader);
-            return mfx_res;
-        }
 
-        *clone = (mfxSession)cloneLoader;
+        return callStats->Release(stats);
     }
-    else {
-        return MFX_ERR_UNSUPPORTED;
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
     }
+}
+
+mfxStatus MFXGetRuntimeFunctions(mfxSession session, mfxRuntimeFunctions *functions) {
+    if (!session)
+        return MFX_ERR_INVALID_HANDLE;
+
+    if (!functions)
+        return MFX_ERR_NULL_PTR;
+
+    // later minor versions only add fields at the end, in reserved space
+    mfxStructVersion version = functions->Version;
+    if (version.Version < MFX_STRUCT_VERSION(1, 0) || version.Version >= MFX_STRUCT_VERSION(2, 0))
+        return MFX_ERR_UNSUPPORTED;
+
+    MFX::LoaderCtx *loader = (MFX::LoaderCtx *)session;
+
+    *functions                = {};
+    functions->Version        = version;
+    functions->RuntimeSession = loader->getSession();
+
+    functions->SyncOperation = (decltype(functions->SyncOperation))loader->getFunction(
+        MFX::eMFXVideoCORE_SyncOperation);
+    functions->DecodeFrameAsync = (decltype(functions->DecodeFrameAsync))loader->getFunction(
+        MFX::eMFXVideoDECODE_DecodeFrameAsync);
+    functions->EncodeFrameAsync = (decltype(functions->EncodeFrameAsync))loader->getFunction(
+        MFX::eMFXVideoENCODE_EncodeFrameAsync);
+    functions->RunFrameVPPAsync = (decltype(functions->RunFrameVPPAsync))loader->getFunction(
+        MFX::eMFXVideoVPP_RunFrameVPPAsync);
+
+    // 2.x functions, NULL for 1.x runtimes
+    functions->ProcessFrameAsync = (decltype(functions->ProcessFrameAsync))loader->getFunction2(
+        MFX::eMFXVideoVPP_ProcessFrameAsync);
+    functions->DecodeVPPFrameAsync =
+        (decltype(functions->DecodeVPPFrameAsync))loader->getFunction2(
+            MFX::eMFXVideoDECODE_VPP_DecodeFrameAsync);
+    functions->GetSurfaceForVPP = (decltype(functions->GetSurfaceForVPP))loader->getFunction2(
+        MFX::eMFXMemory_GetSurfaceForVPP);
+    functions->GetSurfaceForVPPOut =
+        (decltype(functions->GetSurfaceForVPPOut))loader->getFunction2(
+            MFX::eMFXMemory_GetSurfaceForVPPOut);
+    functions->GetSurfaceForEncode =
+        (decltype(functions->GetSurfaceForEncode))loader->getFunction2(
+            MFX::eMFXMemory_GetSurfaceForEncode);
+    functions->GetSurfaceForDecode =
+        (decltype(functions->GetSurfaceForDecode))loader->getFunction2(
+            MFX::eMFXMemory_GetSurfaceForDecode);
 
     return MFX_ERR_NONE;
 }
+#endif
 
 #undef FUNCTION
 #define FUNCTION(return_value, func_name, formal_param_list, actual_param_list)    \
@@ -832,6 +1295,7 @@ mfxStatus MFXCloneSession(mfxSession session, mfxSession *clone) {
         /* get the real session pointer */                                         \
         session = loader->getSession();                                            \
         /* pass down the call */                                                   \
+        MFX::CallStatsTimer callTimer(loader, MFX::e##func_name);                  \
         return (*proc)actual_param_list;                                           \
     }
 
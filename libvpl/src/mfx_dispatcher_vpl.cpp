@@ -6,6 +6,10 @@
 
 #include "src/mfx_dispatcher_vpl.h"
 
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include "src/linux/drm_topology.h"
+#endif
+
 // exported functions for API >= 2.0
 
 // create unique loader context
@@ -16,9 +20,27 @@ mfxLoader MFXLoad() {
         std::unique_ptr<LoaderCtxVPL> pLoaderCtx;
         pLoaderCtx.reset(new LoaderCtxVPL{});
 
+#if !defined(_WIN32) && !defined(_WIN64)
+        // pick up GPUs added, removed, or moved since the last loader was created
+        CheckDRMTopology();
+#endif
+
         // initialize logging if appropriate environment variables are set
         pLoaderCtx->InitDispatcherLog();
 
+        // enable persistent caps cache if appropriate environment variable is set
+        pLoaderCtx->InitCapsCache();
+
+        // enable parallel loading of libraries if appropriate environment variable is set
+        pLoaderCtx->InitParallelProbe();
+
+        // share runtimes with other loaders if appropriate environment variable is set
+        pLoaderCtx->InitRuntimeRegistry();
+
+        // start loading and querying libraries if appropriate environment variable is set
+        // must be last, since the discovery thread uses the settings above
+        pLoaderCtx->InitBackgroundDiscovery();
+
         loaderCtx = (LoaderCtxVPL *)pLoaderCtx.release();
     }
     catch (...) {
@@ -36,6 +58,15 @@ void MFXUnload(mfxLoader loader) {
 
         LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
 
+        // discovery thread may still be loading libraries
+        loaderCtx->WaitBackgroundDiscovery();
+
+        // selections are only kept in memory until the loader is unloaded
+        loaderCtx->SaveCapsCache();
+
+        // pools create sessions from this loader, so stop them first
+        loaderCtx->FreeSessionPools();
+
         loaderCtx->UnloadAllLibraries();
 
         loaderCtx->FreeConfigFilters();
@@ -60,7 +91,12 @@ mfxConfig MFXCreateConfig(mfxLoader loader) {
         DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
         DISP_LOG_FUNCTION(dispLog);
 
+        // does not wait for background discovery, which holds the writer lock
+        std::lock_guard<std::mutex> configLock(loaderCtx->m_configLock);
+
         configCtx = loaderCtx->AddConfigFilter();
+        if (configCtx)
+            loaderCtx->m_bConfigChanged = true;
 
         return (mfxConfig)(configCtx);
     }
@@ -84,26 +120,54 @@ mfxStatus MFXSetConfigFilterProperty(mfxConfig config, const mfxU8 *name, mfxVar
         DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
         DISP_LOG_FUNCTION(dispLog);
 
+        // does not wait for background discovery, which holds the writer lock
+        // low latency mode and property-based query are updated by ApplyConfigChanges()
+        std::lock_guard<std::mutex> configLock(loaderCtx->m_configLock);
+
         mfxStatus sts = configCtx->SetFilterProperty(name, value);
         if (sts)
             return sts;
 
-        loaderCtx->m_bNeedUpdateValidImpls = true;
+        loaderCtx->m_bConfigChanged = true;
+
+        return MFX_ERR_NONE;
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+mfxStatus MFXSetConfigFilterPropertyById(mfxConfig config, mfxU32 propId, mfxVariant value) {
+    try {
+        if (!config)
+            return MFX_ERR_NULL_PTR;
+
+        ConfigCtxVPL *configCtx = (ConfigCtxVPL *)config;
+        LoaderCtxVPL *loaderCtx = configCtx->m_parentLoader;
+
+        if (!loaderCtx)
+            return MFX_ERR_NULL_PTR; // should never happen - always set during MFXCreateConfig()
+
+        DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+        DISP_LOG_FUNCTION_ARG(dispLog, "propId", propId);
+
+        // see MFXSetConfigFilterProperty()
+        std::lock_guard<std::mutex> configLock(loaderCtx->m_configLock);
 
-        sts = loaderCtx->UpdateLowLatency();
+        mfxStatus sts = configCtx->SetFilterPropertyById(propId, value);
         if (sts)
             return sts;
 
-#ifdef ONEVPL_EXPERIMENTAL
-        sts = loaderCtx->UpdatePropsQuery();
-#endif
+        loaderCtx->m_bConfigChanged = true;
 
-        return sts;
+        return MFX_ERR_NONE;
     }
     catch (...) {
         return MFX_ERR_UNKNOWN;
     }
 }
+#endif
 
 // iterate over available implementations
 // capabilities are returned in idesc
@@ -118,10 +182,29 @@ mfxStatus MFXEnumImplementations(mfxLoader loader,
         LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
 
         DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
-        DISP_LOG_FUNCTION(dispLog);
+        DISP_LOG_FUNCTION_ARGS(dispLog, "i", i, "format", format);
 
         mfxStatus sts = MFX_ERR_NONE;
 
+        // if libraries are already loaded and filters applied, only the reader lock is needed
+        // results of background discovery are returned to the application from here on
+        {
+            std::shared_lock<std::shared_timed_mutex> readLock(loaderCtx->m_loaderLock);
+            if (!loaderCtx->NeedsUpdate(false)) {
+                loaderCtx->m_bDiscoveryResultsUnused = false;
+                return loaderCtx->QueryImpl(i, format, idesc);
+            }
+        }
+
+        // otherwise update loader state under the writer lock
+        // another thread may have done this already, so flags are checked again
+        // filter changes are applied first, they may need the results of background discovery
+        std::unique_lock<std::shared_timed_mutex> writeLock(loaderCtx->m_loaderLock);
+        sts = loaderCtx->ApplyConfigChanges();
+        loaderCtx->m_bDiscoveryResultsUnused = false;
+        if (sts)
+            return MFX_ERR_NOT_FOUND;
+
         // load and query all libraries
         if (loaderCtx->m_bNeedFullQuery) {
             // if a session was already created in low-latency mode, unload all implementations
@@ -152,6 +235,74 @@ mfxStatus MFXEnumImplementations(mfxLoader loader,
     }
 }
 
+// run op with libraries loaded and the list of valid implementations up to date
+template <typename Op>
+static mfxStatus RunWithValidImpls(LoaderCtxVPL *loaderCtx, Op op) {
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+
+    mfxStatus sts = MFX_ERR_NONE;
+
+    // if libraries are already loaded and filters applied, only the reader lock is needed
+    //   and several threads may create sessions at the same time
+    // results of background discovery are returned to the application from here on
+    {
+        std::shared_lock<std::shared_timed_mutex> readLock(loaderCtx->m_loaderLock);
+        if (!loaderCtx->NeedsUpdate(true)) {
+            loaderCtx->m_bDiscoveryResultsUnused = false;
+            DISP_LOG_MESSAGE(dispLog,
+                             "message:  low latency mode %s",
+                             (loaderCtx->m_bLowLatency ? "enabled" : "disabled"));
+
+            return op();
+        }
+    }
+
+    // otherwise update loader state under the writer lock
+    // another thread may have done this already, so flags are checked again
+    // filter changes are applied first, they may need the results of background discovery
+    std::unique_lock<std::shared_timed_mutex> writeLock(loaderCtx->m_loaderLock);
+    sts = loaderCtx->ApplyConfigChanges();
+    loaderCtx->m_bDiscoveryResultsUnused = false;
+    if (sts)
+        return MFX_ERR_NOT_FOUND;
+
+    if (loaderCtx->m_bLowLatency) {
+        DISP_LOG_MESSAGE(dispLog, "message:  low latency mode enabled");
+
+        if (loaderCtx->m_bNeedLowLatencyQuery) {
+            // load low latency libraries
+            sts = loaderCtx->LoadLibsLowLatency();
+            if (sts != MFX_ERR_NONE)
+                return MFX_ERR_NOT_FOUND;
+
+            // run limited query operations for low latency init
+            sts = loaderCtx->QueryLibraryCaps();
+            if (sts != MFX_ERR_NONE)
+                return MFX_ERR_NOT_FOUND;
+        }
+    }
+    else {
+        DISP_LOG_MESSAGE(dispLog, "message:  low latency mode disabled");
+
+        // load and query all libraries
+        if (loaderCtx->m_bNeedFullQuery) {
+            sts = loaderCtx->FullLoadAndQuery();
+            if (sts)
+                return MFX_ERR_NOT_FOUND;
+        }
+
+        // update list of valid libraries based on updated set of
+        //   mfxConfig properties
+        if (loaderCtx->m_bNeedUpdateValidImpls) {
+            sts = loaderCtx->UpdateValidImplList();
+            if (sts)
+                return MFX_ERR_NOT_FOUND;
+        }
+    }
+
+    return op();
+}
+
 // create a new session with implementation i
 mfxStatus MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession *session) {
     try {
@@ -161,45 +312,33 @@ mfxStatus MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession *session) {
         LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
 
         DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
-        DISP_LOG_FUNCTION(dispLog);
+        DISP_LOG_FUNCTION_ARG(dispLog, "i", i);
 
-        mfxStatus sts = MFX_ERR_NONE;
+        return RunWithValidImpls(loaderCtx, [&]() {
+            return loaderCtx->CreateSession(i, session);
+        });
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
 
-        if (loaderCtx->m_bLowLatency) {
-            DISP_LOG_MESSAGE(dispLog, "message:  low latency mode enabled");
+// release memory associated with implementation description hdl
+mfxStatus MFXDispReleaseImplDescription(mfxLoader loader, mfxHDL hdl) {
+    try {
+        if (!loader)
+            return MFX_ERR_NULL_PTR;
 
-            if (loaderCtx->m_bNeedLowLatencyQuery) {
-                // load low latency libraries
-                sts = loaderCtx->LoadLibsLowLatency();
-                if (sts != MFX_ERR_NONE)
-                    return MFX_ERR_NOT_FOUND;
+        LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
 
-                // run limited query operations for low latency init
-                sts = loaderCtx->QueryLibraryCaps();
-                if (sts != MFX_ERR_NONE)
-                    return MFX_ERR_NOT_FOUND;
-            }
-        }
-        else {
-            DISP_LOG_MESSAGE(dispLog, "message:  low latency mode disabled");
-
-            // load and query all libraries
-            if (loaderCtx->m_bNeedFullQuery) {
-                sts = loaderCtx->FullLoadAndQuery();
-                if (sts)
-                    return MFX_ERR_NOT_FOUND;
-            }
+        DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+        DISP_LOG_FUNCTION(dispLog);
 
-            // update list of valid libraries based on updated set of
-            //   mfxConfig properties
-            if (loaderCtx->m_bNeedUpdateValidImpls) {
-                sts = loaderCtx->UpdateValidImplList();
-                if (sts)
-                    return MFX_ERR_NOT_FOUND;
-            }
-        }
+        // descriptions are kept until MFXUnload (m_bKeepCapsUntilUnload),
+        //   so loader state is not modified here
+        std::shared_lock<std::shared_timed_mutex> readLock(loaderCtx->m_loaderLock);
 
-        sts = loaderCtx->CreateSession(i, session);
+        mfxStatus sts = loaderCtx->ReleaseImpl(hdl);
 
         return sts;
     }
@@ -208,8 +347,134 @@ mfxStatus MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession *session) {
     }
 }
 
-// release memory associated with implementation description hdl
-mfxStatus MFXDispReleaseImplDescription(mfxLoader loader, mfxHDL hdl) {
+#ifdef ONEVPL_EXPERIMENTAL
+// create pool of initialized sessions for implementation i
+// each loader may have more than one session pool
+mfxStatus MFXCreateSessionPool(mfxLoader loader,
+                               mfxU32 i,
+                               mfxU32 minSessions,
+                               mfxU32 maxSessions,
+                               mfxSessionPool *pool) {
+    try {
+        if (!loader || !pool)
+            return MFX_ERR_NULL_PTR;
+
+        if (maxSessions == 0 || maxSessions < minSessions)
+            return MFX_ERR_INVALID_VIDEO_PARAM;
+
+        LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+        DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+        DISP_LOG_FUNCTION(dispLog);
+
+        SessionPoolVPL *poolCtx = nullptr;
+
+        mfxStatus sts = loaderCtx->AddSessionPool(i, minSessions, maxSessions, &poolCtx);
+        if (sts != MFX_ERR_NONE)
+            return sts;
+
+        *pool = (mfxSessionPool)(poolCtx);
+
+        return MFX_ERR_NONE;
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
+
+// take an initialized session from the pool
+mfxStatus MFXSessionPoolAcquire(mfxSessionPool pool, mfxSession *session) {
+    try {
+        if (!pool || !session)
+            return MFX_ERR_NULL_PTR;
+
+        SessionPoolVPL *poolCtx = (SessionPoolVPL *)pool;
+
+        return poolCtx->Acquire(session);
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
+
+// reset session and return it to the pool
+mfxStatus MFXSessionPoolRelease(mfxSessionPool pool, mfxSession session) {
+    try {
+        if (!pool || !session)
+            return MFX_ERR_NULL_PTR;
+
+        SessionPoolVPL *poolCtx = (SessionPoolVPL *)pool;
+
+        return poolCtx->Release(session);
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
+
+// close idle sessions and destroy the pool
+mfxStatus MFXDestroySessionPool(mfxSessionPool pool) {
+    try {
+        if (!pool)
+            return MFX_ERR_NULL_PTR;
+
+        SessionPoolVPL *poolCtx = (SessionPoolVPL *)pool;
+        LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)(poolCtx->m_parentLoader);
+
+        DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+        DISP_LOG_FUNCTION(dispLog);
+
+        return loaderCtx->FreeSessionPool(poolCtx);
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
+
+// return time spent in each startup phase, for the loader and for each library
+mfxStatus MFXQueryLoaderTiming(mfxLoader loader, mfxLoaderTiming **timing) {
+    try {
+        if (!loader || !timing)
+            return MFX_ERR_NULL_PTR;
+
+        LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+        DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+        DISP_LOG_FUNCTION(dispLog);
+
+        // list of libraries must not change while the snapshot is taken
+        std::shared_lock<std::shared_timed_mutex> readLock(loaderCtx->m_loaderLock);
+
+        return loaderCtx->QueryTiming(timing);
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
+
+// release timing returned by MFXQueryLoaderTiming
+mfxStatus MFXReleaseLoaderTiming(mfxLoader loader, mfxLoaderTiming *timing) {
+    try {
+        if (!loader || !timing)
+            return MFX_ERR_NULL_PTR;
+
+        LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+        DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+        DISP_LOG_FUNCTION(dispLog);
+
+        return loaderCtx->ReleaseTiming(timing);
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
+
+// set policy used by MFXCreateSessionPlaced
+mfxStatus MFXSetPlacementPolicy(mfxLoader loader,
+                                mfxPlacementPolicy policy,
+                                const mfxU32 *weights,
+                                mfxU32 numWeights) {
     try {
         if (!loader)
             return MFX_ERR_NULL_PTR;
@@ -219,11 +484,50 @@ mfxStatus MFXDispReleaseImplDescription(mfxLoader loader, mfxHDL hdl) {
         DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
         DISP_LOG_FUNCTION(dispLog);
 
-        mfxStatus sts = loaderCtx->ReleaseImpl(hdl);
+        return loaderCtx->SetPlacementPolicy(policy, weights, numWeights);
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
 
-        return sts;
+// create a new session with the implementation selected by the placement policy
+mfxStatus MFXCreateSessionPlaced(mfxLoader loader, mfxSession *session, mfxU32 *implIdx) {
+    try {
+        if (!loader || !session)
+            return MFX_ERR_NULL_PTR;
+
+        LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+        DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+        DISP_LOG_FUNCTION(dispLog);
+
+        return RunWithValidImpls(loaderCtx, [&]() {
+            return loaderCtx->CreateSessionPlaced(session, implIdx);
+        });
     }
     catch (...) {
         return MFX_ERR_UNKNOWN;
     }
 }
+
+// return number of open sessions created with implementation i
+mfxStatus MFXQueryImplSessionCount(mfxLoader loader, mfxU32 i, mfxU32 *numActive) {
+    try {
+        if (!loader || !numActive)
+            return MFX_ERR_NULL_PTR;
+
+        LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+        DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+        DISP_LOG_FUNCTION_ARG(dispLog, "i", i);
+
+        return RunWithValidImpls(loaderCtx, [&]() {
+            return loaderCtx->QueryImplSessionCount(i, numActive);
+        });
+    }
+    catch (...) {
+        return MFX_ERR_UNKNOWN;
+    }
+}
+#endif
@@ -8,17 +8,29 @@
 #define LIBVPL_SRC_MFX_DISPATCHER_VPL_H_
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <deque>
+#include <functional>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vpl/mfxdispatcher.h"
 #include "vpl/mfxvideo.h"
 
+#include "./mfx_dispatcher_vpl_cache.h"
 #include "./mfx_dispatcher_vpl_log.h"
+#include "./mfx_dispatcher_vpl_placement.h"
+#include "./mfx_dispatcher_vpl_pool.h"
+#include "./mfx_dispatcher_vpl_registry.h"
 
 #if defined(_WIN32) || defined(_WIN64)
     #include <windows.h>
@@ -84,6 +96,20 @@ mfxStatus MFXInitEx2(mfxVersion version,
                      mfxU16 *deviceID,
                      CHAR_TYPE *dllName);
 
+#if !defined(_WIN32) && !defined(_WIN64)
+// internal functions to create sessions from a library which the dispatcher already loaded
+//   without opening it again or resolving its exports for every session
+mfxStatus MFXCreateRuntimeFuncTable(void *hModule,
+                                    const char *libNameFull,
+                                    std::shared_ptr<const MFX::RuntimeFuncTable> &funcTable);
+
+mfxStatus MFXInitWithFuncTable(mfxVersion version,
+                               mfxInitializationParam vplParam,
+                               mfxIMPL hwImpl,
+                               mfxSession *session,
+                               const std::shared_ptr<const MFX::RuntimeFuncTable> &funcTable);
+#endif
+
 typedef void(MFX_CDECL *VPLFunctionPtr)(void);
 
 extern const mfxIMPL msdkImplTab[MAX_NUM_IMPL_MSDK];
@@ -122,6 +148,9 @@ enum VPLOptionalFunctionIdx {
     // 2.15
     IdxMFXQueryImplsProperties = 0,
 
+    // 2.17
+    IdxMFXQueryImplsAPIVersion,
+
     NumVPLOptionalFunctions
 };
 
@@ -200,48 +229,102 @@ typedef struct mfxVPPDescription::filter VPPFilter;
 typedef struct mfxVPPDescription::filter::memdesc VPPMemDesc;
 typedef struct mfxVPPDescription::filter::memdesc::format VPPFormat;
 
-// flattened version of single enc/dec/vpp configs
-// each struct contains all _settable_ props
+// flattened version of single enc/dec/vpp configs, stored as one column per prop
+// each row is a single combination of all _settable_ props
 //   i.e. not implied values like NumCodecs
-struct DecConfig {
-    mfxU32 CodecID;
-    mfxU16 MaxcodecLevel;
-    mfxU32 Profile;
-    mfxResourceType MemHandleType;
-    mfxRange32U Width;
-    mfxRange32U Height;
-    mfxU32 ColorFormat;
+struct DecCapsTable {
+    std::vector<mfxU32> CodecID;
+    std::vector<mfxU16> MaxcodecLevel;
+    std::vector<mfxU32> Profile;
+    std::vector<mfxU32> MemHandleType;
+    std::vector<mfxRange32U> Width;
+    std::vector<mfxRange32U> Height;
+    std::vector<mfxU32> ColorFormat;
 };
 
-struct EncConfig {
-    mfxU32 CodecID;
-    mfxU16 MaxcodecLevel;
-    mfxU16 BiDirectionalPrediction;
-    mfxU32 Profile;
-    mfxResourceType MemHandleType;
-    mfxRange32U Width;
-    mfxRange32U Height;
-    mfxU32 ColorFormat;
+struct EncCapsTable {
+    std::vector<mfxU32> CodecID;
+    std::vector<mfxU16> MaxcodecLevel;
+    std::vector<mfxU16> BiDirectionalPrediction;
+    std::vector<mfxU32> Profile;
+    std::vector<mfxU32> MemHandleType;
+    std::vector<mfxRange32U> Width;
+    std::vector<mfxRange32U> Height;
+    std::vector<mfxU32> ColorFormat;
 };
 
-struct VPPConfig {
-    mfxU32 FilterFourCC;
-    mfxU16 MaxDelayInFrames;
-    mfxResourceType MemHandleType;
-    mfxRange32U Width;
-    mfxRange32U Height;
-    mfxU32 InFormat;
-    mfxU32 OutFormat;
+struct VPPCapsTable {
+    std::vector<mfxU32> FilterFourCC;
+    std::vector<mfxU16> MaxDelayInFrames;
+    std::vector<mfxU32> MemHandleType;
+    std::vector<mfxRange32U> Width;
+    std::vector<mfxRange32U> Height;
+    std::vector<mfxU32> InFormat;
+    std::vector<mfxU32> OutFormat;
 };
 
-struct SurfaceConfig {
-    mfxU32 SurfaceType;
-    mfxU32 SurfaceComponent;
-    mfxU32 SurfaceFlags;
+struct SurfaceCapsTable {
+    std::vector<mfxU32> SurfaceType;
+    std::vector<mfxU32> SurfaceComponent;
+    std::vector<mfxU32> SurfaceFlags;
+};
+
+// flattened caps of a single implementation
+// built once from the implementation description, then used for every call to ValidateConfig()
+struct ImplCapsIndex {
+    bool bBuilt;
+
+    // descriptions this index was built from
+    const void *srcImplDesc;
+    const void *srcImplSurfTypes;
+
+    DecCapsTable dec;
+    EncCapsTable enc;
+    VPPCapsTable vpp;
+    SurfaceCapsTable surface;
+
+    ImplCapsIndex()
+            : bBuilt(false),
+              srcImplDesc(nullptr),
+              srcImplSurfTypes(nullptr),
+              dec(),
+              enc(),
+              vpp(),
+              surface() {}
+
+    bool IsBuiltFrom(const void *implDesc, const void *implSurfTypes) const {
+        return (bBuilt && srcImplDesc == implDesc && srcImplSurfTypes == implSurfTypes);
+    }
+};
+
+// groups of filter props which are checked together against an implementation
+// when a property is set, only the group it belongs to needs to be checked again
+enum PropGroup {
+    ePropGroup_General = 0, // top-level mfxImplDescription and mfxDeviceDescription
+    ePropGroup_Dec,
+    ePropGroup_Enc,
+    ePropGroup_VPP,
+    ePropGroup_ExtDev,
+    ePropGroup_Surface,
+    ePropGroup_Func,
+
+    // number of groups (always last)
+    ePropGroup_Total
+};
+
+// result of checking the filter props in one mfxConfig against one implementation
+struct ConfigCheckResult {
+    // revision of each group of props when it was last checked (0 = never checked)
+    mfxU32 groupRevision[ePropGroup_Total];
+
+    // bitmask (1 << PropGroup) of groups not supported by the implementation
+    mfxU32 failedGroups;
+
+    ConfigCheckResult() : groupRevision(), failedGroups(0) {}
 };
 
 // special props which are passed in via MFXSetConfigProperty()
-// these are updated with every call to ValidateConfig() and may
+// these are updated with every call to UpdateSpecialConfig() and may
 //   be used in MFXCreateSession()
 struct SpecialConfig {
     bool bIsSet_deviceHandleType;
@@ -282,26 +365,51 @@ public:
 
     // set a single filter property (KV pair)
     mfxStatus SetFilterProperty(const mfxU8 *name, mfxVariant value);
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxStatus SetFilterPropertyById(mfxU32 propId, mfxVariant value);
+#endif
 
-    static bool CheckLowLatencyConfig(std::list<ConfigCtxVPL *> configCtxList,
+    static bool CheckLowLatencyConfig(const std::vector<ConfigCtxVPL *> &configCtxList,
                                       SpecialConfig *specialConfig);
 
 #ifdef ONEVPL_EXPERIMENTAL
-    static bool UpdatePropsQueryConfig(std::list<ConfigCtxVPL *> configCtxList,
+    static bool UpdatePropsQueryConfig(const std::vector<ConfigCtxVPL *> &configCtxList,
                                        std::vector<mfxQueryProperty> &queryProps);
 #endif
 
+    // generate "flat" descriptions of each combination of props
+    //   (e.g. multiple profiles from the same codec)
+    static void BuildCapsIndex(const mfxImplDescription *libImplDesc,
+#ifdef ONEVPL_EXPERIMENTAL
+                               const mfxSurfaceTypesSupported *libImplSurfTypes,
+#endif
+                               ImplCapsIndex &capsIndex);
+
     // compare library caps vs. set of configuration filters
-    static mfxStatus ValidateConfig(const mfxImplDescription *libImplDesc,
-                                    const mfxImplementedFunctions *libImplFuncs,
-                                    const mfxExtendedDeviceId *libImplExtDevID,
+    // configResults holds the result for each config from the previous call, and only
+    //   props which were set since then are checked again
+    static mfxStatus ValidateConfig(
+        const mfxImplDescription *libImplDesc,
+        const mfxImplementedFunctions *libImplFuncs,
+        const mfxExtendedDeviceId *libImplExtDevID,
 #ifdef ONEVPL_EXPERIMENTAL
-                                    const mfxSurfaceTypesSupported *libImplSurfTypes,
+        const mfxSurfaceTypesSupported *libImplSurfTypes,
 #endif
-                                    std::list<ConfigCtxVPL *> configCtxList,
-                                    LibType libType,
+        const ImplCapsIndex &capsIndex,
+        const std::vector<ConfigCtxVPL *> &configCtxList,
+        std::map<const ConfigCtxVPL *, ConfigCheckResult> &configResults,
+        LibType libType,
+        const SpecialConfig *specialConfig);
+
+    // update special (including non-filtering) props from the full set of configuration filters
+    static void UpdateSpecialConfig(const std::vector<ConfigCtxVPL *> &configCtxList,
                                     SpecialConfig *specialConfig);
 
+    // canonical encoding of all props which affect ValidateConfig(), independent of the order
+    //   of the configs - equal keys select the same implementations from the same caps
+    static std::string GetSelectionKey(const std::vector<ConfigCtxVPL *> &configCtxList,
+                                       const SpecialConfig *specialConfig);
+
     // parse deviceID for x86 devices
     static bool ParseDeviceIDx86(mfxChar *cDeviceID, mfxU32 &deviceID, mfxU32 &adapterIdx);
 
@@ -311,44 +419,50 @@ public:
     class LoaderCtxVPL *m_parentLoader;
 
 private:
-    static __inline std::string GetNextProp(std::list<std::string> &s) {
-        if (s.empty())
-            return "";
-        std::string t = s.front();
-        s.pop_front();
-        return t;
-    }
-
     mfxStatus ValidateAndSetProp(mfxI32 idx, mfxVariant value);
-    mfxStatus SetFilterPropertyDec(std::list<std::string> &propParsedString, mfxVariant value);
-    mfxStatus SetFilterPropertyEnc(std::list<std::string> &propParsedString, mfxVariant value);
-    mfxStatus SetFilterPropertyVPP(std::list<std::string> &propParsedString, mfxVariant value);
-    mfxStatus SetFilterPropertySurface(std::list<std::string> &propParsedString, mfxVariant value);
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxStatus SetMultiValueProp(mfxI32 idx, mfxVariantType baseType, mfxU32 multiType, mfxHDL ptr);
+#endif
 
-    static mfxStatus GetFlatDescriptionsDec(const mfxImplDescription *libImplDesc,
-                                            std::list<DecConfig> &decConfigList);
+    // encoding of the filtering props in this config, used by GetSelectionKey()
+    std::string GetFilterKey() const;
 
-    static mfxStatus GetFlatDescriptionsEnc(const mfxImplDescription *libImplDesc,
-                                            std::list<EncConfig> &encConfigList);
+    // bitmask of groups which were set since result was last updated
+    mfxU32 GetChangedGroups(const ConfigCheckResult &result) const;
 
-    static mfxStatus GetFlatDescriptionsVPP(const mfxImplDescription *libImplDesc,
-                                            std::list<VPPConfig> &vppConfigList);
+    // check props in this config against one implementation, updating result
+    //   for the groups which were set since the last check
+    mfxStatus CheckImplProps(const mfxImplDescription *libImplDesc,
+                             const mfxImplementedFunctions *libImplFuncs,
+                             const mfxExtendedDeviceId *libImplExtDevID,
 #ifdef ONEVPL_EXPERIMENTAL
-    static mfxStatus GetFlatDescriptionsSurface(const mfxSurfaceTypesSupported *libSurfaceTypes,
-                                                std::list<SurfaceConfig> &surfaceConfigList);
+                             const mfxSurfaceTypesSupported *libImplSurfTypes,
+#endif
+                             const ImplCapsIndex &capsIndex,
+                             LibType libType,
+                             ConfigCheckResult &result) const;
+
+    static void GetFlatDescriptionsDec(const mfxImplDescription *libImplDesc,
+                                       DecCapsTable &decTable);
+
+    static void GetFlatDescriptionsEnc(const mfxImplDescription *libImplDesc,
+                                       EncCapsTable &encTable);
+
+    static void GetFlatDescriptionsVPP(const mfxImplDescription *libImplDesc,
+                                       VPPCapsTable &vppTable);
+#ifdef ONEVPL_EXPERIMENTAL
+    static void GetFlatDescriptionsSurface(const mfxSurfaceTypesSupported *libSurfaceTypes,
+                                           SurfaceCapsTable &surfaceTable);
 #endif
 
     static mfxStatus CheckPropsGeneral(const mfxVariant cfgPropsAll[],
                                        const mfxImplDescription *libImplDesc);
 
-    static mfxStatus CheckPropsDec(const mfxVariant cfgPropsAll[],
-                                   std::list<DecConfig> decConfigList);
+    static mfxStatus CheckPropsDec(const mfxVariant cfgPropsAll[], const DecCapsTable &decTable);
 
-    static mfxStatus CheckPropsEnc(const mfxVariant cfgPropsAll[],
-                                   std::list<EncConfig> encConfigList);
+    static mfxStatus CheckPropsEnc(const mfxVariant cfgPropsAll[], const EncCapsTable &encTable);
 
-    static mfxStatus CheckPropsVPP(const mfxVariant cfgPropsAll[],
-                                   std::list<VPPConfig> vppConfigList);
+    static mfxStatus CheckPropsVPP(const mfxVariant cfgPropsAll[], const VPPCapsTable &vppTable);
 
     static mfxStatus CheckPropString(const mfxChar *implString, const std::string filtString);
 
@@ -357,11 +471,14 @@ private:
 
 #ifdef ONEVPL_EXPERIMENTAL
     static mfxStatus CheckPropsSurface(const mfxVariant cfgPropsAll[],
-                                       std::list<SurfaceConfig> surfaceConfigList);
+                                       const SurfaceCapsTable &surfaceTable);
 #endif
 
     mfxVariantWrapper m_propVar[NUM_TOTAL_FILTER_PROPS];
 
+    // incremented every time a property in the group is set
+    mfxU32 m_propGroupRevision[ePropGroup_Total];
+
     // special containers for properties which are passed by pointer
     //   (save a copy of the whole object based on property name)
     mfxRange32U m_propRange32U[NUM_PROP_RANGES];
@@ -374,6 +491,13 @@ private:
     mfxU8 m_extDevLUID8U[8];
     std::string m_extDevNameStr;
 
+#ifdef ONEVPL_EXPERIMENTAL
+    // accepted values for props passed with MFX_VARIANT_TYPE_SET (sorted)
+    //   or MFX_VARIANT_TYPE_RANGE, by property index
+    std::map<mfxI32, std::vector<mfxU32>> m_propValueSet;
+    std::map<mfxI32, mfxRange32U> m_propValueRange;
+#endif
+
     std::vector<mfxU8> m_extBuf;
 
     __inline bool SetExtBuf(mfxExtBuffer *extBuf) {
@@ -467,6 +591,39 @@ private:
     }
 };
 
+// phases of loader startup, same values as mfxLoaderPhase (see MFXQueryLoaderTiming)
+enum LoaderPhase {
+    LoaderPhaseSearch = 0,
+    LoaderPhaseLoad,
+    LoaderPhaseQuery,
+    LoaderPhaseFilter,
+    LoaderPhaseInit,
+
+    NumLoaderPhases
+};
+
+// total time in nanoseconds and number of runs of each phase
+struct LoaderPhaseTiming {
+    mfxU64 time[NumLoaderPhases];
+    mfxU32 count[NumLoaderPhases];
+};
+
+// startup timing of one candidate library
+// kept after the library is rejected or unloaded, so that the cost of failed candidates is visible
+struct LibTimingVPL {
+    STRING_TYPE libNameFull; // only set in the copy kept after unloading
+    mfxU64 startTime; // relative to MFXLoad, valid if any phase has run
+    LoaderPhaseTiming phases;
+    bool bCapsCached;
+};
+
+// monotonic timestamp in nanoseconds
+inline mfxU64 GetLoaderTime() {
+    return (mfxU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
 struct LibInfo {
     // during search store candidate file names
     //   and priority based on rules in spec
@@ -482,14 +639,29 @@ struct LibInfo {
     // optional functions which RT may or may not export
     VPLFunctionPtr vplOptionalFuncTable[NumVPLOptionalFunctions]; // NOLINT
 
-    // loader context for legacy MSDK
-    LoaderCtxMSDK msdkCtx[MAX_NUM_IMPL_MSDK];
+    // loader context for legacy MSDK, one per adapter
+    // only allocated for LibTypeMSDK, since most libraries are 2.x runtimes
+    std::unique_ptr<LoaderCtxMSDK[]> msdkCtx;
 
     // API version of legacy MSDK
     mfxVersion msdkVersion;
 
     // user-friendly version of path for MFX_IMPLCAPS_IMPLPATH query
-    mfxChar implCapsPath[MAX_VPL_SEARCH_PATH];
+    std::string implCapsPath;
+
+    // if set, caps were read from the persistent cache or runtime registry
+    //   and library is not loaded
+    const CapsCacheEntry *capsCacheEntry;
+
+    // startup timing, updated under LoaderCtxVPL::m_timingLock
+    LibTimingVPL timing;
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    // functions resolved on first call to CreateSession (or taken from the runtime registry),
+    //   shared by all sessions
+    std::shared_ptr<const MFX::RuntimeFuncTable> runtimeFuncTable;
+    std::once_flag runtimeFuncTableOnce;
+#endif
 
     // avoid warnings
     LibInfo()
@@ -501,7 +673,9 @@ struct LibInfo {
               vplOptionalFuncTable(),
               msdkCtx(),
               msdkVersion(),
-              implCapsPath() {}
+              implCapsPath(),
+              capsCacheEntry(nullptr),
+              timing() {}
 
     virtual ~LibInfo() {}
 
@@ -511,6 +685,23 @@ private:
     LibInfo &operator=(const LibInfo &);
 };
 
+// handles returned by MFXQueryImplsDescription() for a single library
+struct LibCapsQuery {
+    mfxHDL *hImpl;
+    mfxU32 numImpls;
+
+    mfxHDL *hImplExtDeviceID;
+    mfxU32 numImplsExtDeviceID;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxHDL *hImplSurfTypes;
+    mfxU32 numImplsSurfTypes;
+#endif
+
+    mfxHDL *hImplFuncs;
+    mfxU32 numImplsFuncs;
+};
+
 struct ImplInfo {
     // library containing this implementation
     LibInfo *libInfo;
@@ -543,6 +734,20 @@ struct ImplInfo {
     // index of valid libraries - updates with every call to MFXSetConfigFilterProperty()
     mfxI32 validImplIdx;
 
+    // flattened caps, built by UpdateValidImplList() when caps are first available
+    ImplCapsIndex capsIndex;
+
+    // result of checking each config object against this implementation
+    std::map<const ConfigCtxVPL *, ConfigCheckResult> configResults;
+
+    // not valid regardless of filter props (e.g. MSDK library for the same device
+    //   as an Intel® VPL runtime)
+    bool bExcluded;
+
+    // open sessions created with this implementation
+    // allocated by the first session, under LoaderCtxVPL::m_placementLock
+    std::shared_ptr<ImplSessionCount> sessionCount;
+
     // avoid warnings
     ImplInfo()
             : libInfo(nullptr),
@@ -557,10 +762,26 @@ struct ImplInfo {
               msdkImplIdx(0),
               adapterIdx(ADAPTER_IDX_UNKNOWN),
               libImplIdx(0),
-              validImplIdx(-1) {
+              validImplIdx(-1),
+              capsIndex(),
+              configResults(),
+              bExcluded(false),
+              sessionCount() {
     }
 };
 
+// caps handles of one implementation when selections were stored by the loader
+// selections are only reused with the same list of implementations and the same descriptions
+struct SelectionImplHandles {
+    ImplInfo *implInfo;
+    mfxHDL implDesc;
+    mfxHDL implFuncs;
+    mfxHDL implExtDeviceID;
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxHDL implSurfTypes;
+#endif
+};
+
 // loader class implementation
 class LoaderCtxVPL {
 public:
@@ -585,24 +806,84 @@ public:
     // create mfxSession
     mfxStatus CreateSession(mfxU32 idx, mfxSession *session);
 
+    // return true if libraries must be loaded or the list of valid implementations updated
+    //   before calling QueryImpl() or CreateSession()
+    bool NeedsUpdate(bool bCreateSession) const;
+
     // manage configuration filters
     ConfigCtxVPL *AddConfigFilter();
     mfxStatus FreeConfigFilters();
 
+    // manage session pools
+    // pools call MFXCreateSession(), so must not be created or destroyed under m_loaderLock
+    mfxStatus AddSessionPool(mfxU32 implIdx,
+                             mfxU32 minSessions,
+                             mfxU32 maxSessions,
+                             SessionPoolVPL **pool);
+    mfxStatus FreeSessionPool(SessionPoolVPL *pool);
+    mfxStatus FreeSessionPools();
+
     // manage logging
     mfxStatus InitDispatcherLog();
     DispatcherLogVPL *GetLogger();
 
+    // manage persistent caps cache
+    mfxStatus InitCapsCache();
+    void SaveCapsCache();
+
+    // parallel querying of library caps
+    mfxStatus InitParallelProbe();
+
+    // manage process-wide runtime registry
+    mfxStatus InitRuntimeRegistry();
+
+    // background discovery of implementations, started from MFXLoad()
+    mfxStatus InitBackgroundDiscovery();
+    void WaitBackgroundDiscovery();
+
     // low latency initialization
     mfxStatus LoadLibsLowLatency();
     mfxStatus UpdateLowLatency();
 
+    // per-phase startup timing
+    // if libInfo is null the time is added to the loader totals, otherwise to that library
+    void AddPhaseTime(LoaderPhase phase, mfxU64 startTime, LibInfo *libInfo = nullptr);
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxStatus QueryTiming(mfxLoaderTiming **timing);
+    mfxStatus ReleaseTiming(mfxLoaderTiming *timing);
+
+    // load-aware session placement
+    mfxStatus SetPlacementPolicy(mfxPlacementPolicy policy,
+                                 const mfxU32 *weights,
+                                 mfxU32 numWeights);
+    mfxStatus CreateSessionPlaced(mfxSession *session, mfxU32 *implIdx);
+    mfxStatus QueryImplSessionCount(mfxU32 idx, mfxU32 *numActive);
+#endif
+
+    // QueryImpl(), ReleaseImpl() and CreateSession() may run concurrently under the reader lock
+    // anything which modifies loader state (loading and querying libraries, updating the list
+    //   of valid implementations) requires the writer lock
+    std::shared_timed_mutex m_loaderLock;
+
+    // protects m_configCtxList and the filter props of each config, taken after m_loaderLock
+    // MFXCreateConfig() and MFXSetConfigFilterProperty() only take this lock, so they do not
+    //   wait for background discovery, and set m_bConfigChanged
+    // the changes are applied by ApplyConfigChanges() under the writer lock
+    std::mutex m_configLock;
+    std::atomic<bool> m_bConfigChanged;
+    mfxStatus ApplyConfigChanges();
+
     bool m_bLowLatency;
     bool m_bNeedUpdateValidImpls;
     bool m_bNeedFullQuery;
     bool m_bNeedLowLatencyQuery;
     bool m_bPriorityPathEnabled;
 
+    // set when the background discovery thread has queried all libraries, cleared once the
+    //   application enumerates or creates a session (under either lock)
+    // until then a property-based query filter makes the libraries be queried again
+    std::atomic<bool> m_bDiscoveryResultsUnused;
+
 #ifdef ONEVPL_EXPERIMENTAL
     bool m_bEnablePropsQuery;
     mfxStatus UpdatePropsQuery();
@@ -611,6 +892,7 @@ public:
 private:
     // helper functions
     mfxStatus LoadSingleLibrary(LibInfo *libInfo);
+    mfxStatus ProbeSingleLibrary(LibInfo *libInfo);
     mfxStatus UnloadSingleLibrary(LibInfo *libInfo);
     mfxStatus UnloadSingleImplementation(ImplInfo *implInfo);
     VPLFunctionPtr GetFunctionAddr(void *hModuleVPL, const char *pName);
@@ -629,7 +911,7 @@ private:
     mfxU32 ParseLegacySearchPaths(std::list<STRING_TYPE> &searchDirs);
 
     mfxStatus SearchDirForLibs(STRING_TYPE searchDir,
-                               std::list<LibInfo *> &libInfoList,
+                               std::vector<LibInfo *> &libInfoList,
                                mfxU32 priority,
                                bool bLoadVPLOnly = false);
 
@@ -638,6 +920,25 @@ private:
     bool IsValidX86GPU(ImplInfo *implInfo, mfxU32 &deviceID, mfxU32 &adapterIdx);
     mfxStatus UpdateImplPath(LibInfo *libInfo);
 
+    bool IsCapsCacheAllowed(LibInfo *libInfo);
+    const CapsCacheEntry *FindCachedCaps(LibInfo *libInfo);
+    mfxStatus StoreCachedCaps(LibInfo *libInfo,
+                              bool bValidLib,
+                              const std::vector<CapsCacheImpl> &cacheImpls);
+    mfxStatus StoreCachedCapsMSDK(LibInfo *libInfo, const std::vector<CapsCacheImpl> &cacheImpls);
+    mfxStatus AddCachedImpls(LibInfo *libInfo);
+
+    bool ApplyCachedSelection(const std::string &key);
+    void SaveSelection(std::string key);
+    bool IsSelectionImplListCurrent() const;
+    bool IsSelectionCacheAllowed();
+
+    mfxStatus QuerySingleLibraryCaps(LibInfo *libInfo, LibCapsQuery &capsQuery);
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxStatus RequeryLibraryCaps();
+#endif
+    void RunParallelProbe(mfxU32 numTasks, const std::function<void(mfxU32)> &task);
+
     mfxStatus LoadLibsFromDriverStore(mfxU32 numAdapters,
                                       const std::vector<DXGI1DeviceInfo> &adapterInfo,
                                       LibType libType);
@@ -645,11 +946,21 @@ private:
     mfxStatus LoadLibsFromMultipleDirs(LibType libType);
 
     LibInfo *AddSingleLibrary(STRING_TYPE libPath, LibType libType);
-    mfxStatus QuerySessionLowLatency(LibInfo *libInfo, mfxU32 adapterID, mfxVersion *ver);
+    mfxStatus QueryVersionLowLatency(LibInfo *libInfo, mfxU32 adapterID, mfxVersion *ver);
+
+    // lists of libraries and implementations in priority order, pointing into the stores below
+    // removing an entry from a list does not free it, the stores are cleared by
+    //   UnloadAllLibraries() and never move existing entries when they grow
+    std::vector<LibInfo *> m_libInfoList;
+    std::vector<ImplInfo *> m_implInfoList;
+    std::deque<LibInfo> m_libInfoStore;
+    std::deque<ImplInfo> m_implInfoStore;
+
+    LibInfo *NewLibInfo();
+    ImplInfo *NewImplInfo();
 
-    std::list<LibInfo *> m_libInfoList;
-    std::list<ImplInfo *> m_implInfoList;
-    std::list<ConfigCtxVPL *> m_configCtxList;
+    std::vector<ConfigCtxVPL *> m_configCtxList;
+    std::list<SessionPoolVPL *> m_sessionPoolList;
     std::vector<DXGI1DeviceInfo> m_gpuAdapterInfo;
 
 #ifdef ONEVPL_EXPERIMENTAL
@@ -660,10 +971,83 @@ private:
 
     mfxU32 m_implIdxNext;
     bool m_bKeepCapsUntilUnload;
+    mfxU32 m_numProbeThreads;
     CHAR_TYPE m_envVar[MAX_ENV_VAR_LEN];
 
     // logger object - enabled with ONEVPL_DISPATCHER_LOG environment variable
     DispatcherLogVPL m_dispLog;
+
+    // persistent caps cache - enabled with ONEVPL_CAPS_CACHE_FILE environment variable
+    CapsCacheVPL m_capsCache;
+
+    // validImplIdx of each implementation for every set of filter props already applied
+    //   by this loader, cleared when the list of implementations changes
+    std::map<std::string, std::vector<mfxI32>> m_selectionCache;
+    std::vector<SelectionImplHandles> m_selectionImpls;
+
+    // process-wide runtime registry - enabled with ONEVPL_RUNTIME_REGISTRY environment variable
+    std::shared_ptr<RuntimeRegistryVPL> m_registry;
+
+    // background discovery - enabled with ONEVPL_BACKGROUND_DISCOVERY environment variable
+    // the thread holds the writer lock while it runs, so any call which needs loader state
+    //   waits for it to finish
+    bool m_bBackgroundDiscovery;
+    std::thread m_discoveryThread;
+
+    // startup timing - protects the timing of the loader and of each library, since sessions
+    //   may be created (and libraries probed) from several threads at once
+    std::mutex m_timingLock;
+    mfxU64 m_timingStart;
+    LoaderPhaseTiming m_timing;
+    std::list<LibTimingVPL> m_unloadedLibTiming;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    // snapshots returned by QueryTiming(), freed by ReleaseTiming() or MFXUnload()
+    struct TimingSnapshot;
+    std::list<std::unique_ptr<TimingSnapshot>> m_timingSnapshots;
+
+    // session placement policy set with MFXSetPlacementPolicy()
+    mfxPlacementPolicy m_placementPolicy;
+    std::vector<mfxU32> m_placementWeights;
+    mfxU32 m_placementNext;
+
+    ImplInfo *SelectPlacedImpl();
+#endif
+
+    // protects the placement policy and the session counters of all implementations,
+    //   so that selecting an implementation and reserving a session on it is atomic
+    std::mutex m_placementLock;
+
+    // set once the application sets a placement policy or creates a placed session, until then
+    //   CreateSession() does not count sessions so the default path takes no placement locks
+    std::atomic<bool> m_bTrackSessions;
+
+    // return session counter of implInfo, allocated on first use (caller holds m_placementLock)
+    ImplSessionCount *GetSessionCount(ImplInfo *implInfo);
+};
+
+// add the time from construction to destruction to one phase of the loader startup timing
+class LoaderPhaseTimer {
+public:
+    LoaderPhaseTimer(LoaderCtxVPL *loaderCtx, LoaderPhase phase, LibInfo *libInfo = nullptr)
+            : m_loaderCtx(loaderCtx),
+              m_phase(phase),
+              m_libInfo(libInfo),
+              m_startTime(GetLoaderTime()) {}
+
+    ~LoaderPhaseTimer() {
+        m_loaderCtx->AddPhaseTime(m_phase, m_startTime, m_libInfo);
+    }
+
+private:
+    LoaderCtxVPL *m_loaderCtx;
+    LoaderPhase m_phase;
+    LibInfo *m_libInfo;
+    mfxU64 m_startTime;
+
+    // make this class non-copyable
+    LoaderPhaseTimer(const LoaderPhaseTimer &);
+    LoaderPhaseTimer &operator=(const LoaderPhaseTimer &);
 };
 
 #endif // LIBVPL_SRC_MFX_DISPATCHER_VPL_H_
@@ -0,0 +1,1118 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+    #include <process.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+
+    #include "src/linux/drm_topology.h"
+#endif
+
+// increment whenever the layout of the cache file changes
+#define CAPS_CACHE_MAGIC          "VPLCAPS"
+#define CAPS_CACHE_FORMAT_VERSION 5
+
+// every table and array in the cache file starts at a multiple of this
+#define CAPS_CACHE_ALIGN 8
+
+// oldest selections are dropped once this many are stored
+#define CAPS_CACHE_MAX_SELECTIONS 64
+
+// The cache file is a snapshot which later processes map read-only:
+//   CapsSnapshotHeader
+//   CapsSnapshotEntry[numEntries]
+//   CapsCacheImpl[] for all entries
+//   CapsSnapshotSelection[numSelections]
+//   CapsSnapshotSelectionImpl[] for all selections
+//   caps structs, child arrays, strings, library names, and selection keys
+// Pointers in the snapshot are stored as offsets from the start of the file, so it does not
+//   depend on the address where it is mapped. Offset 0 is the header, so it is used for null.
+// The mapping is never written, so its pages stay shared between processes. When an entry is
+//   first used, structs which contain pointers are resolved into memory owned by the cache, and
+//   arrays without pointers (e.g. color formats, strings) are used in place.
+struct CapsSnapshotEntry {
+    mfxU64 libNameOffset;
+    mfxU64 libNameLen;
+    CapsCacheFileID fileID;
+    mfxU32 bValidLib;
+    mfxU32 bMSDK;
+    mfxU32 msdkVersion;
+    mfxU32 numImpls;
+    mfxU64 implsOffset;
+};
+
+struct CapsSnapshotSelection {
+    mfxU64 keyOffset;
+    mfxU64 keyLen;
+    mfxU64 numImpls;
+    mfxU64 implsOffset;
+};
+
+struct CapsSnapshotSelectionImpl {
+    mfxU64 libNameOffset;
+    mfxU64 libNameLen;
+    mfxU32 libImplIdx;
+    mfxI32 validImplIdx;
+};
+
+static size_t AlignSize(size_t size) {
+    return (size + CAPS_CACHE_ALIGN - 1) & ~((size_t)CAPS_CACHE_ALIGN - 1);
+}
+
+// return true if offset is aligned and count elements of elemSize fit in the file
+static bool InFile(mfxU64 offset, mfxU64 count, size_t elemSize, size_t fileSize) {
+    return (offset % CAPS_CACHE_ALIGN) == 0 && offset <= fileSize &&
+           count <= (fileSize - offset) / elemSize;
+}
+
+// arrays are allocated from the last block until it is full, blocks never grow, so earlier
+//   arrays are not moved
+#define CAPS_ARENA_BLOCK_SIZE (16 * 1024)
+
+static mfxU8 *ArenaAlloc(std::list<std::vector<mfxU8>> &arena, size_t size) {
+    size = AlignSize(size);
+
+    if (arena.empty() || arena.back().capacity() - arena.back().size() < size) {
+        arena.emplace_back();
+        arena.back().reserve(std::max(size, (size_t)CAPS_ARENA_BLOCK_SIZE));
+    }
+
+    std::vector<mfxU8> &block = arena.back();
+    size_t pos                = block.size();
+    block.resize(pos + size);
+
+    return block.data() + pos;
+}
+
+// Nested caps structs are serialized by walking every child pointer in a fixed order.
+// The operation (size, flatten, resolve, or copy) decides what to do with each child array.
+// Array() is called before the children of that array are walked, so on flatten/resolve/copy
+//   the walk continues into the new memory.
+// Leaf() is called for arrays of types without pointers, and String() for strings, which the
+//   resolver does not need to copy.
+
+// first pass when saving, returns the size of all child arrays and strings
+class CapsSizer {
+public:
+    CapsSizer() : m_size(0) {}
+
+    void Bytes(size_t size) {
+        m_size += AlignSize(size);
+    }
+
+    template <typename T>
+    bool Array(T *&ptr, mfxU32 count) {
+        if (ptr && count)
+            Bytes(count * sizeof(T));
+        return true;
+    }
+
+    template <typename T>
+    bool Leaf(T *&ptr, mfxU32 count) {
+        return Array(ptr, count);
+    }
+
+    bool String(mfxChar *&str) {
+        if (str)
+            Bytes(strlen(str) + 1);
+        return true;
+    }
+
+    size_t Size() const {
+        return m_size;
+    }
+
+private:
+    size_t m_size;
+};
+
+// second pass when saving, copies each array into the snapshot buffer
+// buffer must already have the size returned by CapsSizer, so it is never reallocated
+// each pointer is converted to an offset by Finish(), once all of the children have been walked
+class CapsFlattener {
+public:
+    CapsFlattener(std::vector<mfxU8> &buf, size_t pos) : m_buf(buf), m_pos(pos), m_fixups() {}
+
+    // copy data which is not referenced by a pointer, return its offset
+    mfxU64 Bytes(const void *data, size_t size) {
+        size_t offset = m_pos;
+        if (size)
+            memcpy(m_buf.data() + offset, data, size);
+        m_pos += AlignSize(size);
+        return offset;
+    }
+
+    template <typename T>
+    bool Array(T *&ptr, mfxU32 count) {
+        if (!ptr || !count) {
+            ptr = nullptr;
+            return true;
+        }
+
+        ptr = (T *)Copy((mfxU8 *)&ptr, ptr, count * sizeof(T));
+        return true;
+    }
+
+    template <typename T>
+    bool Leaf(T *&ptr, mfxU32 count) {
+        return Array(ptr, count);
+    }
+
+    bool String(mfxChar *&str) {
+        if (str)
+            str = (mfxChar *)Copy((mfxU8 *)&str, str, strlen(str) + 1);
+        return true;
+    }
+
+    void Finish() {
+        for (size_t fieldOffset : m_fixups) {
+            mfxU8 **field = (mfxU8 **)(m_buf.data() + fieldOffset);
+            *field        = (mfxU8 *)(uintptr_t)(*field - m_buf.data());
+        }
+        m_fixups.clear();
+    }
+
+private:
+    mfxU8 *Copy(mfxU8 *field, const void *data, size_t size) {
+        m_fixups.push_back(field - m_buf.data());
+        return m_buf.data() + Bytes(data, size);
+    }
+
+    std::vector<mfxU8> &m_buf;
+    size_t m_pos;
+
+    // offsets of all pointer fields in the buffer
+    std::vector<size_t> m_fixups;
+};
+
+// copies arrays out of a mapped snapshot, converting offsets back to pointers
+// leaf arrays and strings point into the mapping instead, since they are never modified
+// every array must be inside the data section of the file, and strings must be terminated
+// in a valid snapshot every array is stored once, so a corrupted file with overlapping arrays
+//   fails once more than the size of the data section has been copied
+class CapsResolver {
+public:
+    CapsResolver(const mfxU8 *base,
+                 size_t size,
+                 mfxU64 dataOffset,
+                 std::list<std::vector<mfxU8>> &arena)
+            : m_base(base),
+              m_size(size),
+              m_dataOffset(dataOffset),
+              m_remaining(size - dataOffset),
+              m_arena(arena) {}
+
+    template <typename T>
+    bool Array(T *&ptr, mfxU32 count) {
+        mfxU64 offset = (mfxU64)(uintptr_t)ptr;
+        if (offset == 0)
+            return true;
+
+        if (count == 0 || offset < m_dataOffset || !InFile(offset, count, sizeof(T), m_size))
+            return false;
+
+        ptr = (T *)Copy(offset, count * sizeof(T));
+        return ptr != nullptr;
+    }
+
+    template <typename T>
+    bool Leaf(T *&ptr, mfxU32 count) {
+        mfxU64 offset = (mfxU64)(uintptr_t)ptr;
+        if (offset == 0)
+            return true;
+
+        if (count == 0 || offset < m_dataOffset || !InFile(offset, count, sizeof(T), m_size))
+            return false;
+
+        ptr = (T *)(m_base + offset);
+        return true;
+    }
+
+    bool String(mfxChar *&str) {
+        mfxU64 offset = (mfxU64)(uintptr_t)str;
+        if (offset == 0)
+            return true;
+
+        if (offset < m_dataOffset || !InFile(offset, 1, 1, m_size))
+            return false;
+
+        if (!memchr(m_base + offset, 0, m_size - offset))
+            return false;
+
+        str = (mfxChar *)(m_base + offset);
+        return true;
+    }
+
+private:
+    mfxU8 *Copy(mfxU64 offset, size_t size) {
+        if (size > m_remaining)
+            return nullptr;
+        m_remaining -= size;
+
+        mfxU8 *dst = ArenaAlloc(m_arena, size);
+        memcpy(dst, m_base + offset, size);
+        return dst;
+    }
+
+    const mfxU8 *m_base;
+    size_t m_size;
+    mfxU64 m_dataOffset;
+    size_t m_remaining;
+    std::list<std::vector<mfxU8>> &m_arena;
+};
+
+class CapsCopier {
+public:
+    explicit CapsCopier(std::list<std::vector<mfxU8>> &arena) : m_arena(arena) {}
+
+    template <typename T>
+    bool Array(T *&ptr, mfxU32 count) {
+        if (!ptr || !count) {
+            ptr = nullptr;
+            return true;
+        }
+
+        T *dst = (T *)ArenaAlloc(m_arena, count * sizeof(T));
+        memcpy(dst, ptr, count * sizeof(T));
+        ptr = dst;
+        return true;
+    }
+
+    template <typename T>
+    bool Leaf(T *&ptr, mfxU32 count) {
+        return Array(ptr, count);
+    }
+
+    bool String(mfxChar *&str) {
+        if (!str)
+            return true;
+
+        size_t len   = strlen(str) + 1;
+        mfxChar *dst = (mfxChar *)ArenaAlloc(m_arena, len);
+        memcpy(dst, str, len);
+        str = dst;
+        return true;
+    }
+
+private:
+    std::list<std::vector<mfxU8>> &m_arena;
+};
+
+#define WALK(op) \
+    if (!(op))   \
+        return false;
+
+template <typename Op>
+static bool WalkCaps(Op &op, mfxImplDescription &desc) {
+    WALK(op.Leaf(desc.Dev.SubDevices, desc.Dev.NumSubDevices));
+
+    WALK(op.Array(desc.Dec.Codecs, desc.Dec.NumCodecs));
+    for (mfxU32 c = 0; desc.Dec.Codecs && c < desc.Dec.NumCodecs; c++) {
+        DecCodec &codec = desc.Dec.Codecs[c];
+#ifdef ONEVPL_EXPERIMENTAL
+        bool bHasExtDesc = (desc.Dec.Version.Version >= MFX_STRUCT_VERSION(1, 1));
+        if (bHasExtDesc) {
+            WALK(op.Array(codec.DecExtDesc, 1));
+            if (codec.DecExtDesc)
+                WALK(op.Leaf(codec.DecExtDesc->ExtBufferIDs, codec.DecExtDesc->NumExtBufferIDs));
+        }
+#endif
+        WALK(op.Array(codec.Profiles, codec.NumProfiles));
+        for (mfxU32 p = 0; codec.Profiles && p < codec.NumProfiles; p++) {
+            DecProfile &profile = codec.Profiles[p];
+            WALK(op.Array(profile.MemDesc, profile.NumMemTypes));
+            for (mfxU32 m = 0; profile.MemDesc && m < profile.NumMemTypes; m++) {
+                DecMemDesc &memDesc = profile.MemDesc[m];
+                WALK(op.Leaf(memDesc.ColorFormats, memDesc.NumColorFormats));
+#ifdef ONEVPL_EXPERIMENTAL
+                if (bHasExtDesc) {
+                    WALK(op.Array(memDesc.MemExtDesc, 1));
+                    if (memDesc.MemExtDesc)
+                        WALK(op.Leaf(memDesc.MemExtDesc->ChromaSubsamplings,
+                                     memDesc.MemExtDesc->NumChromaSubsamplings));
+                }
+#endif
+            }
+        }
+    }
+
+    WALK(op.Array(desc.Enc.Codecs, desc.Enc.NumCodecs));
+    for (mfxU32 c = 0; desc.Enc.Codecs && c < desc.Enc.NumCodecs; c++) {
+        EncCodec &codec = desc.Enc.Codecs[c];
+#ifdef ONEVPL_EXPERIMENTAL
+        bool bHasExtDesc = (desc.Enc.Version.Version >= MFX_STRUCT_VERSION(1, 1));
+        if (bHasExtDesc) {
+            WALK(op.Array(codec.EncExtDesc, 1));
+            if (codec.EncExtDesc) {
+                WALK(op.Leaf(codec.EncExtDesc->RateControlMethods,
+                             codec.EncExtDesc->NumRateControlMethods));
+                WALK(op.Leaf(codec.EncExtDesc->ExtBufferIDs, codec.EncExtDesc->NumExtBufferIDs));
+            }
+        }
+#endif
+        WALK(op.Array(codec.Profiles, codec.NumProfiles));
+        for (mfxU32 p = 0; codec.Profiles && p < codec.NumProfiles; p++) {
+            EncProfile &profile = codec.Profiles[p];
+            WALK(op.Array(profile.MemDesc, profile.NumMemTypes));
+            for (mfxU32 m = 0; profile.MemDesc && m < profile.NumMemTypes; m++) {
+                EncMemDesc &memDesc = profile.MemDesc[m];
+                WALK(op.Leaf(memDesc.ColorFormats, memDesc.NumColorFormats));
+#ifdef ONEVPL_EXPERIMENTAL
+                if (bHasExtDesc) {
+                    WALK(op.Array(memDesc.MemExtDesc, 1));
+                    if (memDesc.MemExtDesc)
+                        WALK(op.Leaf(memDesc.MemExtDesc->TargetChromaSubsamplings,
+                                     memDesc.MemExtDesc->NumTargetChromaSubsamplings));
+                }
+#endif
+            }
+        }
+    }
+
+    WALK(op.Array(desc.VPP.Filters, desc.VPP.NumFilters));
+    for (mfxU32 f = 0; desc.VPP.Filters && f < desc.VPP.NumFilters; f++) {
+        VPPFilter &filter = desc.VPP.Filters[f];
+        WALK(op.Array(filter.MemDesc, filter.NumMemTypes));
+        for (mfxU32 m = 0; filter.MemDesc && m < filter.NumMemTypes; m++) {
+            VPPMemDesc &memDesc = filter.MemDesc[m];
+            WALK(op.Array(memDesc.Formats, memDesc.NumInFormats));
+            for (mfxU32 n = 0; memDesc.Formats && n < memDesc.NumInFormats; n++) {
+                VPPFormat &format = memDesc.Formats[n];
+                WALK(op.Leaf(format.OutFormats, format.NumOutFormat));
+            }
+        }
+    }
+
+    WALK(op.Leaf(desc.AccelerationModeDescription.Mode,
+                 desc.AccelerationModeDescription.NumAccelerationModes));
+
+    // PoolPolicies introduced in mfxImplDescription version 1.2
+    if (desc.Version.Version >= MFX_STRUCT_VERSION(1, 2))
+        WALK(op.Leaf(desc.PoolPolicies.Policy, desc.PoolPolicies.NumPoolPolicies));
+
+    return true;
+}
+
+template <typename Op>
+static bool WalkCaps(Op &op, mfxImplementedFunctions &funcs) {
+    WALK(op.Array(funcs.FunctionsName, funcs.NumFunctions));
+    for (mfxU32 i = 0; funcs.FunctionsName && i < funcs.NumFunctions; i++)
+        WALK(op.String(funcs.FunctionsName[i]));
+
+    return true;
+}
+
+template <typename Op>
+static bool WalkCaps(Op &op, mfxExtendedDeviceId &extDeviceID) {
+    // no child pointers
+    return true;
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+template <typename Op>
+static bool WalkCaps(Op &op, mfxSurfaceTypesSupported &surfTypes) {
+    WALK(op.Array(surfTypes.SurfaceTypes, surfTypes.NumSurfaceTypes));
+    for (mfxU32 i = 0; surfTypes.SurfaceTypes && i < surfTypes.NumSurfaceTypes; i++) {
+        auto &surfType = surfTypes.SurfaceTypes[i];
+        WALK(op.Leaf(surfType.SurfaceComponents, surfType.NumSurfaceComponents));
+    }
+
+    return true;
+}
+#endif
+
+// single top-level struct, which may be null
+template <typename Op, typename T>
+static bool WalkTopLevel(Op &op, T *&caps) {
+    WALK(op.Array(caps, 1));
+    if (caps)
+        WALK(WalkCaps(op, *caps));
+
+    return true;
+}
+
+// cache must be discarded if dispatcher was built with different struct layouts
+static const mfxU32 CapsCacheLayout[] = {
+    MFX_VERSION,
+#ifdef ONEVPL_EXPERIMENTAL
+    1,
+    (mfxU32)sizeof(mfxSurfaceTypesSupported),
+#else
+    0,
+    0,
+#endif
+    (mfxU32)sizeof(void *),
+    (mfxU32)sizeof(CapsCacheFileID),
+    (mfxU32)sizeof(mfxImplDescription),
+    (mfxU32)sizeof(DecCodec),
+    (mfxU32)sizeof(EncCodec),
+    (mfxU32)sizeof(VPPFilter),
+    (mfxU32)sizeof(mfxImplementedFunctions),
+    (mfxU32)sizeof(mfxExtendedDeviceId),
+    (mfxU32)sizeof(CapsCacheImpl),
+    (mfxU32)sizeof(CapsSnapshotEntry),
+    (mfxU32)sizeof(CapsSnapshotSelection),
+    (mfxU32)sizeof(CapsSnapshotSelectionImpl),
+};
+
+struct CapsSnapshotHeader {
+    char magic[sizeof(CAPS_CACHE_MAGIC)];
+    mfxU32 formatVersion;
+    mfxU32 layout[TAB_SIZE(mfxU32, CapsCacheLayout)];
+    mfxU64 fileSize;
+    mfxU64 deviceListKeyOffset;
+    mfxU64 deviceListKeyLen;
+    mfxU64 numEntries;
+    mfxU64 entriesOffset;
+    mfxU64 numSelections;
+    mfxU64 selectionsOffset;
+    mfxU64 dataOffset;
+};
+
+static bool HasEntry(const std::list<CapsCacheEntry> &entries, const std::string &libNameFull) {
+    return std::any_of(entries.begin(), entries.end(), [&](const CapsCacheEntry &e) {
+        return e.libNameFull == libNameFull;
+    });
+}
+
+// fill entries from the mapped snapshot, return false if it is corrupted or stale
+// the descriptions of each entry are checked and copied later by ResolveEntry()
+static bool ParseSnapshot(const mfxU8 *base,
+                          size_t size,
+                          const std::string &deviceListKey,
+                          std::list<CapsCacheEntry> &entries,
+                          std::list<CapsCacheSelection> &selections) {
+    const CapsSnapshotHeader *header = (const CapsSnapshotHeader *)base;
+
+    if (memcmp(header->magic, CAPS_CACHE_MAGIC, sizeof(header->magic)) ||
+        header->formatVersion != CAPS_CACHE_FORMAT_VERSION ||
+        memcmp(header->layout, CapsCacheLayout, sizeof(header->layout)) ||
+        header->fileSize != size || header->dataOffset < sizeof(CapsSnapshotHeader) ||
+        !InFile(header->dataOffset, 0, 1, size))
+        return false;
+
+    if (!InFile(header->deviceListKeyOffset, header->deviceListKeyLen, 1, size) ||
+        deviceListKey.compare(0,
+                              std::string::npos,
+                              (const char *)base + header->deviceListKeyOffset,
+                              (size_t)header->deviceListKeyLen))
+        return false;
+
+    if (!InFile(header->entriesOffset, header->numEntries, sizeof(CapsSnapshotEntry), size))
+        return false;
+
+    const CapsSnapshotEntry *snapEntries =
+        (const CapsSnapshotEntry *)(base + header->entriesOffset);
+
+    for (mfxU64 i = 0; i < header->numEntries; i++) {
+        const CapsSnapshotEntry &snapEntry = snapEntries[i];
+
+        if (!InFile(snapEntry.libNameOffset, snapEntry.libNameLen, 1, size) ||
+            !InFile(snapEntry.implsOffset, snapEntry.numImpls, sizeof(CapsCacheImpl), size))
+            return false;
+
+        CapsCacheEntry entry = {};
+        entry.libNameFull.assign((const char *)base + snapEntry.libNameOffset,
+                                 (size_t)snapEntry.libNameLen);
+        entry.fileID              = snapEntry.fileID;
+        entry.bValidLib           = (snapEntry.bValidLib != 0);
+        entry.bMSDK               = (snapEntry.bMSDK != 0);
+        entry.msdkVersion.Version = snapEntry.msdkVersion;
+
+        const CapsCacheImpl *snapImpls = (const CapsCacheImpl *)(base + snapEntry.implsOffset);
+
+        for (mfxU32 j = 0; j < snapEntry.numImpls; j++) {
+            // every cached implementation must have a description
+            if (!snapImpls[j].implDesc)
+                return false;
+
+            // MSDK implementations are indexed by adapter number
+            if (entry.bMSDK && snapImpls[j].libImplIdx >= MAX_NUM_IMPL_MSDK)
+                return false;
+        }
+
+        if (snapEntry.numImpls) {
+            entry.snapImpls    = snapImpls;
+            entry.numSnapImpls = snapEntry.numImpls;
+        }
+
+        entries.push_back(entry);
+    }
+
+    if (!InFile(header->selectionsOffset,
+                header->numSelections,
+                sizeof(CapsSnapshotSelection),
+                size))
+        return false;
+
+    const CapsSnapshotSelection *snapSelections =
+        (const CapsSnapshotSelection *)(base + header->selectionsOffset);
+
+    for (mfxU64 i = 0; i < header->numSelections; i++) {
+        const CapsSnapshotSelection &snapSelection = snapSelections[i];
+
+        if (!InFile(snapSelection.keyOffset, snapSelection.keyLen, 1, size) ||
+            !InFile(snapSelection.implsOffset,
+                    snapSelection.numImpls,
+                    sizeof(CapsSnapshotSelectionImpl),
+                    size))
+            return false;
+
+        CapsCacheSelection selection;
+        selection.key.assign((const char *)base + snapSelection.keyOffset,
+                             (size_t)snapSelection.keyLen);
+
+        const CapsSnapshotSelectionImpl *snapImpls =
+            (const CapsSnapshotSelectionImpl *)(base + snapSelection.implsOffset);
+
+        for (mfxU64 j = 0; j < snapSelection.numImpls; j++) {
+            if (!InFile(snapImpls[j].libNameOffset, snapImpls[j].libNameLen, 1, size))
+                return false;
+
+            CapsCacheSelectionImpl impl;
+            impl.libNameFull.assign((const char *)base + snapImpls[j].libNameOffset,
+                                    (size_t)snapImpls[j].libNameLen);
+            impl.libImplIdx   = snapImpls[j].libImplIdx;
+            impl.validImplIdx = snapImpls[j].validImplIdx;
+
+            selection.impls.push_back(impl);
+        }
+
+        selections.push_back(selection);
+    }
+
+    return true;
+}
+
+CapsCacheVPL::CapsCacheVPL()
+        : m_cacheFileName(),
+          m_deviceListKey(),
+          m_entries(),
+          m_selections(),
+          m_arena(),
+          m_snapshot(nullptr),
+          m_snapshotSize(0),
+          m_bInMemory(false),
+          m_bLoaded(false),
+          m_bDirty(false) {}
+
+CapsCacheVPL::~CapsCacheVPL() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (m_snapshot)
+        munmap(m_snapshot, m_snapshotSize);
+#endif
+}
+
+mfxStatus CapsCacheVPL::Init(const std::string &cacheFileName) {
+#if defined(_WIN32) || defined(_WIN64)
+    return MFX_ERR_UNSUPPORTED;
+#else
+    if (cacheFileName.empty())
+        return MFX_ERR_UNSUPPORTED;
+
+    m_cacheFileName = cacheFileName;
+
+    return MFX_ERR_NONE;
+#endif
+}
+
+mfxStatus CapsCacheVPL::InitInMemory() {
+#if defined(_WIN32) || defined(_WIN64)
+    return MFX_ERR_UNSUPPORTED;
+#else
+    m_bInMemory = true;
+
+    return MFX_ERR_NONE;
+#endif
+}
+
+mfxStatus CapsCacheVPL::GetFileID(const std::string &fileName, CapsCacheFileID &fileID) {
+    fileID = {};
+
+#if defined(_WIN32) || defined(_WIN64)
+    return MFX_ERR_UNSUPPORTED;
+#else
+    struct stat st;
+    if (stat(fileName.c_str(), &st))
+        return MFX_ERR_NOT_FOUND;
+
+    fileID.dev       = (mfxU64)st.st_dev;
+    fileID.ino       = (mfxU64)st.st_ino;
+    fileID.size      = (mfxU64)st.st_size;
+    fileID.mtimeSec  = (mfxI64)st.st_mtim.tv_sec;
+    fileID.mtimeNsec = (mfxI64)st.st_mtim.tv_nsec;
+
+    return MFX_ERR_NONE;
+#endif
+}
+
+// return a string describing all DRM render nodes on the system
+// if a GPU is added, removed, or moved the cached caps are no longer valid
+std::string CapsCacheVPL::GetDeviceListKey() {
+    std::string key;
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    // nodes are sorted by number, so the key does not depend on readdir() order
+    std::shared_ptr<const DRMTopology> topology = GetDRMTopology();
+
+    for (const DRMRenderNode &node : *topology) {
+        char desc[64];
+        snprintf(desc,
+                 sizeof(desc),
+                 "renderD%u=0x%04x:0x%04x:0x%02x:",
+                 node.nodeNum,
+                 node.vendorID,
+                 node.deviceID,
+                 node.revisionID);
+        key += desc + node.devicePath + ";";
+    }
+#endif
+
+    return key;
+}
+
+mfxU8 *CapsCacheVPL::Alloc(size_t size) {
+    return ArenaAlloc(m_arena, size);
+}
+
+template <typename T>
+T *CapsCacheVPL::CopyCaps(const T *caps) {
+    if (!caps)
+        return nullptr;
+
+    T *dst = (T *)Alloc(sizeof(T));
+    memcpy(dst, caps, sizeof(T));
+
+    CapsCopier copier(m_arena);
+    if (!WalkCaps(copier, *dst))
+        return nullptr;
+
+    return dst;
+}
+
+// resolve the descriptions of an entry read by Load(), only structs with pointers are copied out
+//   of the mapped snapshot
+// return false if they are corrupted, in which case the entry is never returned by Find()
+bool CapsCacheVPL::ResolveEntry(CapsCacheEntry &entry) {
+    if (!entry.snapImpls)
+        return true;
+
+    const CapsSnapshotHeader *header = (const CapsSnapshotHeader *)m_snapshot;
+    CapsResolver resolver(m_snapshot, m_snapshotSize, header->dataOffset, m_arena);
+
+    std::vector<CapsCacheImpl> impls;
+    for (mfxU32 i = 0; i < entry.numSnapImpls; i++) {
+        CapsCacheImpl impl = entry.snapImpls[i];
+        if (!WalkTopLevel(resolver, impl.implDesc) || !WalkTopLevel(resolver, impl.implFuncs) ||
+            !WalkTopLevel(resolver, impl.implExtDeviceID))
+            return false;
+#ifdef ONEVPL_EXPERIMENTAL
+        if (!WalkTopLevel(resolver, impl.implSurfTypes))
+            return false;
+#endif
+        impls.push_back(impl);
+    }
+
+    entry.impls        = impls;
+    entry.snapImpls    = nullptr;
+    entry.numSnapImpls = 0;
+
+    return true;
+}
+
+CapsCacheEntry *CapsCacheVPL::AddEntry(const std::string &libNameFull) {
+    CapsCacheEntry entry = {};
+    entry.libNameFull    = libNameFull;
+    if (GetFileID(libNameFull, entry.fileID))
+        return nullptr;
+
+    if (m_bInMemory) {
+        // keep any existing (stale) entry, Find() returns the newest one first
+        m_entries.push_front(entry);
+        return &m_entries.front();
+    }
+
+    // replace any existing (stale) entry for this library
+    m_entries.remove_if([&](const CapsCacheEntry &e) {
+        return e.libNameFull == libNameFull;
+    });
+
+    // selections were made with the old caps
+    m_selections.remove_if([&](const CapsCacheSelection &sel) {
+        return std::any_of(sel.impls.begin(),
+                           sel.impls.end(),
+                           [&](const CapsCacheSelectionImpl &impl) {
+                               return impl.libNameFull == libNameFull;
+                           });
+    });
+
+    m_entries.push_back(entry);
+    m_bDirty = true;
+
+    return &m_entries.back();
+}
+
+void CapsCacheVPL::CopyImpls(CapsCacheEntry *entry, const std::vector<CapsCacheImpl> &impls) {
+    for (const CapsCacheImpl &impl : impls) {
+        CapsCacheImpl cachedImpl = {};
+
+        cachedImpl.libImplIdx      = impl.libImplIdx;
+        cachedImpl.msdkAdapterD3D9 = impl.msdkAdapterD3D9;
+        cachedImpl.implDesc        = CopyCaps(impl.implDesc);
+        if (cachedImpl.implDesc) {
+            // reserved for future use, not cached
+            cachedImpl.implDesc->NumExtParam          = 0;
+            cachedImpl.implDesc->ExtParams.Reserved2 = 0;
+        }
+
+        cachedImpl.implFuncs       = CopyCaps(impl.implFuncs);
+        cachedImpl.implExtDeviceID = CopyCaps(impl.implExtDeviceID);
+#ifdef ONEVPL_EXPERIMENTAL
+        cachedImpl.implSurfTypes = CopyCaps(impl.implSurfTypes);
+#endif
+
+        entry->impls.push_back(cachedImpl);
+    }
+}
+
+mfxStatus CapsCacheVPL::AddValidLib(const std::string &libNameFull,
+                                    const std::vector<CapsCacheImpl> &impls) {
+    if (!IsEnabled())
+        return MFX_ERR_UNSUPPORTED;
+
+    CapsCacheEntry *entry = AddEntry(libNameFull);
+    if (!entry)
+        return MFX_ERR_NOT_FOUND;
+
+    entry->bValidLib = true;
+    CopyImpls(entry, impls);
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus CapsCacheVPL::AddMSDKLib(const std::string &libNameFull,
+                                   mfxVersion msdkVersion,
+                                   const std::vector<CapsCacheImpl> &impls) {
+    if (!IsEnabled())
+        return MFX_ERR_UNSUPPORTED;
+
+    CapsCacheEntry *entry = AddEntry(libNameFull);
+    if (!entry)
+        return MFX_ERR_NOT_FOUND;
+
+    entry->bValidLib   = true;
+    entry->bMSDK       = true;
+    entry->msdkVersion = msdkVersion;
+    CopyImpls(entry, impls);
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus CapsCacheVPL::AddInvalidLib(const std::string &libNameFull) {
+    if (!IsEnabled())
+        return MFX_ERR_UNSUPPORTED;
+
+    CapsCacheEntry *entry = AddEntry(libNameFull);
+    if (!entry)
+        return MFX_ERR_NOT_FOUND;
+
+    entry->bValidLib = false;
+
+    return MFX_ERR_NONE;
+}
+
+const CapsCacheEntry *CapsCacheVPL::Find(const std::string &libNameFull) {
+    if (!IsEnabled())
+        return nullptr;
+
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const CapsCacheEntry &e) {
+        return e.libNameFull == libNameFull;
+    });
+    if (it == m_entries.end())
+        return nullptr;
+
+    CapsCacheFileID fileID;
+    if (GetFileID(libNameFull, fileID) || memcmp(&fileID, &it->fileID, sizeof(fileID)))
+        return nullptr;
+
+    if (!ResolveEntry(*it))
+        return nullptr;
+
+    return &(*it);
+}
+
+const CapsCacheSelection *CapsCacheVPL::FindSelection(const std::string &key) const {
+    auto it = std::find_if(m_selections.begin(),
+                           m_selections.end(),
+                           [&](const CapsCacheSelection &sel) {
+                               return sel.key == key;
+                           });
+
+    return (it == m_selections.end() ? nullptr : &(*it));
+}
+
+mfxStatus CapsCacheVPL::AddSelection(const std::string &key,
+                                     const std::vector<CapsCacheSelectionImpl> &impls) {
+    if (m_cacheFileName.empty())
+        return MFX_ERR_UNSUPPORTED;
+
+    m_selections.remove_if([&](const CapsCacheSelection &sel) {
+        return sel.key == key;
+    });
+
+    if (m_selections.size() >= CAPS_CACHE_MAX_SELECTIONS)
+        m_selections.pop_front();
+
+    CapsCacheSelection selection;
+    selection.key   = key;
+    selection.impls = impls;
+    m_selections.push_back(selection);
+
+    m_bDirty = true;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus CapsCacheVPL::Load() {
+    if (m_cacheFileName.empty())
+        return MFX_ERR_UNSUPPORTED;
+
+    // only load once per loader, LibInfo may hold pointers to the entries
+    if (m_bLoaded)
+        return MFX_ERR_NONE;
+    m_bLoaded = true;
+
+    m_deviceListKey = GetDeviceListKey();
+
+#if defined(_WIN32) || defined(_WIN64)
+    return MFX_ERR_UNSUPPORTED;
+#else
+    int fd = open(m_cacheFileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return MFX_ERR_NOT_FOUND;
+
+    struct stat st;
+    if (fstat(fd, &st) || st.st_size < (off_t)sizeof(CapsSnapshotHeader)) {
+        close(fd);
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    // Save() replaces the file with rename(), so the mapped contents never change
+    size_t size = (size_t)st.st_size;
+    void *map   = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (map == MAP_FAILED)
+        return MFX_ERR_UNSUPPORTED;
+
+    // parse into temporary lists so a corrupted file leaves the cache empty
+    std::list<CapsCacheEntry> entries;
+    std::list<CapsCacheSelection> selections;
+    if (!ParseSnapshot((const mfxU8 *)map, size, m_deviceListKey, entries, selections)) {
+        munmap(map, size);
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    m_snapshot     = (mfxU8 *)map;
+    m_snapshotSize = size;
+    m_entries.splice(m_entries.end(), entries);
+
+    // selections which refer to a library without an entry are never used
+    for (CapsCacheSelection &selection : selections) {
+        if (std::all_of(selection.impls.begin(),
+                        selection.impls.end(),
+                        [&](const CapsCacheSelectionImpl &impl) {
+                            return HasEntry(m_entries, impl.libNameFull);
+                        }))
+            m_selections.push_back(selection);
+    }
+
+    return MFX_ERR_NONE;
+#endif
+}
+
+mfxStatus CapsCacheVPL::Save() {
+    if (m_cacheFileName.empty())
+        return MFX_ERR_UNSUPPORTED;
+
+    if (!m_bDirty)
+        return MFX_ERR_NONE;
+
+    // drop entries for libraries which were removed or modified
+    std::vector<CapsCacheEntry *> entries;
+    size_t numImpls = 0;
+    for (CapsCacheEntry &entry : m_entries) {
+        CapsCacheFileID fileID;
+        if (GetFileID(entry.libNameFull, fileID) == MFX_ERR_NONE &&
+            !memcmp(&fileID, &entry.fileID, sizeof(fileID)) && ResolveEntry(entry)) {
+            entries.push_back(&entry);
+            numImpls += entry.impls.size();
+        }
+    }
+
+    // drop selections which refer to any of those libraries
+    std::vector<CapsCacheSelection *> selections;
+    size_t numSelectionImpls = 0;
+    for (CapsCacheSelection &selection : m_selections) {
+        bool bAllSaved = std::all_of(selection.impls.begin(),
+                                     selection.impls.end(),
+                                     [&](const CapsCacheSelectionImpl &impl) {
+                                         return std::any_of(entries.begin(),
+                                                            entries.end(),
+                                                            [&](const CapsCacheEntry *e) {
+                                                                return e->libNameFull ==
+                                                                       impl.libNameFull;
+                                                            });
+                                     });
+        if (bAllSaved) {
+            selections.push_back(&selection);
+            numSelectionImpls += selection.impls.size();
+        }
+    }
+
+    size_t entriesOffset = AlignSize(sizeof(CapsSnapshotHeader));
+    size_t implsOffset   = AlignSize(entriesOffset + entries.size() * sizeof(CapsSnapshotEntry));
+    size_t selectionsOffset = AlignSize(implsOffset + numImpls * sizeof(CapsCacheImpl));
+    size_t selectionImplsOffset =
+        AlignSize(selectionsOffset + selections.size() * sizeof(CapsSnapshotSelection));
+    size_t dataOffset =
+        AlignSize(selectionImplsOffset + numSelectionImpls * sizeof(CapsSnapshotSelectionImpl));
+
+    CapsSizer sizer;
+    sizer.Bytes(m_deviceListKey.size());
+    for (CapsCacheEntry *entry : entries) {
+        sizer.Bytes(entry->libNameFull.size());
+
+        for (CapsCacheImpl &impl : entry->impls) {
+            WalkTopLevel(sizer, impl.implDesc);
+            WalkTopLevel(sizer, impl.implFuncs);
+            WalkTopLevel(sizer, impl.implExtDeviceID);
+#ifdef ONEVPL_EXPERIMENTAL
+            WalkTopLevel(sizer, impl.implSurfTypes);
+#endif
+        }
+    }
+
+    for (CapsCacheSelection *selection : selections) {
+        sizer.Bytes(selection->key.size());
+        for (CapsCacheSelectionImpl &impl : selection->impls)
+            sizer.Bytes(impl.libNameFull.size());
+    }
+
+    std::vector<mfxU8> buf(dataOffset + sizer.Size());
+    CapsFlattener flattener(buf, dataOffset);
+
+    CapsSnapshotHeader *header = (CapsSnapshotHeader *)buf.data();
+    memcpy(header->magic, CAPS_CACHE_MAGIC, sizeof(header->magic));
+    header->formatVersion = CAPS_CACHE_FORMAT_VERSION;
+    memcpy(header->layout, CapsCacheLayout, sizeof(header->layout));
+    header->fileSize            = buf.size();
+    header->deviceListKeyOffset = flattener.Bytes(m_deviceListKey.data(), m_deviceListKey.size());
+    header->deviceListKeyLen    = m_deviceListKey.size();
+    header->numEntries          = entries.size();
+    header->entriesOffset       = entriesOffset;
+    header->numSelections       = selections.size();
+    header->selectionsOffset    = selectionsOffset;
+    header->dataOffset          = dataOffset;
+
+    CapsSnapshotEntry *snapEntry = (CapsSnapshotEntry *)(buf.data() + entriesOffset);
+    CapsCacheImpl *snapImpl      = (CapsCacheImpl *)(buf.data() + implsOffset);
+
+    for (CapsCacheEntry *entry : entries) {
+        snapEntry->libNameOffset =
+            flattener.Bytes(entry->libNameFull.data(), entry->libNameFull.size());
+        snapEntry->libNameLen  = entry->libNameFull.size();
+        snapEntry->fileID      = entry->fileID;
+        snapEntry->bValidLib   = (entry->bValidLib ? 1 : 0);
+        snapEntry->bMSDK       = (entry->bMSDK ? 1 : 0);
+        snapEntry->msdkVersion = entry->msdkVersion.Version;
+        snapEntry->numImpls    = (mfxU32)entry->impls.size();
+        snapEntry->implsOffset = (mfxU8 *)snapImpl - buf.data();
+        snapEntry++;
+
+        // walk the copy in the buffer, so each pointer is replaced by the flattened array
+        for (CapsCacheImpl &impl : entry->impls) {
+            *snapImpl = impl;
+            WalkTopLevel(flattener, snapImpl->implDesc);
+            WalkTopLevel(flattener, snapImpl->implFuncs);
+            WalkTopLevel(flattener, snapImpl->implExtDeviceID);
+#ifdef ONEVPL_EXPERIMENTAL
+            WalkTopLevel(flattener, snapImpl->implSurfTypes);
+#endif
+            snapImpl++;
+        }
+    }
+
+    CapsSnapshotSelection *snapSelection =
+        (CapsSnapshotSelection *)(buf.data() + selectionsOffset);
+    CapsSnapshotSelectionImpl *snapSelectionImpl =
+        (CapsSnapshotSelectionImpl *)(buf.data() + selectionImplsOffset);
+
+    for (CapsCacheSelection *selection : selections) {
+        snapSelection->keyOffset   = flattener.Bytes(selection->key.data(), selection->key.size());
+        snapSelection->keyLen      = selection->key.size();
+        snapSelection->numImpls    = selection->impls.size();
+        snapSelection->implsOffset = (mfxU8 *)snapSelectionImpl - buf.data();
+        snapSelection++;
+
+        for (CapsCacheSelectionImpl &impl : selection->impls) {
+            snapSelectionImpl->libNameOffset =
+                flattener.Bytes(impl.libNameFull.data(), impl.libNameFull.size());
+            snapSelectionImpl->libNameLen   = impl.libNameFull.size();
+            snapSelectionImpl->libImplIdx   = impl.libImplIdx;
+            snapSelectionImpl->validImplIdx = impl.validImplIdx;
+            snapSelectionImpl++;
+        }
+    }
+
+    flattener.Finish();
+
+    // write to a temporary file and rename, so other processes never see a partial file
+    // the name is unique per call, so concurrent loaders in one process do not share it
+#if defined(_WIN32) || defined(_WIN64)
+    static std::atomic<mfxU32> tmpFileCount(0);
+    std::string tmpFileName = m_cacheFileName + "." + std::to_string(_getpid()) + "." +
+                              std::to_string(tmpFileCount++) + ".tmp";
+
+    FILE *tmpFile = fopen(tmpFileName.c_str(), "wb");
+    if (!tmpFile)
+        return MFX_ERR_NOT_FOUND;
+#else
+    std::string tmpFileName = m_cacheFileName + ".XXXXXX.tmp";
+
+    int fd = mkstemps(&tmpFileName[0], (int)strlen(".tmp"));
+    if (fd < 0)
+        return MFX_ERR_NOT_FOUND;
+
+    FILE *tmpFile = fdopen(fd, "wb");
+    if (!tmpFile) {
+        close(fd);
+        remove(tmpFileName.c_str());
+        return MFX_ERR_NOT_FOUND;
+    }
+#endif
+
+    size_t nWritten = fwrite(buf.data(), 1, buf.size(), tmpFile);
+    if (fclose(tmpFile) || nWritten != buf.size() ||
+        rename(tmpFileName.c_str(), m_cacheFileName.c_str())) {
+        remove(tmpFileName.c_str());
+        return MFX_ERR_UNKNOWN;
+    }
+
+    m_bDirty = false;
+
+    return MFX_ERR_NONE;
+}
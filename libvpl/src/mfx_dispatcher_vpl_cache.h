@@ -0,0 +1,169 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#ifndef LIBVPL_SRC_MFX_DISPATCHER_VPL_CACHE_H_
+#define LIBVPL_SRC_MFX_DISPATCHER_VPL_CACHE_H_
+
+/* Intel® Video Processing Library (Intel® VPL) Dispatcher Capabilities Cache
+ * The persistent capabilities cache is controlled with the ONEVPL_CAPS_CACHE_FILE environment variable.
+ * To enable the cache, set ONEVPL_CAPS_CACHE_FILE to the full path of a writable file.
+ *
+ * When enabled, the capabilities reported by each 2.x runtime are saved to this file and reused by
+ *   later processes, so that runtimes with a valid cache entry are not loaded or queried during
+ *   MFXEnumImplementations() or MFXCreateSession().
+ * Legacy MSDK runtimes are cached per adapter, so the test sessions used to build their
+ *   descriptions are skipped as well. A session is only opened when the application creates one.
+ * Each entry is keyed by the full path, inode, size, and modification time of the runtime library.
+ *   The entire cache is discarded if the list of DRM render nodes changes.
+ * The file is a position-independent snapshot, with pointers stored as offsets. Later processes map
+ *   it read-only, so its pages are shared by every process using the cache. When an entry is first
+ *   returned by Find(), the structs in its descriptions which contain pointers are copied with the
+ *   offsets resolved, while arrays of plain values and strings are used directly from the mapping.
+ * The prioritized list of valid implementations for each set of filter props is stored as well, so
+ *   later processes which use the same filters skip validating them against the cached caps.
+ *   A stored selection is dropped when the entry for any of its runtime libraries is replaced.
+ * Currently only supported on Linux.
+ */
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "vpl/mfxdispatcher.h"
+#include "vpl/mfxvideo.h"
+
+// identity of a runtime library file, used to detect stale cache entries
+struct CapsCacheFileID {
+    mfxU64 dev;
+    mfxU64 ino;
+    mfxU64 size;
+    mfxI64 mtimeSec;
+    mfxI64 mtimeNsec;
+};
+
+// capabilities of a single implementation within a runtime library
+// all memory is owned by the cache (do not call MFXReleaseImplDescription)
+// this struct is also stored in the cache file, so changes to it require a new format version
+struct CapsCacheImpl {
+    mfxU32 libImplIdx;
+
+    // legacy MSDK only: mfxIMPL to use with MFX_ACCEL_MODE_VIA_D3D9 (see CheckD3D9Support)
+    mfxIMPL msdkAdapterD3D9;
+
+    mfxImplDescription *implDesc;
+    mfxImplementedFunctions *implFuncs;
+    mfxExtendedDeviceId *implExtDeviceID;
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxSurfaceTypesSupported *implSurfTypes;
+#endif
+};
+
+struct CapsCacheEntry {
+    std::string libNameFull;
+    CapsCacheFileID fileID;
+
+    // false if library was loaded but is not a valid runtime
+    bool bValidLib;
+
+    // legacy MSDK runtime, libImplIdx of each implementation is the adapter number
+    bool bMSDK;
+    mfxVersion msdkVersion;
+
+    std::vector<CapsCacheImpl> impls;
+
+    // entry read by Load() which Find() has not returned yet
+    // points to the implementations in the mapped cache file, with pointers still stored as offsets
+    const CapsCacheImpl *snapImpls;
+    mfxU32 numSnapImpls;
+};
+
+// implementation in a stored selection, in priority order
+struct CapsCacheSelectionImpl {
+    std::string libNameFull;
+    mfxU32 libImplIdx;
+
+    // -1 if the implementation did not match the filter props
+    mfxI32 validImplIdx;
+};
+
+// result of selecting implementations with one set of filter props
+// key is generated by ConfigCtxVPL::GetSelectionKey()
+struct CapsCacheSelection {
+    std::string key;
+    std::vector<CapsCacheSelectionImpl> impls;
+};
+
+class CapsCacheVPL {
+public:
+    CapsCacheVPL();
+    ~CapsCacheVPL();
+
+    mfxStatus Init(const std::string &cacheFileName);
+    bool IsEnabled() const {
+        return !m_cacheFileName.empty() || m_bInMemory;
+    }
+
+    // enable cache without a backing file (Load and Save are not supported)
+    // entries are never removed, since other loaders may still hold pointers to them
+    mfxStatus InitInMemory();
+
+    // map cache file, dropping all entries if the device list changed
+    mfxStatus Load();
+
+    // write cache file if any entries were added since Load()
+    mfxStatus Save();
+
+    // return entry for this library, or nullptr if not cached or stale
+    const CapsCacheEntry *Find(const std::string &libNameFull);
+
+    // deep copy runtime caps into the cache
+    mfxStatus AddValidLib(const std::string &libNameFull, const std::vector<CapsCacheImpl> &impls);
+    mfxStatus AddInvalidLib(const std::string &libNameFull);
+    mfxStatus AddMSDKLib(const std::string &libNameFull,
+                         mfxVersion msdkVersion,
+                         const std::vector<CapsCacheImpl> &impls);
+
+    // return stored selection for this key, or nullptr
+    // the pointer is invalidated by the next call to AddSelection() or Add*Lib()
+    const CapsCacheSelection *FindSelection(const std::string &key) const;
+
+    // store selection, replacing any previous one with the same key
+    mfxStatus AddSelection(const std::string &key,
+                           const std::vector<CapsCacheSelectionImpl> &impls);
+
+    static mfxStatus GetFileID(const std::string &fileName, CapsCacheFileID &fileID);
+    static std::string GetDeviceListKey();
+
+private:
+    CapsCacheEntry *AddEntry(const std::string &libNameFull);
+    void CopyImpls(CapsCacheEntry *entry, const std::vector<CapsCacheImpl> &impls);
+    mfxU8 *Alloc(size_t size);
+    bool ResolveEntry(CapsCacheEntry &entry);
+
+    template <typename T>
+    T *CopyCaps(const T *caps);
+
+    std::string m_cacheFileName;
+    std::string m_deviceListKey;
+    std::list<CapsCacheEntry> m_entries;
+    std::list<CapsCacheSelection> m_selections;
+
+    // backing memory for descriptions added or resolved by this process
+    std::list<std::vector<mfxU8>> m_arena;
+
+    // read-only mapping of the cache file, never modified
+    mfxU8 *m_snapshot;
+    size_t m_snapshotSize;
+
+    bool m_bInMemory;
+    bool m_bLoaded;
+    bool m_bDirty;
+
+    CapsCacheVPL(const CapsCacheVPL &other);
+    CapsCacheVPL &operator=(const CapsCacheVPL &other);
+};
+
+#endif // LIBVPL_SRC_MFX_DISPATCHER_VPL_CACHE_H_
@@ -7,6 +7,7 @@
 #include "src/mfx_dispatcher_vpl.h"
 
 #include <assert.h>
+#include <string.h>
 
 #include <map>
 #include <regex>
@@ -37,6 +38,10 @@ ConfigCtxVPL::ConfigCtxVPL()
         m_propVar[idx].bPropsQuery     = false;
     }
 
+    // start at 1 so that a new ConfigCheckResult (revision 0) is checked on first use
+    for (mfxU32 group = 0; group < ePropGroup_Total; group++)
+        m_propGroupRevision[group] = 1;
+
     m_parentLoader = nullptr;
     return;
 }
@@ -230,6 +235,29 @@ static_assert((sizeof(PropIdxTab) / sizeof(PropVariant)) == eProp_TotalProps,
 static_assert(NUM_TOTAL_FILTER_PROPS == eProp_TotalProps,
               "NUM_TOTAL_FILTER_PROPS and eProp_TotalProps are misaligned");
 
+// return the group a filtering property is checked with
+// non-filtering props (special, query) and API version return ePropGroup_Total
+static PropGroup GetPropGroup(mfxI32 idx) {
+    if (idx >= ePropDec_CodecID && idx <= ePropDec_ColorFormats)
+        return ePropGroup_Dec;
+    else if (idx >= ePropEnc_CodecID && idx <= ePropEnc_ColorFormats)
+        return ePropGroup_Enc;
+    else if (idx >= ePropVPP_FilterFourCC && idx <= ePropVPP_OutFormat)
+        return ePropGroup_VPP;
+    else if (idx >= ePropExtDev_VendorID && idx <= ePropExtDev_DeviceName)
+        return ePropGroup_ExtDev;
+    else if (idx >= ePropSurface_SurfaceType && idx <= ePropSurface_SurfaceFlags)
+        return ePropGroup_Surface;
+    else if (idx == ePropFunc_FunctionName)
+        return ePropGroup_Func;
+    else if (idx >= ePropMain_ApiVersion && idx <= ePropMain_ApiVersion_Minor)
+        return ePropGroup_Total;
+    else if (idx >= ePropMain_Impl && idx <= ePropDevice_MediaAdapterType)
+        return ePropGroup_General;
+
+    return ePropGroup_Total;
+}
+
 #ifdef ONEVPL_EXPERIMENTAL
 
 // clang-format off
@@ -245,7 +273,7 @@ static const std::map<enum PropIdx, char *> PropStringMap {
 };
 // clang-format on
 
-bool ConfigCtxVPL::UpdatePropsQueryConfig(std::list<ConfigCtxVPL *> configCtxList,
+bool ConfigCtxVPL::UpdatePropsQueryConfig(const std::vector<ConfigCtxVPL *> &configCtxList,
                                           std::vector<mfxQueryProperty> &queryProps) {
     // disabled by default
     bool bPropsQuery = false;
@@ -291,12 +319,116 @@ bool ConfigCtxVPL::UpdatePropsQueryConfig(std::list<ConfigCtxVPL *> configCtxLis
 
     return bPropsQuery;
 }
+
+// integer props which are compared for equality with a single value from the
+//   implementation, so may also be passed as a set or range of accepted values
+static bool IsMultiValueProp(mfxI32 idx) {
+    switch (idx) {
+        case ePropMain_Impl:
+        case ePropMain_VendorID:
+        case ePropMain_VendorImplID:
+        case ePropDevice_DeviceID:
+        case ePropDevice_MediaAdapterType:
+        case ePropDec_CodecID:
+        case ePropDec_MaxcodecLevel:
+        case ePropDec_Profile:
+        case ePropDec_MemHandleType:
+        case ePropDec_ColorFormats:
+        case ePropEnc_CodecID:
+        case ePropEnc_MaxcodecLevel:
+        case ePropEnc_BiDirectionalPrediction:
+        case ePropEnc_Profile:
+        case ePropEnc_MemHandleType:
+        case ePropEnc_ColorFormats:
+        case ePropVPP_FilterFourCC:
+        case ePropVPP_MaxDelayInFrames:
+        case ePropVPP_MemHandleType:
+        case ePropVPP_InFormat:
+        case ePropVPP_OutFormat:
+        case ePropExtDev_VendorID:
+        case ePropExtDev_DeviceID:
+        case ePropExtDev_PCIDomain:
+        case ePropExtDev_PCIBus:
+        case ePropExtDev_PCIDevice:
+        case ePropExtDev_PCIFunction:
+        case ePropExtDev_LUIDDeviceNodeMask:
+        case ePropExtDev_DRMRenderNodeNum:
+        case ePropExtDev_DRMPrimaryNodeNum:
+        case ePropExtDev_RevisionID:
+        case ePropSurface_SurfaceType:
+        case ePropSurface_SurfaceComponent:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// save a copy of the set (mfxSet32U) or range (mfxRange32U) of accepted values
+// multiType is MFX_VARIANT_TYPE_SET or MFX_VARIANT_TYPE_RANGE, and remains OR'd into
+//   the type of the saved prop so that it is not mistaken for a single value
+mfxStatus ConfigCtxVPL::SetMultiValueProp(mfxI32 idx,
+                                          mfxVariantType baseType,
+                                          mfxU32 multiType,
+                                          mfxHDL ptr) {
+    if (ptr == nullptr) {
+        // unset property to avoid possibly dereferencing null if app ignores error code
+        m_propVar[idx].Type = MFX_VARIANT_TYPE_UNSET;
+        return MFX_ERR_NULL_PTR;
+    }
+
+    mfxU32 maxValue = (baseType == MFX_VARIANT_TYPE_U16 ? 0xFFFF : 0xFFFFFFFF);
+
+    if (multiType == MFX_VARIANT_TYPE_SET) {
+        const mfxSet32U *valueSet = (const mfxSet32U *)ptr;
+        if (valueSet->NumValues == 0)
+            return MFX_ERR_UNSUPPORTED;
+
+        if (valueSet->Values == nullptr) {
+            m_propVar[idx].Type = MFX_VARIANT_TYPE_UNSET;
+            return MFX_ERR_NULL_PTR;
+        }
+
+        const mfxU32 *first = valueSet->Values;
+        const mfxU32 *last  = valueSet->Values + valueSet->NumValues;
+        if (std::any_of(first, last, [maxValue](mfxU32 v) {
+                return v > maxValue;
+            }))
+            return MFX_ERR_UNSUPPORTED;
+
+        // sorted so that each check is a binary search
+        std::vector<mfxU32> &values = m_propValueSet[idx];
+        values.assign(first, last);
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+
+        m_propVar[idx].Data.Ptr = &values;
+    }
+    else {
+        const mfxRange32U *valueRange = (const mfxRange32U *)ptr;
+        if (valueRange->Min > valueRange->Max || valueRange->Min > maxValue)
+            return MFX_ERR_UNSUPPORTED;
+
+        m_propValueRange[idx]   = *valueRange;
+        m_propVar[idx].Data.Ptr = &(m_propValueRange[idx]);
+    }
+
+    m_propVar[idx].Version.Version = MFX_VARIANT_VERSION;
+    m_propVar[idx].Type            = (mfxVariantType)((mfxU32)baseType | multiType);
+
+    return MFX_ERR_NONE;
+}
 #endif
 
 mfxStatus ConfigCtxVPL::ValidateAndSetProp(mfxI32 idx, mfxVariant value) {
     if (idx < 0 || idx >= eProp_TotalProps)
         return MFX_ERR_NOT_FOUND;
 
+    // property may be modified below even if an error is returned, so always
+    //   mark its group as changed
+    PropGroup group = GetPropGroup(idx);
+    if (group != ePropGroup_Total)
+        m_propGroupRevision[group]++;
+
     m_propVar[idx].bPropsQuery = false;
 #ifdef ONEVPL_EXPERIMENTAL
     mfxU32 queryMask = (mfxU32)MFX_VARIANT_TYPE_QUERY;
@@ -318,6 +450,22 @@ mfxStatus ConfigCtxVPL::ValidateAndSetProp(mfxI32 idx, mfxVariant value) {
         if (propString == PropStringMap.end())
             return MFX_ERR_UNSUPPORTED;
     }
+
+    // set or range of accepted values, passed by pointer
+    mfxU32 multiMask = (mfxU32)MFX_VARIANT_TYPE_SET | (mfxU32)MFX_VARIANT_TYPE_RANGE;
+    mfxU32 multiType = (mfxU32)(value.Type) & multiMask;
+    if (multiType) {
+        value.Type = static_cast<mfxVariantType>(((mfxU32)(value.Type)) & (~multiMask));
+
+        // only one of SET or RANGE may be used, and not together with QUERY
+        if (multiType == multiMask || m_propVar[idx].bPropsQuery == true)
+            return MFX_ERR_UNSUPPORTED;
+
+        if (!IsMultiValueProp(idx) || value.Type != PropIdxTab[idx].Type)
+            return MFX_ERR_UNSUPPORTED;
+
+        return SetMultiValueProp(idx, value.Type, multiType, value.Data.Ptr);
+    }
 #endif
 
     if (value.Type != PropIdxTab[idx].Type)
@@ -416,215 +564,252 @@ mfxStatus ConfigCtxVPL::ValidateAndSetProp(mfxI32 idx, mfxVariant value) {
     return MFX_ERR_NONE;
 }
 
-mfxStatus ConfigCtxVPL::SetFilterPropertyDec(std::list<std::string> &propParsedString,
-                                             mfxVariant value) {
-    std::string nextProp;
+struct PropName {
+    const char *Name;
+    enum PropIdx Idx;
+};
 
-    nextProp = GetNextProp(propParsedString);
+// leave table formatting alone
+// clang-format off
 
+// full name of every settable property, including alternate spellings
+// properties with names not in this table return MFX_ERR_NOT_FOUND
+static const PropName PropNameTab[] = {
+    // special properties, not part of mfxImplDescription
+    { "mfxHandleType",                                                                ePropSpecial_HandleType },
+    { "mfxHDL",                                                                       ePropSpecial_Handle },
+    { "NumThread",                                                                    ePropSpecial_NumThread },
 #ifdef ONEVPL_EXPERIMENTAL
-    // empty string indicates property-based query for all decoders
-    // for this case Type should be (MFX_VARIANT_TYPE_QUERY | MFX_VARIANT_TYPE_U32) and Data should be 0
-    if (nextProp == "") {
-        return ValidateAndSetProp(ePropQuery_AllDec, value);
-    }
+    { "DeviceCopy",                                                                   ePropSpecial_DeviceCopy },
+#endif
+    { "ExtBuffer",                                                                    ePropSpecial_ExtBuffer },
+#if defined(_WIN32) || defined(_WIN64)
+    // this property is only valid on Windows
+    { "DXGIAdapterIndex",                                                             ePropSpecial_DXGIAdapterIndex },
 #endif
 
-    // no settable top-level members
-    if (nextProp != "decoder")
-        return MFX_ERR_NOT_FOUND;
+    // functions which must report as implemented
+    { "mfxImplementedFunctions.FunctionsName",                                        ePropFunc_FunctionName },
+
+    // mfxExtendedDeviceId
+    { "mfxExtendedDeviceId.VendorID",                                                 ePropExtDev_VendorID },
+    { "mfxExtendedDeviceId.DeviceID",                                                 ePropExtDev_DeviceID },
+    { "mfxExtendedDeviceId.PCIDomain",                                                ePropExtDev_PCIDomain },
+    { "mfxExtendedDeviceId.PCIBus",                                                   ePropExtDev_PCIBus },
+    { "mfxExtendedDeviceId.PCIDevice",                                                ePropExtDev_PCIDevice },
+    { "mfxExtendedDeviceId.PCIFunction",                                              ePropExtDev_PCIFunction },
+    { "mfxExtendedDeviceId.DeviceLUID",                                               ePropExtDev_DeviceLUID },
+    { "mfxExtendedDeviceId.LUIDDeviceNodeMask",                                       ePropExtDev_LUIDDeviceNodeMask },
+    { "mfxExtendedDeviceId.DRMRenderNodeNum",                                         ePropExtDev_DRMRenderNodeNum },
+    { "mfxExtendedDeviceId.DRMPrimaryNodeNum",                                        ePropExtDev_DRMPrimaryNodeNum },
+    { "mfxExtendedDeviceId.RevisionID",                                               ePropExtDev_RevisionID },
+    { "mfxExtendedDeviceId.DeviceName",                                               ePropExtDev_DeviceName },
 
-    // parse 'decoder'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "CodecID") {
-        return ValidateAndSetProp(ePropDec_CodecID, value);
-    }
-    else if (nextProp == "MaxcodecLevel") {
-        return ValidateAndSetProp(ePropDec_MaxcodecLevel, value);
-    }
-    else if (nextProp != "decprofile") {
-        return MFX_ERR_NOT_FOUND;
-    }
+#ifdef ONEVPL_EXPERIMENTAL
+    // mfxSurfaceTypesSupported
+    { "mfxSurfaceTypesSupported.surftype.SurfaceType",                                ePropSurface_SurfaceType },
+    { "mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceComponent",                  ePropSurface_SurfaceComponent },
+    { "mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceFlags",                      ePropSurface_SurfaceFlags },
+
+    // property-based query (Type should be MFX_VARIANT_TYPE_QUERY | MFX_VARIANT_TYPE_U32)
+    { "mfxImplDescription",                                                           ePropQuery_ImplOnly },
+    { "mfxImplDescription.mfxDecoderDescription",                                     ePropQuery_AllDec },
+    { "mfxImplDescription.mfxEncoderDescription",                                     ePropQuery_AllEnc },
+    { "mfxImplDescription.mfxVPPDescription",                                         ePropQuery_AllVPP },
+#endif
 
-    // parse 'decprofile'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "Profile") {
-        return ValidateAndSetProp(ePropDec_Profile, value);
-    }
-    else if (nextProp != "decmemdesc") {
-        return MFX_ERR_NOT_FOUND;
-    }
+    // top-level members of mfxImplDescription
+    { "mfxImplDescription.Impl",                                                      ePropMain_Impl },
+    { "mfxImplDescription.AccelerationMode",                                          ePropMain_AccelerationMode },
+    { "mfxImplDescription.mfxSurfacePoolMode",                                        ePropMain_PoolAllocationPolicy },
+    { "mfxImplDescription.ApiVersion.Version",                                        ePropMain_ApiVersion },
+    { "mfxImplDescription.ApiVersion.Major",                                          ePropMain_ApiVersion_Major },
+    { "mfxImplDescription.ApiVersion.Minor",                                          ePropMain_ApiVersion_Minor },
+    { "mfxImplDescription.VendorID",                                                  ePropMain_VendorID },
+    { "mfxImplDescription.ImplName",                                                  ePropMain_ImplName },
+    { "mfxImplDescription.License",                                                   ePropMain_License },
+    { "mfxImplDescription.Keywords",                                                  ePropMain_Keywords },
+    { "mfxImplDescription.VendorImplID",                                              ePropMain_VendorImplID },
+
+    // mfxDeviceDescription - old version of table in spec had extra "device"
+    // DeviceID may also be passed as a string, see SetFilterProperty()
+    { "mfxImplDescription.mfxDeviceDescription.DeviceID",                             ePropDevice_DeviceID },
+    { "mfxImplDescription.mfxDeviceDescription.device.DeviceID",                      ePropDevice_DeviceID },
+    { "mfxImplDescription.mfxDeviceDescription.MediaAdapterType",                     ePropDevice_MediaAdapterType },
+    { "mfxImplDescription.mfxDeviceDescription.device.MediaAdapterType",              ePropDevice_MediaAdapterType },
+
+    // mfxDecoderDescription
+    { "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",                     ePropDec_CodecID },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.MaxcodecLevel",               ePropDec_MaxcodecLevel },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.Profile",          ePropDec_Profile },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.MemHandleType", ePropDec_MemHandleType },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.Width", ePropDec_Width },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.Height", ePropDec_Height },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.ColorFormat", ePropDec_ColorFormats },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.ColorFormats", ePropDec_ColorFormats },
+
+    // mfxEncoderDescription
+    { "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",                     ePropEnc_CodecID },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.MaxcodecLevel",               ePropEnc_MaxcodecLevel },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.BiDirectionalPrediction",     ePropEnc_BiDirectionalPrediction },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.Profile",          ePropEnc_Profile },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.MemHandleType", ePropEnc_MemHandleType },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.Width", ePropEnc_Width },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.Height", ePropEnc_Height },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.ColorFormat", ePropEnc_ColorFormats },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.ColorFormats", ePropEnc_ColorFormats },
+
+    // mfxVPPDescription
+    { "mfxImplDescription.mfxVPPDescription.filter.FilterFourCC",                     ePropVPP_FilterFourCC },
+    { "mfxImplDescription.mfxVPPDescription.filter.MaxDelayInFrames",                 ePropVPP_MaxDelayInFrames },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.MemHandleType",            ePropVPP_MemHandleType },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.Width",                    ePropVPP_Width },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.Height",                   ePropVPP_Height },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.InFormat",          ePropVPP_InFormat },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.OutFormat",         ePropVPP_OutFormat },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.OutFormats",        ePropVPP_OutFormat },
+};
 
-    // parse 'decmemdesc'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "MemHandleType") {
-        return ValidateAndSetProp(ePropDec_MemHandleType, value);
-    }
-    else if (nextProp == "Width") {
-        return ValidateAndSetProp(ePropDec_Width, value);
-    }
-    else if (nextProp == "Height") {
-        return ValidateAndSetProp(ePropDec_Height, value);
-    }
-    else if (nextProp == "ColorFormat" || nextProp == "ColorFormats") {
-        return ValidateAndSetProp(ePropDec_ColorFormats, value);
-    }
+// end table formatting
+// clang-format on
 
-    // end of mfxDecoderDescription options
-    return MFX_ERR_NOT_FOUND;
-}
+#define NUM_PROP_NAMES (sizeof(PropNameTab) / sizeof(PropName))
 
-mfxStatus ConfigCtxVPL::SetFilterPropertyEnc(std::list<std::string> &propParsedString,
-                                             mfxVariant value) {
-    std::string nextProp;
+// open-addressed hash table over PropNameTab, must be a power of 2
+// keep at least half of the slots empty so that probe sequences stay short
+#define PROP_NAME_HASH_SIZE 256
 
-    nextProp = GetNextProp(propParsedString);
+static_assert(PROP_NAME_HASH_SIZE >= 2 * NUM_PROP_NAMES,
+              "PROP_NAME_HASH_SIZE is too small for PropNameTab");
 
-#ifdef ONEVPL_EXPERIMENTAL
-    // empty string indicates property-based query for all encoders
-    // for this case Type should be (MFX_VARIANT_TYPE_QUERY | MFX_VARIANT_TYPE_U32) and Data should be 0
-    if (nextProp == "") {
-        return ValidateAndSetProp(ePropQuery_AllEnc, value);
+// FNV-1a
+static mfxU32 HashPropName(const char *name, size_t len) {
+    mfxU32 hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (mfxU8)name[i];
+        hash *= 16777619u;
     }
-#endif
+    return hash;
+}
 
-    // no settable top-level members
-    if (nextProp != "encoder")
-        return MFX_ERR_NOT_FOUND;
+struct PropNameHashTab {
+    struct Slot {
+        mfxI32 nameIdx; // index into PropNameTab, -1 = empty
+        mfxU32 hash;
+        size_t len;
+    };
 
-    // parse 'encoder'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "CodecID") {
-        return ValidateAndSetProp(ePropEnc_CodecID, value);
-    }
-    else if (nextProp == "MaxcodecLevel") {
-        return ValidateAndSetProp(ePropEnc_MaxcodecLevel, value);
-    }
-    else if (nextProp == "BiDirectionalPrediction") {
-        return ValidateAndSetProp(ePropEnc_BiDirectionalPrediction, value);
-    }
-    else if (nextProp != "encprofile") {
-        return MFX_ERR_NOT_FOUND;
-    }
+    Slot slots[PROP_NAME_HASH_SIZE];
 
-    // parse 'encprofile'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "Profile") {
-        return ValidateAndSetProp(ePropEnc_Profile, value);
-    }
-    else if (nextProp != "encmemdesc") {
-        return MFX_ERR_NOT_FOUND;
-    }
+    PropNameHashTab() {
+        for (mfxU32 i = 0; i < PROP_NAME_HASH_SIZE; i++)
+            slots[i].nameIdx = -1;
 
-    // parse 'encmemdesc'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "MemHandleType") {
-        return ValidateAndSetProp(ePropEnc_MemHandleType, value);
-    }
-    else if (nextProp == "Width") {
-        return ValidateAndSetProp(ePropEnc_Width, value);
-    }
-    else if (nextProp == "Height") {
-        return ValidateAndSetProp(ePropEnc_Height, value);
-    }
-    else if (nextProp == "ColorFormat" || nextProp == "ColorFormats") {
-        return ValidateAndSetProp(ePropEnc_ColorFormats, value);
-    }
+        for (mfxU32 nameIdx = 0; nameIdx < NUM_PROP_NAMES; nameIdx++) {
+            size_t len  = strlen(PropNameTab[nameIdx].Name);
+            mfxU32 hash = HashPropName(PropNameTab[nameIdx].Name, len);
 
-    // end of mfxEncoderDescription options
-    return MFX_ERR_NOT_FOUND;
-}
+            mfxU32 i = hash & (PROP_NAME_HASH_SIZE - 1);
+            while (slots[i].nameIdx >= 0)
+                i = (i + 1) & (PROP_NAME_HASH_SIZE - 1);
 
-mfxStatus ConfigCtxVPL::SetFilterPropertyVPP(std::list<std::string> &propParsedString,
-                                             mfxVariant value) {
-    std::string nextProp;
+            slots[i].nameIdx = (mfxI32)nameIdx;
+            slots[i].hash    = hash;
+            slots[i].len     = len;
+        }
+    }
+};
 
-    nextProp = GetNextProp(propParsedString);
+// return PropIdx for the first len characters of name, or -1 if not in PropNameTab
+static mfxI32 LookupPropName(const char *name, size_t len) {
+    // built on first use (thread-safe), then read-only
+    static const PropNameHashTab hashTab;
 
-#ifdef ONEVPL_EXPERIMENTAL
-    // empty string indicates property-based query for all VPP filters
-    // for this case Type should be (MFX_VARIANT_TYPE_QUERY | MFX_VARIANT_TYPE_U32) and Data should be 0
-    if (nextProp == "") {
-        return ValidateAndSetProp(ePropQuery_AllVPP, value);
-    }
-#endif
+    mfxU32 hash = HashPropName(name, len);
 
-    // no settable top-level members
-    if (nextProp != "filter")
-        return MFX_ERR_NOT_FOUND;
+    mfxU32 i = hash & (PROP_NAME_HASH_SIZE - 1);
+    while (hashTab.slots[i].nameIdx >= 0) {
+        const PropNameHashTab::Slot &slot = hashTab.slots[i];
+        if (slot.hash == hash && slot.len == len &&
+            !strncmp(PropNameTab[slot.nameIdx].Name, name, len))
+            return PropNameTab[slot.nameIdx].Idx;
 
-    // parse 'filter'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "FilterFourCC") {
-        return ValidateAndSetProp(ePropVPP_FilterFourCC, value);
-    }
-    else if (nextProp == "MaxDelayInFrames") {
-        return ValidateAndSetProp(ePropVPP_MaxDelayInFrames, value);
-    }
-    else if (nextProp != "memdesc") {
-        return MFX_ERR_NOT_FOUND;
+        i = (i + 1) & (PROP_NAME_HASH_SIZE - 1);
     }
 
-    // parse 'memdesc'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "MemHandleType") {
-        return ValidateAndSetProp(ePropVPP_MemHandleType, value);
-    }
-    else if (nextProp == "Width") {
-        return ValidateAndSetProp(ePropVPP_Width, value);
-    }
-    else if (nextProp == "Height") {
-        return ValidateAndSetProp(ePropVPP_Height, value);
-    }
-    else if (nextProp != "format") {
-        return MFX_ERR_NOT_FOUND;
-    }
+    return -1;
+}
 
-    // parse 'format'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "InFormat") {
-        return ValidateAndSetProp(ePropVPP_InFormat, value);
-    }
-    else if (nextProp == "OutFormat" || nextProp == "OutFormats") {
-        return ValidateAndSetProp(ePropVPP_OutFormat, value);
+// return PropIdx for the full property name, or -1 if name is unknown
+// does not allocate, so configs can be set up cheaply
+static mfxI32 FindPropIdx(const char *name) {
+    // a single trailing '.' has always been accepted, so ignore it
+    size_t len = strlen(name);
+    if (len > 0 && name[len - 1] == '.')
+        len--;
+
+    mfxI32 idx = LookupPropName(name, len);
+    if (idx >= 0)
+        return idx;
+
+    // for compatibility, extra trailing components after the name of a property are ignored
+    //   (e.g. "mfxImplDescription.Impl.Foo" sets mfxImplDescription.Impl)
+    // property-based query names must match exactly, since they are prefixes of other names
+    while (len > 0) {
+        // drop the last component
+        while (len > 0 && name[len - 1] != '.')
+            len--;
+        if (len == 0)
+            break;
+
+        len--;
+        idx = LookupPropName(name, len);
+        if (idx >= 0) {
+#ifdef ONEVPL_EXPERIMENTAL
+            if (idx >= ePropQuery_ImplOnly && idx <= ePropQuery_AllVPP)
+                return -1;
+#endif
+            return idx;
+        }
     }
 
-    // end of mfxVPPDescription options
-    return MFX_ERR_NOT_FOUND;
+    return -1;
 }
 
-mfxStatus ConfigCtxVPL::SetFilterPropertySurface(std::list<std::string> &propParsedString,
-                                                 mfxVariant value) {
-    std::string nextProp;
+#ifdef ONEVPL_EXPERIMENTAL
+struct PropId {
+    mfxU32 Id;
+    const char *Name;
+};
 
-    nextProp = GetNextProp(propParsedString);
+// public property IDs for MFXSetConfigFilterPropertyById(), generated from the same list as
+//   mfxConfigPropertyId so the two cannot get out of sync
+#define PROP_ID_ENTRY(id, value, name) { id, name },
 
-    // no settable top-level members
-    if (nextProp != "surftype")
-        return MFX_ERR_NOT_FOUND;
+static constexpr PropId PropIdTab[] = { MFX_CFG_PROP_LIST(PROP_ID_ENTRY) };
 
-    // parse 'surftype'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "SurfaceType") {
-        return ValidateAndSetProp(ePropSurface_SurfaceType, value);
-    }
-    else if (nextProp != "surfcomp") {
-        return MFX_ERR_NOT_FOUND;
-    }
+#undef PROP_ID_ENTRY
 
-    // parse 'surfcomp'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "SurfaceComponent") {
-        return ValidateAndSetProp(ePropSurface_SurfaceComponent, value);
-    }
-    else if (nextProp == "SurfaceFlags") {
-        return ValidateAndSetProp(ePropSurface_SurfaceFlags, value);
-    }
+#define NUM_PROP_IDS (sizeof(PropIdTab) / sizeof(PropId))
 
-    // end of mfxSurfaceTypesSupported options
-    return MFX_ERR_NOT_FOUND;
+// values in the list must be 0, 1, 2, ... so the table can be indexed by ID
+static constexpr bool IsPropIdTabAligned(size_t i) {
+    return (i == NUM_PROP_IDS) || (PropIdTab[i].Id == i && IsPropIdTabAligned(i + 1));
 }
 
+static_assert(IsPropIdTabAligned(0), "mfxConfigPropertyId values are not consecutive");
+
+struct PropIdIdxTab {
+    mfxI32 idx[NUM_PROP_IDS];
+
+    // PropIdx of each ID, -1 if the name is not settable on this platform (e.g. DXGIAdapterIndex)
+    PropIdIdxTab() {
+        for (mfxU32 i = 0; i < NUM_PROP_IDS; i++)
+            idx[i] = LookupPropName(PropIdTab[i].Name, strlen(PropIdTab[i].Name));
+    }
+};
+#endif
+
 // return codes (from spec):
 //   MFX_ERR_NOT_FOUND - name contains unknown parameter name
 //   MFX_ERR_UNSUPPORTED - value data type != parameter with provided name
@@ -632,200 +817,37 @@ mfxStatus ConfigCtxVPL::SetFilterProperty(const mfxU8 *name, mfxVariant value) {
     if (!name)
         return MFX_ERR_NULL_PTR;
 
-    std::list<std::string> propParsedString;
-
-    // parse property string into individual properties,
-    //   separated by '.'
-    std::stringstream prop((char *)name);
-    std::string s;
-    propParsedString.clear();
-    while (getline(prop, s, '.')) {
-        propParsedString.push_back(s);
-    }
-
-    // get first property descriptor
-    std::string nextProp = GetNextProp(propParsedString);
-
-    // check for special-case properties, not part of mfxImplDescription
-    if (nextProp == "mfxHandleType") {
-        return ValidateAndSetProp(ePropSpecial_HandleType, value);
-    }
-    else if (nextProp == "mfxHDL") {
-        return ValidateAndSetProp(ePropSpecial_Handle, value);
-    }
-    else if (nextProp == "NumThread") {
-        return ValidateAndSetProp(ePropSpecial_NumThread, value);
-    }
-#ifdef ONEVPL_EXPERIMENTAL
-    else if (nextProp == "DeviceCopy") {
-        return ValidateAndSetProp(ePropSpecial_DeviceCopy, value);
-    }
-#endif
-    else if (nextProp == "ExtBuffer") {
-        return ValidateAndSetProp(ePropSpecial_ExtBuffer, value);
-    }
-    else if (nextProp == "DXGIAdapterIndex") {
-#if defined(_WIN32) || defined(_WIN64)
-        // this property is only valid on Windows
-        return ValidateAndSetProp(ePropSpecial_DXGIAdapterIndex, value);
-#else
+    mfxI32 idx = FindPropIdx((const char *)name);
+    if (idx < 0)
         return MFX_ERR_NOT_FOUND;
-#endif
-    }
 
-    // to require that a specific function is implemented, use the property name
-    //   "mfxImplementedFunctions.FunctionsName"
-    if (nextProp == "mfxImplementedFunctions") {
-        nextProp = GetNextProp(propParsedString);
-        if (nextProp == "FunctionsName") {
-            return ValidateAndSetProp(ePropFunc_FunctionName, value);
-        }
-        return MFX_ERR_NOT_FOUND;
-    }
+    // special case - deviceID may be passed as U16 (default) or string (since API 2.4)
+    // for compatibility, both are supported (value.Type distinguishes between them)
+    if (idx == ePropDevice_DeviceID && value.Type == MFX_VARIANT_TYPE_PTR)
+        idx = ePropDevice_DeviceIDStr;
 
-    // extended device ID properties must begin with mfxExtendedDeviceId
-    if (nextProp == "mfxExtendedDeviceId") {
-        nextProp = GetNextProp(propParsedString);
-        if (nextProp == "VendorID") {
-            return ValidateAndSetProp(ePropExtDev_VendorID, value);
-        }
-        else if (nextProp == "DeviceID") {
-            return ValidateAndSetProp(ePropExtDev_DeviceID, value);
-        }
-        else if (nextProp == "PCIDomain") {
-            return ValidateAndSetProp(ePropExtDev_PCIDomain, value);
-        }
-        else if (nextProp == "PCIBus") {
-            return ValidateAndSetProp(ePropExtDev_PCIBus, value);
-        }
-        else if (nextProp == "PCIDevice") {
-            return ValidateAndSetProp(ePropExtDev_PCIDevice, value);
-        }
-        else if (nextProp == "PCIFunction") {
-            return ValidateAndSetProp(ePropExtDev_PCIFunction, value);
-        }
-        else if (nextProp == "DeviceLUID") {
-            return ValidateAndSetProp(ePropExtDev_DeviceLUID, value);
-        }
-        else if (nextProp == "LUIDDeviceNodeMask") {
-            return ValidateAndSetProp(ePropExtDev_LUIDDeviceNodeMask, value);
-        }
-        else if (nextProp == "DRMRenderNodeNum") {
-            return ValidateAndSetProp(ePropExtDev_DRMRenderNodeNum, value);
-        }
-        else if (nextProp == "DRMPrimaryNodeNum") {
-            return ValidateAndSetProp(ePropExtDev_DRMPrimaryNodeNum, value);
-        }
-        else if (nextProp == "RevisionID") {
-            return ValidateAndSetProp(ePropExtDev_RevisionID, value);
-        }
-        else if (nextProp == "DeviceName") {
-            return ValidateAndSetProp(ePropExtDev_DeviceName, value);
-        }
-        return MFX_ERR_NOT_FOUND;
-    }
+    return ValidateAndSetProp(idx, value);
+}
 
 #ifdef ONEVPL_EXPERIMENTAL
-    // property is a member of mfxSurfaceTypesSupported
-    if (nextProp == "mfxSurfaceTypesSupported") {
-        return SetFilterPropertySurface(propParsedString, value);
-    }
-#endif
+// same as SetFilterProperty(), with property looked up by mfxConfigPropertyId
+mfxStatus ConfigCtxVPL::SetFilterPropertyById(mfxU32 propId, mfxVariant value) {
+    // built on first use (thread-safe), then read-only
+    static const PropIdIdxTab idxTab;
 
-    // standard properties must begin with "mfxImplDescription"
-    if (nextProp != "mfxImplDescription") {
+    if (propId >= NUM_PROP_IDS)
         return MFX_ERR_NOT_FOUND;
-    }
-
-    // get next property descriptor
-    nextProp = GetNextProp(propParsedString);
-
-#ifdef ONEVPL_EXPERIMENTAL
-    // empty string indicates property-based query for implOnly info (shallow query)
-    // for this case Type should be (MFX_VARIANT_TYPE_QUERY | MFX_VARIANT_TYPE_U32) and Data should be 0
-    if (nextProp == "") {
-        return ValidateAndSetProp(ePropQuery_ImplOnly, value);
-    }
-#endif
-
-    // property is a top-level member of mfxImplDescription
-    if (nextProp == "Impl") {
-        return ValidateAndSetProp(ePropMain_Impl, value);
-    }
-    else if (nextProp == "AccelerationMode") {
-        return ValidateAndSetProp(ePropMain_AccelerationMode, value);
-    }
-    else if (nextProp == "mfxSurfacePoolMode") {
-        return ValidateAndSetProp(ePropMain_PoolAllocationPolicy, value);
-    }
-    else if (nextProp == "ApiVersion") {
-        // ApiVersion may be passed as single U32 (Version) or two U16's (Major, Minor)
-        nextProp = GetNextProp(propParsedString);
-        if (nextProp == "Version")
-            return ValidateAndSetProp(ePropMain_ApiVersion, value);
-        else if (nextProp == "Major")
-            return ValidateAndSetProp(ePropMain_ApiVersion_Major, value);
-        else if (nextProp == "Minor")
-            return ValidateAndSetProp(ePropMain_ApiVersion_Minor, value);
-        else
-            return MFX_ERR_NOT_FOUND;
-    }
-    else if (nextProp == "VendorID") {
-        return ValidateAndSetProp(ePropMain_VendorID, value);
-    }
-    else if (nextProp == "ImplName") {
-        return ValidateAndSetProp(ePropMain_ImplName, value);
-    }
-    else if (nextProp == "License") {
-        return ValidateAndSetProp(ePropMain_License, value);
-    }
-    else if (nextProp == "Keywords") {
-        return ValidateAndSetProp(ePropMain_Keywords, value);
-    }
-    else if (nextProp == "VendorImplID") {
-        return ValidateAndSetProp(ePropMain_VendorImplID, value);
-    }
-
-    // property is a member of mfxDeviceDescription
-    if (nextProp == "mfxDeviceDescription") {
-        nextProp = GetNextProp(propParsedString);
-        // old version of table in spec had extra "device", just skip if present
-        if (nextProp == "device")
-            nextProp = GetNextProp(propParsedString);
-
-        // special case - deviceID may be passed as U16 (default) or string (since API 2.4)
-        // for compatibility, both are supported (value.Type distinguishes between them)
-        if (nextProp == "DeviceID") {
-            if (value.Type == MFX_VARIANT_TYPE_PTR)
-                return ValidateAndSetProp(ePropDevice_DeviceIDStr, value);
-            else
-                return ValidateAndSetProp(ePropDevice_DeviceID, value);
-        }
-
-        if (nextProp == "MediaAdapterType") {
-            return ValidateAndSetProp(ePropDevice_MediaAdapterType, value);
-        }
 
+    mfxI32 idx = idxTab.idx[propId];
+    if (idx < 0)
         return MFX_ERR_NOT_FOUND;
-    }
 
-    // property is a member of mfxDecoderDescription
-    if (nextProp == "mfxDecoderDescription") {
-        return SetFilterPropertyDec(propParsedString, value);
-    }
+    if (idx == ePropDevice_DeviceID && value.Type == MFX_VARIANT_TYPE_PTR)
+        idx = ePropDevice_DeviceIDStr;
 
-    // property is a member of mfxEncoderDescription
-    if (nextProp == "mfxEncoderDescription") {
-        return SetFilterPropertyEnc(propParsedString, value);
-    }
-
-    // property is a member of mfxVPPDescription
-    if (nextProp == "mfxVPPDescription") {
-        return SetFilterPropertyVPP(propParsedString, value);
-    }
-
-    return MFX_ERR_NOT_FOUND;
+    return ValidateAndSetProp(idx, value);
 }
+#endif
 
 #define CHECK_IDX(idxA, idxB, numB) \
     if ((idxB) == (numB)) {         \
@@ -834,8 +856,8 @@ mfxStatus ConfigCtxVPL::SetFilterProperty(const mfxU8 *name, mfxVariant value) {
         continue;                   \
     }
 
-mfxStatus ConfigCtxVPL::GetFlatDescriptionsDec(const mfxImplDescription *libImplDesc,
-                                               std::list<DecConfig> &decConfigList) {
+void ConfigCtxVPL::GetFlatDescriptionsDec(const mfxImplDescription *libImplDesc,
+                                          DecCapsTable &decTable) {
     mfxU32 codecIdx   = 0;
     mfxU32 profileIdx = 0;
     mfxU32 memIdx     = 0;
@@ -846,38 +868,30 @@ mfxStatus ConfigCtxVPL::GetFlatDescriptionsDec(const mfxImplDescription *libImpl
     DecMemDesc *decMemDesc = nullptr;
 
     while (codecIdx < libImplDesc->Dec.NumCodecs) {
-        DecConfig dc = {};
-
-        decCodec         = &(libImplDesc->Dec.Codecs[codecIdx]);
-        dc.CodecID       = decCodec->CodecID;
-        dc.MaxcodecLevel = decCodec->MaxcodecLevel;
+        decCodec = &(libImplDesc->Dec.Codecs[codecIdx]);
         CHECK_IDX(codecIdx, profileIdx, decCodec->NumProfiles);
 
         decProfile = &(decCodec->Profiles[profileIdx]);
-        dc.Profile = decProfile->Profile;
         CHECK_IDX(profileIdx, memIdx, decProfile->NumMemTypes);
 
-        decMemDesc       = &(decProfile->MemDesc[memIdx]);
-        dc.MemHandleType = decMemDesc->MemHandleType;
-        dc.Width         = decMemDesc->Width;
-        dc.Height        = decMemDesc->Height;
+        decMemDesc = &(decProfile->MemDesc[memIdx]);
         CHECK_IDX(memIdx, outFmtIdx, decMemDesc->NumColorFormats);
 
-        dc.ColorFormat = decMemDesc->ColorFormats[outFmtIdx];
-        outFmtIdx++;
+        // we have a valid, unique description - add row to table
+        decTable.CodecID.push_back(decCodec->CodecID);
+        decTable.MaxcodecLevel.push_back(decCodec->MaxcodecLevel);
+        decTable.Profile.push_back(decProfile->Profile);
+        decTable.MemHandleType.push_back(decMemDesc->MemHandleType);
+        decTable.Width.push_back(decMemDesc->Width);
+        decTable.Height.push_back(decMemDesc->Height);
+        decTable.ColorFormat.push_back(decMemDesc->ColorFormats[outFmtIdx]);
 
-        // we have a valid, unique description - add to list
-        decConfigList.push_back(dc);
+        outFmtIdx++;
     }
-
-    if (decConfigList.empty())
-        return MFX_ERR_INVALID_VIDEO_PARAM;
-
-    return MFX_ERR_NONE;
 }
 
-mfxStatus ConfigCtxVPL::GetFlatDescriptionsEnc(const mfxImplDescription *libImplDesc,
-                                               std::list<EncConfig> &encConfigList) {
+void ConfigCtxVPL::GetFlatDescriptionsEnc(const mfxImplDescription *libImplDesc,
+                                          EncCapsTable &encTable) {
     mfxU32 codecIdx   = 0;
     mfxU32 profileIdx = 0;
     mfxU32 memIdx     = 0;
@@ -888,40 +902,31 @@ mfxStatus ConfigCtxVPL::GetFlatDescriptionsEnc(const mfxImplDescription *libImpl
     EncMemDesc *encMemDesc = nullptr;
 
     while (codecIdx < libImplDesc->Enc.NumCodecs) {
-        EncConfig ec = {};
-
-        encCodec                   = &(libImplDesc->Enc.Codecs[codecIdx]);
-        ec.CodecID                 = encCodec->CodecID;
-        ec.MaxcodecLevel           = encCodec->MaxcodecLevel;
-        ec.BiDirectionalPrediction = encCodec->BiDirectionalPrediction;
-
+        encCodec = &(libImplDesc->Enc.Codecs[codecIdx]);
         CHECK_IDX(codecIdx, profileIdx, encCodec->NumProfiles);
 
         encProfile = &(encCodec->Profiles[profileIdx]);
-        ec.Profile = encProfile->Profile;
         CHECK_IDX(profileIdx, memIdx, encProfile->NumMemTypes);
 
-        encMemDesc       = &(encProfile->MemDesc[memIdx]);
-        ec.MemHandleType = encMemDesc->MemHandleType;
-        ec.Width         = encMemDesc->Width;
-        ec.Height        = encMemDesc->Height;
+        encMemDesc = &(encProfile->MemDesc[memIdx]);
         CHECK_IDX(memIdx, inFmtIdx, encMemDesc->NumColorFormats);
 
-        ec.ColorFormat = encMemDesc->ColorFormats[inFmtIdx];
-        inFmtIdx++;
+        // we have a valid, unique description - add row to table
+        encTable.CodecID.push_back(encCodec->CodecID);
+        encTable.MaxcodecLevel.push_back(encCodec->MaxcodecLevel);
+        encTable.BiDirectionalPrediction.push_back(encCodec->BiDirectionalPrediction);
+        encTable.Profile.push_back(encProfile->Profile);
+        encTable.MemHandleType.push_back(encMemDesc->MemHandleType);
+        encTable.Width.push_back(encMemDesc->Width);
+        encTable.Height.push_back(encMemDesc->Height);
+        encTable.ColorFormat.push_back(encMemDesc->ColorFormats[inFmtIdx]);
 
-        // we have a valid, unique description - add to list
-        encConfigList.push_back(ec);
+        inFmtIdx++;
     }
-
-    if (encConfigList.empty())
-        return MFX_ERR_INVALID_VIDEO_PARAM;
-
-    return MFX_ERR_NONE;
 }
 
-mfxStatus ConfigCtxVPL::GetFlatDescriptionsVPP(const mfxImplDescription *libImplDesc,
-                                               std::list<VPPConfig> &vppConfigList) {
+void ConfigCtxVPL::GetFlatDescriptionsVPP(const mfxImplDescription *libImplDesc,
+                                          VPPCapsTable &vppTable) {
     mfxU32 filterIdx = 0;
     mfxU32 memIdx    = 0;
     mfxU32 inFmtIdx  = 0;
@@ -932,43 +937,33 @@ mfxStatus ConfigCtxVPL::GetFlatDescriptionsVPP(const mfxImplDescription *libImpl
     VPPFormat *vppFormat   = nullptr;
 
     while (filterIdx < libImplDesc->VPP.NumFilters) {
-        VPPConfig vc = {};
-
-        vppFilter           = &(libImplDesc->VPP.Filters[filterIdx]);
-        vc.FilterFourCC     = vppFilter->FilterFourCC;
-        vc.MaxDelayInFrames = vppFilter->MaxDelayInFrames;
+        vppFilter = &(libImplDesc->VPP.Filters[filterIdx]);
         CHECK_IDX(filterIdx, memIdx, vppFilter->NumMemTypes);
 
-        vppMemDesc       = &(vppFilter->MemDesc[memIdx]);
-        vc.MemHandleType = vppMemDesc->MemHandleType;
-        vc.Width         = vppMemDesc->Width;
-        vc.Height        = vppMemDesc->Height;
+        vppMemDesc = &(vppFilter->MemDesc[memIdx]);
         CHECK_IDX(memIdx, inFmtIdx, vppMemDesc->NumInFormats);
 
-        vppFormat   = &(vppMemDesc->Formats[inFmtIdx]);
-        vc.InFormat = vppFormat->InFormat;
+        vppFormat = &(vppMemDesc->Formats[inFmtIdx]);
         CHECK_IDX(inFmtIdx, outFmtIdx, vppFormat->NumOutFormat);
 
-        vc.OutFormat = vppFormat->OutFormats[outFmtIdx];
-        outFmtIdx++;
+        // we have a valid, unique description - add row to table
+        vppTable.FilterFourCC.push_back(vppFilter->FilterFourCC);
+        vppTable.MaxDelayInFrames.push_back(vppFilter->MaxDelayInFrames);
+        vppTable.MemHandleType.push_back(vppMemDesc->MemHandleType);
+        vppTable.Width.push_back(vppMemDesc->Width);
+        vppTable.Height.push_back(vppMemDesc->Height);
+        vppTable.InFormat.push_back(vppFormat->InFormat);
+        vppTable.OutFormat.push_back(vppFormat->OutFormats[outFmtIdx]);
 
-        // we have a valid, unique description - add to list
-        vppConfigList.push_back(vc);
+        outFmtIdx++;
     }
-
-    if (vppConfigList.empty())
-        return MFX_ERR_INVALID_VIDEO_PARAM;
-
-    return MFX_ERR_NONE;
 }
 
 #ifdef ONEVPL_EXPERIMENTAL
-mfxStatus ConfigCtxVPL::GetFlatDescriptionsSurface(const mfxSurfaceTypesSupported *libSurfaceTypes,
-                                                   std::list<SurfaceConfig> &surfaceConfigList) {
-    if (!libSurfaceTypes) {
-        surfaceConfigList.clear();
-        return MFX_ERR_INVALID_VIDEO_PARAM;
-    }
+void ConfigCtxVPL::GetFlatDescriptionsSurface(const mfxSurfaceTypesSupported *libSurfaceTypes,
+                                              SurfaceCapsTable &surfaceTable) {
+    if (!libSurfaceTypes)
+        return;
 
     mfxU32 typeIdx = 0;
     mfxU32 compIdx = 0;
@@ -977,32 +972,69 @@ mfxStatus ConfigCtxVPL::GetFlatDescriptionsSurface(const mfxSurfaceTypesSupporte
     mfxSurfaceTypesSupported::surftype::surfcomp *surfaceComp = nullptr;
 
     while (typeIdx < libSurfaceTypes->NumSurfaceTypes) {
-        SurfaceConfig sc = {};
-
-        surfaceType    = &(libSurfaceTypes->SurfaceTypes[typeIdx]);
-        sc.SurfaceType = surfaceType->SurfaceType;
+        surfaceType = &(libSurfaceTypes->SurfaceTypes[typeIdx]);
         CHECK_IDX(typeIdx, compIdx, surfaceType->NumSurfaceComponents);
 
-        surfaceComp         = &(surfaceType->SurfaceComponents[compIdx]);
-        sc.SurfaceComponent = surfaceComp->SurfaceComponent;
-        sc.SurfaceFlags     = surfaceComp->SurfaceFlags;
+        surfaceComp = &(surfaceType->SurfaceComponents[compIdx]);
+
+        // we have a valid, unique description - add row to table
+        surfaceTable.SurfaceType.push_back(surfaceType->SurfaceType);
+        surfaceTable.SurfaceComponent.push_back(surfaceComp->SurfaceComponent);
+        surfaceTable.SurfaceFlags.push_back(surfaceComp->SurfaceFlags);
 
         compIdx++;
+    }
+}
+#endif
 
-        // we have a valid, unique description - add to list
-        surfaceConfigList.push_back(sc);
+void ConfigCtxVPL::BuildCapsIndex(const mfxImplDescription *libImplDesc,
+#ifdef ONEVPL_EXPERIMENTAL
+                                  const mfxSurfaceTypesSupported *libImplSurfTypes,
+#endif
+                                  ImplCapsIndex &capsIndex) {
+    capsIndex = ImplCapsIndex();
+
+    if (libImplDesc) {
+        GetFlatDescriptionsDec(libImplDesc, capsIndex.dec);
+        GetFlatDescriptionsEnc(libImplDesc, capsIndex.enc);
+        GetFlatDescriptionsVPP(libImplDesc, capsIndex.vpp);
     }
 
-    if (surfaceConfigList.empty())
-        return MFX_ERR_INVALID_VIDEO_PARAM;
+#ifdef ONEVPL_EXPERIMENTAL
+    GetFlatDescriptionsSurface(libImplSurfTypes, capsIndex.surface);
+    capsIndex.srcImplSurfTypes = libImplSurfTypes;
+#endif
 
-    return MFX_ERR_NONE;
+    capsIndex.srcImplDesc = libImplDesc;
+    capsIndex.bBuilt      = true;
 }
+
+// return true if val is accepted by an integer filter prop (U16 or U32)
+// the prop may hold a single value, or a set or range of accepted values
+static bool MatchPropValue(const mfxVariant &prop, mfxU32 val) {
+#ifdef ONEVPL_EXPERIMENTAL
+    if (prop.Type & MFX_VARIANT_TYPE_SET) {
+        const std::vector<mfxU32> *values = (const std::vector<mfxU32> *)(prop.Data.Ptr);
+        return std::binary_search(values->begin(), values->end(), val);
+    }
+
+    if (prop.Type & MFX_VARIANT_TYPE_RANGE) {
+        const mfxRange32U *range = (const mfxRange32U *)(prop.Data.Ptr);
+        if (val < range->Min || val > range->Max)
+            return false;
+        return (range->Step <= 1) || ((val - range->Min) % range->Step == 0);
+    }
 #endif
 
-#define CHECK_PROP(idx, type, val)                             \
+    if (prop.Type == MFX_VARIANT_TYPE_U16)
+        return (val == prop.Data.U16);
+
+    return (val == prop.Data.U32);
+}
+
+#define CHECK_PROP(idx, val)                                   \
     if ((cfgPropsAll[(idx)].Type != MFX_VARIANT_TYPE_UNSET) && \
-        (cfgPropsAll[(idx)].Data.type != val))                 \
+        !MatchPropValue(cfgPropsAll[(idx)], (val)))            \
         isCompatible = false;
 
 mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
@@ -1011,9 +1043,9 @@ mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
 
     // check if this implementation includes
     //   all of the required top-level properties
-    CHECK_PROP(ePropMain_Impl, U32, libImplDesc->Impl);
-    CHECK_PROP(ePropMain_VendorID, U32, libImplDesc->VendorID);
-    CHECK_PROP(ePropMain_VendorImplID, U32, libImplDesc->VendorImplID);
+    CHECK_PROP(ePropMain_Impl, libImplDesc->Impl);
+    CHECK_PROP(ePropMain_VendorID, libImplDesc->VendorID);
+    CHECK_PROP(ePropMain_VendorImplID, libImplDesc->VendorImplID);
 
     // check API version in calling function since major and minor may be passed
     //   in separate cfg objects
@@ -1033,7 +1065,7 @@ mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
     }
     else {
         // check default mode
-        CHECK_PROP(ePropMain_AccelerationMode, U32, libImplDesc->AccelerationMode);
+        CHECK_PROP(ePropMain_AccelerationMode, libImplDesc->AccelerationMode);
     }
 
     if (cfgPropsAll[ePropMain_PoolAllocationPolicy].Type != MFX_VARIANT_TYPE_UNSET) {
@@ -1091,8 +1123,7 @@ mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
             return MFX_ERR_UNSUPPORTED;
         }
 
-        unsigned int filtDeviceID = (unsigned int)(cfgPropsAll[ePropDevice_DeviceID].Data.U16);
-        if (implDeviceID != filtDeviceID)
+        if (!MatchPropValue(cfgPropsAll[ePropDevice_DeviceID], implDeviceID))
             isCompatible = false;
     }
 
@@ -1111,7 +1142,7 @@ mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
             if (libImplDesc->Dev.Version.Version < MFX_STRUCT_VERSION(1, 1))
                 isCompatible = false;
 
-            CHECK_PROP(ePropDevice_MediaAdapterType, U16, libImplDesc->Dev.MediaAdapterType);
+            CHECK_PROP(ePropDevice_MediaAdapterType, libImplDesc->Dev.MediaAdapterType);
         }
     }
 
@@ -1121,140 +1152,137 @@ mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
     return MFX_ERR_UNSUPPORTED;
 }
 
-mfxStatus ConfigCtxVPL::CheckPropsDec(const mfxVariant cfgPropsAll[],
-                                      std::list<DecConfig> decConfigList) {
-    auto it = decConfigList.begin();
-    while (it != decConfigList.end()) {
-        DecConfig dc      = (DecConfig)(*it);
-        bool isCompatible = true;
-
-        // check if this decode description includes
-        //   all of the required decoder properties
-        CHECK_PROP(ePropDec_CodecID, U32, dc.CodecID);
-        CHECK_PROP(ePropDec_MaxcodecLevel, U16, dc.MaxcodecLevel);
-        CHECK_PROP(ePropDec_Profile, U32, dc.Profile);
-        CHECK_PROP(ePropDec_MemHandleType, U32, dc.MemHandleType);
-        CHECK_PROP(ePropDec_ColorFormats, U32, dc.ColorFormat);
-
-        // special handling for properties passed via pointer
-        if (cfgPropsAll[ePropDec_Width].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U width = {};
-            if (cfgPropsAll[ePropDec_Width].Data.Ptr)
-                width = *((mfxRange32U *)(cfgPropsAll[ePropDec_Width].Data.Ptr));
-
-            if ((width.Max > dc.Width.Max) || (width.Min < dc.Width.Min) ||
-                (width.Step < dc.Width.Step))
-                isCompatible = false;
-        }
+// one bit per row of a caps table, set while the row matches all filter props checked so far
+// each prop is checked by scanning a single column, skipping rows which already failed
+class CapsRowMask {
+public:
+    explicit CapsRowMask(size_t numRows) : m_bits((numRows + 63) / 64, ~0ULL) {
+        if (numRows % 64)
+            m_bits.back() = (1ULL << (numRows % 64)) - 1;
+    }
 
-        if (cfgPropsAll[ePropDec_Height].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U height = {};
-            if (cfgPropsAll[ePropDec_Height].Data.Ptr)
-                height = *((mfxRange32U *)(cfgPropsAll[ePropDec_Height].Data.Ptr));
+    // clear rows for which bMatch(column[row]) is false, return false if no rows are left
+    template <typename T, typename F>
+    bool Keep(const std::vector<T> &column, F bMatch) {
+        bool bAnyRows = false;
 
-            if ((height.Max > dc.Height.Max) || (height.Min < dc.Height.Min) ||
-                (height.Step < dc.Height.Step))
-                isCompatible = false;
+        for (size_t w = 0; w < m_bits.size(); w++) {
+            mfxU64 bits = m_bits[w];
+            if (!bits)
+                continue;
+
+            for (size_t b = 0; b < 64; b++) {
+                if ((bits >> b) & 1ULL) {
+                    if (!bMatch(column[w * 64 + b]))
+                        bits &= ~(1ULL << b);
+                }
+            }
+
+            m_bits[w] = bits;
+            bAnyRows  = bAnyRows || (bits != 0);
         }
 
-        if (isCompatible == true)
-            return MFX_ERR_NONE;
+        return bAnyRows;
+    }
 
-        it++;
+    bool Any() const {
+        return std::any_of(m_bits.begin(), m_bits.end(), [](mfxU64 bits) {
+            return bits != 0;
+        });
     }
 
-    return MFX_ERR_UNSUPPORTED;
+private:
+    std::vector<mfxU64> m_bits;
+};
+
+// remove rows which do not match an integer prop, return false if none are left
+// a single value is compared directly, a set or range goes through MatchPropValue()
+template <typename T>
+static bool FilterColumn(CapsRowMask &rowMask, const mfxVariant &prop, const std::vector<T> &column) {
+    if (prop.Type == MFX_VARIANT_TYPE_U16 || prop.Type == MFX_VARIANT_TYPE_U32) {
+        mfxU32 filtVal = (prop.Type == MFX_VARIANT_TYPE_U16) ? prop.Data.U16 : prop.Data.U32;
+        return rowMask.Keep(column, [filtVal](T v) {
+            return (mfxU32)v == filtVal;
+        });
+    }
+
+    return rowMask.Keep(column, [&prop](T v) {
+        return MatchPropValue(prop, (mfxU32)v);
+    });
 }
 
-mfxStatus ConfigCtxVPL::CheckPropsEnc(const mfxVariant cfgPropsAll[],
-                                      std::list<EncConfig> encConfigList) {
-    auto it = encConfigList.begin();
-    while (it != encConfigList.end()) {
-        EncConfig ec      = (EncConfig)(*it);
-        bool isCompatible = true;
-
-        // check if this encode description includes
-        //   all of the required encoder properties
-        CHECK_PROP(ePropEnc_CodecID, U32, ec.CodecID);
-        CHECK_PROP(ePropEnc_MaxcodecLevel, U16, ec.MaxcodecLevel);
-        CHECK_PROP(ePropEnc_BiDirectionalPrediction, U16, ec.BiDirectionalPrediction);
-        CHECK_PROP(ePropEnc_Profile, U32, ec.Profile);
-        CHECK_PROP(ePropEnc_MemHandleType, U32, ec.MemHandleType);
-        CHECK_PROP(ePropEnc_ColorFormats, U32, ec.ColorFormat);
-
-        // special handling for properties passed via pointer
-        if (cfgPropsAll[ePropEnc_Width].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U width = {};
-            if (cfgPropsAll[ePropEnc_Width].Data.Ptr)
-                width = *((mfxRange32U *)(cfgPropsAll[ePropEnc_Width].Data.Ptr));
-
-            if ((width.Max > ec.Width.Max) || (width.Min < ec.Width.Min) ||
-                (width.Step < ec.Width.Step))
-                isCompatible = false;
-        }
+#define FILTER_COLUMN(idx, column)                                 \
+    if (cfgPropsAll[(idx)].Type != MFX_VARIANT_TYPE_UNSET) {       \
+        if (!FilterColumn(rowMask, cfgPropsAll[(idx)], (column)))  \
+            return MFX_ERR_UNSUPPORTED;                            \
+    }
 
-        if (cfgPropsAll[ePropEnc_Height].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U height = {};
-            if (cfgPropsAll[ePropEnc_Height].Data.Ptr)
-                height = *((mfxRange32U *)(cfgPropsAll[ePropEnc_Height].Data.Ptr));
+// remove rows which do not support the requested range (passed via pointer)
+#define FILTER_RANGE(idx, column)                                              \
+    if (cfgPropsAll[(idx)].Type != MFX_VARIANT_TYPE_UNSET) {                   \
+        mfxRange32U filtRange = {};                                            \
+        if (cfgPropsAll[(idx)].Data.Ptr)                                       \
+            filtRange = *((mfxRange32U *)(cfgPropsAll[(idx)].Data.Ptr));       \
+        if (!rowMask.Keep((column), [&filtRange](const mfxRange32U &v) {       \
+                return !((filtRange.Max > v.Max) || (filtRange.Min < v.Min) || \
+                         (filtRange.Step < v.Step));                           \
+            }))                                                                \
+            return MFX_ERR_UNSUPPORTED;                                        \
+    }
 
-            if ((height.Max > ec.Height.Max) || (height.Min < ec.Height.Min) ||
-                (height.Step < ec.Height.Step))
-                isCompatible = false;
-        }
+mfxStatus ConfigCtxVPL::CheckPropsDec(const mfxVariant cfgPropsAll[],
+                                      const DecCapsTable &decTable) {
+    CapsRowMask rowMask(decTable.CodecID.size());
 
-        if (isCompatible == true)
-            return MFX_ERR_NONE;
+    // keep only the decode descriptions which include
+    //   all of the required decoder properties
+    FILTER_COLUMN(ePropDec_CodecID, decTable.CodecID);
+    FILTER_COLUMN(ePropDec_MaxcodecLevel, decTable.MaxcodecLevel);
+    FILTER_COLUMN(ePropDec_Profile, decTable.Profile);
+    FILTER_COLUMN(ePropDec_MemHandleType, decTable.MemHandleType);
+    FILTER_COLUMN(ePropDec_ColorFormats, decTable.ColorFormat);
 
-        it++;
-    }
+    FILTER_RANGE(ePropDec_Width, decTable.Width);
+    FILTER_RANGE(ePropDec_Height, decTable.Height);
 
-    return MFX_ERR_UNSUPPORTED;
+    return (rowMask.Any() ? MFX_ERR_NONE : MFX_ERR_UNSUPPORTED);
 }
 
-mfxStatus ConfigCtxVPL::CheckPropsVPP(const mfxVariant cfgPropsAll[],
-                                      std::list<VPPConfig> vppConfigList) {
-    auto it = vppConfigList.begin();
-    while (it != vppConfigList.end()) {
-        VPPConfig vc      = (VPPConfig)(*it);
-        bool isCompatible = true;
-
-        // check if this filter description includes
-        //   all of the required VPP properties
-        CHECK_PROP(ePropVPP_FilterFourCC, U32, vc.FilterFourCC);
-        CHECK_PROP(ePropVPP_MaxDelayInFrames, U16, vc.MaxDelayInFrames);
-        CHECK_PROP(ePropVPP_MemHandleType, U32, vc.MemHandleType);
-        CHECK_PROP(ePropVPP_InFormat, U32, vc.InFormat);
-        CHECK_PROP(ePropVPP_OutFormat, U32, vc.OutFormat);
-
-        // special handling for properties passed via pointer
-        if (cfgPropsAll[ePropVPP_Width].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U width = {};
-            if (cfgPropsAll[ePropVPP_Width].Data.Ptr)
-                width = *((mfxRange32U *)(cfgPropsAll[ePropVPP_Width].Data.Ptr));
-
-            if ((width.Max > vc.Width.Max) || (width.Min < vc.Width.Min) ||
-                (width.Step < vc.Width.Step))
-                isCompatible = false;
-        }
-
-        if (cfgPropsAll[ePropVPP_Height].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U height = {};
-            if (cfgPropsAll[ePropVPP_Height].Data.Ptr)
-                height = *((mfxRange32U *)(cfgPropsAll[ePropVPP_Height].Data.Ptr));
+mfxStatus ConfigCtxVPL::CheckPropsEnc(const mfxVariant cfgPropsAll[],
+                                      const EncCapsTable &encTable) {
+    CapsRowMask rowMask(encTable.CodecID.size());
+
+    // keep only the encode descriptions which include
+    //   all of the required encoder properties
+    FILTER_COLUMN(ePropEnc_CodecID, encTable.CodecID);
+    FILTER_COLUMN(ePropEnc_MaxcodecLevel, encTable.MaxcodecLevel);
+    FILTER_COLUMN(ePropEnc_BiDirectionalPrediction, encTable.BiDirectionalPrediction);
+    FILTER_COLUMN(ePropEnc_Profile, encTable.Profile);
+    FILTER_COLUMN(ePropEnc_MemHandleType, encTable.MemHandleType);
+    FILTER_COLUMN(ePropEnc_ColorFormats, encTable.ColorFormat);
+
+    FILTER_RANGE(ePropEnc_Width, encTable.Width);
+    FILTER_RANGE(ePropEnc_Height, encTable.Height);
+
+    return (rowMask.Any() ? MFX_ERR_NONE : MFX_ERR_UNSUPPORTED);
+}
 
-            if ((height.Max > vc.Height.Max) || (height.Min < vc.Height.Min) ||
-                (height.Step < vc.Height.Step))
-                isCompatible = false;
-        }
+mfxStatus ConfigCtxVPL::CheckPropsVPP(const mfxVariant cfgPropsAll[],
+                                      const VPPCapsTable &vppTable) {
+    CapsRowMask rowMask(vppTable.FilterFourCC.size());
 
-        if (isCompatible == true)
-            return MFX_ERR_NONE;
+    // keep only the filter descriptions which include
+    //   all of the required VPP properties
+    FILTER_COLUMN(ePropVPP_FilterFourCC, vppTable.FilterFourCC);
+    FILTER_COLUMN(ePropVPP_MaxDelayInFrames, vppTable.MaxDelayInFrames);
+    FILTER_COLUMN(ePropVPP_MemHandleType, vppTable.MemHandleType);
+    FILTER_COLUMN(ePropVPP_InFormat, vppTable.InFormat);
+    FILTER_COLUMN(ePropVPP_OutFormat, vppTable.OutFormat);
 
-        it++;
-    }
+    FILTER_RANGE(ePropVPP_Width, vppTable.Width);
+    FILTER_RANGE(ePropVPP_Height, vppTable.Height);
 
-    return MFX_ERR_UNSUPPORTED;
+    return (rowMask.Any() ? MFX_ERR_NONE : MFX_ERR_UNSUPPORTED);
 }
 
 mfxStatus ConfigCtxVPL::CheckPropsExtDevID(const mfxVariant cfgPropsAll[],
@@ -1263,13 +1291,13 @@ mfxStatus ConfigCtxVPL::CheckPropsExtDevID(const mfxVariant cfgPropsAll[],
 
     // check if this implementation includes
     //   all of the required extended device ID properties
-    CHECK_PROP(ePropExtDev_VendorID, U16, libImplExtDevID->VendorID);
-    CHECK_PROP(ePropExtDev_DeviceID, U16, libImplExtDevID->DeviceID);
+    CHECK_PROP(ePropExtDev_VendorID, libImplExtDevID->VendorID);
+    CHECK_PROP(ePropExtDev_DeviceID, libImplExtDevID->DeviceID);
 
-    CHECK_PROP(ePropExtDev_PCIDomain, U32, libImplExtDevID->PCIDomain);
-    CHECK_PROP(ePropExtDev_PCIBus, U32, libImplExtDevID->PCIBus);
-    CHECK_PROP(ePropExtDev_PCIDevice, U32, libImplExtDevID->PCIDevice);
-    CHECK_PROP(ePropExtDev_PCIFunction, U32, libImplExtDevID->PCIFunction);
+    CHECK_PROP(ePropExtDev_PCIDomain, libImplExtDevID->PCIDomain);
+    CHECK_PROP(ePropExtDev_PCIBus, libImplExtDevID->PCIBus);
+    CHECK_PROP(ePropExtDev_PCIDevice, libImplExtDevID->PCIDevice);
+    CHECK_PROP(ePropExtDev_PCIFunction, libImplExtDevID->PCIFunction);
 
     // check DeviceLUID, require LUIDValid == true
     if (cfgPropsAll[ePropExtDev_DeviceLUID].Type != MFX_VARIANT_TYPE_UNSET) {
@@ -1289,7 +1317,7 @@ mfxStatus ConfigCtxVPL::CheckPropsExtDevID(const mfxVariant cfgPropsAll[],
     // check LUIDDeviceNodeMask, require LUIDValid == true
     if (cfgPropsAll[ePropExtDev_LUIDDeviceNodeMask].Type != MFX_VARIANT_TYPE_UNSET) {
         if (libImplExtDevID->LUIDValid) {
-            CHECK_PROP(ePropExtDev_LUIDDeviceNodeMask, U32, libImplExtDevID->LUIDDeviceNodeMask);
+            CHECK_PROP(ePropExtDev_LUIDDeviceNodeMask, libImplExtDevID->LUIDDeviceNodeMask);
         }
         else {
             isCompatible = false;
@@ -1299,7 +1327,7 @@ mfxStatus ConfigCtxVPL::CheckPropsExtDevID(const mfxVariant cfgPropsAll[],
     // check DRMRenderNodeNum
     if (cfgPropsAll[ePropExtDev_DRMRenderNodeNum].Type != MFX_VARIANT_TYPE_UNSET) {
         if (libImplExtDevID->DRMRenderNodeNum != 0) {
-            CHECK_PROP(ePropExtDev_DRMRenderNodeNum, U32, libImplExtDevID->DRMRenderNodeNum);
+            CHECK_PROP(ePropExtDev_DRMRenderNodeNum, libImplExtDevID->DRMRenderNodeNum);
         }
         else {
             isCompatible = false;
@@ -1309,14 +1337,14 @@ mfxStatus ConfigCtxVPL::CheckPropsExtDevID(const mfxVariant cfgPropsAll[],
     // check DRMPrimaryNodeNum
     if (cfgPropsAll[ePropExtDev_DRMPrimaryNodeNum].Type != MFX_VARIANT_TYPE_UNSET) {
         if (libImplExtDevID->DRMRenderNodeNum != 0x7FFFFFFF) {
-            CHECK_PROP(ePropExtDev_DRMPrimaryNodeNum, U32, libImplExtDevID->DRMPrimaryNodeNum);
+            CHECK_PROP(ePropExtDev_DRMPrimaryNodeNum, libImplExtDevID->DRMPrimaryNodeNum);
         }
         else {
             isCompatible = false;
         }
     }
 
-    CHECK_PROP(ePropExtDev_RevisionID, U16, libImplExtDevID->RevisionID);
+    CHECK_PROP(ePropExtDev_RevisionID, libImplExtDevID->RevisionID);
 
     // check string: DeviceName (string match)
     if (cfgPropsAll[ePropExtDev_DeviceName].Type != MFX_VARIANT_TYPE_UNSET) {
@@ -1334,31 +1362,24 @@ mfxStatus ConfigCtxVPL::CheckPropsExtDevID(const mfxVariant cfgPropsAll[],
 
 #ifdef ONEVPL_EXPERIMENTAL
 mfxStatus ConfigCtxVPL::CheckPropsSurface(const mfxVariant cfgPropsAll[],
-                                          std::list<SurfaceConfig> surfaceConfigList) {
-    auto it = surfaceConfigList.begin();
-    while (it != surfaceConfigList.end()) {
-        SurfaceConfig sc  = (SurfaceConfig)(*it);
-        bool isCompatible = true;
-
-        // check if this filter description includes
-        //   all of the required surface properties
-        CHECK_PROP(ePropSurface_SurfaceType, U32, sc.SurfaceType);
-        CHECK_PROP(ePropSurface_SurfaceComponent, U32, sc.SurfaceComponent);
-
-        // require that supported surface flags (bitmask) includes all of the requested flags
-        if (cfgPropsAll[ePropSurface_SurfaceFlags].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxU32 requestedFlags = cfgPropsAll[ePropSurface_SurfaceFlags].Data.U32;
-            if ((sc.SurfaceFlags & requestedFlags) != requestedFlags)
-                isCompatible = false;
-        }
-
-        if (isCompatible == true)
-            return MFX_ERR_NONE;
-
-        it++;
+                                          const SurfaceCapsTable &surfaceTable) {
+    CapsRowMask rowMask(surfaceTable.SurfaceType.size());
+
+    // keep only the surface descriptions which include
+    //   all of the required surface properties
+    FILTER_COLUMN(ePropSurface_SurfaceType, surfaceTable.SurfaceType);
+    FILTER_COLUMN(ePropSurface_SurfaceComponent, surfaceTable.SurfaceComponent);
+
+    // require that supported surface flags (bitmask) includes all of the requested flags
+    if (cfgPropsAll[ePropSurface_SurfaceFlags].Type != MFX_VARIANT_TYPE_UNSET) {
+        mfxU32 requestedFlags = cfgPropsAll[ePropSurface_SurfaceFlags].Data.U32;
+        if (!rowMask.Keep(surfaceTable.SurfaceFlags, [requestedFlags](mfxU32 v) {
+                return (v & requestedFlags) == requestedFlags;
+            }))
+            return MFX_ERR_UNSUPPORTED;
     }
 
-    return MFX_ERR_UNSUPPORTED;
+    return (rowMask.Any() ? MFX_ERR_NONE : MFX_ERR_UNSUPPORTED);
 }
 #endif
 
@@ -1386,133 +1407,314 @@ mfxStatus ConfigCtxVPL::CheckPropString(const mfxChar *implString, const std::st
     return MFX_ERR_NONE;
 }
 
-mfxStatus ConfigCtxVPL::ValidateConfig(const mfxImplDescription *libImplDesc,
+mfxU32 ConfigCtxVPL::GetChangedGroups(const ConfigCheckResult &result) const {
+    mfxU32 changedGroups = 0;
+    for (mfxU32 group = 0; group < ePropGroup_Total; group++) {
+        if (result.groupRevision[group] != m_propGroupRevision[group])
+            changedGroups |= (1 << group);
+    }
+
+    return changedGroups;
+}
+
+mfxStatus ConfigCtxVPL::CheckImplProps(const mfxImplDescription *libImplDesc,
                                        const mfxImplementedFunctions *libImplFuncs,
                                        const mfxExtendedDeviceId *libImplExtDevID,
 #ifdef ONEVPL_EXPERIMENTAL
                                        const mfxSurfaceTypesSupported *libImplSurfTypes,
 #endif
-                                       std::list<ConfigCtxVPL *> configCtxList,
+                                       const ImplCapsIndex &capsIndex,
                                        LibType libType,
-                                       SpecialConfig *specialConfig) {
-    mfxU32 idx;
-    bool decRequested    = false;
-    bool encRequested    = false;
-    bool vppRequested    = false;
-    bool extDevRequested = false;
+                                       ConfigCheckResult &result) const {
+    mfxU32 changedGroups = GetChangedGroups(result);
+    if (changedGroups == 0)
+        return (result.failedGroups ? MFX_ERR_UNSUPPORTED : MFX_ERR_NONE);
+
+    // initially all properties are unset
+    mfxVariant cfgPropsAll[eProp_TotalProps] = {};
+    mfxU32 setGroups                         = 0;
+
+    for (mfxU32 idx = 0; idx < eProp_TotalProps; idx++) {
+        cfgPropsAll[idx].Type = MFX_VARIANT_TYPE_UNSET;
+
+        // ignore unset properties
+        if (m_propVar[idx].Type == MFX_VARIANT_TYPE_UNSET)
+            continue;
+
+        PropGroup group = GetPropGroup(idx);
+        if (group != ePropGroup_Total)
+            setGroups |= (1 << group);
+
+        // required function name is stored in m_implFunctionName
+        if (idx == ePropFunc_FunctionName)
+            continue;
+
+        cfgPropsAll[idx].Type = m_propVar[idx].Type;
+        cfgPropsAll[idx].Data = m_propVar[idx].Data;
+    }
+
+    for (mfxU32 group = 0; group < ePropGroup_Total; group++) {
+        mfxU32 groupMask = (1 << group);
+        if (!(changedGroups & groupMask))
+            continue;
+
+        bool bSupported = true;
+
+        switch (group) {
+            case ePropGroup_General:
+                if (CheckPropsGeneral(cfgPropsAll, libImplDesc))
+                    bSupported = false;
+                break;
+
+            // MSDK RT compatibility mode (1.x) does not provide Dec/Enc/VPP caps
+            // ignore these filters if set (do not use them to _exclude_ the library)
+            case ePropGroup_Dec:
+                if ((setGroups & groupMask) && libType != LibTypeMSDK &&
+                    CheckPropsDec(cfgPropsAll, capsIndex.dec))
+                    bSupported = false;
+                break;
+
+            case ePropGroup_Enc:
+                if ((setGroups & groupMask) && libType != LibTypeMSDK &&
+                    CheckPropsEnc(cfgPropsAll, capsIndex.enc))
+                    bSupported = false;
+                break;
+
+            case ePropGroup_VPP:
+                if ((setGroups & groupMask) && libType != LibTypeMSDK &&
+                    CheckPropsVPP(cfgPropsAll, capsIndex.vpp))
+                    bSupported = false;
+                break;
+
+            case ePropGroup_ExtDev:
+                // fail if extDevID is not available (null) or if prop is not supported
+                if ((setGroups & groupMask) &&
+                    (!libImplExtDevID || CheckPropsExtDevID(cfgPropsAll, libImplExtDevID)))
+                    bSupported = false;
+                break;
 
-    bool surfaceRequested = false;
+            case ePropGroup_Surface:
+#ifdef ONEVPL_EXPERIMENTAL
+                if ((setGroups & groupMask) &&
+                    (!libImplSurfTypes || CheckPropsSurface(cfgPropsAll, capsIndex.surface)))
+                    bSupported = false;
+#else
+                if (setGroups & groupMask)
+                    bSupported = false;
+#endif
+                break;
 
-    bool bImplValid = true;
+            case ePropGroup_Func:
+                // check whether required function is implemented
+                if (setGroups & groupMask) {
+                    bSupported = false;
+
+                    // library may not provide list of implemented functions
+                    if (libImplFuncs) {
+                        for (mfxU32 fnIdx = 0; fnIdx < libImplFuncs->NumFunctions; fnIdx++) {
+                            if (m_implFunctionName == libImplFuncs->FunctionsName[fnIdx]) {
+                                bSupported = true;
+                                break;
+                            }
+                        }
+                    }
+                }
+                break;
 
+            default:
+                break;
+        }
+
+        result.groupRevision[group] = m_propGroupRevision[group];
+        if (bSupported)
+            result.failedGroups &= ~groupMask;
+        else
+            result.failedGroups |= groupMask;
+    }
+
+    return (result.failedGroups ? MFX_ERR_UNSUPPORTED : MFX_ERR_NONE);
+}
+
+mfxStatus ConfigCtxVPL::ValidateConfig(
+    const mfxImplDescription *libImplDesc,
+    const mfxImplementedFunctions *libImplFuncs,
+    const mfxExtendedDeviceId *libImplExtDevID,
+#ifdef ONEVPL_EXPERIMENTAL
+    const mfxSurfaceTypesSupported *libImplSurfTypes,
+#endif
+    const ImplCapsIndex &capsIndex,
+    const std::vector<ConfigCtxVPL *> &configCtxList,
+    std::map<const ConfigCtxVPL *, ConfigCheckResult> &configResults,
+    LibType libType,
+    const SpecialConfig *specialConfig) {
     if (!libImplDesc)
         return MFX_ERR_NULL_PTR;
 
-    std::list<DecConfig> decConfigList;
-    std::list<EncConfig> encConfigList;
-    std::list<VPPConfig> vppConfigList;
-    std::list<SurfaceConfig> surfaceConfigList;
+    // major and minor API version may be passed in separate cfg objects, so
+    //   the requested version is combined in UpdateSpecialConfig()
+    if (specialConfig->bIsSet_ApiVersion &&
+        libImplDesc->ApiVersion.Version < specialConfig->ApiVersion.Version)
+        return MFX_ERR_UNSUPPORTED;
 
-    // generate "flat" descriptions of each combination
-    //   (e.g. multiple profiles from the same codec)
-    GetFlatDescriptionsDec(libImplDesc, decConfigList);
-    GetFlatDescriptionsEnc(libImplDesc, encConfigList);
-    GetFlatDescriptionsVPP(libImplDesc, vppConfigList);
+    // if this implementation already failed a filter which was not changed since,
+    //   it is still invalid and there is no need to check the other filters
+    for (ConfigCtxVPL *config : configCtxList) {
+        const ConfigCheckResult &result = configResults[config];
+        if (result.failedGroups & ~config->GetChangedGroups(result))
+            return MFX_ERR_UNSUPPORTED;
+    }
 
+    // check only the props which were set since the previous call
+    for (ConfigCtxVPL *config : configCtxList) {
+        mfxStatus sts = config->CheckImplProps(libImplDesc,
+                                               libImplFuncs,
+                                               libImplExtDevID,
 #ifdef ONEVPL_EXPERIMENTAL
-    GetFlatDescriptionsSurface(libImplSurfTypes, surfaceConfigList);
+                                               libImplSurfTypes,
 #endif
+                                               capsIndex,
+                                               libType,
+                                               configResults[config]);
+        if (sts != MFX_ERR_NONE)
+            return sts;
+    }
 
-    // list of functions required to be implemented
-    std::list<std::string> implFunctionList;
-    implFunctionList.clear();
+    return MFX_ERR_NONE;
+}
 
-    // check requested API version
-    mfxVersion reqVersion = {};
-    bool bVerSetMajor     = false;
-    bool bVerSetMinor     = false;
+template <typename T>
+static void AppendKey(std::string &key, const T &val) {
+    key.append((const char *)&val, sizeof(T));
+}
 
-    // clear list of extension buffers
-    specialConfig->bIsSet_ExtBuffer = false;
-    specialConfig->ExtBuffers.clear();
+// length prefix, so adjacent strings cannot run together
+static void AppendKeyString(std::string &key, const std::string &str) {
+    AppendKey(key, (mfxU64)str.size());
+    key.append(str);
+}
 
-    // iterate through all filters and populate cfgPropsAll
-    auto it = configCtxList.begin();
+std::string ConfigCtxVPL::GetFilterKey() const {
+    std::string key;
 
-    while (it != configCtxList.end()) {
-        ConfigCtxVPL *config = (*it);
-        it++;
+    for (mfxI32 idx = 0; idx < eProp_TotalProps; idx++) {
+        const mfxVariantWrapper &prop = m_propVar[idx];
 
-        // initially all properties are unset
-        mfxVariant cfgPropsAll[eProp_TotalProps] = {};
-        for (idx = 0; idx < eProp_TotalProps; idx++) {
-            cfgPropsAll[idx].Type = MFX_VARIANT_TYPE_UNSET;
-        }
+        // non-filtering props do not affect which implementations are valid
+        if (prop.Type == MFX_VARIANT_TYPE_UNSET || GetPropGroup(idx) == ePropGroup_Total)
+            continue;
 
-        for (idx = 0; idx < eProp_TotalProps; idx++) {
-            // ignore unset properties
-            if (config->m_propVar[idx].Type == MFX_VARIANT_TYPE_UNSET)
-                continue;
+        AppendKey(key, idx);
+        AppendKey(key, (mfxU32)prop.Type);
 
-            // if property is required function, add to list which will be checked below
-            if (idx == ePropFunc_FunctionName) {
-                implFunctionList.push_back(config->m_implFunctionName);
-                continue;
-            }
+#ifdef ONEVPL_EXPERIMENTAL
+        if (prop.Type & MFX_VARIANT_TYPE_SET) {
+            const std::vector<mfxU32> *values = (const std::vector<mfxU32> *)(prop.Data.Ptr);
+            AppendKey(key, (mfxU64)values->size());
+            key.append((const char *)values->data(), values->size() * sizeof(mfxU32));
+            continue;
+        }
 
-            cfgPropsAll[idx].Type = config->m_propVar[idx].Type;
-            cfgPropsAll[idx].Data = config->m_propVar[idx].Data;
+        if (prop.Type & MFX_VARIANT_TYPE_RANGE) {
+            AppendKey(key, *(const mfxRange32U *)(prop.Data.Ptr));
+            continue;
+        }
+#endif
 
-            if (idx >= ePropDec_CodecID && idx <= ePropDec_ColorFormats)
-                decRequested = true;
-            else if (idx >= ePropEnc_CodecID && idx <= ePropEnc_ColorFormats)
-                encRequested = true;
-            else if (idx >= ePropVPP_FilterFourCC && idx <= ePropVPP_OutFormat)
-                vppRequested = true;
-            else if (idx >= ePropExtDev_VendorID && idx <= ePropExtDev_DeviceName)
-                extDevRequested = true;
-            else if (idx >= ePropSurface_SurfaceType && idx <= ePropSurface_SurfaceFlags)
-                surfaceRequested = true;
+        // only the bytes of the active member, the rest of the union may be uninitialized
+        switch (prop.Type) {
+            case MFX_VARIANT_TYPE_U8:
+            case MFX_VARIANT_TYPE_I8:
+                AppendKey(key, prop.Data.U8);
+                break;
+            case MFX_VARIANT_TYPE_U16:
+            case MFX_VARIANT_TYPE_I16:
+            case MFX_VARIANT_TYPE_FP16:
+                AppendKey(key, prop.Data.U16);
+                break;
+            case MFX_VARIANT_TYPE_U32:
+            case MFX_VARIANT_TYPE_I32:
+            case MFX_VARIANT_TYPE_F32:
+                AppendKey(key, prop.Data.U32);
+                break;
+            case MFX_VARIANT_TYPE_U64:
+            case MFX_VARIANT_TYPE_I64:
+            case MFX_VARIANT_TYPE_F64:
+                AppendKey(key, prop.Data.U64);
+                break;
+            case MFX_VARIANT_TYPE_PTR:
+                // copies of data passed by pointer are saved in ValidateAndSetProp()
+                switch (idx) {
+                    case ePropDec_Width:
+                    case ePropDec_Height:
+                    case ePropEnc_Width:
+                    case ePropEnc_Height:
+                    case ePropVPP_Width:
+                    case ePropVPP_Height:
+                        AppendKey(key, *(const mfxRange32U *)(prop.Data.Ptr));
+                        break;
+                    case ePropExtDev_DeviceLUID:
+                        AppendKey(key, m_extDevLUID8U);
+                        break;
+                    case ePropFunc_FunctionName:
+                        AppendKeyString(key, m_implFunctionName);
+                        break;
+                    default:
+                        // strings
+                        AppendKeyString(key, *(const std::string *)(prop.Data.Ptr));
+                        break;
+                }
+                break;
+            default:
+                break;
         }
+    }
 
-        // if already marked invalid, no need to check props again
-        // however we still need to iterate over all of the config objects
-        //   to get any non-filtering properties (returned in SpecialConfig)
-        if (bImplValid == true) {
-            if (CheckPropsGeneral(cfgPropsAll, libImplDesc))
-                bImplValid = false;
+    return key;
+}
 
-            if (extDevRequested) {
-                // fail if extDevID is not available (null) or if prop is not supported
-                if (!libImplExtDevID || CheckPropsExtDevID(cfgPropsAll, libImplExtDevID))
-                    bImplValid = false;
-            }
-#ifdef ONEVPL_EXPERIMENTAL
-            if (surfaceRequested) {
-                if (!libImplSurfTypes || CheckPropsSurface(cfgPropsAll, surfaceConfigList))
-                    bImplValid = false;
-            }
-#else
-            if (surfaceRequested)
-                bImplValid = false;
-#endif
+std::string ConfigCtxVPL::GetSelectionKey(const std::vector<ConfigCtxVPL *> &configCtxList,
+                                          const SpecialConfig *specialConfig) {
+    // an implementation must match every config, so their order does not matter
+    std::vector<std::string> filterKeys;
+    filterKeys.reserve(configCtxList.size());
 
-            // MSDK RT compatibility mode (1.x) does not provide Dec/Enc/VPP caps
-            // ignore these filters if set (do not use them to _exclude_ the library)
-            if (libType != LibTypeMSDK) {
-                if (decRequested && CheckPropsDec(cfgPropsAll, decConfigList))
-                    bImplValid = false;
+    size_t keyLen = 4 * sizeof(mfxU32);
+    for (const ConfigCtxVPL *config : configCtxList) {
+        filterKeys.push_back(config->GetFilterKey());
+        keyLen += sizeof(mfxU64) + filterKeys.back().size();
+    }
 
-                if (encRequested && CheckPropsEnc(cfgPropsAll, encConfigList))
-                    bImplValid = false;
+    std::sort(filterKeys.begin(), filterKeys.end());
 
-                if (vppRequested && CheckPropsVPP(cfgPropsAll, vppConfigList))
-                    bImplValid = false;
-            }
-        }
+    std::string key;
+    key.reserve(keyLen);
+    for (const std::string &filterKey : filterKeys)
+        AppendKeyString(key, filterKey);
+
+    // API version may be combined from several configs, and the adapter index is
+    //   not part of the implementation caps
+    AppendKey(key, (mfxU32)specialConfig->bIsSet_ApiVersion);
+    AppendKey(key, (mfxU32)(specialConfig->bIsSet_ApiVersion ? specialConfig->ApiVersion.Version : 0));
+    AppendKey(key, (mfxU32)specialConfig->bIsSet_dxgiAdapterIdx);
+    AppendKey(key, (mfxU32)(specialConfig->bIsSet_dxgiAdapterIdx ? specialConfig->dxgiAdapterIdx : 0));
+
+    return key;
+}
+
+void ConfigCtxVPL::UpdateSpecialConfig(const std::vector<ConfigCtxVPL *> &configCtxList,
+                                       SpecialConfig *specialConfig) {
+    mfxVersion reqVersion = {};
+    bool bVerSetMajor     = false;
+    bool bVerSetMinor     = false;
+
+    // clear list of extension buffers
+    specialConfig->bIsSet_ExtBuffer = false;
+    specialConfig->ExtBuffers.clear();
+
+    // if multiple cfg objects set the same non-filtering property, the last (most recent) one is used
+    for (ConfigCtxVPL *config : configCtxList) {
+        const mfxVariantWrapper *cfgPropsAll = config->m_propVar;
 
-        // update any special (including non-filtering) properties, for use by caller
-        // if multiple cfg objects set the same non-filtering property, the last (most recent) one is used
         if (cfgPropsAll[ePropSpecial_HandleType].Type != MFX_VARIANT_TYPE_UNSET) {
             specialConfig->deviceHandleType =
                 (mfxHandleType)cfgPropsAll[ePropSpecial_HandleType].Data.U32;
@@ -1572,45 +1774,14 @@ mfxStatus ConfigCtxVPL::ValidateConfig(const mfxImplDescription *libImplDesc,
         }
     }
 
+    // require both Major and Minor to be set if filtering this way
     if (bVerSetMajor && bVerSetMinor) {
-        // require both Major and Minor to be set if filtering this way
-        if (libImplDesc->ApiVersion.Version < reqVersion.Version)
-            bImplValid = false;
-
         specialConfig->ApiVersion.Version = reqVersion.Version;
         specialConfig->bIsSet_ApiVersion  = true;
     }
-
-    if (bImplValid == false)
-        return MFX_ERR_UNSUPPORTED;
-
-    // check whether required functions are implemented
-    if (!implFunctionList.empty()) {
-        if (!libImplFuncs) {
-            // library did not provide list of implemented functions
-            return MFX_ERR_UNSUPPORTED;
-        }
-
-        auto fn = implFunctionList.begin();
-        while (fn != implFunctionList.end()) {
-            std::string fnName = (*fn++);
-            mfxU32 fnIdx;
-
-            // search for fnName in list of implemented functions
-            for (fnIdx = 0; fnIdx < libImplFuncs->NumFunctions; fnIdx++) {
-                if (fnName == libImplFuncs->FunctionsName[fnIdx])
-                    break;
-            }
-
-            if (fnIdx == libImplFuncs->NumFunctions)
-                return MFX_ERR_UNSUPPORTED;
-        }
-    }
-
-    return MFX_ERR_NONE;
 }
 
-bool ConfigCtxVPL::CheckLowLatencyConfig(std::list<ConfigCtxVPL *> configCtxList,
+bool ConfigCtxVPL::CheckLowLatencyConfig(const std::vector<ConfigCtxVPL *> &configCtxList,
                                          SpecialConfig *specialConfig) {
     mfxU32 idx;
     bool bLowLatency = true;
@@ -5,11 +5,15 @@
   ############################################################################*/
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "src/mfx_dispatcher_vpl.h"
 
 #if defined(_WIN32) || defined(_WIN64)
     #include "src/mfx_dispatcher_vpl_win.h"
+#else
+    #include "src/linux/elf_exports.h"
 #endif
 
 // leave table formatting alone
@@ -35,6 +39,7 @@ static const VPLFunctionDesc FunctionDesc2[NumVPLFunctions] = {
 
 static const VPLFunctionDesc FunctionDescOptional[NumVPLOptionalFunctions] = {
     { "MFXQueryImplsProperties",                { { 15, 2 } } },
+    { "MFXQueryImplsAPIVersion",                { { 17, 2 } } },
 };
 
 static const VPLFunctionDesc MSDKCompatFunctions[NumMSDKFunctions] = {
@@ -45,6 +50,23 @@ static const VPLFunctionDesc MSDKCompatFunctions[NumMSDKFunctions] = {
 // end table formatting
 // clang-format on
 
+#ifdef ONEVPL_EXPERIMENTAL
+static_assert((int)LoaderPhaseSearch == MFX_LOADER_PHASE_SEARCH &&
+                  (int)LoaderPhaseLoad == MFX_LOADER_PHASE_LOAD &&
+                  (int)LoaderPhaseQuery == MFX_LOADER_PHASE_QUERY &&
+                  (int)LoaderPhaseFilter == MFX_LOADER_PHASE_FILTER &&
+                  (int)LoaderPhaseInit == MFX_LOADER_PHASE_INIT,
+              "LoaderPhase must match mfxLoaderPhase");
+static_assert(NumLoaderPhases <= MFX_LOADER_MAX_PHASES, "too many loader phases");
+
+// timing returned by MFXQueryLoaderTiming(), with storage for the arrays it points to
+struct LoaderCtxVPL::TimingSnapshot {
+    mfxLoaderTiming timing;
+    std::vector<mfxLibraryTiming> libs;
+    std::vector<std::string> libPaths;
+};
+#endif
+
 // implementation of loader context (mfxLoader)
 // each loader instance will build a list of valid runtimes and allow
 // application to create sessions with them
@@ -52,6 +74,7 @@ LoaderCtxVPL::LoaderCtxVPL()
         : m_libInfoList(),
           m_implInfoList(),
           m_configCtxList(),
+          m_sessionPoolList(),
           m_gpuAdapterInfo(),
 #ifdef ONEVPL_EXPERIMENTAL
           m_queryProps(),
@@ -59,8 +82,26 @@ LoaderCtxVPL::LoaderCtxVPL()
           m_specialConfig(),
           m_implIdxNext(0),
           m_bKeepCapsUntilUnload(true),
+          m_numProbeThreads(0),
           m_envVar(),
-          m_dispLog() {
+          m_dispLog(),
+          m_capsCache(),
+          m_selectionCache(),
+          m_selectionImpls(),
+          m_registry(),
+          m_bBackgroundDiscovery(false),
+          m_discoveryThread(),
+          m_timingLock(),
+          m_timingStart(GetLoaderTime()),
+          m_timing(),
+          m_unloadedLibTiming(),
+#ifdef ONEVPL_EXPERIMENTAL
+          m_timingSnapshots(),
+          m_placementPolicy(MFX_PLACEMENT_POLICY_NONE),
+          m_placementWeights(),
+          m_placementNext(0),
+#endif
+          m_placementLock() {
     // allow loader to distinguish between property value of 0
     //   and property not set
     m_specialConfig.bIsSet_deviceHandleType = false;
@@ -79,6 +120,10 @@ LoaderCtxVPL::LoaderCtxVPL()
     m_bNeedLowLatencyQuery  = true;
     m_bPriorityPathEnabled  = false;
 
+    m_bDiscoveryResultsUnused = false;
+    m_bTrackSessions          = false;
+    m_bConfigChanged          = false;
+
 #ifdef ONEVPL_EXPERIMENTAL
     m_bEnablePropsQuery = false;
 #endif
@@ -87,6 +132,7 @@ LoaderCtxVPL::LoaderCtxVPL()
 }
 
 LoaderCtxVPL::~LoaderCtxVPL() {
+    WaitBackgroundDiscovery();
     return;
 }
 
@@ -100,15 +146,24 @@ mfxStatus LoaderCtxVPL::FullLoadAndQuery() {
     if (MFX_ERR_NONE != sts)
         return sts;
 
+    // read persistent caps cache, if enabled
+    m_capsCache.Load();
+
     // prune libraries which are not actually implementations, filling function
     // ptr table for each library which is
     mfxU32 numLibs = CheckValidLibraries();
-    if (numLibs == 0)
+    if (numLibs == 0) {
+        m_capsCache.Save();
         return MFX_ERR_UNSUPPORTED;
+    }
 
     // query capabilities of each implementation
     // may be more than one implementation per library
     sts = QueryLibraryCaps();
+
+    // write any newly queried libraries to persistent caps cache, if enabled
+    m_capsCache.Save();
+
     if (MFX_ERR_NONE != sts)
         return MFX_ERR_NOT_FOUND;
 
@@ -156,7 +211,7 @@ mfxU32 LoaderCtxVPL::ParseEnvSearchPaths(const CHAR_TYPE *envVarName,
 #define NUM_LIB_PREFIXES 3
 
 mfxStatus LoaderCtxVPL::SearchDirForLibs(STRING_TYPE searchDir,
-                                         std::list<LibInfo *> &libInfoList,
+                                         std::vector<LibInfo *> &libInfoList,
                                          mfxU32 priority,
                                          bool bLoadVPLOnly) {
     // okay to call with empty searchDir
@@ -219,7 +274,7 @@ mfxStatus LoaderCtxVPL::SearchDirForLibs(STRING_TYPE searchDir,
                 if (libFound != libInfoList.end())
                     continue;
 
-                LibInfo *libInfo = new (std::nothrow) LibInfo;
+                LibInfo *libInfo = NewLibInfo();
                 if (!libInfo) {
                     FindClose(hTestFile);
                     return MFX_ERR_MEMORY_ALLOC;
@@ -284,7 +339,7 @@ mfxStatus LoaderCtxVPL::SearchDirForLibs(STRING_TYPE searchDir,
                     continue;
                 }
 
-                LibInfo *libInfo = new (std::nothrow) LibInfo;
+                LibInfo *libInfo = NewLibInfo();
                 if (!libInfo) {
                     closedir(pSearchDir);
                     return MFX_ERR_MEMORY_ALLOC;
@@ -462,6 +517,7 @@ mfxU32 LoaderCtxVPL::GetSearchPathsInstallDir(std::list<STRING_TYPE> &searchDirs
 // search for implementations of Intel® Video Processing Library (Intel® VPL)
 //   according to the rules in the spec
 mfxStatus LoaderCtxVPL::BuildListOfCandidateLibs() {
+    LoaderPhaseTimer phaseTimer(this, LoaderPhaseSearch);
     DISP_LOG_FUNCTION(&m_dispLog);
 
     mfxStatus sts = MFX_ERR_NONE;
@@ -615,23 +671,73 @@ mfxStatus LoaderCtxVPL::BuildListOfCandidateLibs() {
 // return number of valid libraries found
 mfxU32 LoaderCtxVPL::CheckValidLibraries() {
     DISP_LOG_FUNCTION(&m_dispLog);
+    LoaderPhaseTimer phaseTimer(this, LoaderPhaseLoad);
 
     LibInfo *msdkLibBest   = nullptr;
     LibInfo *msdkLibBestDS = nullptr;
 
+    // keep track of the MSDK library with highest API version
+    auto updateBestMSDK = [&](LibInfo *libInfo) {
+        if (msdkLibBest == nullptr ||
+            (libInfo->msdkVersion.Version > msdkLibBest->msdkVersion.Version)) {
+            msdkLibBest = libInfo;
+        }
+
+        if (libInfo->libPriority == LIB_PRIORITY_LEGACY_DRIVERSTORE) {
+            if (msdkLibBestDS == nullptr ||
+                (libInfo->msdkVersion.Version > msdkLibBestDS->msdkVersion.Version)) {
+                msdkLibBestDS = libInfo;
+            }
+        }
+    };
+
+    // if library is unchanged since it was last queried, use the cached result
+    //   instead of loading it
+    std::vector<const CapsCacheEntry *> cacheEntries;
+    for (LibInfo *libInfo : m_libInfoList)
+        cacheEntries.push_back(FindCachedCaps(libInfo));
+
     // load all libraries
-    std::list<LibInfo *>::iterator it = m_libInfoList.begin();
-    while (it != m_libInfoList.end()) {
+    std::vector<LibInfo *>::iterator it = m_libInfoList.begin();
+    for (mfxU32 libIdx = 0; it != m_libInfoList.end(); libIdx++) {
         LibInfo *libInfo = (*it);
         mfxStatus sts    = MFX_ERR_NONE;
 
-        // load DLL
-        sts = LoadSingleLibrary(libInfo);
+        const CapsCacheEntry *cacheEntry = cacheEntries[libIdx];
+        if (cacheEntry) {
+            libInfo->timing.bCapsCached = true;
 
-        // load video functions: pointers to exposed functions
-        // not all function pointers may be filled in (depends on API version)
-        if (sts == MFX_ERR_NONE && libInfo->hModuleVPL)
-            LoadAPIExports(libInfo, LibTypeVPL);
+            // MSDK adapters are filled in from the cached caps in QueryLibraryCaps()
+            if (cacheEntry->bValidLib && cacheEntry->bMSDK)
+                libInfo->msdkCtx.reset(new (std::nothrow) LoaderCtxMSDK[MAX_NUM_IMPL_MSDK]);
+
+            if (libInfo->msdkCtx) {
+                libInfo->libType        = LibTypeMSDK;
+                libInfo->msdkVersion    = cacheEntry->msdkVersion;
+                libInfo->capsCacheEntry = cacheEntry;
+                updateBestMSDK(libInfo);
+                it++;
+            }
+            else if (cacheEntry->bValidLib && !cacheEntry->bMSDK) {
+                libInfo->libType        = LibTypeVPL;
+                libInfo->capsCacheEntry = cacheEntry;
+                it++;
+            }
+            else {
+                UnloadSingleLibrary(libInfo);
+                it = m_libInfoList.erase(it);
+            }
+            continue;
+        }
+
+        // always serial, dlopen() holds a process-wide lock so threads do not help here
+        sts = ProbeSingleLibrary(libInfo);
+
+        if (sts == MFX_ERR_UNSUPPORTED) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  skipped library without required exports -- %s",
+                             libInfo->libNameFull.c_str());
+        }
 
         // all runtime libraries with API >= 2.0 must export MFXInitialize()
         // validation of additional functions vs. API version takes place
@@ -659,19 +765,12 @@ mfxU32 LoaderCtxVPL::CheckValidLibraries() {
         if (numFunctions == NumMSDKFunctions) {
             sts = LoaderCtxMSDK::QueryAPIVersion(libInfo->libNameFull, &(libInfo->msdkVersion));
 
-            if (sts == MFX_ERR_NONE) {
-                libInfo->libType = LibTypeMSDK;
-                if (msdkLibBest == nullptr ||
-                    (libInfo->msdkVersion.Version > msdkLibBest->msdkVersion.Version)) {
-                    msdkLibBest = libInfo;
-                }
+            if (sts == MFX_ERR_NONE)
+                libInfo->msdkCtx.reset(new (std::nothrow) LoaderCtxMSDK[MAX_NUM_IMPL_MSDK]);
 
-                if (libInfo->libPriority == LIB_PRIORITY_LEGACY_DRIVERSTORE) {
-                    if (msdkLibBestDS == nullptr ||
-                        (libInfo->msdkVersion.Version > msdkLibBestDS->msdkVersion.Version)) {
-                        msdkLibBestDS = libInfo;
-                    }
-                }
+            if (sts == MFX_ERR_NONE && libInfo->msdkCtx) {
+                libInfo->libType = LibTypeMSDK;
+                updateBestMSDK(libInfo);
 
 #if defined(_WIN32) || defined(_WIN64)
                 // workaround for double-init issue in old versions of MSDK runtime
@@ -691,6 +790,10 @@ mfxU32 LoaderCtxVPL::CheckValidLibraries() {
 
         // required functions missing from DLL, or DLL failed to load
         // remove this library from the list of options
+        // do not cache failure to load, which may be caused by missing dependencies
+        if (sts == MFX_ERR_NONE && libInfo->hModuleVPL)
+            StoreCachedCaps(libInfo, false, std::vector<CapsCacheImpl>());
+
         UnloadSingleLibrary(libInfo);
         it = m_libInfoList.erase(it);
     }
@@ -716,6 +819,53 @@ mfxU32 LoaderCtxVPL::CheckValidLibraries() {
     return (mfxU32)m_libInfoList.size();
 }
 
+#if !defined(_WIN32) && !defined(_WIN64)
+// return false if the library definitely does not export the functions required by
+//   CheckValidLibraries() for either a 2.x or a legacy 1.x runtime
+// if the ELF file cannot be parsed, return true and let dlopen() decide
+static bool HasRequiredExports(LibInfo *libInfo) {
+    std::vector<const char *> names;
+    names.push_back(FunctionDesc2[IdxMFXInitialize].pName);
+    for (mfxU32 i = 0; i < NumMSDKFunctions; i++)
+        names.push_back(MSDKCompatFunctions[i].pName);
+
+    std::vector<bool> found;
+    if (CheckElfExports(libInfo->libNameFull, names, found) != MFX_ERR_NONE)
+        return true;
+
+    if (found[0] && libInfo->libPriority < LIB_PRIORITY_LEGACY_DRIVERSTORE)
+        return true;
+
+    if (libInfo->libNameFull.find(MSDK_LIB_NAME) != std::string::npos &&
+        std::all_of(found.begin() + 1, found.end(), [](bool b) {
+            return b;
+        }))
+        return true;
+
+    return false;
+}
+#endif
+
+// load library and fill in table of 2.x functions
+// on Linux, libraries which cannot be a valid runtime are rejected before dlopen(),
+//   avoiding the cost and side effects (constructors, dependencies) of loading them
+mfxStatus LoaderCtxVPL::ProbeSingleLibrary(LibInfo *libInfo) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (!HasRequiredExports(libInfo))
+        return MFX_ERR_UNSUPPORTED;
+#endif
+
+    // load DLL
+    mfxStatus sts = LoadSingleLibrary(libInfo);
+
+    // load video functions: pointers to exposed functions
+    // not all function pointers may be filled in (depends on API version)
+    if (sts == MFX_ERR_NONE && libInfo->hModuleVPL)
+        LoadAPIExports(libInfo, LibTypeVPL);
+
+    return sts;
+}
+
 VPLFunctionPtr LoaderCtxVPL::GetFunctionAddr(void *hModuleVPL, const char *pName) {
     VPLFunctionPtr pProc = nullptr;
 
@@ -735,6 +885,8 @@ mfxStatus LoaderCtxVPL::LoadSingleLibrary(LibInfo *libInfo) {
     if (!libInfo)
         return MFX_ERR_NULL_PTR;
 
+    LoaderPhaseTimer phaseTimer(this, LoaderPhaseLoad, libInfo);
+
 #if defined(_WIN32) || defined(_WIN64)
     libInfo->hModuleVPL = MFX::mfx_dll_load(libInfo->libNameFull.c_str());
 #else
@@ -747,6 +899,30 @@ mfxStatus LoaderCtxVPL::LoadSingleLibrary(LibInfo *libInfo) {
     return MFX_ERR_NONE;
 }
 
+// add a library or implementation to the per-loader store, returns nullptr if out of memory
+// the caller adds it to m_libInfoList or m_implInfoList
+LibInfo *LoaderCtxVPL::NewLibInfo() {
+    try {
+        m_libInfoStore.emplace_back();
+    }
+    catch (...) {
+        return nullptr;
+    }
+
+    return &m_libInfoStore.back();
+}
+
+ImplInfo *LoaderCtxVPL::NewImplInfo() {
+    try {
+        m_implInfoStore.emplace_back();
+    }
+    catch (...) {
+        return nullptr;
+    }
+
+    return &m_implInfoStore.back();
+}
+
 // unload single runtime
 mfxStatus LoaderCtxVPL::UnloadSingleLibrary(LibInfo *libInfo) {
     if (libInfo) {
@@ -757,7 +933,16 @@ mfxStatus LoaderCtxVPL::UnloadSingleLibrary(LibInfo *libInfo) {
             dlclose(libInfo->hModuleVPL);
 #endif
         }
-        delete libInfo;
+
+        // keep timing of rejected libraries for MFXQueryLoaderTiming()
+        {
+            std::lock_guard<std::mutex> lock(m_timingLock);
+            m_unloadedLibTiming.push_back(libInfo->timing);
+            m_unloadedLibTiming.back().libNameFull = libInfo->libNameFull;
+        }
+
+        // LibInfo stays in m_libInfoStore until UnloadAllLibraries()
+        libInfo->hModuleVPL = nullptr;
         return MFX_ERR_NONE;
     }
     else {
@@ -770,7 +955,7 @@ mfxStatus LoaderCtxVPL::UnloadSingleLibrary(LibInfo *libInfo) {
 mfxStatus LoaderCtxVPL::UnloadAllLibraries() {
     DISP_LOG_FUNCTION(&m_dispLog);
 
-    std::list<ImplInfo *>::iterator it2 = m_implInfoList.begin();
+    std::vector<ImplInfo *>::iterator it2 = m_implInfoList.begin();
     while (it2 != m_implInfoList.end()) {
         ImplInfo *implInfo = (*it2);
 
@@ -781,7 +966,7 @@ mfxStatus LoaderCtxVPL::UnloadAllLibraries() {
     }
 
     // lastly, unload and destroy LibInfo for each library
-    std::list<LibInfo *>::iterator it = m_libInfoList.begin();
+    std::vector<LibInfo *>::iterator it = m_libInfoList.begin();
     while (it != m_libInfoList.end()) {
         LibInfo *libInfo = (*it);
 
@@ -793,8 +978,14 @@ mfxStatus LoaderCtxVPL::UnloadAllLibraries() {
 
     m_implInfoList.clear();
     m_libInfoList.clear();
+    m_implInfoStore.clear();
+    m_libInfoStore.clear();
     m_implIdxNext = 0;
 
+    // stored selections refer to the implementations which were just freed
+    m_selectionCache.clear();
+    m_selectionImpls.clear();
+
     return MFX_ERR_NONE;
 }
 
@@ -809,7 +1000,8 @@ mfxStatus LoaderCtxVPL::UnloadSingleImplementation(ImplInfo *implInfo) {
         //   was never called by the application
         // this is a valid scenario, e.g. app did not call MFXEnumImplementations()
         //   and just used the first available implementation provided by dispatcher
-        if (libInfo->libType == LibTypeVPL) {
+        // caps from the persistent cache are owned by the cache, not the runtime
+        if (libInfo->libType == LibTypeVPL && !libInfo->capsCacheEntry) {
             if (implInfo->implDesc) {
                 // MFX_IMPLCAPS_IMPLDESCSTRUCTURE;
                 (*(mfxStatus(MFX_CDECL *)(mfxHDL))pFunc)(implInfo->implDesc);
@@ -838,7 +1030,6 @@ mfxStatus LoaderCtxVPL::UnloadSingleImplementation(ImplInfo *implInfo) {
 
             // nothing to do if (capsFormat == MFX_IMPLCAPS_IMPLPATH) since no new memory was allocated
         }
-        delete implInfo;
         return MFX_ERR_NONE;
     }
     else {
@@ -896,24 +1087,217 @@ mfxStatus LoaderCtxVPL::ValidateAPIExports(VPLFunctionPtr *vplFuncTable,
 }
 
 // convert full path into char* for MFX_IMPLCAPS_IMPLPATH query
-mfxStatus LoaderCtxVPL::UpdateImplPath(LibInfo *libInfo) {
+// convert full path of library to 8-bit string
+static mfxStatus ConvertLibPath(const STRING_TYPE &libNameFull, std::string &path) {
 #if defined(_WIN32) || defined(_WIN64)
     // Windows - strings are 16-bit
-    size_t nCvt = 0;
-    if (wcstombs_s(&nCvt,
-                   libInfo->implCapsPath,
-                   sizeof(libInfo->implCapsPath),
-                   libInfo->libNameFull.c_str(),
-                   _TRUNCATE)) {
+    mfxChar libPath[MAX_VPL_SEARCH_PATH] = {};
+    size_t nCvt                          = 0;
+    if (wcstombs_s(&nCvt, libPath, sizeof(libPath), libNameFull.c_str(), _TRUNCATE)) {
         // unknown error - set to empty string
-        libInfo->implCapsPath[0] = 0;
+        path.clear();
         return MFX_ERR_UNSUPPORTED;
     }
+    path = libPath;
 #else
     // Linux - strings are 8-bit
-    strncpy(libInfo->implCapsPath, libInfo->libNameFull.c_str(), sizeof(libInfo->implCapsPath) - 1);
+    path = libNameFull;
+#endif
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus LoaderCtxVPL::UpdateImplPath(LibInfo *libInfo) {
+    return ConvertLibPath(libInfo->libNameFull, libInfo->implCapsPath);
+}
+
+// return true if results for this library may be read from or written to the persistent caps cache
+// applies to both the persistent caps cache and the runtime registry
+bool LoaderCtxVPL::IsCapsCacheAllowed(LibInfo *libInfo) {
+    if ((!m_capsCache.IsEnabled() && !m_registry) || m_bLowLatency)
+        return false;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    // results of property-based query depend on the application's filters
+    if (m_bEnablePropsQuery)
+        return false;
+#endif
+
+    return true;
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+// libraries found in legacy search locations are only accepted as MSDK runtimes
+// the same library may also be found in a 2.x search location, so only MSDK results are
+//   read from or written to the cache for these locations
+static bool IsLegacySearchPath(LibInfo *libInfo) {
+    return (libInfo->libPriority >= LIB_PRIORITY_LEGACY_DRIVERSTORE);
+}
+#endif
+
+const CapsCacheEntry *LoaderCtxVPL::FindCachedCaps(LibInfo *libInfo) {
+#if defined(_WIN32) || defined(_WIN64)
+    // not currently supported on Windows
+    return nullptr;
+#else
+    if (!IsCapsCacheAllowed(libInfo))
+        return nullptr;
+
+    const CapsCacheEntry *cacheEntry = nullptr;
+
+    // runtime registry also provides the function table, so check it first
+    // MSDK runtimes are not shared through the registry
+    if (m_registry && !IsLegacySearchPath(libInfo)) {
+        cacheEntry = m_registry->Find(libInfo->libNameFull, libInfo->runtimeFuncTable);
+        if (cacheEntry) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  runtime registry hit -- %s",
+                             libInfo->libNameFull.c_str());
+            return cacheEntry;
+        }
+
+        DISP_LOG_MESSAGE(&m_dispLog,
+                         "message:  runtime registry miss -- %s",
+                         libInfo->libNameFull.c_str());
+    }
+
+    if (m_capsCache.IsEnabled()) {
+        cacheEntry = m_capsCache.Find(libInfo->libNameFull);
+        if (cacheEntry && !cacheEntry->bMSDK && IsLegacySearchPath(libInfo))
+            cacheEntry = nullptr;
+
+        if (cacheEntry) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  caps cache hit -- %s",
+                             libInfo->libNameFull.c_str());
+        }
+        else {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  caps cache miss -- %s",
+                             libInfo->libNameFull.c_str());
+        }
+    }
+
+    return cacheEntry;
+#endif
+}
+
+mfxStatus LoaderCtxVPL::StoreCachedCaps(LibInfo *libInfo,
+                                        bool bValidLib,
+                                        const std::vector<CapsCacheImpl> &cacheImpls) {
+#if defined(_WIN32) || defined(_WIN64)
+    // not currently supported on Windows
+    return MFX_ERR_UNSUPPORTED;
+#else
+    if (!IsCapsCacheAllowed(libInfo) || IsLegacySearchPath(libInfo))
+        return MFX_ERR_UNSUPPORTED;
+
+    mfxStatus sts = MFX_ERR_UNSUPPORTED;
+
+    if (m_registry) {
+        // share the function table as well, so other loaders can create sessions
+        //   without loading this library again
+        if (bValidLib && !libInfo->runtimeFuncTable && libInfo->hModuleVPL)
+            MFXCreateRuntimeFuncTable(libInfo->hModuleVPL,
+                                      libInfo->libNameFull.c_str(),
+                                      libInfo->runtimeFuncTable);
+
+        sts = (bValidLib ? m_registry->AddValidLib(libInfo->libNameFull,
+                                                   cacheImpls,
+                                                   libInfo->runtimeFuncTable)
+                         : m_registry->AddInvalidLib(libInfo->libNameFull));
+
+        if (sts == MFX_ERR_NONE) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  runtime registry stored -- %s",
+                             libInfo->libNameFull.c_str());
+        }
+    }
+
+    if (m_capsCache.IsEnabled()) {
+        sts = (bValidLib ? m_capsCache.AddValidLib(libInfo->libNameFull, cacheImpls)
+                         : m_capsCache.AddInvalidLib(libInfo->libNameFull));
+
+        if (sts == MFX_ERR_NONE) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  caps cache stored -- %s",
+                             libInfo->libNameFull.c_str());
+        }
+    }
+
+    return sts;
+#endif
+}
+
+// save the description of each MSDK adapter, so later processes do not need to open
+//   test sessions to build them
+// only called if at least one adapter is supported, failures are always queried again
+mfxStatus LoaderCtxVPL::StoreCachedCapsMSDK(LibInfo *libInfo,
+                                            const std::vector<CapsCacheImpl> &cacheImpls) {
+#if defined(_WIN32) || defined(_WIN64)
+    // not currently supported on Windows
+    return MFX_ERR_UNSUPPORTED;
+#else
+    if (!IsCapsCacheAllowed(libInfo) || !m_capsCache.IsEnabled())
+        return MFX_ERR_UNSUPPORTED;
+
+    mfxStatus sts = m_capsCache.AddMSDKLib(libInfo->libNameFull, libInfo->msdkVersion, cacheImpls);
+    if (sts == MFX_ERR_NONE) {
+        DISP_LOG_MESSAGE(&m_dispLog,
+                         "message:  caps cache stored -- %s",
+                         libInfo->libNameFull.c_str());
+    }
+
+    return sts;
+#endif
+}
+
+// create implementations from persistent cache without loading the library
+// exports were validated against the reported API version before the entry was stored
+mfxStatus LoaderCtxVPL::AddCachedImpls(LibInfo *libInfo) {
+    LoaderPhaseTimer phaseTimer(this, LoaderPhaseQuery, libInfo);
+
+    const CapsCacheEntry *cacheEntry = libInfo->capsCacheEntry;
+
+    // save user-friendly path for MFX_IMPLCAPS_IMPLPATH query (API >= 2.4)
+    UpdateImplPath(libInfo);
+
+    for (const CapsCacheImpl &cacheImpl : cacheEntry->impls) {
+        ImplInfo *implInfo = NewImplInfo();
+        if (!implInfo)
+            return MFX_ERR_MEMORY_ALLOC;
+
+        implInfo->libInfo         = libInfo;
+        implInfo->implDesc        = cacheImpl.implDesc;
+        implInfo->implFuncs       = cacheImpl.implFuncs;
+        implInfo->implExtDeviceID = cacheImpl.implExtDeviceID;
+#ifdef ONEVPL_EXPERIMENTAL
+        implInfo->implSurfTypes = cacheImpl.implSurfTypes;
 #endif
 
+        memset(&(implInfo->vplParam), 0, sizeof(mfxInitializationParam));
+        implInfo->vplParam.AccelerationMode = cacheImpl.implDesc->AccelerationMode;
+        implInfo->version                   = cacheImpl.implDesc->ApiVersion;
+
+        if (libInfo->libType == LibTypeMSDK) {
+            // adapter number, the runtime is loaded by MFXInitEx2() during CreateSession
+            mfxU32 adapterIdx = cacheImpl.libImplIdx;
+
+            libInfo->msdkCtx[adapterIdx].m_msdkAdapter     = msdkImplTab[adapterIdx];
+            libInfo->msdkCtx[adapterIdx].m_msdkAdapterD3D9 = cacheImpl.msdkAdapterD3D9;
+
+            implInfo->msdkImplIdx = adapterIdx;
+            implInfo->libImplIdx  = 0;
+        }
+        else {
+            implInfo->libImplIdx = cacheImpl.libImplIdx;
+        }
+
+        implInfo->validImplIdx = m_implIdxNext++;
+
+        m_implInfoList.push_back(implInfo);
+    }
+
     return MFX_ERR_NONE;
 }
 
@@ -942,100 +1326,188 @@ bool LoaderCtxVPL::IsValidX86GPU(ImplInfo *implInfo, mfxU32 &deviceID, mfxU32 &a
     return false;
 }
 
+// call MFXQueryImplsDescription() for each supported caps format
+// does not modify loader state, so may be called for several libraries in parallel
+mfxStatus LoaderCtxVPL::QuerySingleLibraryCaps(LibInfo *libInfo, LibCapsQuery &capsQuery) {
+    LoaderPhaseTimer phaseTimer(this, LoaderPhaseQuery, libInfo);
+
+    VPLFunctionPtr pFunc = libInfo->vplFuncTable[IdxMFXQueryImplsDescription];
+
+#ifdef ONEVPL_EXPERIMENTAL
+    VPLFunctionPtr pFuncProps = libInfo->vplOptionalFuncTable[IdxMFXQueryImplsProperties];
+#endif
+
+    capsQuery = {};
+
+    if (m_bLowLatency == false) {
+#ifdef ONEVPL_EXPERIMENTAL
+        // attempt property-based query if requested by application and RT supports the function
+        // otherwise just do full query
+        if (m_bEnablePropsQuery == true && pFuncProps != nullptr) {
+            // create temporary array of pointers to each mfxQueryProperty for C RT API
+            std::vector<mfxQueryProperty *> queryProps;
+            for (mfxU32 i = 0; i < m_queryProps.size(); i++)
+                queryProps.push_back(&m_queryProps[i]);
+
+            capsQuery.hImpl = (*(mfxHDL * (MFX_CDECL *)(mfxQueryProperty **, mfxU32, mfxU32 *))
+                                   pFuncProps)(queryProps.data(),
+                                               (mfxU32)queryProps.size(),
+                                               &capsQuery.numImpls);
+        }
+        else {
+#endif
+            // call MFXQueryImplsDescription() for this implementation
+            // return handle to description in requested format
+            capsQuery.hImpl = (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
+                                   pFunc)(MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &capsQuery.numImpls);
+#ifdef ONEVPL_EXPERIMENTAL
+        }
+#endif
+        // validate description pointer for each implementation
+        if (!capsQuery.hImpl)
+            return MFX_ERR_UNSUPPORTED;
+
+        for (mfxU32 i = 0; i < capsQuery.numImpls; i++) {
+            if (!capsQuery.hImpl[i])
+                return MFX_ERR_UNSUPPORTED;
+        }
+
+        capsQuery.hImplExtDeviceID =
+            (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
+                 pFunc)(MFX_IMPLCAPS_DEVICE_ID_EXTENDED, &capsQuery.numImplsExtDeviceID);
+
+#ifdef ONEVPL_EXPERIMENTAL
+        capsQuery.hImplSurfTypes =
+            (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
+                 pFunc)(MFX_IMPLCAPS_SURFACE_TYPES, &capsQuery.numImplsSurfTypes);
+#endif
+    }
+
+    // query for list of implemented functions
+    // prior to API 2.2, this will return null since the format was not defined yet
+    //   so we need to check whether the returned handle is valid before attempting to use it
+    capsQuery.hImplFuncs = (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
+                                pFunc)(MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS, &capsQuery.numImplsFuncs);
+
+    return MFX_ERR_NONE;
+}
+
+// run task(0) ... task(numTasks - 1) on a pool of m_numProbeThreads worker threads
+// tasks are assigned in order, but may complete in any order
+void LoaderCtxVPL::RunParallelProbe(mfxU32 numTasks, const std::function<void(mfxU32)> &task) {
+    std::atomic<mfxU32> nextTask(0);
+
+    auto worker = [&]() {
+        mfxU32 idx;
+        while ((idx = nextTask++) < numTasks) {
+            try {
+                task(idx);
+            }
+            catch (...) {
+                // task results stay unset, caller will retry serially
+            }
+        }
+    };
+
+    mfxU32 numThreads = (std::min)(m_numProbeThreads, numTasks);
+
+    std::vector<std::thread> threads;
+    for (mfxU32 i = 1; i < numThreads; i++) {
+        try {
+            threads.emplace_back(worker);
+        }
+        catch (...) {
+            // failed to create thread - continue with fewer workers
+            break;
+        }
+    }
+
+    // calling thread is also a worker
+    worker();
+
+    for (auto &t : threads)
+        t.join();
+}
+
 // query capabilities of all valid libraries
 //   and add to list for future calls to EnumImplementations()
 //   as well as filtering by functionality
 // assume MFX_IMPLCAPS_IMPLDESCSTRUCTURE is the only format supported
 mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
     DISP_LOG_FUNCTION(&m_dispLog);
+    LoaderPhaseTimer phaseTimer(this, LoaderPhaseQuery);
 
     mfxStatus sts = MFX_ERR_NONE;
 
-    std::list<LibInfo *>::iterator it = m_libInfoList.begin();
-    while (it != m_libInfoList.end()) {
-        LibInfo *libInfo = (*it);
-
-        if (libInfo->libType == LibTypeVPL) {
-            VPLFunctionPtr pFunc = libInfo->vplFuncTable[IdxMFXQueryImplsDescription];
-
-#ifdef ONEVPL_EXPERIMENTAL
-            VPLFunctionPtr pFuncProps = libInfo->vplOptionalFuncTable[IdxMFXQueryImplsProperties];
-#endif
+    // optionally query 2.x libraries in parallel, results are added below in priority order
+    // skip duplicate handles so that a runtime is never queried from two threads at once
+    std::vector<LibCapsQuery> probeCaps;
+    std::vector<mfxStatus> probeSts;
+    if (m_numProbeThreads > 1 && m_bLowLatency == false) {
+        std::vector<LibInfo *> probeLibs(m_libInfoList.begin(), m_libInfoList.end());
+        probeCaps.resize(probeLibs.size());
+        probeSts.resize(probeLibs.size(), MFX_ERR_NOT_INITIALIZED);
+
+        RunParallelProbe((mfxU32)probeLibs.size(), [&](mfxU32 idx) {
+            LibInfo *libInfo = probeLibs[idx];
+            if (libInfo->libType != LibTypeVPL || libInfo->capsCacheEntry)
+                return;
+
+            for (mfxU32 i = 0; i < idx; i++) {
+                if (probeLibs[i]->hModuleVPL == libInfo->hModuleVPL)
+                    return;
+            }
 
-            // handle to implDesc structure, null in low-latency mode (no query)
-            mfxHDL *hImpl   = nullptr;
-            mfxU32 numImpls = 0;
+            probeSts[idx] = QuerySingleLibraryCaps(libInfo, probeCaps[idx]);
+        });
+    }
 
-            mfxHDL *hImplExtDeviceID   = nullptr;
-            mfxU32 numImplsExtDeviceID = 0;
+    std::vector<LibInfo *>::iterator it = m_libInfoList.begin();
+    for (mfxU32 libIdx = 0; it != m_libInfoList.end(); libIdx++) {
+        LibInfo *libInfo = (*it);
 
-#ifdef ONEVPL_EXPERIMENTAL
-            mfxHDL *hImplSurfTypes   = nullptr;
-            mfxU32 numImplsSurfTypes = 0;
-#endif
+        if (libInfo->capsCacheEntry) {
+            // library was not loaded, use caps from persistent cache
+            sts = AddCachedImpls(libInfo);
+            if (sts != MFX_ERR_NONE)
+                return sts;
+        }
+        else if (libInfo->libType == LibTypeVPL) {
+            LibCapsQuery capsQuery = {};
+            mfxStatus querySts     = MFX_ERR_NOT_INITIALIZED;
+
+            if (libIdx < probeSts.size() && probeSts[libIdx] != MFX_ERR_NOT_INITIALIZED) {
+                // already queried by RunParallelProbe()
+                capsQuery = probeCaps[libIdx];
+                querySts  = probeSts[libIdx];
+            }
+            else {
+                querySts = QuerySingleLibraryCaps(libInfo, capsQuery);
+            }
 
-            if (m_bLowLatency == false) {
-#ifdef ONEVPL_EXPERIMENTAL
-                // attempt property-based query if requested by application and RT supports the function
-                // otherwise just do full query
-                if (m_bEnablePropsQuery == true && pFuncProps != nullptr) {
-                    // create temporary array of pointers to each mfxQueryProperty for C RT API
-                    std::vector<mfxQueryProperty *> queryProps;
-                    for (mfxU32 i = 0; i < m_queryProps.size(); i++)
-                        queryProps.push_back(&m_queryProps[i]);
-
-                    hImpl =
-                        (*(mfxHDL * (MFX_CDECL *)(mfxQueryProperty **, mfxU32, mfxU32 *))
-                             pFuncProps)(queryProps.data(), (mfxU32)queryProps.size(), &numImpls);
-                }
-                else {
-#endif
-                    // call MFXQueryImplsDescription() for this implementation
-                    // return handle to description in requested format
-                    hImpl = (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
-                                 pFunc)(MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &numImpls);
-#ifdef ONEVPL_EXPERIMENTAL
-                }
-#endif
-                // validate description pointer for each implementation
-                bool b_isValidDesc = true;
-                if (!hImpl) {
-                    b_isValidDesc = false;
-                }
-                else {
-                    for (mfxU32 i = 0; i < numImpls; i++) {
-                        if (!hImpl[i]) {
-                            b_isValidDesc = false;
-                            break;
-                        }
-                    }
-                }
+            if (querySts != MFX_ERR_NONE) {
+                // the required function is implemented incorrectly
+                // remove this library from the list of valid libraries
+                StoreCachedCaps(libInfo, false, std::vector<CapsCacheImpl>());
+                UnloadSingleLibrary(libInfo);
+                it = m_libInfoList.erase(it);
+                continue;
+            }
 
-                if (!b_isValidDesc) {
-                    // the required function is implemented incorrectly
-                    // remove this library from the list of valid libraries
-                    UnloadSingleLibrary(libInfo);
-                    it = m_libInfoList.erase(it);
-                    continue;
-                }
+            // handle to implDesc structure, null in low-latency mode (no query)
+            mfxHDL *hImpl   = capsQuery.hImpl;
+            mfxU32 numImpls = capsQuery.numImpls;
 
-                hImplExtDeviceID =
-                    (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
-                         pFunc)(MFX_IMPLCAPS_DEVICE_ID_EXTENDED, &numImplsExtDeviceID);
+            mfxHDL *hImplExtDeviceID   = capsQuery.hImplExtDeviceID;
+            mfxU32 numImplsExtDeviceID = capsQuery.numImplsExtDeviceID;
 
 #ifdef ONEVPL_EXPERIMENTAL
-                hImplSurfTypes = (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
-                                      pFunc)(MFX_IMPLCAPS_SURFACE_TYPES, &numImplsSurfTypes);
+            mfxHDL *hImplSurfTypes   = capsQuery.hImplSurfTypes;
+            mfxU32 numImplsSurfTypes = capsQuery.numImplsSurfTypes;
 #endif
-            }
 
-            // query for list of implemented functions
-            // prior to API 2.2, this will return null since the format was not defined yet
-            //   so we need to check whether the returned handle is valid before attempting to use it
-            mfxHDL *hImplFuncs   = nullptr;
-            mfxU32 numImplsFuncs = 0;
-            hImplFuncs           = (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
-                              pFunc)(MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS, &numImplsFuncs);
+            mfxHDL *hImplFuncs   = capsQuery.hImplFuncs;
+            mfxU32 numImplsFuncs = capsQuery.numImplsFuncs;
 
             // only report single impl, but application may still attempt to create session using
             //    any of VendorImplID via the DXGIAdapterIndex filter property
@@ -1045,8 +1517,11 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
             // save user-friendly path for MFX_IMPLCAPS_IMPLPATH query (API >= 2.4)
             UpdateImplPath(libInfo);
 
+            // caps of each valid implementation, saved to persistent cache if enabled
+            std::vector<CapsCacheImpl> cacheImpls;
+
             for (mfxU32 i = 0; i < numImpls; i++) {
-                ImplInfo *implInfo = new (std::nothrow) ImplInfo;
+                ImplInfo *implInfo = NewImplInfo();
                 if (!implInfo)
                     return MFX_ERR_MEMORY_ALLOC;
 
@@ -1091,8 +1566,8 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
 
                     mfxVersion queryVersion = {};
 
-                    // create test session to get API version
-                    sts = QuerySessionLowLatency(libInfo, i, &queryVersion);
+                    // get API version from the RT, or create test session if not supported
+                    sts = QueryVersionLowLatency(libInfo, i, &queryVersion);
                     if (sts != MFX_ERR_NONE) {
                         UnloadSingleImplementation(implInfo);
                         continue;
@@ -1118,9 +1593,26 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
 
                 // add implementation to overall list
                 m_implInfoList.push_back(implInfo);
+
+                if (m_bLowLatency == false) {
+                    CapsCacheImpl cacheImpl   = {};
+                    cacheImpl.libImplIdx      = implInfo->libImplIdx;
+                    cacheImpl.implDesc        = (mfxImplDescription *)implInfo->implDesc;
+                    cacheImpl.implFuncs       = (mfxImplementedFunctions *)implInfo->implFuncs;
+                    cacheImpl.implExtDeviceID = (mfxExtendedDeviceId *)implInfo->implExtDeviceID;
+#ifdef ONEVPL_EXPERIMENTAL
+                    cacheImpl.implSurfTypes = (mfxSurfaceTypesSupported *)implInfo->implSurfTypes;
+#endif
+                    cacheImpls.push_back(cacheImpl);
+                }
             }
+
+            if (m_bLowLatency == false)
+                StoreCachedCaps(libInfo, true, cacheImpls);
         }
         else if (libInfo->libType == LibTypeMSDK) {
+            mfxU64 queryStartTime = GetLoaderTime();
+
             // save user-friendly path for MFX_IMPLCAPS_IMPLPATH query (API >= 2.4)
             UpdateImplPath(libInfo);
 
@@ -1138,6 +1630,9 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
                 maxImplMSDK = 1;
             }
 
+            // description of each supported adapter, saved to persistent cache if enabled
+            std::vector<CapsCacheImpl> cacheImpls;
+
             mfxU32 numImplMSDK = 0;
             for (mfxU32 i = 0; i < maxImplMSDK; i++) {
                 mfxImplDescription *implDesc         = nullptr;
@@ -1182,7 +1677,7 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
                     msdkCtx->m_msdkAdapterD3D9 = msdkImplTab[i];
                 }
 
-                ImplInfo *implInfo = new (std::nothrow) ImplInfo;
+                ImplInfo *implInfo = NewImplInfo();
                 if (!implInfo)
                     return MFX_ERR_MEMORY_ALLOC;
 
@@ -1242,8 +1737,23 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
 
                 // update number of valid MSDK adapters
                 numImplMSDK++;
+
+                if (m_bLowLatency == false) {
+                    CapsCacheImpl cacheImpl   = {};
+                    cacheImpl.libImplIdx      = i;
+                    cacheImpl.msdkAdapterD3D9 = msdkCtx->m_msdkAdapterD3D9;
+                    cacheImpl.implDesc        = implDesc;
+                    cacheImpl.implFuncs       = implFuncs;
+                    cacheImpl.implExtDeviceID = implExtDeviceID;
+                    cacheImpls.push_back(cacheImpl);
+                }
             }
 
+            AddPhaseTime(LoaderPhaseQuery, queryStartTime, libInfo);
+
+            if (!cacheImpls.empty())
+                StoreCachedCapsMSDK(libInfo, cacheImpls);
+
             if (numImplMSDK == 0) {
                 // error loading MSDK library in compatibility mode - remove from list
                 UnloadSingleLibrary(libInfo);
@@ -1258,7 +1768,7 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
         bool bD3D9Requested = (m_specialConfig.bIsSet_accelerationMode &&
                                m_specialConfig.accelerationMode == MFX_ACCEL_MODE_VIA_D3D9);
 
-        std::list<ImplInfo *>::iterator it2 = m_implInfoList.begin();
+        std::vector<ImplInfo *>::iterator it2 = m_implInfoList.begin();
         while (it2 != m_implInfoList.end()) {
             ImplInfo *implInfo = (*it2);
 
@@ -1295,13 +1805,17 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
                                 implDesc->Impl == MFX_IMPL_TYPE_HARDWARE && bMatchingDeviceID);
                     });
 
-                if (vplIdx != m_implInfoList.end() && bD3D9Requested == false)
+                if (vplIdx != m_implInfoList.end() && bD3D9Requested == false) {
                     implInfo->validImplIdx = -1;
+                    implInfo->bExcluded    = true;
+                }
 
                 // avoid loading Intel® VPL RT via compatibility entrypoint
                 if (msdkImplDesc && msdkImplDesc->ApiVersion.Major == 1 &&
-                    msdkImplDesc->ApiVersion.Minor == 255)
+                    msdkImplDesc->ApiVersion.Minor == 255) {
                     implInfo->validImplIdx = -1;
+                    implInfo->bExcluded    = true;
+                }
             }
 
             if (implInfo->libInfo->libType == LibTypeVPL && !implInfo->implDesc) {
@@ -1353,11 +1867,11 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
 
 // query implementation i
 mfxStatus LoaderCtxVPL::QueryImpl(mfxU32 idx, mfxImplCapsDeliveryFormat format, mfxHDL *idesc) {
-    DISP_LOG_FUNCTION(&m_dispLog);
+    DISP_LOG_FUNCTION_ARGS(&m_dispLog, "idx", idx, "format", format);
 
     *idesc = nullptr;
 
-    std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
+    std::vector<ImplInfo *>::iterator it = m_implInfoList.begin();
     while (it != m_implInfoList.end()) {
         ImplInfo *implInfo = (*it);
         if (implInfo->validImplIdx == (mfxI32)idx) {
@@ -1368,7 +1882,7 @@ mfxStatus LoaderCtxVPL::QueryImpl(mfxU32 idx, mfxImplCapsDeliveryFormat format,
                 *idesc = implInfo->implFuncs;
             }
             else if (format == MFX_IMPLCAPS_IMPLPATH) {
-                *idesc = implInfo->libInfo->implCapsPath;
+                *idesc = (mfxHDL)(implInfo->libInfo->implCapsPath.c_str());
             }
             else if (format == MFX_IMPLCAPS_DEVICE_ID_EXTENDED) {
                 *idesc = implInfo->implExtDeviceID;
@@ -1403,7 +1917,7 @@ mfxStatus LoaderCtxVPL::ReleaseImpl(mfxHDL idesc) {
     // all we get from the application is a handle to the descriptor,
     //   not the implementation associated with it, so we search
     //   through the full list until we find a match
-    std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
+    std::vector<ImplInfo *>::iterator it = m_implInfoList.begin();
     while (it != m_implInfoList.end()) {
         ImplInfo *implInfo                   = (*it);
         mfxImplCapsDeliveryFormat capsFormat = (mfxImplCapsDeliveryFormat)0; // unknown format
@@ -1416,7 +1930,7 @@ mfxStatus LoaderCtxVPL::ReleaseImpl(mfxHDL idesc) {
         else if (implInfo->implFuncs == idesc) {
             capsFormat = MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS;
         }
-        else if (implInfo->libInfo->implCapsPath == idesc) {
+        else if (implInfo->libInfo->implCapsPath.c_str() == idesc) {
             capsFormat = MFX_IMPLCAPS_IMPLPATH;
         }
         else if (implInfo->implExtDeviceID == idesc) {
@@ -1441,7 +1955,8 @@ mfxStatus LoaderCtxVPL::ReleaseImpl(mfxHDL idesc) {
             return MFX_ERR_NONE;
 
         // LibTypeMSDK does not require calling a release function
-        if (implInfo->libInfo->libType == LibTypeVPL) {
+        // caps from the persistent cache are owned by the cache, not the runtime
+        if (implInfo->libInfo->libType == LibTypeVPL && !implInfo->libInfo->capsCacheEntry) {
             // call MFXReleaseImplDescription() for this implementation
             VPLFunctionPtr pFunc = implInfo->libInfo->vplFuncTable[IdxMFXReleaseImplDescription];
 
@@ -1479,6 +1994,12 @@ mfxStatus LoaderCtxVPL::UpdateLowLatency() {
 
     m_bLowLatency = ConfigCtxVPL::CheckLowLatencyConfig(m_configCtxList, &m_specialConfig);
 
+    // full discovery was already started by MFXLoad(), so low latency mode would not save any work
+    if (m_bBackgroundDiscovery && m_bLowLatency) {
+        DISP_LOG_MESSAGE(&m_dispLog, "message:  low latency mode disabled by background discovery");
+        m_bLowLatency = false;
+    }
+
     return MFX_ERR_NONE;
 }
 
@@ -1494,25 +2015,154 @@ mfxStatus LoaderCtxVPL::UpdatePropsQuery() {
 }
 #endif
 
-mfxStatus LoaderCtxVPL::UpdateValidImplList(void) {
+// update state derived from the config filters after MFXCreateConfig() or
+//   MFXSetConfigFilterProperty(), must be called with the writer lock held
+mfxStatus LoaderCtxVPL::ApplyConfigChanges() {
+    if (!m_bConfigChanged)
+        return MFX_ERR_NONE;
+
+    mfxStatus sts = MFX_ERR_NONE;
+    {
+        std::lock_guard<std::mutex> configLock(m_configLock);
+        m_bConfigChanged = false;
+
+        sts = UpdateLowLatency();
+        if (sts)
+            return sts;
+
+#ifdef ONEVPL_EXPERIMENTAL
+        sts = UpdatePropsQuery();
+        if (sts)
+            return sts;
+#endif
+    }
+
+    m_bNeedUpdateValidImpls = true;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    if (m_bEnablePropsQuery && !m_bNeedFullQuery) {
+        // libraries were queried by background discovery before this filter was set
+        // nothing has been returned to the application yet, so query them again
+        if (m_bDiscoveryResultsUnused) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  property-based query set after background discovery, "
+                             "libraries will be queried again");
+            m_bDiscoveryResultsUnused = false;
+
+            sts = RequeryLibraryCaps();
+        }
+        else {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  property-based query set after libraries were queried, "
+                             "not used");
+        }
+    }
+#endif
+
+    return sts;
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+// query the libraries found by background discovery again with the current settings
+// libraries stay loaded, only their implementations are released and queried again
+mfxStatus LoaderCtxVPL::RequeryLibraryCaps() {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    for (ImplInfo *implInfo : m_implInfoList)
+        UnloadSingleImplementation(implInfo);
+
+    m_implInfoList.clear();
+    m_implInfoStore.clear();
+    m_implIdxNext = 0;
+
+    // stored selections refer to the implementations which were just freed
+    m_selectionCache.clear();
+    m_selectionImpls.clear();
+
+    // 2.x runtimes with caps from the persistent cache were not loaded, so load them now
+    std::vector<LibInfo *>::iterator it = m_libInfoList.begin();
+    while (it != m_libInfoList.end()) {
+        LibInfo *libInfo = (*it);
+
+        if (libInfo->libType == LibTypeVPL && libInfo->capsCacheEntry) {
+            libInfo->capsCacheEntry     = nullptr;
+            libInfo->timing.bCapsCached = false;
+
+            mfxStatus sts = ProbeSingleLibrary(libInfo);
+            if (sts != MFX_ERR_NONE || !libInfo->vplFuncTable[IdxMFXInitialize]) {
+                UnloadSingleLibrary(libInfo);
+                it = m_libInfoList.erase(it);
+                continue;
+            }
+        }
+        it++;
+    }
+
+    mfxStatus sts = QueryLibraryCaps();
+    if (sts != MFX_ERR_NONE) {
+        // start again from the beginning on the next call from the application
+        UnloadAllLibraries();
+        m_bNeedFullQuery = true;
+        return MFX_ERR_NONE;
+    }
+
+    m_bNeedUpdateValidImpls = true;
+
+    return MFX_ERR_NONE;
+}
+#endif
+
+mfxStatus LoaderCtxVPL::UpdateValidImplList(void) {
     DISP_LOG_FUNCTION(&m_dispLog);
+    LoaderPhaseTimer phaseTimer(this, LoaderPhaseFilter);
+
+    std::lock_guard<std::mutex> configLock(m_configLock);
 
     mfxStatus sts = MFX_ERR_NONE;
 
     mfxI32 validImplIdx = 0;
 
+    // non-filtering props do not depend on the implementation
+    ConfigCtxVPL::UpdateSpecialConfig(m_configCtxList, &m_specialConfig);
+
+    // skip validation if this set of filter props was already applied to the same caps
+    std::string selectionKey = ConfigCtxVPL::GetSelectionKey(m_configCtxList, &m_specialConfig);
+    if (ApplyCachedSelection(selectionKey)) {
+        m_bNeedUpdateValidImpls = false;
+        return MFX_ERR_NONE;
+    }
+
     // iterate over all libraries and update list of those that
     //   meet current current set of config props
-    std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
+    // results for each config are kept from the previous call, so only filters which
+    //   changed are checked again (in either direction, a filter may also be relaxed)
+    std::vector<ImplInfo *>::iterator it = m_implInfoList.begin();
     while (it != m_implInfoList.end()) {
         ImplInfo *implInfo = (*it);
 
-        // already invalidated by previous filter
-        if (implInfo->validImplIdx == -1) {
+        // never valid, independent of filters
+        if (implInfo->bExcluded) {
             it++;
             continue;
         }
 
+        // caps do not change after they are queried, so only flatten them again if
+        //   the description was replaced (e.g. queried later in low latency mode)
+#ifdef ONEVPL_EXPERIMENTAL
+        if (!implInfo->capsIndex.IsBuiltFrom(implInfo->implDesc, implInfo->implSurfTypes)) {
+#else
+        if (!implInfo->capsIndex.IsBuiltFrom(implInfo->implDesc, nullptr)) {
+#endif
+            ConfigCtxVPL::BuildCapsIndex((mfxImplDescription *)implInfo->implDesc,
+#ifdef ONEVPL_EXPERIMENTAL
+                                         (mfxSurfaceTypesSupported *)implInfo->implSurfTypes,
+#endif
+                                         implInfo->capsIndex);
+
+            // previous results were checked against the old description
+            implInfo->configResults.clear();
+        }
+
         // compare caps from this library vs. config filters
         sts = ConfigCtxVPL::ValidateConfig((mfxImplDescription *)implInfo->implDesc,
                                            (mfxImplementedFunctions *)implInfo->implFuncs,
@@ -1520,7 +2170,9 @@ mfxStatus LoaderCtxVPL::UpdateValidImplList(void) {
 #ifdef ONEVPL_EXPERIMENTAL
                                            (mfxSurfaceTypesSupported *)implInfo->implSurfTypes,
 #endif
+                                           implInfo->capsIndex,
                                            m_configCtxList,
+                                           implInfo->configResults,
                                            implInfo->libInfo->libType,
                                            &m_specialConfig);
 
@@ -1546,11 +2198,174 @@ mfxStatus LoaderCtxVPL::UpdateValidImplList(void) {
     // re-sort valid implementations according to priority rules in spec
     PrioritizeImplList();
 
+    SaveSelection(std::move(selectionKey));
+
     m_bNeedUpdateValidImpls = false;
 
     return MFX_ERR_NONE;
 }
 
+// return true if selections may be read from or written to the persistent caps cache
+// every implementation must come from a cache entry which is still valid, so the stored
+//   selection was made with the same caps
+bool LoaderCtxVPL::IsSelectionCacheAllowed() {
+#if defined(_WIN32) || defined(_WIN64)
+    // not currently supported on Windows
+    return false;
+#else
+    if (!m_capsCache.IsEnabled() || m_bLowLatency)
+        return false;
+
+    #ifdef ONEVPL_EXPERIMENTAL
+    // results of property-based query depend on the application's filters
+    if (m_bEnablePropsQuery)
+        return false;
+    #endif
+
+    for (ImplInfo *implInfo : m_implInfoList) {
+        LibInfo *libInfo = implInfo->libInfo;
+
+        const CapsCacheEntry *cacheEntry = m_capsCache.Find(libInfo->libNameFull);
+        if (!cacheEntry)
+            return false;
+
+        // caps may also have come from the runtime registry
+        if (libInfo->capsCacheEntry && libInfo->capsCacheEntry != cacheEntry)
+            return false;
+    }
+
+    return true;
+#endif
+}
+
+// return true if the implementations and their caps are the same as when the selections
+//   kept by this loader were made
+bool LoaderCtxVPL::IsSelectionImplListCurrent() const {
+    if (m_selectionImpls.size() != m_implInfoList.size())
+        return false;
+
+    for (size_t i = 0; i < m_implInfoList.size(); i++) {
+        const SelectionImplHandles &handles = m_selectionImpls[i];
+        ImplInfo *implInfo                  = m_implInfoList[i];
+
+        if (handles.implInfo != implInfo || handles.implDesc != implInfo->implDesc ||
+            handles.implFuncs != implInfo->implFuncs ||
+#ifdef ONEVPL_EXPERIMENTAL
+            handles.implSurfTypes != implInfo->implSurfTypes ||
+#endif
+            handles.implExtDeviceID != implInfo->implExtDeviceID)
+            return false;
+    }
+
+    return true;
+}
+
+// set validImplIdx of each implementation from a previous selection with the same filter props
+// returns false if there is none, or if it was made with different implementations
+bool LoaderCtxVPL::ApplyCachedSelection(const std::string &key) {
+    if (!m_selectionCache.empty() && IsSelectionImplListCurrent()) {
+        auto it = m_selectionCache.find(key);
+        if (it != m_selectionCache.end()) {
+            for (size_t i = 0; i < m_implInfoList.size(); i++)
+                m_implInfoList[i]->validImplIdx = it->second[i];
+
+            DISP_LOG_MESSAGE(&m_dispLog, "message:  selection reused from loader");
+            return true;
+        }
+    }
+
+    if (!IsSelectionCacheAllowed())
+        return false;
+
+    const CapsCacheSelection *selection = m_capsCache.FindSelection(key);
+    if (!selection || selection->impls.size() != m_implInfoList.size())
+        return false;
+
+    for (size_t i = 0; i < selection->impls.size(); i++) {
+        ImplInfo *implInfo = m_implInfoList[i];
+
+        if (selection->impls[i].libNameFull != implInfo->libInfo->libNameFull ||
+            selection->impls[i].libImplIdx != implInfo->libImplIdx)
+            return false;
+    }
+
+    for (size_t i = 0; i < selection->impls.size(); i++)
+        m_implInfoList[i]->validImplIdx = selection->impls[i].validImplIdx;
+
+    DISP_LOG_MESSAGE(&m_dispLog, "message:  selection reused from caps cache");
+
+    // keep in loader as well, so the next time it does not need to check the cache
+    SaveSelection(key);
+
+    return true;
+}
+
+// stored selections are dropped once a loader has applied this many different sets of filters
+#define MAX_LOADER_SELECTIONS 64
+
+// store result of UpdateValidImplList() for the current filter props
+void LoaderCtxVPL::SaveSelection(std::string key) {
+    if (IsSelectionCacheAllowed()) {
+        std::vector<CapsCacheSelectionImpl> cacheImpls;
+        for (ImplInfo *implInfo : m_implInfoList) {
+            CapsCacheSelectionImpl cacheImpl;
+            cacheImpl.libNameFull  = implInfo->libInfo->libNameFull;
+            cacheImpl.libImplIdx   = implInfo->libImplIdx;
+            cacheImpl.validImplIdx = implInfo->validImplIdx;
+
+            cacheImpls.push_back(cacheImpl);
+        }
+
+        // do not rewrite the cache file if the same result is already stored
+        const CapsCacheSelection *selection = m_capsCache.FindSelection(key);
+        bool bStored =
+            (selection && selection->impls.size() == cacheImpls.size() &&
+             std::equal(cacheImpls.begin(),
+                        cacheImpls.end(),
+                        selection->impls.begin(),
+                        [](const CapsCacheSelectionImpl &a, const CapsCacheSelectionImpl &b) {
+                            return (a.libNameFull == b.libNameFull &&
+                                    a.libImplIdx == b.libImplIdx &&
+                                    a.validImplIdx == b.validImplIdx);
+                        }));
+
+        // written to the cache file by MFXUnload(), so the writer lock is not held for the I/O
+        if (!bStored && m_capsCache.AddSelection(key, cacheImpls) == MFX_ERR_NONE) {
+            DISP_LOG_MESSAGE(&m_dispLog, "message:  selection stored in caps cache");
+        }
+    }
+
+    // selections made with the previous list of implementations are no longer valid
+    if (!IsSelectionImplListCurrent()) {
+        m_selectionCache.clear();
+        m_selectionImpls.clear();
+
+        for (ImplInfo *implInfo : m_implInfoList) {
+            SelectionImplHandles handles;
+            handles.implInfo        = implInfo;
+            handles.implDesc        = implInfo->implDesc;
+            handles.implFuncs       = implInfo->implFuncs;
+            handles.implExtDeviceID = implInfo->implExtDeviceID;
+#ifdef ONEVPL_EXPERIMENTAL
+            handles.implSurfTypes = implInfo->implSurfTypes;
+#endif
+            m_selectionImpls.push_back(handles);
+        }
+    }
+
+    // applications normally switch between a few sets of filters, so start over rather than
+    //   tracking which selection was used least recently
+    if (m_selectionCache.size() >= MAX_LOADER_SELECTIONS)
+        m_selectionCache.clear();
+
+    std::vector<mfxI32> validImplIdx;
+    validImplIdx.reserve(m_implInfoList.size());
+    for (ImplInfo *implInfo : m_implInfoList)
+        validImplIdx.push_back(implInfo->validImplIdx);
+
+    m_selectionCache[std::move(key)] = std::move(validImplIdx);
+}
+
 // From specification section "Intel® VPL Session":
 //
 // When the dispatcher searches for the implementation, it uses the following priority rules
@@ -1564,32 +2379,29 @@ mfxStatus LoaderCtxVPL::PrioritizeImplList(void) {
     // API 2.6 introduced special search location ONEVPL_PRIORITY_PATH
     // Libs here always have highest priority = LIB_PRIORITY_SPECIAL
     //   and are not sorted by the other priority rules,
-    //   so we move them to a temporary list before priority sorting and
-    //   then add back to the full implementation list at the end.
-    std::list<ImplInfo *> implInfoListPriority;
+    //   so we move them to the beginning of the list (keeping their order)
+    //   and only sort the implementations after them.
+    auto itSort = m_implInfoList.begin();
+    auto itEnd  = m_implInfoList.end();
     if (m_bPriorityPathEnabled) {
-        auto it = m_implInfoList.begin();
-        while (it != m_implInfoList.end()) {
-            ImplInfo *implInfo = (*it);
-
-            auto it2 = std::next(it, 1);
-            if (implInfo->libInfo->libPriority == LIB_PRIORITY_SPECIAL)
-                implInfoListPriority.splice(implInfoListPriority.end(), m_implInfoList, it);
-
-            it = it2;
-        }
+        itSort = std::stable_partition(m_implInfoList.begin(),
+                                       itEnd,
+                                       [](const ImplInfo *implInfo) {
+                                           return (implInfo->libInfo->libPriority ==
+                                                   LIB_PRIORITY_SPECIAL);
+                                       });
     }
 
     // stable sort - work from lowest to highest priority conditions
 
     // 4 - sort by search path priority
-    m_implInfoList.sort([](const ImplInfo *impl1, const ImplInfo *impl2) {
+    std::stable_sort(itSort, itEnd, [](const ImplInfo *impl1, const ImplInfo *impl2) {
         // prioritize lowest value for libPriority (1 = highest priority)
         return (impl1->libInfo->libPriority < impl2->libInfo->libPriority);
     });
 
     // 3 - sort by API version
-    m_implInfoList.sort([](const ImplInfo *impl1, const ImplInfo *impl2) {
+    std::stable_sort(itSort, itEnd, [](const ImplInfo *impl1, const ImplInfo *impl2) {
         mfxImplDescription *implDesc1 = (mfxImplDescription *)(impl1->implDesc);
         mfxImplDescription *implDesc2 = (mfxImplDescription *)(impl2->implDesc);
 
@@ -1598,7 +2410,7 @@ mfxStatus LoaderCtxVPL::PrioritizeImplList(void) {
     });
 
     // 2 - sort by general HW vs. VSI
-    m_implInfoList.sort([](const ImplInfo *impl1, const ImplInfo *impl2) {
+    std::stable_sort(itSort, itEnd, [](const ImplInfo *impl1, const ImplInfo *impl2) {
         mfxImplDescription *implDesc1 = (mfxImplDescription *)(impl1->implDesc);
         mfxImplDescription *implDesc2 = (mfxImplDescription *)(impl2->implDesc);
 
@@ -1608,7 +2420,7 @@ mfxStatus LoaderCtxVPL::PrioritizeImplList(void) {
     });
 
     // 1 - sort by implementation type (HW > SW)
-    m_implInfoList.sort([](const ImplInfo *impl1, const ImplInfo *impl2) {
+    std::stable_sort(itSort, itEnd, [](const ImplInfo *impl1, const ImplInfo *impl2) {
         mfxImplDescription *implDesc1 = (mfxImplDescription *)(impl1->implDesc);
         mfxImplDescription *implDesc2 = (mfxImplDescription *)(impl2->implDesc);
 
@@ -1616,15 +2428,10 @@ mfxStatus LoaderCtxVPL::PrioritizeImplList(void) {
         return (implDesc1->Impl > implDesc2->Impl);
     });
 
-    if (m_bPriorityPathEnabled) {
-        // add back unsorted ONEVPL_PRIORITY_PATH libs to beginning of list
-        m_implInfoList.splice(m_implInfoList.begin(), implInfoListPriority);
-    }
-
     // final pass - update index to match new priority order
     // validImplIdx will be the index associated with MFXEnumImplememntations()
-    mfxI32 validImplIdx                = 0;
-    std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
+    mfxI32 validImplIdx                  = 0;
+    std::vector<ImplInfo *>::iterator it = m_implInfoList.begin();
     while (it != m_implInfoList.end()) {
         ImplInfo *implInfo = (*it);
 
@@ -1637,15 +2444,28 @@ mfxStatus LoaderCtxVPL::PrioritizeImplList(void) {
     return MFX_ERR_NONE;
 }
 
+bool LoaderCtxVPL::NeedsUpdate(bool bCreateSession) const {
+    // filters changed since the last update
+    if (m_bConfigChanged)
+        return true;
+
+    // session creation in low latency mode does not use the full list of implementations
+    if (bCreateSession && m_bLowLatency)
+        return m_bNeedLowLatencyQuery;
+
+    return (m_bNeedFullQuery || m_bNeedUpdateValidImpls);
+}
+
+// does not modify loader state, so may be called from several threads at once
 mfxStatus LoaderCtxVPL::CreateSession(mfxU32 idx, mfxSession *session) {
-    DISP_LOG_FUNCTION(&m_dispLog);
+    DISP_LOG_FUNCTION_ARG(&m_dispLog, "idx", idx);
 
     mfxStatus sts = MFX_ERR_NONE;
 
     // find library with given implementation index
     // list of valid implementations (and associated indices) is updated
     //   every time a filter property is added/modified
-    std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
+    std::vector<ImplInfo *>::iterator it = m_implInfoList.begin();
     while (it != m_implInfoList.end()) {
         ImplInfo *implInfo = (*it);
 
@@ -1653,23 +2473,26 @@ mfxStatus LoaderCtxVPL::CreateSession(mfxU32 idx, mfxSession *session) {
             LibInfo *libInfo = implInfo->libInfo;
             mfxU16 deviceID  = 0;
 
+            // copy initialization params, since implInfo is shared by concurrent callers
+            mfxInitializationParam vplParam = implInfo->vplParam;
+
             // pass VendorImplID for this implementation (disambiguate if one
             //   library contains multiple implementations)
             // NOTE: implDesc may be null in low latency mode (RT query not called)
             //   so this value will not be available
             mfxImplDescription *implDesc = (mfxImplDescription *)(implInfo->implDesc);
             if (implDesc) {
-                implInfo->vplParam.VendorImplID = implDesc->VendorImplID;
+                vplParam.VendorImplID = implDesc->VendorImplID;
             }
 
             // set any special parameters passed in via SetConfigProperty
             // if application did not specify accelerationMode, use default
             if (m_specialConfig.bIsSet_accelerationMode)
-                implInfo->vplParam.AccelerationMode = m_specialConfig.accelerationMode;
+                vplParam.AccelerationMode = m_specialConfig.accelerationMode;
 
 #ifdef ONEVPL_EXPERIMENTAL
             if (m_specialConfig.bIsSet_DeviceCopy)
-                implInfo->vplParam.DeviceCopy = m_specialConfig.DeviceCopy;
+                vplParam.DeviceCopy = m_specialConfig.DeviceCopy;
 #endif
 
             // in low latency mode there was no implementation filtering, so check here
@@ -1681,7 +2504,7 @@ mfxStatus LoaderCtxVPL::CreateSession(mfxU32 idx, mfxSession *session) {
 
             mfxIMPL msdkImpl = 0;
             if (libInfo->libType == LibTypeMSDK) {
-                if (implInfo->vplParam.AccelerationMode == MFX_ACCEL_MODE_VIA_D3D9)
+                if (vplParam.AccelerationMode == MFX_ACCEL_MODE_VIA_D3D9)
                     msdkImpl = libInfo->msdkCtx[implInfo->msdkImplIdx].m_msdkAdapterD3D9;
                 else
                     msdkImpl = libInfo->msdkCtx[implInfo->msdkImplIdx].m_msdkAdapter;
@@ -1690,7 +2513,7 @@ mfxStatus LoaderCtxVPL::CreateSession(mfxU32 idx, mfxSession *session) {
             // in low latency mode implDesc is not available, but application may set adapter number via DXGIAdapterIndex filter
             if (m_bLowLatency) {
                 if (m_specialConfig.bIsSet_dxgiAdapterIdx && libInfo->libType == LibTypeVPL) {
-                    implInfo->vplParam.VendorImplID = m_specialConfig.dxgiAdapterIdx;
+                    vplParam.VendorImplID = m_specialConfig.dxgiAdapterIdx;
                 }
                 else if (m_specialConfig.bIsSet_dxgiAdapterIdx && libInfo->libType == LibTypeMSDK) {
                     if (m_specialConfig.dxgiAdapterIdx >= MAX_NUM_IMPL_MSDK)
@@ -1724,18 +2547,41 @@ mfxStatus LoaderCtxVPL::CreateSession(mfxU32 idx, mfxSession *session) {
             }
 
             // attach vector of extBufs to mfxInitializationParam
-            implInfo->vplParam.NumExtParam = static_cast<mfxU16>(extBufs.size());
-            implInfo->vplParam.ExtParam =
-                (implInfo->vplParam.NumExtParam ? extBufs.data() : nullptr);
-
-            // initialize this library via MFXInitialize or else fail
-            //   (specify full path to library)
-            sts = MFXInitEx2(implInfo->version,
-                             implInfo->vplParam,
-                             msdkImpl,
-                             session,
-                             &deviceID,
-                             (CHAR_TYPE *)libInfo->libNameFull.c_str());
+            vplParam.NumExtParam = static_cast<mfxU16>(extBufs.size());
+            vplParam.ExtParam    = (vplParam.NumExtParam ? extBufs.data() : nullptr);
+
+            mfxU64 initStartTime = GetLoaderTime();
+
+#if !defined(_WIN32) && !defined(_WIN64)
+            // reuse the handle opened during discovery and resolve the exported functions
+            //   only once per library, so each new session only costs the RT initialization
+            // if this fails (e.g. caps read from cache, library not loaded) fall back to MFXInitEx2
+            std::call_once(libInfo->runtimeFuncTableOnce, [libInfo]() {
+                if (!libInfo->runtimeFuncTable && libInfo->hModuleVPL)
+                    MFXCreateRuntimeFuncTable(libInfo->hModuleVPL,
+                                              libInfo->libNameFull.c_str(),
+                                              libInfo->runtimeFuncTable);
+            });
+
+            if (libInfo->runtimeFuncTable) {
+                sts = MFXInitWithFuncTable(implInfo->version,
+                                           vplParam,
+                                           msdkImpl,
+                                           session,
+                                           libInfo->runtimeFuncTable);
+            }
+            else
+#endif
+            {
+                // initialize this library via MFXInitialize or else fail
+                //   (specify full path to library)
+                sts = MFXInitEx2(implInfo->version,
+                                 vplParam,
+                                 msdkImpl,
+                                 session,
+                                 &deviceID,
+                                 (CHAR_TYPE *)libInfo->libNameFull.c_str());
+            }
 
             // optionally call MFXSetHandle() if present via SetConfigProperty
             if (sts == MFX_ERR_NONE && m_specialConfig.bIsSet_deviceHandleType &&
@@ -1746,6 +2592,18 @@ mfxStatus LoaderCtxVPL::CreateSession(mfxU32 idx, mfxSession *session) {
                                              m_specialConfig.deviceHandle);
             }
 
+            // sessions are initialized in parallel if created from several threads, so the
+            //   loader total is the sum over all sessions rather than elapsed time
+            AddPhaseTime(LoaderPhaseInit, initStartTime, libInfo);
+            AddPhaseTime(LoaderPhaseInit, initStartTime);
+
+            // count open sessions for placement, MFXClose() decrements the count
+            if (sts == MFX_ERR_NONE && m_bTrackSessions) {
+                std::lock_guard<std::mutex> lock(m_placementLock);
+                GetSessionCount(implInfo);
+                TrackPlacedSession(*session, implInfo->sessionCount);
+            }
+
             return sts;
         }
         it++;
@@ -1779,7 +2637,7 @@ ConfigCtxVPL *LoaderCtxVPL::AddConfigFilter() {
 mfxStatus LoaderCtxVPL::FreeConfigFilters() {
     DISP_LOG_FUNCTION(&m_dispLog);
 
-    std::list<ConfigCtxVPL *>::iterator it = m_configCtxList.begin();
+    std::vector<ConfigCtxVPL *>::iterator it = m_configCtxList.begin();
 
     while (it != m_configCtxList.end()) {
         ConfigCtxVPL *config = (*it);
@@ -1791,6 +2649,68 @@ mfxStatus LoaderCtxVPL::FreeConfigFilters() {
     return MFX_ERR_NONE;
 }
 
+mfxStatus LoaderCtxVPL::AddSessionPool(mfxU32 implIdx,
+                                       mfxU32 minSessions,
+                                       mfxU32 maxSessions,
+                                       SessionPoolVPL **pool) {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    std::unique_ptr<SessionPoolVPL> poolCtx;
+    try {
+        poolCtx.reset(new SessionPoolVPL((mfxLoader)this, implIdx, minSessions, maxSessions));
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    // create initial sessions, pool is destroyed if any of them fail
+    mfxStatus sts = poolCtx->Init(&m_dispLog);
+    if (sts != MFX_ERR_NONE) {
+        DISP_LOG_MESSAGE(&m_dispLog, "message:  session pool init failed, sts = %d", sts);
+        return sts;
+    }
+
+    *pool = poolCtx.release();
+    {
+        std::unique_lock<std::shared_timed_mutex> writeLock(m_loaderLock);
+        m_sessionPoolList.push_back(*pool);
+    }
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus LoaderCtxVPL::FreeSessionPool(SessionPoolVPL *pool) {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    {
+        std::unique_lock<std::shared_timed_mutex> writeLock(m_loaderLock);
+
+        auto it = std::find(m_sessionPoolList.begin(), m_sessionPoolList.end(), pool);
+        if (it == m_sessionPoolList.end())
+            return MFX_ERR_INVALID_HANDLE;
+
+        m_sessionPoolList.erase(it);
+    }
+
+    // background thread may be waiting for m_loaderLock in MFXCreateSession()
+    delete pool;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus LoaderCtxVPL::FreeSessionPools() {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    while (!m_sessionPoolList.empty()) {
+        SessionPoolVPL *pool = m_sessionPoolList.front();
+        m_sessionPoolList.pop_front();
+
+        delete pool;
+    }
+
+    return MFX_ERR_NONE;
+}
+
 mfxStatus LoaderCtxVPL::InitDispatcherLog() {
     std::string strLogEnabled, strLogFile;
 
@@ -1825,6 +2745,10 @@ mfxStatus LoaderCtxVPL::InitDispatcherLog() {
         strLogFile = logFile;
 #endif
 
+    // binary trace, written in Chrome trace format at MFXUnload()
+    if (strLogEnabled == "TRACE")
+        return m_dispLog.InitTrace(strLogFile);
+
     if (strLogEnabled != "ON")
         return MFX_ERR_UNSUPPORTED;
 
@@ -1833,6 +2757,397 @@ mfxStatus LoaderCtxVPL::InitDispatcherLog() {
     return m_dispLog.Init(1, strLogFile);
 }
 
+mfxStatus LoaderCtxVPL::InitCapsCache() {
+#if defined(_WIN32) || defined(_WIN64)
+    // not currently supported on Windows
+    return MFX_ERR_UNSUPPORTED;
+#else
+    const char *cacheFile = std::getenv("ONEVPL_CAPS_CACHE_FILE");
+    if (!cacheFile || !cacheFile[0])
+        return MFX_ERR_UNSUPPORTED;
+
+    return m_capsCache.Init(cacheFile);
+#endif
+}
+
+mfxStatus LoaderCtxVPL::InitRuntimeRegistry() {
+#if defined(_WIN32) || defined(_WIN64)
+    // not currently supported on Windows
+    return MFX_ERR_UNSUPPORTED;
+#else
+    const char *runtimeRegistry = std::getenv("ONEVPL_RUNTIME_REGISTRY");
+    if (!runtimeRegistry || std::string(runtimeRegistry) != "ON")
+        return MFX_ERR_UNSUPPORTED;
+
+    m_registry = RuntimeRegistryVPL::Acquire();
+
+    return (m_registry ? MFX_ERR_NONE : MFX_ERR_UNSUPPORTED);
+#endif
+}
+
+mfxStatus LoaderCtxVPL::InitBackgroundDiscovery() {
+    std::string strBackgroundDiscovery;
+
+#if defined(_WIN32) || defined(_WIN64)
+    DWORD err;
+
+    char backgroundDiscovery[MAX_VPL_SEARCH_PATH] = "";
+    err = GetEnvironmentVariableA("ONEVPL_BACKGROUND_DISCOVERY",
+                                  backgroundDiscovery,
+                                  MAX_VPL_SEARCH_PATH);
+    if (err == 0 || err >= MAX_VPL_SEARCH_PATH)
+        return MFX_ERR_UNSUPPORTED; // environment variable not defined or string too long
+
+    strBackgroundDiscovery = backgroundDiscovery;
+#else
+    const char *backgroundDiscovery = std::getenv("ONEVPL_BACKGROUND_DISCOVERY");
+    if (!backgroundDiscovery)
+        return MFX_ERR_UNSUPPORTED;
+
+    strBackgroundDiscovery = backgroundDiscovery;
+#endif
+
+    if (strBackgroundDiscovery != "ON")
+        return MFX_ERR_UNSUPPORTED;
+
+    m_bBackgroundDiscovery = true;
+
+    m_discoveryThread = std::thread([this]() {
+        std::unique_lock<std::shared_timed_mutex> writeLock(m_loaderLock);
+
+        // application may already have enumerated or created a session from this loader
+        if (!m_bNeedFullQuery) {
+            DISP_LOG_MESSAGE(&m_dispLog, "message:  background discovery not needed");
+            return;
+        }
+
+        // use any filters which were set before discovery started (e.g. property-based query)
+        ApplyConfigChanges();
+
+        // on failure m_bNeedFullQuery is still set, so the next call from the application
+        //   retries and returns the error
+        mfxStatus sts = FullLoadAndQuery();
+        if (sts == MFX_ERR_NONE)
+            m_bDiscoveryResultsUnused = true;
+
+        DISP_LOG_MESSAGE(&m_dispLog, "message:  background discovery done, sts = %d", sts);
+    });
+
+    return MFX_ERR_NONE;
+}
+
+void LoaderCtxVPL::WaitBackgroundDiscovery() {
+    if (m_discoveryThread.joinable())
+        m_discoveryThread.join();
+}
+
+// write selections stored since the last load to the persistent caps cache, if enabled
+void LoaderCtxVPL::SaveCapsCache() {
+    m_capsCache.Save();
+}
+
+// maximum number of threads used to load and query libraries in parallel
+#define MAX_PROBE_THREADS 16
+
+mfxStatus LoaderCtxVPL::InitParallelProbe() {
+    std::string strProbeThreads;
+
+#if defined(_WIN32) || defined(_WIN64)
+    DWORD err;
+
+    char probeThreads[MAX_VPL_SEARCH_PATH] = "";
+    err = GetEnvironmentVariableA("ONEVPL_PROBE_THREADS", probeThreads, MAX_VPL_SEARCH_PATH);
+    if (err == 0 || err >= MAX_VPL_SEARCH_PATH)
+        return MFX_ERR_UNSUPPORTED; // environment variable not defined or string too long
+
+    strProbeThreads = probeThreads;
+#else
+    const char *probeThreads = std::getenv("ONEVPL_PROBE_THREADS");
+    if (!probeThreads)
+        return MFX_ERR_UNSUPPORTED;
+
+    strProbeThreads = probeThreads;
+#endif
+
+    // "ON" selects the number of hardware threads, otherwise parse thread count
+    // 0 or 1 keeps the default serial behavior
+    mfxU32 numThreads = 0;
+    if (strProbeThreads == "ON") {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    else {
+        try {
+            numThreads = (mfxU32)std::stoul(strProbeThreads);
+        }
+        catch (...) {
+            return MFX_ERR_UNSUPPORTED;
+        }
+    }
+
+    m_numProbeThreads = (std::min)(numThreads, (mfxU32)MAX_PROBE_THREADS);
+
+    return MFX_ERR_NONE;
+}
+
+void LoaderCtxVPL::AddPhaseTime(LoaderPhase phase, mfxU64 startTime, LibInfo *libInfo) {
+    mfxU64 endTime = GetLoaderTime();
+
+    std::lock_guard<std::mutex> lock(m_timingLock);
+
+    LoaderPhaseTiming &timing = (libInfo ? libInfo->timing.phases : m_timing);
+    timing.time[phase] += endTime - startTime;
+    timing.count[phase]++;
+
+    if (libInfo && libInfo->timing.startTime == 0)
+        libInfo->timing.startTime = startTime - m_timingStart;
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+// return a snapshot of the timing for the loader and each candidate library, including
+//   those which were rejected
+mfxStatus LoaderCtxVPL::QueryTiming(mfxLoaderTiming **timing) {
+    std::unique_ptr<TimingSnapshot> snapshot(new TimingSnapshot());
+
+    std::lock_guard<std::mutex> lock(m_timingLock);
+
+    struct LibTimingRef {
+        const LibTimingVPL *timing;
+        const STRING_TYPE *libNameFull;
+        bool bValid;
+    };
+
+    std::vector<LibTimingRef> libRefs;
+    for (const LibInfo *libInfo : m_libInfoList)
+        libRefs.push_back({ &libInfo->timing, &libInfo->libNameFull, true });
+    for (const LibTimingVPL &libTiming : m_unloadedLibTiming)
+        libRefs.push_back({ &libTiming, &libTiming.libNameFull, false });
+
+    // order in which the libraries were first processed, libraries with no timing last
+    auto sortKey = [](const LibTimingRef &ref) {
+        return ref.timing->startTime ? ref.timing->startTime : (mfxU64)-1;
+    };
+    std::stable_sort(libRefs.begin(),
+                     libRefs.end(),
+                     [&](const LibTimingRef &a, const LibTimingRef &b) {
+                         return sortKey(a) < sortKey(b);
+                     });
+
+    mfxU32 numLibs = (mfxU32)libRefs.size();
+    snapshot->libs.resize(numLibs);
+    snapshot->libPaths.resize(numLibs);
+
+    for (mfxU32 i = 0; i < numLibs; i++) {
+        const LibTimingVPL *libTiming = libRefs[i].timing;
+        mfxLibraryTiming &lib         = snapshot->libs[i];
+
+        ConvertLibPath(*libRefs[i].libNameFull, snapshot->libPaths[i]);
+
+        lib            = {};
+        lib.LibPath    = snapshot->libPaths[i].c_str();
+        lib.StartTime  = libTiming->startTime;
+        lib.Valid      = libRefs[i].bValid;
+        lib.CapsCached = libTiming->bCapsCached;
+        for (mfxU32 phase = 0; phase < NumLoaderPhases; phase++) {
+            lib.PhaseTime[phase]  = libTiming->phases.time[phase];
+            lib.PhaseCount[phase] = libTiming->phases.count[phase];
+        }
+    }
+
+    mfxLoaderTiming &loaderTiming = snapshot->timing;
+    loaderTiming                  = {};
+    loaderTiming.Version.Version  = MFX_LOADERTIMING_VERSION;
+    loaderTiming.NumLibraries     = numLibs;
+    loaderTiming.Libraries        = (numLibs ? snapshot->libs.data() : nullptr);
+    for (mfxU32 phase = 0; phase < NumLoaderPhases; phase++) {
+        loaderTiming.PhaseTime[phase]  = m_timing.time[phase];
+        loaderTiming.PhaseCount[phase] = m_timing.count[phase];
+    }
+
+    *timing = &snapshot->timing;
+    m_timingSnapshots.push_back(std::move(snapshot));
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus LoaderCtxVPL::ReleaseTiming(mfxLoaderTiming *timing) {
+    std::lock_guard<std::mutex> lock(m_timingLock);
+
+    auto it = std::find_if(m_timingSnapshots.begin(),
+                           m_timingSnapshots.end(),
+                           [timing](const std::unique_ptr<TimingSnapshot> &snapshot) {
+                               return &snapshot->timing == timing;
+                           });
+    if (it == m_timingSnapshots.end())
+        return MFX_ERR_INVALID_HANDLE;
+
+    m_timingSnapshots.erase(it);
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus LoaderCtxVPL::SetPlacementPolicy(mfxPlacementPolicy policy,
+                                           const mfxU32 *weights,
+                                           mfxU32 numWeights) {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    switch (policy) {
+        case MFX_PLACEMENT_POLICY_NONE:
+        case MFX_PLACEMENT_POLICY_ROUND_ROBIN:
+        case MFX_PLACEMENT_POLICY_LEAST_ACTIVE:
+            break;
+        case MFX_PLACEMENT_POLICY_WEIGHTED:
+            if (!weights)
+                return MFX_ERR_NULL_PTR;
+            break;
+        default:
+            return MFX_ERR_UNSUPPORTED;
+    }
+
+    std::lock_guard<std::mutex> lock(m_placementLock);
+
+    m_bTrackSessions  = true;
+    m_placementPolicy = policy;
+    m_placementNext   = 0;
+
+    if (policy == MFX_PLACEMENT_POLICY_WEIGHTED)
+        m_placementWeights.assign(weights, weights + numWeights);
+    else
+        m_placementWeights.clear();
+
+    return MFX_ERR_NONE;
+}
+
+// select an implementation according to the placement policy
+// caller holds m_placementLock and at least the reader lock
+ImplInfo *LoaderCtxVPL::SelectPlacedImpl() {
+    // valid implementations, ordered by index
+    std::vector<ImplInfo *> validImpls;
+    for (ImplInfo *implInfo : m_implInfoList) {
+        if (implInfo->validImplIdx < 0)
+            continue;
+
+        mfxU32 idx = (mfxU32)implInfo->validImplIdx;
+        if (idx >= validImpls.size())
+            validImpls.resize(idx + 1, nullptr);
+        validImpls[idx] = implInfo;
+    }
+
+    if (validImpls.empty())
+        return nullptr;
+
+    ImplInfo *selected = nullptr;
+
+    switch (m_placementPolicy) {
+        case MFX_PLACEMENT_POLICY_ROUND_ROBIN:
+            selected = validImpls[m_placementNext % validImpls.size()];
+            m_placementNext++;
+            break;
+
+        case MFX_PLACEMENT_POLICY_LEAST_ACTIVE:
+        case MFX_PLACEMENT_POLICY_WEIGHTED: {
+            // pick the lowest (numActive + 1) / weight, i.e. the implementation which is furthest
+            //   below its share after adding one session
+            // compared as a cross product to avoid division, ties go to the lower index
+            mfxU64 bestLoad   = 0;
+            mfxU64 bestWeight = 0;
+
+            for (size_t idx = 0; idx < validImpls.size(); idx++) {
+                ImplInfo *implInfo = validImpls[idx];
+                if (!implInfo)
+                    continue;
+
+                mfxU64 weight = 1;
+                if (m_placementPolicy == MFX_PLACEMENT_POLICY_WEIGHTED &&
+                    idx < m_placementWeights.size())
+                    weight = m_placementWeights[idx];
+
+                if (weight == 0)
+                    continue;
+
+                mfxU64 load = (mfxU64)GetSessionCount(implInfo)->numActive + 1;
+                if (!selected || load * bestWeight < bestLoad * weight) {
+                    selected   = implInfo;
+                    bestLoad   = load;
+                    bestWeight = weight;
+                }
+            }
+            break;
+        }
+
+        case MFX_PLACEMENT_POLICY_NONE:
+        default:
+            selected = validImpls[0];
+            break;
+    }
+
+    return selected;
+}
+
+mfxStatus LoaderCtxVPL::CreateSessionPlaced(mfxSession *session, mfxU32 *implIdx) {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    ImplInfo *implInfo        = nullptr;
+    mfxU32 idx                = 0;
+    mfxPlacementPolicy policy = MFX_PLACEMENT_POLICY_NONE;
+
+    // reserve one session on the selected implementation while it is initialized,
+    //   so concurrent callers see the pending session
+    {
+        std::lock_guard<std::mutex> lock(m_placementLock);
+
+        m_bTrackSessions = true;
+
+        implInfo = SelectPlacedImpl();
+        if (!implInfo)
+            return MFX_ERR_NOT_FOUND;
+
+        idx    = (mfxU32)implInfo->validImplIdx;
+        policy = m_placementPolicy;
+        GetSessionCount(implInfo)->numActive++;
+    }
+
+    // policy may be changed by another thread once the lock is released
+    DISP_LOG_MESSAGE(&m_dispLog,
+                     "message:  placement policy %d selected implementation %d",
+                     policy,
+                     idx);
+
+    mfxStatus sts = CreateSession(idx, session);
+
+    // CreateSession() counts the session itself if it succeeded
+    {
+        std::lock_guard<std::mutex> lock(m_placementLock);
+        implInfo->sessionCount->numActive--;
+    }
+
+    if (sts == MFX_ERR_NONE && implIdx)
+        *implIdx = idx;
+
+    return sts;
+}
+
+mfxStatus LoaderCtxVPL::QueryImplSessionCount(mfxU32 idx, mfxU32 *numActive) {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    for (ImplInfo *implInfo : m_implInfoList) {
+        if (implInfo->validImplIdx == (mfxI32)idx) {
+            std::lock_guard<std::mutex> lock(m_placementLock);
+            *numActive = (implInfo->sessionCount ? (mfxU32)implInfo->sessionCount->numActive : 0);
+            return MFX_ERR_NONE;
+        }
+    }
+
+    return MFX_ERR_NOT_FOUND;
+}
+#endif
+
+ImplSessionCount *LoaderCtxVPL::GetSessionCount(ImplInfo *implInfo) {
+    if (!implInfo->sessionCount)
+        implInfo->sessionCount = std::make_shared<ImplSessionCount>();
+
+    return implInfo->sessionCount.get();
+}
+
 // public function to return logger object
 // allows logging from C API functions outside of loaderCtx
 DispatcherLogVPL *LoaderCtxVPL::GetLogger() {
@@ -6,9 +6,78 @@
 
 #include "src/mfx_dispatcher_vpl_log.h"
 
-DispatcherLogVPL::DispatcherLogVPL() : m_logLevel(0), m_logFileName(), m_logFile(nullptr) {}
+#if defined(_WIN32) || defined(_WIN64)
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+
+// trace buffer most recently used by this thread, avoids taking m_traceLock on every event
+struct DispatcherTraceThreadCache {
+    mfxU64 traceID;
+    DispatcherTraceBuffer *buffer;
+};
+
+static thread_local DispatcherTraceThreadCache t_traceCache = { 0, nullptr };
+
+// IDs are never reused, so a cached buffer cannot belong to a newer logger at the same address
+static std::atomic<mfxU64> g_nextTraceID(1);
+
+// every traced function in the process, indexed by DispatcherTraceFunction::id
+// plain array of pointers to static objects, so it stays valid during static destruction
+static const DispatcherTraceFunction *g_traceFunctions[DISP_TRACE_MAX_FUNCTIONS];
+static std::atomic<mfxU32> g_numTraceFunctions(0);
+
+DispatcherTraceFunction::DispatcherTraceFunction(const char *fnName,
+                                                 const char *argName0,
+                                                 const char *argName1)
+        : id(DISP_TRACE_MAX_FUNCTIONS),
+          name(fnName),
+          argNames{ argName0, argName1 } {
+    mfxU32 fnId = g_numTraceFunctions++;
+    if (fnId < DISP_TRACE_MAX_FUNCTIONS) {
+        g_traceFunctions[fnId] = this;
+        id                     = fnId;
+    }
+}
+
+static mfxU64 GetTraceTime() {
+    return (mfxU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static void WriteTraceString(FILE *traceFile, const char *str) {
+    fputc('"', traceFile);
+    for (const char *c = str; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            fprintf(traceFile, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20)
+            fprintf(traceFile, "\\u%04x", (unsigned char)*c);
+        else
+            fputc(*c, traceFile);
+    }
+    fputc('"', traceFile);
+}
+
+DispatcherLogVPL::DispatcherLogVPL()
+        : m_logLevel(0),
+          m_bTrace(false),
+          m_logFileName(),
+          m_logFile(nullptr),
+          m_traceID(0),
+          m_traceStart(0),
+          m_traceLock(),
+          m_traceBuffers() {}
 
 DispatcherLogVPL::~DispatcherLogVPL() {
+    // trace is only written once, after the last API call on this loader
+    if (m_bTrace)
+        WriteTrace();
+
     if (!m_logFileName.empty() && m_logFile)
         fclose(m_logFile);
     m_logFile = nullptr;
@@ -48,10 +117,40 @@ mfxStatus DispatcherLogVPL::Init(mfxU32 logLevel, const std::string &logFileName
     return MFX_ERR_NONE;
 }
 
+mfxStatus DispatcherLogVPL::InitTrace(const std::string &traceFileName) {
+    if (m_logLevel)
+        return MFX_ERR_UNSUPPORTED;
+
+    // the file is opened when the trace is written
+    m_logFileName = traceFileName.empty() ? DISP_TRACE_DEF_FILENAME : traceFileName;
+    m_traceID     = g_nextTraceID++;
+    m_traceStart  = GetTraceTime();
+    m_bTrace      = true;
+    m_logLevel    = 1;
+
+    return MFX_ERR_NONE;
+}
+
 mfxStatus DispatcherLogVPL::LogMessage(const char *msg, ...) {
+    if (m_bTrace) {
+        va_list args;
+        va_start(args, msg);
+        TraceMessage(msg, args);
+        va_end(args);
+
+        return MFX_ERR_NONE;
+    }
+
     if (!m_logLevel || !m_logFile)
         return MFX_ERR_NONE;
 
+    // keep each message on a single line when several threads use the same loader
+#if defined(_WIN32) || defined(_WIN64)
+    _lock_file(m_logFile);
+#else
+    flockfile(m_logFile);
+#endif
+
     va_list args;
     va_start(args, msg);
     vfprintf(m_logFile, msg, args);
@@ -59,5 +158,176 @@ mfxStatus DispatcherLogVPL::LogMessage(const char *msg, ...) {
 
     fprintf(m_logFile, "\n");
 
+#if defined(_WIN32) || defined(_WIN64)
+    _unlock_file(m_logFile);
+#else
+    funlockfile(m_logFile);
+#endif
+
+    return MFX_ERR_NONE;
+}
+
+DispatcherTraceBuffer *DispatcherLogVPL::GetTraceBuffer() {
+    if (t_traceCache.traceID == m_traceID)
+        return t_traceCache.buffer;
+
+    std::thread::id threadId = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> lock(m_traceLock);
+
+    // thread may have used this logger before, then switched to another one
+    DispatcherTraceBuffer *buffer = nullptr;
+    for (auto &b : m_traceBuffers) {
+        if (b->threadId == threadId) {
+            buffer = b.get();
+            break;
+        }
+    }
+
+    if (!buffer) {
+        std::unique_ptr<DispatcherTraceBuffer> newBuffer(new DispatcherTraceBuffer);
+        newBuffer->threadId    = threadId;
+        newBuffer->threadIndex = (mfxU32)m_traceBuffers.size();
+        newBuffer->numEvents   = 0;
+
+        buffer = newBuffer.get();
+        m_traceBuffers.push_back(std::move(newBuffer));
+    }
+
+    t_traceCache.traceID = m_traceID;
+    t_traceCache.buffer  = buffer;
+
+    return buffer;
+}
+
+// return the slot for the next event of the calling thread, or nullptr if out of memory
+// the buffer only grows as events are added, so a short trace does not take the full ring
+DispatcherTraceEvent *DispatcherLogVPL::NextTraceEvent() {
+    DispatcherTraceBuffer *buffer = GetTraceBuffer();
+
+    DispatcherTraceEvent *event = nullptr;
+    if (buffer->events.size() < DISP_TRACE_MAX_EVENTS) {
+        try {
+            buffer->events.emplace_back();
+        }
+        catch (...) {
+            return nullptr;
+        }
+        event = &buffer->events.back();
+    }
+    else {
+        event = &buffer->events[buffer->numEvents % DISP_TRACE_MAX_EVENTS];
+    }
+
+    buffer->numEvents++;
+
+    return event;
+}
+
+void DispatcherLogVPL::TraceFunction(mfxU32 type,
+                                     const DispatcherTraceFunction &fn,
+                                     mfxU64 arg0,
+                                     mfxU64 arg1) {
+    DispatcherTraceEvent *event = NextTraceEvent();
+    if (!event)
+        return;
+
+    event->timestamp = GetTraceTime();
+    event->type      = type;
+    event->fnId      = fn.id;
+    event->args[0]   = arg0;
+    event->args[1]   = arg1;
+}
+
+void DispatcherLogVPL::TraceMessage(const char *msg, va_list args) {
+    DispatcherTraceEvent *event = NextTraceEvent();
+    if (!event)
+        return;
+
+    event->timestamp = GetTraceTime();
+    event->type      = DISP_TRACE_EVENT_MESSAGE;
+    vsnprintf(event->msg, sizeof(event->msg), msg, args);
+}
+
+// convert all buffers to Chrome trace event format
+mfxStatus DispatcherLogVPL::WriteTrace() {
+    FILE *traceFile = nullptr;
+#if defined(_WIN32) || defined(_WIN64)
+    fopen_s(&traceFile, m_logFileName.c_str(), "w");
+    int pid = _getpid();
+#else
+    traceFile = fopen(m_logFileName.c_str(), "w");
+    int pid   = getpid();
+#endif
+    if (!traceFile)
+        return MFX_ERR_UNKNOWN;
+
+    fprintf(traceFile, "{\"traceEvents\":[\n");
+    fprintf(traceFile,
+            "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,"
+            "\"args\":{\"name\":\"libvpl dispatcher\"}}",
+            pid);
+
+    for (auto &buffer : m_traceBuffers) {
+        mfxU64 numDropped = 0;
+        if (buffer->numEvents > DISP_TRACE_MAX_EVENTS)
+            numDropped = buffer->numEvents - DISP_TRACE_MAX_EVENTS;
+
+        fprintf(traceFile,
+                ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,"
+                "\"args\":{\"name\":\"thread %u (%llu events dropped)\"}}",
+                pid,
+                buffer->threadIndex,
+                buffer->threadIndex,
+                (unsigned long long)numDropped);
+
+        // oldest event first
+        for (mfxU64 i = numDropped; i < buffer->numEvents; i++) {
+            const DispatcherTraceEvent &event = buffer->events[i % DISP_TRACE_MAX_EVENTS];
+
+            // ts is in microseconds
+            mfxU64 timeNS = (event.timestamp > m_traceStart) ? event.timestamp - m_traceStart : 0;
+            fprintf(traceFile,
+                    ",\n{\"pid\":%d,\"tid\":%u,\"ts\":%llu.%03u,",
+                    pid,
+                    buffer->threadIndex,
+                    (unsigned long long)(timeNS / 1000),
+                    (unsigned int)(timeNS % 1000));
+
+            if (event.type == DISP_TRACE_EVENT_MESSAGE) {
+                fprintf(traceFile,
+                        "\"ph\":\"i\",\"s\":\"t\",\"name\":\"message\",\"args\":{\"msg\":");
+                WriteTraceString(traceFile, event.msg);
+                fprintf(traceFile, "}}");
+            }
+            else {
+                const DispatcherTraceFunction *fn = nullptr;
+                if (event.fnId < DISP_TRACE_MAX_FUNCTIONS)
+                    fn = g_traceFunctions[event.fnId];
+
+                fprintf(traceFile,
+                        "\"ph\":\"%s\",\"name\":",
+                        (event.type == DISP_TRACE_EVENT_BEGIN) ? "B" : "E");
+                WriteTraceString(traceFile, fn ? fn->name : "unknown");
+
+                // key arguments are saved with the enter event only
+                if (fn && event.type == DISP_TRACE_EVENT_BEGIN && fn->argNames[0]) {
+                    fprintf(traceFile, ",\"args\":{");
+                    for (mfxU32 j = 0; j < DISP_TRACE_MAX_ARGS && fn->argNames[j]; j++) {
+                        if (j > 0)
+                            fputc(',', traceFile);
+                        WriteTraceString(traceFile, fn->argNames[j]);
+                        fprintf(traceFile, ":%llu", (unsigned long long)event.args[j]);
+                    }
+                    fprintf(traceFile, "}");
+                }
+                fprintf(traceFile, "}");
+            }
+        }
+    }
+
+    fprintf(traceFile, "\n]}\n");
+    fclose(traceFile);
+
     return MFX_ERR_NONE;
 }
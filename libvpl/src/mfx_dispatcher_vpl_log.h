@@ -14,12 +14,25 @@
  * By default, Intel® VPL dispatcher prints all log messages to the console.
  * To redirect log output to the desired file, set the ONEVPL_DISPATCHER_LOG_FILE environmental 
  *   variable with the file name of the log file.
+ *
+ * For low-overhead tracing, set ONEVPL_DISPATCHER_LOG to "TRACE" instead.
+ * Function enter/exit (with the function ID and key arguments) and log messages are then stored
+ *   as binary events in a ring buffer per thread, which grows as needed up to DISP_TRACE_MAX_EVENTS
+ *   (then oldest events are overwritten). Nothing is written until MFXUnload().
+ * The trace is then converted to Chrome trace event format (JSON), which can be opened with
+ *   chrome://tracing or https://ui.perfetto.dev, and written to ONEVPL_DISPATCHER_LOG_FILE
+ *   (default: DISP_TRACE_DEF_FILENAME in the current directory).
  */
 
 #include <stdarg.h>
 #include <stdio.h>
 
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "vpl/mfxdispatcher.h"
 #include "vpl/mfxvideo.h"
@@ -32,49 +45,135 @@
     #endif
 #endif
 
+#define DISP_TRACE_DEF_FILENAME "libvpl_dispatcher_trace.json"
+
+// number of events kept per thread in trace mode
+#define DISP_TRACE_MAX_EVENTS 4096
+
+// number of distinct traced functions (DISP_LOG_FUNCTION sites), later ones are traced as unknown
+#define DISP_TRACE_MAX_FUNCTIONS 256
+
+// number of arguments saved with a function enter event
+#define DISP_TRACE_MAX_ARGS 2
+
+// log messages longer than this are truncated in trace mode
+#define DISP_TRACE_MAX_MSG_LEN 128
+
+enum DispatcherTraceEventType {
+    DISP_TRACE_EVENT_BEGIN   = 0, // function enter
+    DISP_TRACE_EVENT_END     = 1, // function return
+    DISP_TRACE_EVENT_MESSAGE = 2, // formatted log message
+};
+
+// static description of a traced function, one per DISP_LOG_FUNCTION site
+// registered on first use, events then store only the ID
+// all strings must have static storage duration
+struct DispatcherTraceFunction {
+    DispatcherTraceFunction(const char *fnName,
+                            const char *argName0 = nullptr,
+                            const char *argName1 = nullptr);
+
+    mfxU32 id;
+    const char *name;
+    const char *argNames[DISP_TRACE_MAX_ARGS]; // nullptr if argument is not used
+};
+
+struct DispatcherTraceEvent {
+    mfxU64 timestamp;
+    mfxU64 args[DISP_TRACE_MAX_ARGS];
+    mfxU32 type;
+    mfxU32 fnId;
+    char msg[DISP_TRACE_MAX_MSG_LEN];
+};
+
+// events from a single thread, only written by that thread
+struct DispatcherTraceBuffer {
+    std::thread::id threadId;
+    mfxU32 threadIndex;
+    mfxU64 numEvents; // total number written, including overwritten events
+    std::vector<DispatcherTraceEvent> events; // grows up to DISP_TRACE_MAX_EVENTS
+};
+
 class DispatcherLogVPL {
 public:
     DispatcherLogVPL();
     ~DispatcherLogVPL();
 
     mfxStatus Init(mfxU32 logLevel, const std::string &logFileName);
+    mfxStatus InitTrace(const std::string &traceFileName);
     mfxStatus LogMessage(const char *msdk, ...);
 
+    void TraceFunction(mfxU32 type, const DispatcherTraceFunction &fn, mfxU64 arg0, mfxU64 arg1);
+
     mfxU32 m_logLevel;
+    bool m_bTrace;
 
 private:
+    void TraceMessage(const char *msg, va_list args);
+    DispatcherTraceBuffer *GetTraceBuffer();
+    DispatcherTraceEvent *NextTraceEvent();
+    mfxStatus WriteTrace();
+
     std::string m_logFileName;
     FILE *m_logFile;
+
+    // trace mode only
+    mfxU64 m_traceID; // unique per logger, used to find the cached buffer of the calling thread
+    mfxU64 m_traceStart;
+    std::mutex m_traceLock;
+    std::list<std::unique_ptr<DispatcherTraceBuffer>> m_traceBuffers;
+
     DispatcherLogVPL(const DispatcherLogVPL &other);
     DispatcherLogVPL &operator=(const DispatcherLogVPL &other);
 };
 
 class DispatcherLogVPLFunction {
 public:
-    DispatcherLogVPLFunction(DispatcherLogVPL *dispLog, const char *fnName)
+    DispatcherLogVPLFunction(DispatcherLogVPL *dispLog,
+                             const DispatcherTraceFunction &fn,
+                             mfxU64 arg0 = 0,
+                             mfxU64 arg1 = 0)
             : m_dispLog(),
-              m_fnName() {
+              m_fn(fn) {
         m_dispLog = dispLog;
 
         if (m_dispLog && m_dispLog->m_logLevel) {
-            m_fnName = fnName;
-            m_dispLog->LogMessage("function: %s (enter)", m_fnName.c_str());
+            if (m_dispLog->m_bTrace)
+                m_dispLog->TraceFunction(DISP_TRACE_EVENT_BEGIN, m_fn, arg0, arg1);
+            else
+                m_dispLog->LogMessage("function: %s (enter)", m_fn.name);
         }
     }
 
     ~DispatcherLogVPLFunction() {
-        if (m_dispLog && m_dispLog->m_logLevel)
-            m_dispLog->LogMessage("function: %s (return)", m_fnName.c_str());
+        if (m_dispLog && m_dispLog->m_logLevel) {
+            if (m_dispLog->m_bTrace)
+                m_dispLog->TraceFunction(DISP_TRACE_EVENT_END, m_fn, 0, 0);
+            else
+                m_dispLog->LogMessage("function: %s (return)", m_fn.name);
+        }
     }
 
 private:
     DispatcherLogVPL *m_dispLog;
-    std::string m_fnName;
+    const DispatcherTraceFunction &m_fn;
     DispatcherLogVPLFunction(const DispatcherLogVPLFunction &other);
     DispatcherLogVPLFunction &operator=(const DispatcherLogVPLFunction &other);
 };
 
-#define DISP_LOG_FUNCTION(dispLog) DispatcherLogVPLFunction _dispLogFn(dispLog, __FUNC_NAME__);
+#define DISP_LOG_FUNCTION(dispLog)                                     \
+    static const DispatcherTraceFunction _dispTraceFn(__FUNC_NAME__); \
+    DispatcherLogVPLFunction _dispLogFn(dispLog, _dispTraceFn);
+
+// same as DISP_LOG_FUNCTION, also saving one or two integer arguments with the enter event
+// in trace mode (e.g. implementation index), argName is a string literal
+#define DISP_LOG_FUNCTION_ARG(dispLog, argName0, arg0)                           \
+    static const DispatcherTraceFunction _dispTraceFn(__FUNC_NAME__, argName0); \
+    DispatcherLogVPLFunction _dispLogFn(dispLog, _dispTraceFn, (mfxU64)(arg0));
+
+#define DISP_LOG_FUNCTION_ARGS(dispLog, argName0, arg0, argName1, arg1)                    \
+    static const DispatcherTraceFunction _dispTraceFn(__FUNC_NAME__, argName0, argName1); \
+    DispatcherLogVPLFunction _dispLogFn(dispLog, _dispTraceFn, (mfxU64)(arg0), (mfxU64)(arg1));
 #define DISP_LOG_MESSAGE(dispLog, ...)          \
     {                                           \
         if (dispLog) {                          \
@@ -77,7 +77,7 @@ LibInfo *LoaderCtxVPL::AddSingleLibrary(STRING_TYPE libPath, LibType libType) {
 #endif
 
     // create new LibInfo and add to list
-    libInfo = new (std::nothrow) LibInfo;
+    libInfo = NewLibInfo();
     if (!libInfo)
         return nullptr;
 
@@ -85,6 +85,14 @@ LibInfo *LoaderCtxVPL::AddSingleLibrary(STRING_TYPE libPath, LibType libType) {
     libInfo->libType     = libType;
     libInfo->libPriority = (libType == LibTypeVPL ? LIB_PRIORITY_01 : LIB_PRIORITY_LEGACY);
 
+    if (libType == LibTypeMSDK) {
+        libInfo->msdkCtx.reset(new (std::nothrow) LoaderCtxMSDK[MAX_NUM_IMPL_MSDK]);
+        if (!libInfo->msdkCtx) {
+            m_libInfoStore.pop_back();
+            return nullptr;
+        }
+    }
+
     return libInfo;
 }
 
@@ -245,10 +253,14 @@ mfxStatus LoaderCtxVPL::LoadLibsFromMultipleDirs(LibType libType) {
 
 mfxStatus LoaderCtxVPL::LoadLibsLowLatency() {
     DISP_LOG_FUNCTION(&m_dispLog);
+    LoaderPhaseTimer phaseTimer(this, LoaderPhaseLoad);
 
 #if defined(_WIN32) || defined(_WIN64)
     mfxStatus sts = MFX_ERR_NONE;
 
+    // filter props are read below to set the name of the MSDK library
+    std::lock_guard<std::mutex> configLock(m_configLock);
+
     // check driver store
     mfxU32 numAdapters = 0;
 
@@ -390,13 +402,34 @@ mfxStatus LoaderCtxVPL::LoadLibsLowLatency() {
 #endif
 }
 
-// try creating a session in order to get runtime API version
-mfxStatus LoaderCtxVPL::QuerySessionLowLatency(LibInfo *libInfo,
+// get runtime API version from the optional MFXQueryImplsAPIVersion() export, if available
+// otherwise try creating a session in order to get runtime API version
+mfxStatus LoaderCtxVPL::QueryVersionLowLatency(LibInfo *libInfo,
                                                mfxU32 adapterID,
                                                mfxVersion *ver) {
+    LoaderPhaseTimer phaseTimer(this, LoaderPhaseQuery, libInfo);
+
     mfxStatus sts;
     mfxSession session = nullptr;
 
+#ifdef ONEVPL_EXPERIMENTAL
+    VPLFunctionPtr pFunc = libInfo->vplOptionalFuncTable[IdxMFXQueryImplsAPIVersion];
+    if (libInfo->libType == LibTypeVPL && pFunc) {
+        mfxVersion queryVersion = {};
+
+        sts = (*(mfxStatus(MFX_CDECL *)(mfxVersion *))pFunc)(&queryVersion);
+        if (sts == MFX_ERR_NONE && queryVersion.Major >= 2) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  API version %d.%d from MFXQueryImplsAPIVersion",
+                             queryVersion.Major,
+                             queryVersion.Minor);
+
+            *ver = queryVersion;
+            return MFX_ERR_NONE;
+        }
+    }
+#endif
+
     mfxVersion reqVersion;
     if (libInfo->libType == LibTypeVPL) {
         reqVersion.Major = 2;
@@ -4,7 +4,6 @@
   # SPDX-License-Identifier: MIT
   ############################################################################*/
 
-#include <fstream>
 #include "src/mfx_dispatcher_vpl.h"
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -13,6 +12,7 @@
 
 #ifdef __linux__
     #include <pthread.h>
+    #include "src/linux/drm_topology.h"
     #define strncpy_s(dst, size, src, cnt) strncpy((dst), (src), (cnt)) // NOLINT
 #endif
 
@@ -483,27 +483,6 @@ mfxStatus LoaderCtxMSDK::CheckD3D9Support(mfxU64 luid, STRING_TYPE libNameFull,
 #endif
 }
 
-mfxU32 read_device_file(std::string &path) {
-    mfxU32 result = 0;
-    std::string line;
-    std::ifstream dev_str(path);
-    if (!dev_str.is_open()) {
-        return 0;
-    }
-    std::getline(dev_str, line);
-    dev_str.close();
-    try {
-        result = std::stoul(line, 0, 16);
-    }
-    catch (std::invalid_argument &) {
-        return 0;
-    }
-    catch (std::out_of_range &) {
-        return 0;
-    }
-    return result;
-}
-
 mfxStatus LoaderCtxMSDK::GetRenderNodeDescription(mfxU32 adapterID,
                                                   mfxU32 &vendorID,
                                                   mfxU16 &deviceID) {
@@ -511,18 +490,18 @@ mfxStatus LoaderCtxMSDK::GetRenderNodeDescription(mfxU32 adapterID,
     deviceID = 0;
 
 #if defined(__linux__)
-    mfxU32 DRMRenderNodeNum = 128 + adapterID;
-    std::string nodeStr     = std::to_string(DRMRenderNodeNum);
+    std::shared_ptr<const DRMTopology> topology = GetDRMTopology();
 
-    std::string vendorPath = "/sys/class/drm/renderD" + nodeStr + "/device/vendor";
-    std::string devPath    = "/sys/class/drm/renderD" + nodeStr + "/device/device";
+    const DRMRenderNode *node = FindDRMRenderNode(*topology, 128 + adapterID);
+    if (!node)
+        return MFX_ERR_UNSUPPORTED;
 
-    vendorID = read_device_file(vendorPath);
+    vendorID = node->vendorID;
 
     if (vendorID != 0x8086)
         return MFX_ERR_UNSUPPORTED;
 
-    deviceID = read_device_file(devPath);
+    deviceID = (mfxU16)node->deviceID;
 
     if (deviceID == 0)
         return MFX_ERR_UNSUPPORTED;
@@ -0,0 +1,59 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl_placement.h"
+
+#include <mutex>
+#include <unordered_map>
+
+// open sessions of all loaders in the process
+struct PlacedSessionTable {
+    PlacedSessionTable() : lock(), sessions(), numSessions(0) {}
+
+    std::mutex lock;
+    std::unordered_map<mfxSession, std::shared_ptr<ImplSessionCount>> sessions;
+
+    // lets MFXClose() skip the lock for sessions which were not created from a loader
+    std::atomic<size_t> numSessions;
+};
+
+static PlacedSessionTable &GetPlacedSessionTable() {
+    static PlacedSessionTable table;
+    return table;
+}
+
+void TrackPlacedSession(mfxSession session, const std::shared_ptr<ImplSessionCount> &count) {
+    PlacedSessionTable &table = GetPlacedSessionTable();
+    std::lock_guard<std::mutex> lock(table.lock);
+
+    // the address of a closed session may be reused by a new one
+    std::shared_ptr<ImplSessionCount> &entry = table.sessions[session];
+    if (entry)
+        entry->numActive--;
+
+    entry = count;
+    count->numActive++;
+    count->numCreated++;
+
+    table.numSessions = table.sessions.size();
+}
+
+void UntrackPlacedSession(mfxSession session) {
+    PlacedSessionTable &table = GetPlacedSessionTable();
+    if (table.numSessions == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(table.lock);
+
+    auto it = table.sessions.find(session);
+    if (it == table.sessions.end())
+        return;
+
+    it->second->numActive--;
+    table.sessions.erase(it);
+
+    table.numSessions = table.sessions.size();
+}
@@ -0,0 +1,41 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#ifndef LIBVPL_SRC_MFX_DISPATCHER_VPL_PLACEMENT_H_
+#define LIBVPL_SRC_MFX_DISPATCHER_VPL_PLACEMENT_H_
+
+/* Intel® Video Processing Library (Intel® VPL) Dispatcher Session Placement
+ * Every session created from a loader is counted against the implementation it was created
+ *   with, and the count is decremented again when the application calls MFXClose().
+ * MFXCreateSessionPlaced() uses these counts to pick an implementation according to the
+ *   placement policy set with MFXSetPlacementPolicy().
+ *
+ * Sessions may outlive the loader, so each implementation owns its counter through a shared_ptr
+ *   which is also held by the process-wide table of open sessions.
+ */
+
+#include <atomic>
+#include <memory>
+
+#include "vpl/mfxsession.h"
+
+// number of open sessions created with one implementation
+struct ImplSessionCount {
+    ImplSessionCount() : numActive(0), numCreated(0) {}
+
+    std::atomic<mfxU32> numActive;
+    std::atomic<mfxU64> numCreated;
+};
+
+// record that session was created with the implementation which owns count
+// count is incremented here, and decremented by UntrackPlacedSession()
+void TrackPlacedSession(mfxSession session, const std::shared_ptr<ImplSessionCount> &count);
+
+// called from MFXClose() once the session has been closed
+// does nothing if the session was not created from a loader
+void UntrackPlacedSession(mfxSession session);
+
+#endif // LIBVPL_SRC_MFX_DISPATCHER_VPL_PLACEMENT_H_
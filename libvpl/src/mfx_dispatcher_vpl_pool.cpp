@@ -0,0 +1,291 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl_pool.h"
+
+#include <atomic>
+
+// sessions acquired from all pools in the process and not yet released
+// lock order is table lock before pool lock
+struct PooledSessionTable {
+    PooledSessionTable() : lock(), sessions(), numSessions(0) {}
+
+    std::mutex lock;
+    std::unordered_map<mfxSession, SessionPoolVPL *> sessions;
+
+    // lets MFXClose() skip the lock if no pooled sessions are held
+    std::atomic<size_t> numSessions;
+};
+
+static PooledSessionTable &GetPooledSessionTable() {
+    static PooledSessionTable table;
+    return table;
+}
+
+static void TrackPooledSession(mfxSession session, SessionPoolVPL *pool) {
+    PooledSessionTable &table = GetPooledSessionTable();
+    std::lock_guard<std::mutex> lock(table.lock);
+
+    // the address of a closed session may be reused by a new one
+    table.sessions[session] = pool;
+    table.numSessions       = table.sessions.size();
+}
+
+// remove session from the table without notifying its pool
+// if pool is not null, only remove the session if it belongs to that pool
+static void RemovePooledSession(mfxSession session, SessionPoolVPL *pool) {
+    PooledSessionTable &table = GetPooledSessionTable();
+    std::lock_guard<std::mutex> lock(table.lock);
+
+    auto it = table.sessions.find(session);
+    if (it != table.sessions.end() && (!pool || it->second == pool))
+        table.sessions.erase(it);
+
+    table.numSessions = table.sessions.size();
+}
+
+void UntrackPooledSession(mfxSession session) {
+    PooledSessionTable &table = GetPooledSessionTable();
+    if (table.numSessions == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(table.lock);
+
+    auto it = table.sessions.find(session);
+    if (it == table.sessions.end())
+        return;
+
+    it->second->ForgetSession(session);
+    table.sessions.erase(it);
+
+    table.numSessions = table.sessions.size();
+}
+
+void JoinPooledSession(mfxSession session) {
+    PooledSessionTable &table = GetPooledSessionTable();
+    if (table.numSessions == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(table.lock);
+
+    auto it = table.sessions.find(session);
+    if (it != table.sessions.end())
+        it->second->MarkSessionJoined(session);
+}
+
+SessionPoolVPL::SessionPoolVPL(mfxLoader loader,
+                               mfxU32 implIdx,
+                               mfxU32 minSessions,
+                               mfxU32 maxSessions)
+        : m_parentLoader(loader),
+          m_implIdx(implIdx),
+          m_minSessions(minSessions),
+          m_maxSessions(maxSessions),
+          m_dispLog(nullptr),
+          m_mutex(),
+          m_refillCond(),
+          m_refillThread(),
+          m_bStopRefill(false),
+          m_bRefillFailed(false),
+          m_idleSessions(),
+          m_activeSessions() {}
+
+SessionPoolVPL::~SessionPoolVPL() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStopRefill = true;
+    }
+    m_refillCond.notify_all();
+
+    if (m_refillThread.joinable())
+        m_refillThread.join();
+
+    // sessions still held by the application now belong to it
+    // MFXClose() may call ForgetSession() until they are removed from the table
+    std::vector<mfxSession> activeSessions;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto &active : m_activeSessions)
+            activeSessions.push_back(active.first);
+        m_activeSessions.clear();
+    }
+
+    for (auto session : activeSessions)
+        RemovePooledSession(session, this);
+
+    for (auto session : m_idleSessions)
+        MFXClose(session);
+    m_idleSessions.clear();
+}
+
+mfxStatus SessionPoolVPL::Init(DispatcherLogVPL *dispLog) {
+    m_dispLog = dispLog;
+
+    DISP_LOG_MESSAGE(m_dispLog,
+                     "message:  session pool for implementation %d, min = %d, max = %d",
+                     m_implIdx,
+                     m_minSessions,
+                     m_maxSessions);
+
+    // fill the pool before returning, so the first sessions handed out are already initialized
+    // this also returns any error creating sessions for this implementation to the application
+    while (m_idleSessions.size() < m_minSessions) {
+        mfxSession session = nullptr;
+        mfxStatus sts      = CreatePoolSession(&session);
+        if (sts != MFX_ERR_NONE)
+            return sts;
+
+        m_idleSessions.push_back(session);
+    }
+
+    m_refillThread = std::thread(&SessionPoolVPL::RefillThread, this);
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus SessionPoolVPL::CreatePoolSession(mfxSession *session) {
+    // take loader locks and update the list of implementations if needed
+    return MFXCreateSession(m_parentLoader, m_implIdx, session);
+}
+
+// keep minSessions idle sessions available
+void SessionPoolVPL::RefillThread() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_bStopRefill) {
+        if (m_bRefillFailed || m_idleSessions.size() >= m_minSessions) {
+            m_refillCond.wait(lock);
+            continue;
+        }
+
+        // do not block Acquire() or Release() while the RT is initialized
+        lock.unlock();
+
+        mfxSession session = nullptr;
+        mfxStatus sts      = CreatePoolSession(&session);
+
+        lock.lock();
+
+        if (sts != MFX_ERR_NONE) {
+            // do not retry until the next call to Acquire()
+            DISP_LOG_MESSAGE(m_dispLog, "message:  session pool refill failed, sts = %d", sts);
+            m_bRefillFailed = true;
+        }
+        else if (m_bStopRefill || m_idleSessions.size() >= m_maxSessions) {
+            MFXClose(session);
+        }
+        else {
+            m_idleSessions.push_back(session);
+        }
+    }
+}
+
+mfxStatus SessionPoolVPL::Acquire(mfxSession *session) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (!m_idleSessions.empty()) {
+        *session = m_idleSessions.back();
+        m_idleSessions.pop_back();
+        m_activeSessions[*session] = false;
+    }
+    else {
+        DISP_LOG_MESSAGE(m_dispLog, "message:  session pool empty, creating new session");
+
+        lock.unlock();
+
+        mfxSession newSession = nullptr;
+        mfxStatus sts         = CreatePoolSession(&newSession);
+        if (sts != MFX_ERR_NONE)
+            return sts;
+
+        lock.lock();
+
+        *session                   = newSession;
+        m_activeSessions[*session] = false;
+    }
+
+    m_bRefillFailed = false;
+    lock.unlock();
+
+    m_refillCond.notify_one();
+
+    // taken after the pool lock is released, see PooledSessionTable
+    TrackPooledSession(*session, this);
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus SessionPoolVPL::Release(mfxSession session) {
+    bool bJoined = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_activeSessions.find(session);
+        if (it == m_activeSessions.end())
+            return MFX_ERR_INVALID_HANDLE;
+
+        bJoined = it->second;
+        m_activeSessions.erase(it);
+    }
+
+    RemovePooledSession(session, this);
+
+    // close anything left open by the application before handing the session out again
+    // children may still be joined to a parent, so it is never handed out again
+    bool bReset = !bJoined && ResetSession(session);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (bReset && m_idleSessions.size() < m_maxSessions) {
+            m_idleSessions.push_back(session);
+            return MFX_ERR_NONE;
+        }
+    }
+
+    DISP_LOG_MESSAGE(m_dispLog, "message:  session pool closing released session");
+
+    return MFXClose(session);
+}
+
+// return false if the session may not be reused
+bool SessionPoolVPL::ResetSession(mfxSession session) {
+    // not initialized (or not supported by the RT) means there is nothing to close
+    auto IsClosed = [](mfxStatus sts) {
+        return (sts == MFX_ERR_NONE || sts == MFX_ERR_NOT_INITIALIZED ||
+                sts == MFX_ERR_NOT_IMPLEMENTED);
+    };
+
+    bool bReset = true;
+
+    bReset = IsClosed(MFXVideoDECODE_VPP_Close(session)) && bReset;
+    bReset = IsClosed(MFXVideoDECODE_Close(session)) && bReset;
+    bReset = IsClosed(MFXVideoENCODE_Close(session)) && bReset;
+    bReset = IsClosed(MFXVideoVPP_Close(session)) && bReset;
+
+    // session may have been joined to another one by the application
+    // MFX_ERR_UNDEFINED_BEHAVIOR means it was not joined, any other error (or warning, e.g.
+    //   MFX_WRN_IN_EXECUTION) means it may still be joined
+    mfxStatus sts = MFXDisjoinSession(session);
+    bReset = (sts == MFX_ERR_NONE || sts == MFX_ERR_UNDEFINED_BEHAVIOR ||
+              sts == MFX_ERR_NOT_IMPLEMENTED) &&
+             bReset;
+
+    return bReset;
+}
+
+void SessionPoolVPL::ForgetSession(mfxSession session) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_activeSessions.erase(session);
+}
+
+void SessionPoolVPL::MarkSessionJoined(mfxSession session) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_activeSessions.find(session);
+    if (it != m_activeSessions.end())
+        it->second = true;
+}
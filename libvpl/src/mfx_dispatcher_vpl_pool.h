@@ -0,0 +1,95 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#ifndef LIBVPL_SRC_MFX_DISPATCHER_VPL_POOL_H_
+#define LIBVPL_SRC_MFX_DISPATCHER_VPL_POOL_H_
+
+/* Intel® Video Processing Library (Intel® VPL) Dispatcher Session Pool
+ * A session pool is created with MFXCreateSessionPool() and keeps a number of initialized sessions
+ *   for one implementation, so that MFXSessionPoolAcquire() does not pay for runtime initialization.
+ *
+ * minSessions sessions are created before MFXCreateSessionPool() returns. After that a background
+ *   thread creates new sessions whenever the number of idle sessions drops below minSessions.
+ *   If the pool is empty, MFXSessionPoolAcquire() creates a session directly.
+ * Sessions passed to MFXSessionPoolRelease() are reset (all components closed) and kept for
+ *   reuse, up to maxSessions idle sessions. Any others are closed.
+ * Pools are destroyed by MFXDestroySessionPool() or MFXUnload(). Sessions which were acquired and
+ *   not released remain valid, and must be closed by the application with MFXClose().
+ *
+ * Acquired sessions are also kept in a process-wide table, so that MFXClose() and MFXJoinSession()
+ *   can tell the pool about them. A session closed by the application is forgotten by its pool,
+ *   and a session used as the parent of MFXJoinSession() is closed on release instead of reused,
+ *   since the dispatcher cannot tell whether all of its children were disjoined.
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "vpl/mfxdispatcher.h"
+#include "vpl/mfxvideo.h"
+
+#include "./mfx_dispatcher_vpl_log.h"
+
+class SessionPoolVPL {
+public:
+    SessionPoolVPL(mfxLoader loader, mfxU32 implIdx, mfxU32 minSessions, mfxU32 maxSessions);
+
+    // stop the background thread and close all idle sessions
+    ~SessionPoolVPL();
+
+    // create the first minSessions sessions and start the background thread
+    mfxStatus Init(DispatcherLogVPL *dispLog);
+
+    mfxStatus Acquire(mfxSession *session);
+    mfxStatus Release(mfxSession session);
+
+    // called through the process-wide table of acquired sessions
+    void ForgetSession(mfxSession session);
+    void MarkSessionJoined(mfxSession session);
+
+    // loader which owns this pool
+    mfxLoader m_parentLoader;
+
+private:
+    void RefillThread();
+    mfxStatus CreatePoolSession(mfxSession *session);
+    static bool ResetSession(mfxSession session);
+
+    mfxU32 m_implIdx;
+    mfxU32 m_minSessions;
+    mfxU32 m_maxSessions;
+
+    DispatcherLogVPL *m_dispLog;
+
+    std::mutex m_mutex;
+    std::condition_variable m_refillCond;
+    std::thread m_refillThread;
+    bool m_bStopRefill;
+    bool m_bRefillFailed;
+
+    // most recently released sessions are handed out first
+    std::vector<mfxSession> m_idleSessions;
+
+    // sessions created by this pool and currently held by the application
+    // value is true if the session was used as the parent of MFXJoinSession()
+    std::unordered_map<mfxSession, bool> m_activeSessions;
+
+    SessionPoolVPL(const SessionPoolVPL &other);
+    SessionPoolVPL &operator=(const SessionPoolVPL &other);
+};
+
+// called from MFXClose() once the session has been closed
+// does nothing if the session was not acquired from a pool
+void UntrackPooledSession(mfxSession session);
+
+// called from MFXJoinSession() once child was joined to session
+// does nothing if the session was not acquired from a pool
+void JoinPooledSession(mfxSession session);
+
+#endif // LIBVPL_SRC_MFX_DISPATCHER_VPL_POOL_H_
@@ -0,0 +1,80 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl_registry.h"
+
+// the registry is owned by the loaders which use it
+// only a weak reference is kept here, so it is destroyed along with the last loader
+static std::mutex g_registryMutex;
+static std::weak_ptr<RuntimeRegistryVPL> g_registry;
+
+RuntimeRegistryVPL::RuntimeRegistryVPL() : m_mutex(), m_caps(), m_funcTables() {}
+
+RuntimeRegistryVPL::~RuntimeRegistryVPL() {}
+
+std::shared_ptr<RuntimeRegistryVPL> RuntimeRegistryVPL::Acquire() {
+#if defined(_WIN32) || defined(_WIN64)
+    // not currently supported on Windows
+    return nullptr;
+#else
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+
+    std::shared_ptr<RuntimeRegistryVPL> registry = g_registry.lock();
+    if (!registry) {
+        registry = std::make_shared<RuntimeRegistryVPL>();
+        if (registry->m_caps.InitInMemory() != MFX_ERR_NONE)
+            return nullptr;
+
+        g_registry = registry;
+    }
+
+    return registry;
+#endif
+}
+
+const CapsCacheEntry *RuntimeRegistryVPL::Find(
+    const std::string &libNameFull,
+    std::shared_ptr<const MFX::RuntimeFuncTable> &funcTable) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const CapsCacheEntry *entry = m_caps.Find(libNameFull);
+    if (!entry)
+        return nullptr;
+
+    auto it = m_funcTables.find(libNameFull);
+    if (it != m_funcTables.end())
+        funcTable = it->second;
+
+    return entry;
+}
+
+mfxStatus RuntimeRegistryVPL::AddValidLib(
+    const std::string &libNameFull,
+    const std::vector<CapsCacheImpl> &impls,
+    const std::shared_ptr<const MFX::RuntimeFuncTable> &funcTable) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    mfxStatus sts = m_caps.AddValidLib(libNameFull, impls);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    // table for the previous version of a modified library is released here,
+    //   but stays loaded until all sessions which use it are closed
+    if (funcTable)
+        m_funcTables[libNameFull] = funcTable;
+    else
+        m_funcTables.erase(libNameFull);
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus RuntimeRegistryVPL::AddInvalidLib(const std::string &libNameFull) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_funcTables.erase(libNameFull);
+
+    return m_caps.AddInvalidLib(libNameFull);
+}
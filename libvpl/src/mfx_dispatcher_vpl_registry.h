@@ -0,0 +1,64 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#ifndef LIBVPL_SRC_MFX_DISPATCHER_VPL_REGISTRY_H_
+#define LIBVPL_SRC_MFX_DISPATCHER_VPL_REGISTRY_H_
+
+/* Intel® Video Processing Library (Intel® VPL) Dispatcher Runtime Registry
+ * The process-wide runtime registry is controlled with the ONEVPL_RUNTIME_REGISTRY environment variable.
+ * To enable the registry, set ONEVPL_RUNTIME_REGISTRY=ON.
+ *
+ * When enabled, the capabilities of each 2.x runtime and its table of exported functions are shared
+ *   by all loaders in the process. The first loader to query a runtime adds it to the registry, and
+ *   later loaders create implementations and sessions from the registry without loading or querying
+ *   the library again.
+ * Each loader holds a reference to the registry, which is destroyed by the last call to MFXUnload().
+ * Currently only supported on Linux.
+ */
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "./mfx_dispatcher_vpl_cache.h"
+
+namespace MFX {
+struct RuntimeFuncTable;
+}
+
+class RuntimeRegistryVPL {
+public:
+    RuntimeRegistryVPL();
+    ~RuntimeRegistryVPL();
+
+    // return the registry for this process, creating it if no other loader holds a reference
+    static std::shared_ptr<RuntimeRegistryVPL> Acquire();
+
+    // return entry for this library, or nullptr if not registered or stale
+    // funcTable is set if the library may be used to create sessions without loading it again
+    // entries remain valid for the lifetime of the registry
+    const CapsCacheEntry *Find(const std::string &libNameFull,
+                               std::shared_ptr<const MFX::RuntimeFuncTable> &funcTable);
+
+    // deep copy runtime caps into the registry, and take a reference on the function table
+    mfxStatus AddValidLib(const std::string &libNameFull,
+                          const std::vector<CapsCacheImpl> &impls,
+                          const std::shared_ptr<const MFX::RuntimeFuncTable> &funcTable);
+    mfxStatus AddInvalidLib(const std::string &libNameFull);
+
+private:
+    std::mutex m_mutex;
+
+    CapsCacheVPL m_caps;
+    std::map<std::string, std::shared_ptr<const MFX::RuntimeFuncTable>> m_funcTables;
+
+    RuntimeRegistryVPL(const RuntimeRegistryVPL &other);
+    RuntimeRegistryVPL &operator=(const RuntimeRegistryVPL &other);
+};
+
+#endif // LIBVPL_SRC_MFX_DISPATCHER_VPL_REGISTRY_H_
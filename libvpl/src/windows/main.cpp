@@ -16,6 +16,9 @@
 
 #include "src/windows/mfx_vector.h"
 
+#include "src/mfx_dispatcher_vpl_placement.h"
+#include "src/mfx_dispatcher_vpl_pool.h"
+
 #if defined(MEDIASDK_UWP_DISPATCHER)
     #include "src/windows/mfx_driver_store_loader.h"
 #endif
@@ -609,6 +612,8 @@ mfxStatus MFXClose(mfxSession session) {
             if (MFX_ERR_UNDEFINED_BEHAVIOR != mfxRes) {
                 // release the handle
                 delete pHandle;
+                UntrackPlacedSession(session);
+                UntrackPooledSession(session);
             }
         }
         catch (...) {
@@ -745,6 +750,8 @@ mfxStatus MFXJoinSession(mfxSession session, mfxSession child_session) {
             mfxRes =
                 (*(mfxStatus(MFX_CDECL *)(mfxSession, mfxSession))pFunc)(pHandle->session,
                                                                          pChildHandle->session);
+            if (mfxRes == MFX_ERR_NONE)
+                JoinPooledSession(session);
         }
     }
 
@@ -1107,6 +1114,40 @@ mfxStatus MFXVideoVPP_ProcessFrameAsync(mfxSession session,
     return sts;
 }
 
+#ifdef ONEVPL_EXPERIMENTAL
+// per-function call stats are only collected by the Linux dispatcher
+mfxStatus MFXQuerySessionCallStats(mfxSession session, mfxSessionCallStats **stats) {
+    if (!session)
+        return MFX_ERR_INVALID_HANDLE;
+
+    if (!stats)
+        return MFX_ERR_NULL_PTR;
+
+    return MFX_ERR_UNSUPPORTED;
+}
+
+mfxStatus MFXReleaseSessionCallStats(mfxSession session, mfxSessionCallStats *stats) {
+    if (!session)
+        return MFX_ERR_INVALID_HANDLE;
+
+    if (!stats)
+        return MFX_ERR_NULL_PTR;
+
+    return MFX_ERR_UNSUPPORTED;
+}
+
+// direct calls are only supported by the Linux dispatcher
+mfxStatus MFXGetRuntimeFunctions(mfxSession session, mfxRuntimeFunctions *functions) {
+    if (!session)
+        return MFX_ERR_INVALID_HANDLE;
+
+    if (!functions)
+        return MFX_ERR_NULL_PTR;
+
+    return MFX_ERR_UNSUPPORTED;
+}
+#endif
+
 // move GetHandle() into a non-passthrough function so that we can catch dispatcher-level QueryInterface requests
 mfxStatus MFXVideoCORE_GetHandle(mfxSession session, mfxHandleType type, mfxHDL *hdl) {
     mfxStatus mfxRes         = MFX_ERR_INVALID_HANDLE;
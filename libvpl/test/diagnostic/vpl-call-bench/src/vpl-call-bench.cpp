@@ -0,0 +1,131 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+// Measure the overhead of per-frame calls made through the dispatcher
+//   trampolines, compared with calling the runtime directly through the
+//   function table returned by MFXGetRuntimeFunctions().
+// Run with the stub runtime (ONEVPL_SEARCH_PATH) to measure only the
+//   call overhead, since its functions return immediately.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "vpl/mfx.h"
+
+static void Usage() {
+    printf("Usage: vpl-call-bench [options]\n");
+    printf("       -iter R ........... calls for each mode (default = 10000000)\n");
+    printf("       -impl name ........ ImplName of the runtime (default = \"Stub Implementation\")\n");
+}
+
+template <typename Call>
+static double MeasureCall(mfxU32 numIter, Call call) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    for (mfxU32 i = 0; i < numIter; i++)
+        call();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::nano>(endTime - startTime).count() / numIter;
+}
+
+int main(int argc, char *argv[]) {
+    mfxU32 numIter       = 10000000;
+    const char *implName = "Stub Implementation";
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-iter") && i + 1 < argc) {
+            numIter = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "-impl") && i + 1 < argc) {
+            implName = argv[++i];
+        }
+        else {
+            printf("Error - invalid argument\n\n");
+            Usage();
+            return -1;
+        }
+    }
+
+    if (numIter == 0) {
+        Usage();
+        return -1;
+    }
+
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxLoader loader = MFXLoad();
+    if (!loader) {
+        printf("Error - MFXLoad() failed\n");
+        return -1;
+    }
+
+    mfxConfig cfg  = MFXCreateConfig(loader);
+    mfxVariant var = {};
+
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_PTR;
+    var.Data.Ptr        = (mfxHDL)implName;
+    MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.ImplName", var);
+
+    mfxSession session = nullptr;
+    mfxStatus sts      = MFXCreateSession(loader, 0, &session);
+    if (sts != MFX_ERR_NONE) {
+        printf("Error - MFXCreateSession() failed for %s (%d)\n", implName, sts);
+        MFXUnload(loader);
+        return -1;
+    }
+
+    mfxRuntimeFunctions functions = {};
+    functions.Version.Version     = MFX_RUNTIMEFUNCTIONS_VERSION;
+
+    sts = MFXGetRuntimeFunctions(session, &functions);
+    if (sts != MFX_ERR_NONE || !functions.SyncOperation || !functions.GetSurfaceForDecode) {
+        printf("Error - MFXGetRuntimeFunctions() failed (%d)\n", sts);
+        MFXClose(session);
+        MFXUnload(loader);
+        return -1;
+    }
+
+    printf("  Runtime = %s, iterations = %u\n\n", implName, numIter);
+
+    mfxSession rtSession      = functions.RuntimeSession;
+    mfxFrameSurface1 *surface = nullptr;
+
+    double syncDisp = MeasureCall(numIter, [&]() {
+        MFXVideoCORE_SyncOperation(session, nullptr, 0);
+    });
+    double syncDirect = MeasureCall(numIter, [&]() {
+        functions.SyncOperation(rtSession, nullptr, 0);
+    });
+    double surfDisp = MeasureCall(numIter, [&]() {
+        MFXMemory_GetSurfaceForDecode(session, &surface);
+    });
+    double surfDirect = MeasureCall(numIter, [&]() {
+        functions.GetSurfaceForDecode(rtSession, &surface);
+    });
+
+    MFXClose(session);
+    MFXUnload(loader);
+
+    printf("vpl-call-bench -- %-32s  dispatcher = % 6.2f nsec  direct = % 6.2f nsec\n",
+           "MFXVideoCORE_SyncOperation",
+           syncDisp,
+           syncDirect);
+    printf("vpl-call-bench -- %-32s  dispatcher = % 6.2f nsec  direct = % 6.2f nsec\n",
+           "MFXMemory_GetSurfaceForDecode",
+           surfDisp,
+           surfDirect);
+
+    return 0;
+#else
+    printf("Error - MFXGetRuntimeFunctions() requires ONEVPL_EXPERIMENTAL\n");
+    return -1;
+#endif
+}
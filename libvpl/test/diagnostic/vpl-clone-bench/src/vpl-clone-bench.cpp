@@ -0,0 +1,150 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+// Measure the cost of MFXCloneSession(), compared with creating the same
+//   number of sessions with MFXCreateSession().
+// Run with the stub runtime (ONEVPL_SEARCH_PATH) to measure only the
+//   dispatcher overhead, since it does not initialize any device.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+
+#include "vpl/mfx.h"
+
+static void Usage() {
+    printf("Usage: vpl-clone-bench [options]\n");
+    printf("       -n N .............. number of sessions to clone (default = 1000)\n");
+    printf("       -impl name ........ ImplName of the runtime (default = \"Stub Implementation\")\n");
+}
+
+// return elapsed time in usec
+static double GetElapsed(std::chrono::high_resolution_clock::time_point startTime) {
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::micro>(endTime - startTime).count();
+}
+
+static void PrintResult(const char *name, double totalTime, mfxU32 numSessions) {
+    printf("vpl-clone-bench -- %-24s  total = % 10.1f usec  per session = % 8.2f usec\n",
+           name,
+           totalTime,
+           totalTime / numSessions);
+}
+
+int main(int argc, char *argv[]) {
+    mfxU32 numSessions   = 1000;
+    const char *implName = "Stub Implementation";
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            numSessions = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "-impl") && i + 1 < argc) {
+            implName = argv[++i];
+        }
+        else {
+            printf("Error - invalid argument\n\n");
+            Usage();
+            return -1;
+        }
+    }
+
+    if (numSessions == 0) {
+        Usage();
+        return -1;
+    }
+
+    mfxLoader loader = MFXLoad();
+    if (!loader) {
+        printf("Error - MFXLoad() failed\n");
+        return -1;
+    }
+
+    mfxConfig cfg  = MFXCreateConfig(loader);
+    mfxVariant var = {};
+
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_PTR;
+    var.Data.Ptr        = (mfxHDL)implName;
+    MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.ImplName", var);
+
+    // first session also loads the runtime, so it is not included
+    mfxSession session = nullptr;
+    mfxStatus sts      = MFXCreateSession(loader, 0, &session);
+    if (sts != MFX_ERR_NONE) {
+        printf("Error - MFXCreateSession() failed for %s (%d)\n", implName, sts);
+        MFXUnload(loader);
+        return -1;
+    }
+
+    printf("  Runtime = %s, sessions = %u\n\n", implName, numSessions);
+
+    std::vector<mfxSession> sessions(numSessions, nullptr);
+
+    // clone and close
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (mfxU32 i = 0; i < numSessions; i++) {
+        sts = MFXCloneSession(session, &sessions[i]);
+        if (sts != MFX_ERR_NONE) {
+            printf("Error - MFXCloneSession() failed for session %u (%d)\n", i, sts);
+            break;
+        }
+    }
+    double cloneTime = GetElapsed(startTime);
+
+    startTime = std::chrono::high_resolution_clock::now();
+    for (mfxSession &clone : sessions) {
+        if (clone) {
+            MFXDisjoinSession(clone);
+            MFXClose(clone);
+            clone = nullptr;
+        }
+    }
+    double cloneCloseTime = GetElapsed(startTime);
+
+    if (sts != MFX_ERR_NONE) {
+        MFXClose(session);
+        MFXUnload(loader);
+        return -1;
+    }
+
+    // create and close, for comparison
+    startTime = std::chrono::high_resolution_clock::now();
+    for (mfxU32 i = 0; i < numSessions; i++) {
+        sts = MFXCreateSession(loader, 0, &sessions[i]);
+        if (sts != MFX_ERR_NONE) {
+            printf("Error - MFXCreateSession() failed for session %u (%d)\n", i, sts);
+            break;
+        }
+    }
+    double createTime = GetElapsed(startTime);
+
+    startTime = std::chrono::high_resolution_clock::now();
+    for (mfxSession &created : sessions) {
+        if (created) {
+            MFXClose(created);
+            created = nullptr;
+        }
+    }
+    double createCloseTime = GetElapsed(startTime);
+
+    MFXClose(session);
+    MFXUnload(loader);
+
+    if (sts != MFX_ERR_NONE)
+        return -1;
+
+    PrintResult("MFXCloneSession", cloneTime, numSessions);
+    PrintResult("MFXClose (clone)", cloneCloseTime, numSessions);
+    PrintResult("MFXCreateSession", createTime, numSessions);
+    PrintResult("MFXClose (session)", createCloseTime, numSessions);
+
+    return 0;
+}
@@ -0,0 +1,290 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+// Measure the cost of MFXSetConfigFilterProperty() for every supported
+//   property name, and of MFXSetConfigFilterPropertyById() for the same
+//   property. Runtime libraries are not loaded.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "vpl/mfx.h"
+
+struct BenchProp {
+    const char *name;
+    mfxVariantType type;
+    mfxI32 propId; // mfxConfigPropertyId, -1 if not available
+};
+
+#ifdef ONEVPL_EXPERIMENTAL
+    #define PROP_ID(id) (id)
+#else
+    #define PROP_ID(id) (-1)
+#endif
+
+// leave table formatting alone
+// clang-format off
+
+static const BenchProp BenchPropTab[] = {
+    { "mfxHandleType",                                                                          MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_HANDLE_TYPE) },
+    { "mfxHDL",                                                                                 MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_HANDLE) },
+    { "NumThread",                                                                              MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_NUM_THREAD) },
+#ifdef ONEVPL_EXPERIMENTAL
+    { "DeviceCopy",                                                                             MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_DEVICE_COPY) },
+#endif
+    { "ExtBuffer",                                                                              MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_EXT_BUFFER) },
+#if defined(_WIN32) || defined(_WIN64)
+    { "DXGIAdapterIndex",                                                                       MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_DXGI_ADAPTER_INDEX) },
+#endif
+
+    { "mfxImplementedFunctions.FunctionsName",                                                  MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_FUNCTION_NAME) },
+
+    { "mfxExtendedDeviceId.VendorID",                                                           MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_EXTDEV_VENDOR_ID) },
+    { "mfxExtendedDeviceId.DeviceID",                                                           MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_EXTDEV_DEVICE_ID) },
+    { "mfxExtendedDeviceId.PCIDomain",                                                          MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_EXTDEV_PCI_DOMAIN) },
+    { "mfxExtendedDeviceId.PCIBus",                                                             MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_EXTDEV_PCI_BUS) },
+    { "mfxExtendedDeviceId.PCIDevice",                                                          MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_EXTDEV_PCI_DEVICE) },
+    { "mfxExtendedDeviceId.PCIFunction",                                                        MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_EXTDEV_PCI_FUNCTION) },
+    { "mfxExtendedDeviceId.DeviceLUID",                                                         MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_EXTDEV_DEVICE_LUID) },
+    { "mfxExtendedDeviceId.LUIDDeviceNodeMask",                                                 MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_EXTDEV_LUID_DEVICE_NODE_MASK) },
+    { "mfxExtendedDeviceId.DRMRenderNodeNum",                                                   MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_EXTDEV_DRM_RENDER_NODE_NUM) },
+    { "mfxExtendedDeviceId.DRMPrimaryNodeNum",                                                  MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_EXTDEV_DRM_PRIMARY_NODE_NUM) },
+    { "mfxExtendedDeviceId.RevisionID",                                                         MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_EXTDEV_REVISION_ID) },
+    { "mfxExtendedDeviceId.DeviceName",                                                         MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_EXTDEV_DEVICE_NAME) },
+
+#ifdef ONEVPL_EXPERIMENTAL
+    { "mfxSurfaceTypesSupported.surftype.SurfaceType",                                          MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_SURFACE_TYPE) },
+    { "mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceComponent",                            MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_SURFACE_COMPONENT) },
+    { "mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceFlags",                                MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_SURFACE_FLAGS) },
+
+    { "mfxImplDescription",                                                                     MFX_VARIANT_TYPE_QUERY,      PROP_ID(MFX_CFG_PROP_QUERY_IMPL) },
+    { "mfxImplDescription.mfxDecoderDescription",                                               MFX_VARIANT_TYPE_QUERY,      PROP_ID(MFX_CFG_PROP_QUERY_DEC) },
+    { "mfxImplDescription.mfxEncoderDescription",                                               MFX_VARIANT_TYPE_QUERY,      PROP_ID(MFX_CFG_PROP_QUERY_ENC) },
+    { "mfxImplDescription.mfxVPPDescription",                                                   MFX_VARIANT_TYPE_QUERY,      PROP_ID(MFX_CFG_PROP_QUERY_VPP) },
+#endif
+
+    { "mfxImplDescription.Impl",                                                                MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_IMPL) },
+    { "mfxImplDescription.AccelerationMode",                                                    MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_ACCELERATION_MODE) },
+    { "mfxImplDescription.mfxSurfacePoolMode",                                                  MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_SURFACE_POOL_MODE) },
+    { "mfxImplDescription.ApiVersion.Version",                                                  MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_API_VERSION) },
+    { "mfxImplDescription.ApiVersion.Major",                                                    MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_API_VERSION_MAJOR) },
+    { "mfxImplDescription.ApiVersion.Minor",                                                    MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_API_VERSION_MINOR) },
+    { "mfxImplDescription.VendorID",                                                            MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_VENDOR_ID) },
+    { "mfxImplDescription.ImplName",                                                            MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_IMPL_NAME) },
+    { "mfxImplDescription.License",                                                             MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_LICENSE) },
+    { "mfxImplDescription.Keywords",                                                            MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_KEYWORDS) },
+    { "mfxImplDescription.VendorImplID",                                                        MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_VENDOR_IMPL_ID) },
+
+    { "mfxImplDescription.mfxDeviceDescription.DeviceID",                                       MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_DEVICE_ID) },
+    { "mfxImplDescription.mfxDeviceDescription.device.DeviceID",                                MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_DEVICE_ID) },
+    { "mfxImplDescription.mfxDeviceDescription.MediaAdapterType",                               MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_MEDIA_ADAPTER_TYPE) },
+    { "mfxImplDescription.mfxDeviceDescription.device.MediaAdapterType",                        MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_MEDIA_ADAPTER_TYPE) },
+
+    { "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",                               MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_DEC_CODEC_ID) },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.MaxcodecLevel",                         MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_DEC_MAX_CODEC_LEVEL) },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.Profile",                    MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_DEC_PROFILE) },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.MemHandleType",   MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_DEC_MEM_HANDLE_TYPE) },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.Width",           MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_DEC_WIDTH) },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.Height",          MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_DEC_HEIGHT) },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.ColorFormat",     MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_DEC_COLOR_FORMAT) },
+    { "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.ColorFormats",    MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_DEC_COLOR_FORMAT) },
+
+    { "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",                               MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_ENC_CODEC_ID) },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.MaxcodecLevel",                         MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_ENC_MAX_CODEC_LEVEL) },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.BiDirectionalPrediction",               MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_ENC_BIDIRECTIONAL_PREDICTION) },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.Profile",                    MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_ENC_PROFILE) },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.MemHandleType",   MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_ENC_MEM_HANDLE_TYPE) },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.Width",           MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_ENC_WIDTH) },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.Height",          MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_ENC_HEIGHT) },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.ColorFormat",     MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_ENC_COLOR_FORMAT) },
+    { "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.ColorFormats",    MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_ENC_COLOR_FORMAT) },
+
+    { "mfxImplDescription.mfxVPPDescription.filter.FilterFourCC",                               MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_VPP_FILTER_FOURCC) },
+    { "mfxImplDescription.mfxVPPDescription.filter.MaxDelayInFrames",                           MFX_VARIANT_TYPE_U16,        PROP_ID(MFX_CFG_PROP_VPP_MAX_DELAY_IN_FRAMES) },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.MemHandleType",                      MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_VPP_MEM_HANDLE_TYPE) },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.Width",                              MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_VPP_WIDTH) },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.Height",                             MFX_VARIANT_TYPE_PTR,        PROP_ID(MFX_CFG_PROP_VPP_HEIGHT) },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.InFormat",                    MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_VPP_IN_FORMAT) },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.OutFormat",                   MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_VPP_OUT_FORMAT) },
+    { "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.OutFormats",                  MFX_VARIANT_TYPE_U32,        PROP_ID(MFX_CFG_PROP_VPP_OUT_FORMAT) },
+
+    // unknown name, measures the cost of a failed lookup
+    { "mfxImplDescription.mfxDecoderDescription.decoder.Unknown",                               MFX_VARIANT_TYPE_U32,        -1 },
+};
+
+// end table formatting
+// clang-format on
+
+#define NUM_BENCH_PROPS (sizeof(BenchPropTab) / sizeof(BenchProp))
+
+// data for properties passed by pointer
+static mfxRange32U g_range   = { 64, 4096, 16 };
+static mfxU8 g_luid[8]       = { 1, 2, 3, 4, 5, 6, 7, 8 };
+static mfxExtBuffer g_extBuf = { MFX_MAKEFOURCC('B', 'E', 'N', 'C'), sizeof(mfxExtBuffer) };
+static char g_string[]       = "vpl-config-bench";
+static mfxU32 g_handle       = 0;
+
+static void FillValue(const BenchProp &prop, mfxVariant &var) {
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Data.U64        = 0;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    if (prop.type == MFX_VARIANT_TYPE_QUERY) {
+        // property-based query, Data must be 0
+        var.Type = static_cast<mfxVariantType>(MFX_VARIANT_TYPE_QUERY | MFX_VARIANT_TYPE_U32);
+        return;
+    }
+#endif
+
+    var.Type = prop.type;
+    if (prop.type == MFX_VARIANT_TYPE_U32) {
+        var.Data.U32 = 1;
+    }
+    else if (prop.type == MFX_VARIANT_TYPE_U16) {
+        var.Data.U16 = 1;
+    }
+    else if (strstr(prop.name, ".Width") || strstr(prop.name, ".Height")) {
+        var.Data.Ptr = &g_range;
+    }
+    else if (strstr(prop.name, "DeviceLUID")) {
+        var.Data.Ptr = g_luid;
+    }
+    else if (!strcmp(prop.name, "ExtBuffer")) {
+        var.Data.Ptr = &g_extBuf;
+    }
+    else if (!strcmp(prop.name, "mfxHDL")) {
+        var.Data.Ptr = &g_handle;
+    }
+    else {
+        var.Data.Ptr = g_string;
+    }
+}
+
+static void Usage() {
+    printf("Usage: vpl-config-bench [options]\n");
+    printf("       -iter R ........... calls for each property name (default = 100000)\n");
+    printf("       -v ................ print time for each property name\n");
+}
+
+int main(int argc, char *argv[]) {
+    mfxU32 numIter = 100000;
+    bool bVerbose  = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-iter") && i + 1 < argc) {
+            numIter = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "-v")) {
+            bVerbose = true;
+        }
+        else {
+            printf("Error - invalid argument\n\n");
+            Usage();
+            return -1;
+        }
+    }
+
+    if (numIter == 0) {
+        Usage();
+        return -1;
+    }
+
+    mfxLoader loader = MFXLoad();
+    if (!loader) {
+        printf("Error - MFXLoad() failed\n");
+        return -1;
+    }
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    if (!cfg) {
+        printf("Error - MFXCreateConfig() failed\n");
+        MFXUnload(loader);
+        return -1;
+    }
+
+    printf("  Property names = %zu, iterations = %u\n\n", NUM_BENCH_PROPS, numIter);
+
+    double totalNsec   = 0;
+    double totalIdNsec = 0;
+    mfxU32 numIdProps  = 0;
+    int numErrors      = 0;
+
+    for (mfxU32 p = 0; p < NUM_BENCH_PROPS; p++) {
+        const BenchProp &prop = BenchPropTab[p];
+        const mfxU8 *name     = reinterpret_cast<const mfxU8 *>(prop.name);
+
+        mfxVariant var = {};
+        FillValue(prop, var);
+
+        // last entry is expected to fail
+        mfxStatus expSts = (p == NUM_BENCH_PROPS - 1) ? MFX_ERR_NOT_FOUND : MFX_ERR_NONE;
+        mfxStatus sts    = MFXSetConfigFilterProperty(cfg, name, var);
+        if (sts != expSts) {
+            printf("Error - %s returned %d\n", prop.name, sts);
+            numErrors++;
+            continue;
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (mfxU32 i = 0; i < numIter; i++)
+            MFXSetConfigFilterProperty(cfg, name, var);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        double nsec  = std::chrono::duration<double, std::nano>(endTime - startTime).count();
+
+        totalNsec += nsec;
+
+        double idNsec = 0;
+#ifdef ONEVPL_EXPERIMENTAL
+        if (prop.propId >= 0) {
+            sts = MFXSetConfigFilterPropertyById(cfg, (mfxU32)prop.propId, var);
+            if (sts != MFX_ERR_NONE) {
+                printf("Error - %s (ID %d) returned %d\n", prop.name, prop.propId, sts);
+                numErrors++;
+                continue;
+            }
+
+            startTime = std::chrono::high_resolution_clock::now();
+
+            for (mfxU32 i = 0; i < numIter; i++)
+                MFXSetConfigFilterPropertyById(cfg, (mfxU32)prop.propId, var);
+
+            endTime = std::chrono::high_resolution_clock::now();
+            idNsec  = std::chrono::duration<double, std::nano>(endTime - startTime).count();
+
+            totalIdNsec += idNsec;
+            numIdProps++;
+        }
+#endif
+
+        if (bVerbose)
+            printf("  % 8.1f nsec  % 8.1f nsec (ID)  %s\n",
+                   nsec / numIter,
+                   idNsec / numIter,
+                   prop.name);
+    }
+
+    MFXUnload(loader);
+
+    if (numErrors) {
+        printf("Error - %d property names failed\n", numErrors);
+        return -1;
+    }
+
+    printf("%svpl-config-bench -- mean = % 8.1f nsec per MFXSetConfigFilterProperty()\n",
+           bVerbose ? "\n" : "",
+           totalNsec / ((double)numIter * NUM_BENCH_PROPS));
+
+    if (numIdProps)
+        printf("vpl-config-bench -- mean = % 8.1f nsec per MFXSetConfigFilterPropertyById()\n",
+               totalIdNsec / ((double)numIter * numIdProps));
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+// Measure dispatcher startup time with N copies of a runtime library,
+//   comparing serial with parallel caps queries (ONEVPL_PROBE_THREADS).
+// Linux only.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "vpl/mfx.h"
+
+struct BenchResult {
+    std::vector<double> timeMsec;
+    std::vector<std::string> implPaths;
+};
+
+static void Usage() {
+    printf("Usage: vpl-probe-bench -stub <path to stub runtime> [options]\n");
+    printf("       -n N .............. number of copies of the runtime (default = 8)\n");
+    printf("       -threads T ........ value of ONEVPL_PROBE_THREADS (default = 4)\n");
+    printf("       -iter R ........... iterations for each mode (default = 10)\n");
+    printf("       -delay D .......... simulated caps query time in msec (default = 20)\n");
+    printf("                           (VPL_STUB_QUERY_DELAY_MS, stub runtime only)\n");
+}
+
+static bool CopyFile(const std::string &src, const std::string &dst) {
+    std::ifstream srcFile(src, std::ios::binary);
+    std::ofstream dstFile(dst, std::ios::binary);
+    if (!srcFile.is_open() || !dstFile.is_open())
+        return false;
+
+    dstFile << srcFile.rdbuf();
+    return dstFile.good();
+}
+
+// create a loader, enumerate all implementations, and return elapsed time
+static mfxStatus RunOnce(double &timeMsec, std::vector<std::string> &implPaths) {
+    implPaths.clear();
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    mfxLoader loader = MFXLoad();
+    if (!loader)
+        return MFX_ERR_NULL_PTR;
+
+    // first call triggers loading and querying of all libraries
+    mfxStatus sts = MFX_ERR_NONE;
+    for (mfxU32 idx = 0;; idx++) {
+        mfxHDL hImplPath = nullptr;
+        sts              = MFXEnumImplementations(loader, idx, MFX_IMPLCAPS_IMPLPATH, &hImplPath);
+        if (sts != MFX_ERR_NONE || !hImplPath)
+            break;
+
+        implPaths.push_back(reinterpret_cast<mfxChar *>(hImplPath));
+        MFXDispReleaseImplDescription(loader, hImplPath);
+    }
+
+    MFXUnload(loader);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    timeMsec     = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return (implPaths.empty() ? MFX_ERR_NOT_FOUND : MFX_ERR_NONE);
+}
+
+static mfxStatus RunBench(const char *probeThreads, mfxU32 numIter, BenchResult &result) {
+    if (probeThreads)
+        setenv("ONEVPL_PROBE_THREADS", probeThreads, 1);
+    else
+        unsetenv("ONEVPL_PROBE_THREADS");
+
+    for (mfxU32 i = 0; i < numIter; i++) {
+        double timeMsec = 0;
+        mfxStatus sts   = RunOnce(timeMsec, result.implPaths);
+        if (sts != MFX_ERR_NONE)
+            return sts;
+
+        result.timeMsec.push_back(timeMsec);
+    }
+
+    std::sort(result.timeMsec.begin(), result.timeMsec.end());
+
+    return MFX_ERR_NONE;
+}
+
+static void PrintResult(const char *name, const BenchResult &result) {
+    printf("vpl-probe-bench -- %-24s  min = % 8.2f msec  median = % 8.2f msec  (%zu impls)\n",
+           name,
+           result.timeMsec.front(),
+           result.timeMsec[result.timeMsec.size() / 2],
+           result.implPaths.size());
+}
+
+int main(int argc, char *argv[]) {
+    std::string stubPath;
+    mfxU32 numCopies  = 8;
+    mfxU32 numThreads = 4;
+    mfxU32 numIter    = 10;
+    mfxU32 queryDelay = 20;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-stub") && i + 1 < argc) {
+            stubPath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            numCopies = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "-threads") && i + 1 < argc) {
+            numThreads = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "-iter") && i + 1 < argc) {
+            numIter = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "-delay") && i + 1 < argc) {
+            queryDelay = atoi(argv[++i]);
+        }
+        else {
+            printf("Error - invalid argument\n\n");
+            Usage();
+            return -1;
+        }
+    }
+
+    if (stubPath.empty() || numCopies == 0 || numIter == 0) {
+        Usage();
+        return -1;
+    }
+
+    // copy runtime to temporary directory, each copy is loaded as a separate library
+    char tmpDir[] = "/tmp/vpl-probe-bench-XXXXXX";
+    if (!mkdtemp(tmpDir)) {
+        printf("Error - failed to create temporary directory\n");
+        return -1;
+    }
+
+    std::vector<std::string> libPaths;
+    for (mfxU32 i = 0; i < numCopies; i++) {
+        std::string libPath = std::string(tmpDir) + "/libvplbench" + std::to_string(i) + ".so";
+        if (!CopyFile(stubPath, libPath)) {
+            printf("Error - failed to copy %s\n", stubPath.c_str());
+            return -1;
+        }
+        libPaths.push_back(libPath);
+    }
+
+    setenv("ONEVPL_SEARCH_PATH", tmpDir, 1);
+    setenv("VPL_STUB_QUERY_DELAY_MS", std::to_string(queryDelay).c_str(), 1);
+
+    printf("  Runtime copies = %u, threads = %u, iterations = %u, query delay = %u msec\n\n",
+           numCopies,
+           numThreads,
+           numIter,
+           queryDelay);
+
+    BenchResult serial, parallel;
+    std::string strThreads = std::to_string(numThreads);
+
+    mfxStatus sts = RunBench(nullptr, numIter, serial);
+    if (sts == MFX_ERR_NONE)
+        sts = RunBench(strThreads.c_str(), numIter, parallel);
+
+    for (auto &libPath : libPaths)
+        remove(libPath.c_str());
+    rmdir(tmpDir);
+
+    if (sts != MFX_ERR_NONE) {
+        printf("Error - failed to enumerate implementations (%d)\n", sts);
+        return -1;
+    }
+
+    PrintResult("serial", serial);
+    PrintResult("parallel", parallel);
+
+    printf("\n  Speedup (median) = %.2fx\n",
+           serial.timeMsec[serial.timeMsec.size() / 2] /
+               parallel.timeMsec[parallel.timeMsec.size() / 2]);
+
+    // parallel loading must not change the priority order of implementations
+    if (serial.implPaths != parallel.implPaths) {
+        printf("Error - implementation order differs between serial and parallel loading\n");
+        return -1;
+    }
+    printf("  Implementation order matches\n");
+
+    return 0;
+}
@@ -27,6 +27,11 @@ struct mfxDispatcherVersion {
 
 static mfxStatus GetDispatcherVersion(mfxDispatcherVersion *dispatcherVersion);
 
+#ifdef ONEVPL_EXPERIMENTAL
+static void PrintLoaderTiming(const mfxLoaderTiming *timing);
+static bool WriteLoaderTimingJSON(const mfxLoaderTiming *timing, const char *fileName);
+#endif
+
 static void SetDefaultParamsEncode(mfxVideoParam *par) {
     par->mfx.CodecId                  = MFX_CODEC_AVC;
     par->mfx.TargetUsage              = MFX_TARGETUSAGE_BALANCED;
@@ -59,6 +64,9 @@ int main(int argc, char *argv[]) {
     bool bEnumImpls     = false;
     bool bUseFastLoad   = false;
     bool bPrintImplPath = false;
+    bool bPrintPhases   = false;
+
+    const char *jsonFileName = nullptr;
 
     for (int i = 1; i < argc; i++) {
         if (!strncmp(argv[i], "-e", 2)) {
@@ -70,6 +78,15 @@ int main(int argc, char *argv[]) {
         else if (!strncmp(argv[i], "-p", 2)) {
             bPrintImplPath = true;
         }
+#ifdef ONEVPL_EXPERIMENTAL
+        else if (!strncmp(argv[i], "-t", 2)) {
+            bPrintPhases = true;
+        }
+        else if (!strncmp(argv[i], "-json", 5) && i + 1 < argc) {
+            i++;
+            jsonFileName = argv[i];
+        }
+#endif
         else if (!strncmp(argv[i], "-adapterNum", 11)) {
             i++;
             adapterNum = atol(argv[i]);
@@ -80,6 +97,10 @@ int main(int argc, char *argv[]) {
             printf("       -e ................ enable EnumImplementations (description)\n");
             printf("       -f ................ enable fast loading\n");
             printf("       -p ................ print paths of loaded implementation\n");
+#ifdef ONEVPL_EXPERIMENTAL
+            printf("       -t ................ print time of each startup phase for each library\n");
+            printf("       -json file ........ write time of each startup phase to file as JSON\n");
+#endif
             printf("       -adapterNum n ..... use device adapter number n (default = 0)\n");
             return -1;
         }
@@ -234,6 +255,29 @@ int main(int argc, char *argv[]) {
 
     printf("\n");
 
+#ifdef ONEVPL_EXPERIMENTAL
+    if (bPrintPhases || jsonFileName) {
+        mfxLoaderTiming *timing = nullptr;
+
+        sts = MFXQueryLoaderTiming(loader, &timing);
+        if (sts == MFX_ERR_NONE) {
+            if (bPrintPhases)
+                PrintLoaderTiming(timing);
+
+            if (jsonFileName && !WriteLoaderTimingJSON(timing, jsonFileName))
+                printf("  Warning - unable to write %s\n", jsonFileName);
+
+            MFXReleaseLoaderTiming(loader, timing);
+        }
+        else {
+            printf("  Warning - MFXQueryLoaderTiming returned %d\n", sts);
+        }
+    }
+#else
+    (void)bPrintPhases;
+    (void)jsonFileName;
+#endif
+
     mfxVersion actualVersion = {};
 
     sts = MFXQueryVersion(session, &actualVersion);
@@ -268,6 +312,91 @@ int main(int argc, char *argv[]) {
     return 0;
 }
 
+#ifdef ONEVPL_EXPERIMENTAL
+// names of mfxLoaderPhase values
+static const char *PhaseNames[] = { "search", "load", "query", "filter", "init" };
+    #define NUM_PHASES (sizeof(PhaseNames) / sizeof(PhaseNames[0]))
+
+static void PrintLoaderTiming(const mfxLoaderTiming *timing) {
+    printf("Startup phases (msec, count in parentheses)\n");
+
+    printf("  %-10s", "");
+    for (mfxU32 phase = 0; phase < NUM_PHASES; phase++)
+        printf(" %14s", PhaseNames[phase]);
+    printf("\n");
+
+    printf("  %-10s", "loader");
+    for (mfxU32 phase = 0; phase < NUM_PHASES; phase++)
+        printf(" %8.2f (%3u)", timing->PhaseTime[phase] / 1e6, timing->PhaseCount[phase]);
+    printf("\n");
+
+    for (mfxU32 i = 0; i < timing->NumLibraries; i++) {
+        const mfxLibraryTiming *lib = &timing->Libraries[i];
+
+        printf("  %-10s", lib->Valid ? "valid" : "rejected");
+        for (mfxU32 phase = 0; phase < NUM_PHASES; phase++)
+            printf(" %8.2f (%3u)", lib->PhaseTime[phase] / 1e6, lib->PhaseCount[phase]);
+        printf("  %s%s\n", lib->LibPath, lib->CapsCached ? " (cached caps)" : "");
+    }
+    printf("\n");
+}
+
+// write string with JSON escapes (paths may contain backslashes)
+static void WriteJSONString(FILE *f, const char *str) {
+    fputc('"', f);
+    for (const char *c = str; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            fprintf(f, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20)
+            fprintf(f, "\\u%04x", (unsigned char)*c);
+        else
+            fputc(*c, f);
+    }
+    fputc('"', f);
+}
+
+static void WriteJSONPhases(FILE *f, const mfxU64 *phaseTime, const mfxU32 *phaseCount) {
+    fprintf(f, "{");
+    for (mfxU32 phase = 0; phase < NUM_PHASES; phase++) {
+        fprintf(f,
+                "%s\"%s\": { \"time_ns\": %llu, \"count\": %u }",
+                phase ? ", " : " ",
+                PhaseNames[phase],
+                (unsigned long long)phaseTime[phase],
+                phaseCount[phase]);
+    }
+    fprintf(f, " }");
+}
+
+static bool WriteLoaderTimingJSON(const mfxLoaderTiming *timing, const char *fileName) {
+    FILE *f = fopen(fileName, "w");
+    if (!f)
+        return false;
+
+    fprintf(f, "{\n  \"loader\": ");
+    WriteJSONPhases(f, timing->PhaseTime, timing->PhaseCount);
+    fprintf(f, ",\n  \"libraries\": [");
+
+    for (mfxU32 i = 0; i < timing->NumLibraries; i++) {
+        const mfxLibraryTiming *lib = &timing->Libraries[i];
+
+        fprintf(f, "%s\n    { \"path\": ", i ? "," : "");
+        WriteJSONString(f, lib->LibPath);
+        fprintf(f,
+                ", \"valid\": %s, \"caps_cached\": %s, \"start_ns\": %llu,\n      \"phases\": ",
+                lib->Valid ? "true" : "false",
+                lib->CapsCached ? "true" : "false",
+                (unsigned long long)lib->StartTime);
+        WriteJSONPhases(f, lib->PhaseTime, lib->PhaseCount);
+        fprintf(f, " }");
+    }
+
+    fprintf(f, "%s]\n}\n", timing->NumLibraries ? "\n  " : "");
+
+    return (fclose(f) == 0);
+}
+#endif
+
 static mfxStatus GetDispatcherVersion(mfxDispatcherVersion *ver) {
 #if defined(_WIN32) || defined(_WIN64)
     std::vector<char> fileInfoBuf;
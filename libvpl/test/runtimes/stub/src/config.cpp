@@ -4,10 +4,13 @@
   # SPDX-License-Identifier: MIT
   ############################################################################*/
 
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <map>
 #include <ostream>
 #include <string>
+#include <thread>
 
 #include "src/caps.h"
 #include "src/config.h"
@@ -227,15 +230,51 @@ mfxStatus MFXCloneSession(mfxSession session, mfxSession *clone) {
     return MFX_ERR_NONE;
 }
 
+static bool IsValidSession(const _mfxSession *stubSession) {
+    return (stubSession->handleType == DEFAULT_SESSION_HANDLE_1X ||
+            stubSession->handleType == DEFAULT_SESSION_HANDLE_2X ||
+            stubSession->handleType == DEFAULT_CLONE_SESSION_HANDLE);
+}
+
+mfxStatus MFXJoinSession(mfxSession session, mfxSession child) {
+    if (!session || !child || session == child)
+        return MFX_ERR_INVALID_HANDLE;
+
+    _mfxSession *stubSession = (_mfxSession *)session;
+    _mfxSession *stubChild   = (_mfxSession *)child;
+    if (!IsValidSession(stubSession) || !IsValidSession(stubChild))
+        return MFX_ERR_INVALID_HANDLE;
+
+    // child may only have one parent, and may not be a parent itself
+    if (stubChild->parent || stubChild->numChildren)
+        return MFX_ERR_UNDEFINED_BEHAVIOR;
+
+    stubChild->parent = stubSession;
+    stubSession->numChildren++;
+
+    return MFX_ERR_NONE;
+}
+
 mfxStatus MFXDisjoinSession(mfxSession session) {
     if (!session)
         return MFX_ERR_INVALID_HANDLE;
 
     _mfxSession *stubSession = (_mfxSession *)session;
-    if (stubSession->handleType != DEFAULT_CLONE_SESSION_HANDLE)
+    if (!IsValidSession(stubSession))
         return MFX_ERR_INVALID_HANDLE;
 
-    return MFX_ERR_NONE;
+    if (stubSession->parent) {
+        stubSession->parent->numChildren--;
+        stubSession->parent = nullptr;
+        return MFX_ERR_NONE;
+    }
+
+    // clones are treated as joined to the session they were cloned from
+    if (stubSession->handleType == DEFAULT_CLONE_SESSION_HANDLE)
+        return MFX_ERR_NONE;
+
+    // independent session, or parent of other sessions
+    return MFX_ERR_UNDEFINED_BEHAVIOR;
 }
 
 mfxStatus MFXClose(mfxSession session) {
@@ -248,6 +287,13 @@ mfxStatus MFXClose(mfxSession session) {
         stubSession->handleType != DEFAULT_CLONE_SESSION_HANDLE)
         return MFX_ERR_INVALID_HANDLE;
 
+    // children must be disjoined first
+    if (stubSession->numChildren)
+        return MFX_ERR_UNDEFINED_BEHAVIOR;
+
+    if (stubSession->parent)
+        stubSession->parent->numChildren--;
+
     delete stubSession;
 
     return MFX_ERR_NONE;
@@ -455,6 +501,7 @@ static const mfxChar *minImplFuncsNames[] = {
 
 #ifndef SKIP_NEW_FUNCTIONS
     "MFXQueryImplsProperties",
+    "MFXQueryImplsAPIVersion",
 #endif
 };
 
@@ -537,6 +584,12 @@ mfxHDL *MFXQueryImplsDescription(mfxImplCapsDeliveryFormat format, mfxU32 *num_i
     *num_impls = NUM_CPU_IMPLS;
 
     if (format == MFX_IMPLCAPS_IMPLDESCSTRUCTURE) {
+        // optionally simulate the cost of a real caps query (e.g. opening the device)
+        // used for measuring dispatcher startup time
+        const char *queryDelay = std::getenv("VPL_STUB_QUERY_DELAY_MS");
+        if (queryDelay)
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::atoi(queryDelay)));
+
         return (mfxHDL *)(minImplDescArray);
     }
     else if (format == MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS) {
@@ -931,6 +984,24 @@ mfxHDL *MFXQueryImplsProperties(mfxQueryProperty **properties,
 // define dummy function to avoid link error if ONEVPL_EXPERIMENTAL is disabled (preprocessor does not apply to .def file)
 mfxHDL *MFXQueryImplsProperties(void **properties, mfxU32 num_properties, mfxU32 *num_impls) {
     return nullptr;
+}
+    #endif
+
+    #ifdef ONEVPL_EXPERIMENTAL
+// lets the dispatcher read the API version in low-latency mode without creating a session
+mfxStatus MFXQueryImplsAPIVersion(mfxVersion *version) {
+    if (!version)
+        return MFX_ERR_NULL_PTR;
+
+    version->Major = MFX_VERSION_MAJOR;
+    version->Minor = MFX_VERSION_MINOR;
+
+    return MFX_ERR_NONE;
+}
+    #else
+// define dummy function to avoid link error if ONEVPL_EXPERIMENTAL is disabled (preprocessor does not apply to .def file)
+mfxStatus MFXQueryImplsAPIVersion(mfxVersion *version) {
+    return MFX_ERR_UNSUPPORTED;
 }
     #endif
 #endif
@@ -955,8 +1026,14 @@ mfxStatus MFXQueryVersion(mfxSession session, mfxVersion *pVersion) {
     }
 
     // set the library's version
+#ifdef ENABLE_STUB_MSDK
+    // legacy MSDK runtimes report the final 1.x API version
+    pVersion->Major = 1;
+    pVersion->Minor = 35;
+#else
     pVersion->Major = MFX_VERSION_MAJOR;
     pVersion->Minor = MFX_VERSION_MINOR;
+#endif
 
     return MFX_ERR_NONE;
 }
@@ -20,8 +20,14 @@
 struct _mfxSession {
     mfxU32 handleType;
 
+    // set by MFXJoinSession
+    _mfxSession *parent;
+    mfxU32 numChildren;
+
     _mfxSession() {
-        handleType = 0;
+        handleType  = 0;
+        parent      = nullptr;
+        numChildren = 0;
     }
 };
 
@@ -10,10 +10,6 @@ mfxStatus MFXInit(mfxIMPL implParam, mfxVersion *ver, mfxSession *session) {
     return MFX_ERR_NOT_IMPLEMENTED;
 }
 
-mfxStatus MFXJoinSession(mfxSession session, mfxSession child) {
-    return MFX_ERR_NOT_IMPLEMENTED;
-}
-
 mfxStatus MFXSetPriority(mfxSession session, mfxPriority priority) {
     return MFX_ERR_NOT_IMPLEMENTED;
 }
@@ -0,0 +1,187 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for background discovery started by MFXLoad (ONEVPL_BACKGROUND_DISCOVERY).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+    #include <stdlib.h>
+
+    #include <chrono>
+    #include <thread>
+
+static void EnableBackgroundDiscovery() {
+    setenv("ONEVPL_BACKGROUND_DISCOVERY", "ON", 1);
+}
+
+static void DisableBackgroundDiscovery() {
+    unsetenv("ONEVPL_BACKGROUND_DISCOVERY");
+}
+
+TEST(Dispatcher_BackgroundDiscovery, StartedByMFXLoad) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableBackgroundDiscovery();
+
+    // MFXUnload waits for the discovery thread, which logs when it is done
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  background discovery done, sts = 0");
+    CleanupOutputLog();
+
+    DisableBackgroundDiscovery();
+}
+
+TEST(Dispatcher_BackgroundDiscovery, FiltersSetAfterLoadAreApplied) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableBackgroundDiscovery();
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_FALSE(implDesc == nullptr);
+
+    if (implDesc) {
+        EXPECT_EQ(std::string(implDesc->ImplName), "Stub Implementation");
+        MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    // filter which matches no implementation, set after discovery has finished
+    sts = SetConfigFilterProperty<mfxU32>(loader, "mfxImplDescription.VendorID", 0xFFFF);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+
+    DisableBackgroundDiscovery();
+}
+
+TEST(Dispatcher_BackgroundDiscovery, LowLatencyFiltersUseFullDiscovery) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableBackgroundDiscovery();
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    // these filters select low latency mode when background discovery is disabled
+    mfxStatus sts =
+        SetConfigFilterProperty<mfxU32>(loader, "mfxImplDescription.Impl", MFX_IMPL_TYPE_HARDWARE);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    sts = SetConfigFilterProperty<mfxHDL>(loader, "mfxImplDescription.ImplName", (mfxHDL) "mfx-gen");
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    sts = SetConfigFilterProperty<mfxU32>(loader, "mfxImplDescription.VendorID", 0x8086);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    sts = SetConfigFilterProperty<mfxU32>(loader,
+                                          "mfxImplDescription.AccelerationMode",
+                                          MFX_ACCEL_MODE_VIA_VAAPI);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // session may fail if there is no GPU runtime, only the mode is checked
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  low latency mode disabled");
+    CheckOutputLog("message:  low latency mode enabled", false);
+    CleanupOutputLog();
+
+    DisableBackgroundDiscovery();
+}
+
+    #ifdef ONEVPL_EXPERIMENTAL
+TEST(Dispatcher_BackgroundDiscovery, PropsQuerySetAfterLoadIsApplied) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableBackgroundDiscovery();
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // let discovery finish first, so the libraries have already been queried without the filter
+    // the filter must be applied whichever thread takes the loader lock first
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // stub RT only reports the MPEG2 decoder when queried with this property
+    mfxConfig cfg       = MFXCreateConfig(loader);
+    mfxVariant var      = {};
+    var.Version.Version = MFX_VARIANT_VERSION;
+    var.Type     = static_cast<mfxVariantType>(MFX_VARIANT_TYPE_U32 | MFX_VARIANT_TYPE_QUERY);
+    var.Data.U32 = MFX_CODEC_MPEG2;
+    sts          = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+        var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_FALSE(implDesc == nullptr);
+
+    EXPECT_EQ(std::string(implDesc->ImplName), "Stub Implementation");
+    EXPECT_EQ(implDesc->Dec.NumCodecs, 1);
+    if (implDesc->Dec.NumCodecs == 1) {
+        EXPECT_EQ(implDesc->Dec.Codecs[0].CodecID, MFX_CODEC_MPEG2);
+    }
+    EXPECT_EQ(implDesc->Enc.NumCodecs, 0);
+
+    MFXDispReleaseImplDescription(loader, implDesc);
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  property-based query set after libraries were queried", false);
+    CleanupOutputLog();
+
+    DisableBackgroundDiscovery();
+}
+    #endif
+
+TEST(Dispatcher_BackgroundDiscovery, DisabledByDefault) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    DisableBackgroundDiscovery();
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  background discovery", false);
+    CleanupOutputLog();
+}
+
+#endif
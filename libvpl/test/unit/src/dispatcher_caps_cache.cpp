@@ -0,0 +1,601 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for persistent capabilities cache (ONEVPL_CAPS_CACHE_FILE).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+    #include <dirent.h>
+    #include <stdlib.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #include <utime.h>
+
+    #include <sstream>
+    #include <thread>
+
+    #define CAPS_CACHE_DEF_FILENAME "utestCapsCache_vpl.bin"
+
+// run a stub session, leaving the dispatcher log for this loader in CAPTURE_LOG_DEF_FILENAME
+static void RunLoggedStubSession() {
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    RunStubSession();
+}
+
+static void EnableCapsCache() {
+    std::remove(CAPS_CACHE_DEF_FILENAME);
+    setenv("ONEVPL_CAPS_CACHE_FILE", CAPS_CACHE_DEF_FILENAME, 1);
+}
+
+static void DisableCapsCache() {
+    unsetenv("ONEVPL_CAPS_CACHE_FILE");
+    std::remove(CAPS_CACHE_DEF_FILENAME);
+}
+
+TEST(Dispatcher_CapsCache, SecondLoaderUsesCache) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableCapsCache();
+
+    // first loader queries the RT and writes the cache
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache miss");
+    CheckOutputLog("message:  caps cache stored");
+    CleanupOutputLog();
+
+    // second loader uses cached caps without loading the RT
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit");
+    CheckOutputLog("message:  caps cache miss", false);
+    CheckOutputLog("message:  caps cache stored", false);
+    CleanupOutputLog();
+
+    DisableCapsCache();
+}
+
+// return the number of temporary files left next to the cache file
+static int CountCacheTmpFiles() {
+    DIR *pDir = opendir(".");
+    if (!pDir)
+        return -1;
+
+    std::string prefix = std::string(CAPS_CACHE_DEF_FILENAME) + ".";
+
+    int numFiles = 0;
+    struct dirent *ent;
+    while ((ent = readdir(pDir)) != nullptr) {
+        if (!strncmp(ent->d_name, prefix.c_str(), prefix.size()))
+            numFiles++;
+    }
+    closedir(pDir);
+
+    return numFiles;
+}
+
+TEST(Dispatcher_CapsCache, ConcurrentSaveKeepsCacheValid) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableCapsCache();
+
+    // several loaders in one process miss the empty cache and write it at the same time
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([]() {
+            mfxLoader loader = LoadStub();
+            EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+            MFXUnload(loader);
+        });
+    }
+
+    for (auto &t : threads)
+        t.join();
+
+    EXPECT_EQ(CountCacheTmpFiles(), 0);
+
+    // the file left by the last writer is complete
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit");
+    CheckOutputLog("message:  caps cache miss", false);
+    CleanupOutputLog();
+
+    DisableCapsCache();
+}
+
+TEST(Dispatcher_CapsCache, SelectionStoredWithCaps) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableCapsCache();
+
+    // first loader validates the filters and stores the result along with the caps
+    RunLoggedStubSession();
+    CheckOutputLog("message:  selection stored in caps cache");
+    CheckOutputLog("message:  selection reused", false);
+    CleanupOutputLog();
+
+    // second loader with the same filters uses the stored selection
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit");
+    CheckOutputLog("message:  selection reused from caps cache");
+    CheckOutputLog("message:  selection stored in caps cache", false);
+    CleanupOutputLog();
+
+    // different filters are validated again
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = SetConfigFilterProperty<mfxU32>(loader, "mfxImplDescription.VendorID", 0xFFFF);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  selection reused", false);
+    CheckOutputLog("message:  selection stored in caps cache");
+    CleanupOutputLog();
+
+    DisableCapsCache();
+}
+
+// return the description and function names of the stub RT, as reported by the loader
+static std::string GetStubCapsString() {
+    std::stringstream ss;
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (implDesc) {
+        ss << implDesc->ImplName << ";" << implDesc->ApiVersion.Version << ";"
+           << implDesc->Dev.DeviceID << ";";
+        for (mfxU32 c = 0; c < implDesc->Dec.NumCodecs; c++) {
+            const auto &codec = implDesc->Dec.Codecs[c];
+            ss << "dec:" << codec.CodecID << ":" << codec.MaxcodecLevel;
+            for (mfxU32 p = 0; p < codec.NumProfiles; p++) {
+                const auto &profile = codec.Profiles[p];
+                ss << ":" << profile.Profile;
+                for (mfxU32 m = 0; m < profile.NumMemTypes; m++) {
+                    const auto &memDesc = profile.MemDesc[m];
+                    ss << "/" << memDesc.MemHandleType << "/" << memDesc.Width.Max;
+                    for (mfxU32 f = 0; f < memDesc.NumColorFormats; f++)
+                        ss << "," << memDesc.ColorFormats[f];
+                }
+            }
+            ss << ";";
+        }
+        for (mfxU32 f = 0; f < implDesc->VPP.NumFilters; f++) {
+            const auto &filter = implDesc->VPP.Filters[f];
+            ss << "vpp:" << filter.FilterFourCC;
+            for (mfxU32 m = 0; m < filter.NumMemTypes; m++) {
+                const auto &memDesc = filter.MemDesc[m];
+                for (mfxU32 n = 0; n < memDesc.NumInFormats; n++) {
+                    ss << "/" << memDesc.Formats[n].InFormat;
+                    for (mfxU32 o = 0; o < memDesc.Formats[n].NumOutFormat; o++)
+                        ss << "," << memDesc.Formats[n].OutFormats[o];
+                }
+            }
+            ss << ";";
+        }
+        MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    mfxImplementedFunctions *implFuncs = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS, (mfxHDL *)&implFuncs);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (implFuncs) {
+        for (mfxU32 i = 0; i < implFuncs->NumFunctions; i++)
+            ss << implFuncs->FunctionsName[i] << ";";
+        MFXDispReleaseImplDescription(loader, implFuncs);
+    }
+
+    MFXUnload(loader);
+
+    return ss.str();
+}
+
+TEST(Dispatcher_CapsCache, CachedCapsMatchRuntime) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    DisableCapsCache();
+
+    std::string rtCaps = GetStubCapsString();
+    EXPECT_FALSE(rtCaps.empty());
+
+    // first loader writes the cache, second one uses the mapped copy
+    EnableCapsCache();
+    EXPECT_EQ(GetStubCapsString(), rtCaps);
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    EXPECT_EQ(GetStubCapsString(), rtCaps);
+    CheckOutputLog("message:  caps cache hit");
+    CleanupOutputLog();
+
+    DisableCapsCache();
+}
+
+TEST(Dispatcher_CapsCache, ModifiedLibraryInvalidatesEntry) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    const char *searchPath = getenv("ONEVPL_SEARCH_PATH");
+    if (!searchPath)
+        GTEST_SKIP();
+    std::string origSearchPath = searchPath;
+
+    // copy stub RT to a temporary directory so that it can be modified
+    char tmpDir[] = "/tmp/utestCapsCacheXXXXXX";
+    ASSERT_FALSE(mkdtemp(tmpDir) == nullptr);
+
+    std::string srcLib = origSearchPath + PATH_SEPARATOR + "libvplstubrt64.so";
+    std::string dstLib = std::string(tmpDir) + PATH_SEPARATOR + "libvplstubrt64.so";
+    {
+        std::ifstream src(srcLib, std::ios::binary);
+        std::ofstream dst(dstLib, std::ios::binary);
+        ASSERT_TRUE(src.is_open() && dst.is_open());
+        dst << src.rdbuf();
+    }
+
+    setenv("ONEVPL_SEARCH_PATH", tmpDir, 1);
+    EnableCapsCache();
+
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache stored");
+    CleanupOutputLog();
+
+    // change modification time, entry should be discarded
+    struct utimbuf newTime = {};
+    newTime.actime         = 1000000000;
+    newTime.modtime        = 1000000000;
+    EXPECT_EQ(utime(dstLib.c_str(), &newTime), 0);
+
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit", false);
+    CheckOutputLog("message:  caps cache miss");
+    CheckOutputLog("message:  caps cache stored");
+    CleanupOutputLog();
+
+    // cache updated with new entry
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit");
+    CleanupOutputLog();
+
+    DisableCapsCache();
+    setenv("ONEVPL_SEARCH_PATH", origSearchPath.c_str(), 1);
+
+    std::remove(dstLib.c_str());
+    rmdir(tmpDir);
+}
+
+static void WriteSysfsAttr(const std::string &path, const char *value) {
+    std::ofstream attrFile(path);
+    EXPECT_TRUE(attrFile.is_open());
+    attrFile << value << "\n";
+}
+
+// fake sysfs tree with one Intel render node (renderD128), selected with ONEVPL_SYSFS_ROOT
+class FakeSysfs {
+public:
+    bool Create() {
+        char tmpDir[] = "/tmp/utestSysfsXXXXXX";
+        if (mkdtemp(tmpDir) == nullptr)
+            return false;
+
+        m_root    = tmpDir;
+        m_pciDir  = m_root + "/devices/pci0000:00/0000:03:00.0";
+        m_nodeDir = m_root + "/class/drm/renderD128";
+        for (const std::string &dir : GetDirs()) {
+            if (dir != m_root && mkdir(dir.c_str(), 0700))
+                return false;
+        }
+        if (symlink(m_pciDir.c_str(), (m_nodeDir + "/device").c_str()))
+            return false;
+
+        WriteSysfsAttr(m_pciDir + "/vendor", "0x8086");
+        WriteSysfsAttr(m_pciDir + "/device", "0x56a0");
+        WriteSysfsAttr(m_pciDir + "/revision", "0x08");
+
+        setenv("ONEVPL_SYSFS_ROOT", m_root.c_str(), 1);
+
+        return true;
+    }
+
+    // move the GPU to another render node number
+    bool MoveNode(mfxU32 nodeNum) {
+        std::string nodeDir = m_root + "/class/drm/renderD" + std::to_string(nodeNum);
+        if (rename(m_nodeDir.c_str(), nodeDir.c_str()))
+            return false;
+
+        m_nodeDir = nodeDir;
+        return true;
+    }
+
+    void Remove() {
+        unsetenv("ONEVPL_SYSFS_ROOT");
+
+        if (m_root.empty())
+            return;
+
+        for (const char *attr : { "/vendor", "/device", "/revision" })
+            std::remove((m_pciDir + attr).c_str());
+        std::remove((m_nodeDir + "/device").c_str());
+
+        std::vector<std::string> dirs = GetDirs();
+        for (auto it = dirs.rbegin(); it != dirs.rend(); it++)
+            rmdir(it->c_str());
+    }
+
+private:
+    std::vector<std::string> GetDirs() {
+        return { m_root,
+                 m_root + "/devices",
+                 m_root + "/devices/pci0000:00",
+                 m_pciDir,
+                 m_root + "/class",
+                 m_root + "/class/drm",
+                 m_nodeDir };
+    }
+
+    std::string m_root;
+    std::string m_pciDir;
+    std::string m_nodeDir;
+};
+
+TEST(Dispatcher_CapsCache, ChangedDeviceListInvalidatesCache) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    FakeSysfs sysfs;
+    ASSERT_TRUE(sysfs.Create());
+    EnableCapsCache();
+
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache stored");
+    CleanupOutputLog();
+
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit");
+    CleanupOutputLog();
+
+    // GPU shows up on a different render node, all entries should be discarded
+    EXPECT_TRUE(sysfs.MoveNode(129));
+
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit", false);
+    CheckOutputLog("message:  caps cache miss");
+    CheckOutputLog("message:  caps cache stored");
+    CleanupOutputLog();
+
+    DisableCapsCache();
+    sysfs.Remove();
+}
+
+// create loader filtered to the legacy MSDK RT
+static mfxLoader LoadMSDKStub() {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    mfxVariant var;
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_PTR;
+    var.Data.Ptr        = (mfxHDL) "mfxhw64";
+    mfxStatus sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.ImplName", var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    return loader;
+}
+
+// check the description of the MSDK RT on the fake render node
+static void CheckMSDKStubCaps(mfxLoader loader) {
+    mfxImplDescription *implDesc = nullptr;
+    mfxStatus sts =
+        MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_FALSE(implDesc == nullptr);
+
+    if (implDesc) {
+        EXPECT_EQ(implDesc->Impl, MFX_IMPL_TYPE_HARDWARE);
+        EXPECT_EQ(implDesc->AccelerationMode, MFX_ACCEL_MODE_VIA_VAAPI);
+        EXPECT_EQ(implDesc->VendorImplID, 0u);
+        EXPECT_EQ(std::string(implDesc->Dev.DeviceID), "56a0/0");
+        MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    mfxExtendedDeviceId *extDeviceID = nullptr;
+    sts                              = MFXEnumImplementations(loader,
+                                     0,
+                                     MFX_IMPLCAPS_DEVICE_ID_EXTENDED,
+                                     (mfxHDL *)&extDeviceID);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (extDeviceID) {
+        EXPECT_EQ(extDeviceID->DeviceID, 0x56a0);
+        EXPECT_EQ(extDeviceID->DRMRenderNodeNum, 128u);
+        MFXDispReleaseImplDescription(loader, extDeviceID);
+    }
+
+    // only the first adapter has a render node
+    implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 1, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+}
+
+TEST(Dispatcher_CapsCache, MSDKCapsWithoutTestSessions) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    const char *searchPath = getenv("ONEVPL_SEARCH_PATH");
+    if (!searchPath)
+        GTEST_SKIP();
+    std::string origSearchPath = searchPath;
+
+    // stub RT built without the 2.x entrypoints, named like a legacy MSDK RT
+    char tmpDir[] = "/tmp/utestCapsCacheXXXXXX";
+    ASSERT_FALSE(mkdtemp(tmpDir) == nullptr);
+
+    std::string srcLib = origSearchPath + PATH_SEPARATOR + "stub-msdk" + PATH_SEPARATOR +
+                         "libvplstubrt-msdk64.so";
+    std::string dstLib = std::string(tmpDir) + PATH_SEPARATOR + "libmfxhw64.so.1";
+    {
+        std::ifstream src(srcLib, std::ios::binary);
+        std::ofstream dst(dstLib, std::ios::binary);
+        ASSERT_TRUE(src.is_open() && dst.is_open());
+        dst << src.rdbuf();
+    }
+
+    FakeSysfs sysfs;
+    ASSERT_TRUE(sysfs.Create());
+
+    setenv("ONEVPL_SEARCH_PATH", tmpDir, 1);
+    EnableCapsCache();
+
+    // first loader opens test sessions on the RT to build the description
+    CaptureOutputLog(CAPTURE_LOG_COUT);
+    mfxLoader loader = LoadMSDKStub();
+    CheckMSDKStubCaps(loader);
+    CheckOutputLog("[STUB RT]: message -- MFXInitEx");
+    CleanupOutputLog();
+    MFXUnload(loader);
+
+    // second loader reads the description from the cache, without opening any session
+    CaptureOutputLog(CAPTURE_LOG_COUT);
+    loader = LoadMSDKStub();
+    CheckMSDKStubCaps(loader);
+    CheckOutputLog("[STUB RT]: message -- MFXInitEx", false);
+    CleanupOutputLog();
+
+    // RT is loaded when the application creates a session
+    mfxSession session = nullptr;
+    mfxStatus sts      = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+    MFXUnload(loader);
+
+    DisableCapsCache();
+    sysfs.Remove();
+    setenv("ONEVPL_SEARCH_PATH", origSearchPath.c_str(), 1);
+
+    std::remove(dstLib.c_str());
+    rmdir(tmpDir);
+}
+
+TEST(Dispatcher_CapsCache, CorruptFileIgnored) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableCapsCache();
+
+    RunLoggedStubSession();
+    CleanupOutputLog();
+
+    // truncate valid cache file
+    std::string cacheData;
+    {
+        std::ifstream cacheFile(CAPS_CACHE_DEF_FILENAME, std::ios::binary);
+        ASSERT_TRUE(cacheFile.is_open());
+        std::stringstream ss;
+        ss << cacheFile.rdbuf();
+        cacheData = ss.str();
+    }
+    ASSERT_GT(cacheData.size(), 16);
+    {
+        std::ofstream cacheFile(CAPS_CACHE_DEF_FILENAME, std::ios::binary | std::ios::trunc);
+        cacheFile << cacheData.substr(0, cacheData.size() - 16);
+    }
+
+    // should fall back to loading the RT and rewrite the cache
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit", false);
+    CheckOutputLog("message:  caps cache stored");
+    CleanupOutputLog();
+
+    // replace with garbage
+    {
+        std::ofstream cacheFile(CAPS_CACHE_DEF_FILENAME, std::ios::binary | std::ios::trunc);
+        cacheFile << "not a caps cache file";
+    }
+
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit", false);
+    CheckOutputLog("message:  caps cache stored");
+    CleanupOutputLog();
+
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache hit");
+    CleanupOutputLog();
+
+    DisableCapsCache();
+}
+
+// cache file is mapped read-only and shared, cached caps are copied out of it when used
+TEST(Dispatcher_CapsCache, SnapshotMappedReadOnly) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableCapsCache();
+
+    RunLoggedStubSession();
+    CleanupOutputLog();
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_FALSE(implDesc == nullptr);
+    EXPECT_EQ(std::string(implDesc->ImplName), "Stub Implementation");
+
+    // address range, permissions, offset, device, inode, path
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    int numMappings = 0;
+    while (std::getline(maps, line)) {
+        if (line.find(CAPS_CACHE_DEF_FILENAME) == std::string::npos)
+            continue;
+
+        std::istringstream fields(line);
+        std::string range, perms;
+        fields >> range >> perms;
+        EXPECT_EQ(perms, "r--s");
+        numMappings++;
+    }
+    EXPECT_EQ(numMappings, 1);
+
+    MFXDispReleaseImplDescription(loader, implDesc);
+    MFXUnload(loader);
+
+    DisableCapsCache();
+}
+
+TEST(Dispatcher_CapsCache, DisabledByDefault) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    DisableCapsCache();
+
+    RunLoggedStubSession();
+    CheckOutputLog("message:  caps cache", false);
+    CleanupOutputLog();
+
+    std::ifstream cacheFile(CAPS_CACHE_DEF_FILENAME);
+    EXPECT_FALSE(cacheFile.is_open());
+}
+
+#endif
@@ -8,6 +8,60 @@
 
 #include "src/dispatcher_common.h"
 
+mfxLoader LoadStub() {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    return loader;
+}
+
+mfxStatus EnumStub(mfxLoader loader) {
+    mfxImplDescription *implDesc = nullptr;
+    mfxStatus sts =
+        MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+
+    if (implDesc) {
+        EXPECT_EQ(std::string(implDesc->ImplName), "Stub Implementation");
+        EXPECT_GT(implDesc->Dec.NumCodecs, 0);
+        EXPECT_FALSE(implDesc->Dec.Codecs == nullptr);
+        MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    return sts;
+}
+
+mfxSession CreateStubSession(mfxLoader loader) {
+    mfxSession session = nullptr;
+    mfxStatus sts      = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    return session;
+}
+
+mfxStatus CreateAndCloseStubSession(mfxLoader loader) {
+    mfxSession session = nullptr;
+    mfxStatus sts      = MFXCreateSession(loader, 0, &session);
+    if (session)
+        MFXClose(session);
+
+    return sts;
+}
+
+void RunStubSession() {
+    mfxLoader loader = LoadStub();
+
+    mfxStatus sts = EnumStub(loader);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = CreateAndCloseStubSession(loader);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+}
+
 void Dispatcher_CreateSession_SimpleConfigCanCreateSession(mfxImplType implType) {
     mfxLoader loader = MFXLoad();
     EXPECT_FALSE(loader == nullptr);
@@ -2419,6 +2473,249 @@ TEST(Dispatcher_Common_SetConfigFilterProperty, PartialFilterReturnsErrNotFound)
     MFXUnload(loader);
 }
 
+TEST(Dispatcher_Common_SetConfigFilterProperty, AlternateNamesReturnErrNone) {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxStatus sts;
+    mfxVariant ImplValue;
+
+    ImplValue.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    ImplValue.Type            = MFX_VARIANT_TYPE_U32;
+    ImplValue.Data.U32        = MFX_FOURCC_NV12;
+
+    sts = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.ColorFormat",
+        ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.ColorFormats",
+        ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxVPPDescription.filter.memdesc.format.OutFormats",
+        ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // trailing '.' is ignored
+    ImplValue.Data.U32 = MFX_IMPL_TYPE_SOFTWARE;
+
+    sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.Impl.", ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // old version of table in spec had extra "device"
+    ImplValue.Type     = MFX_VARIANT_TYPE_U16;
+    ImplValue.Data.U16 = 0x1234;
+
+    sts = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDeviceDescription.device.DeviceID",
+        ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // partial names are not found
+    sts = MFXSetConfigFilterProperty(cfg,
+                                     (const mfxU8 *)"mfxImplDescription.mfxDeviceDescription",
+                                     ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.Imp", ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // free internal resources
+    MFXUnload(loader);
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+TEST(Dispatcher_Common_SetConfigFilterPropertyById, NullConfigReturnsErrNull) {
+    mfxVariant ImplValue;
+
+    ImplValue.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    ImplValue.Type            = MFX_VARIANT_TYPE_U32;
+    ImplValue.Data.U32        = MFX_IMPL_TYPE_SOFTWARE;
+
+    mfxStatus sts = MFXSetConfigFilterPropertyById(nullptr, MFX_CFG_PROP_IMPL, ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+}
+
+TEST(Dispatcher_Common_SetConfigFilterPropertyById, UnknownIdReturnsNotFound) {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxVariant ImplValue;
+
+    ImplValue.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    ImplValue.Type            = MFX_VARIANT_TYPE_U32;
+    ImplValue.Data.U32        = 0;
+
+    mfxStatus sts = MFXSetConfigFilterPropertyById(cfg, MFX_CFG_PROP_QUERY_VPP + 1, ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    sts = MFXSetConfigFilterPropertyById(cfg, 0xFFFFFFFF, ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // free internal resources
+    MFXUnload(loader);
+}
+
+// every ID must select the same property as its name in mfxdispatcher.h
+TEST(Dispatcher_Common_SetConfigFilterPropertyById, IdMatchesPropertyName) {
+    struct {
+        mfxU32 propId;
+        const char *name;
+    } propTab[] = {
+        { MFX_CFG_PROP_IMPL, "mfxImplDescription.Impl" },
+        { MFX_CFG_PROP_ACCELERATION_MODE, "mfxImplDescription.AccelerationMode" },
+        { MFX_CFG_PROP_API_VERSION, "mfxImplDescription.ApiVersion.Version" },
+        { MFX_CFG_PROP_API_VERSION_MAJOR, "mfxImplDescription.ApiVersion.Major" },
+        { MFX_CFG_PROP_API_VERSION_MINOR, "mfxImplDescription.ApiVersion.Minor" },
+        { MFX_CFG_PROP_IMPL_NAME, "mfxImplDescription.ImplName" },
+        { MFX_CFG_PROP_LICENSE, "mfxImplDescription.License" },
+        { MFX_CFG_PROP_KEYWORDS, "mfxImplDescription.Keywords" },
+        { MFX_CFG_PROP_VENDOR_ID, "mfxImplDescription.VendorID" },
+        { MFX_CFG_PROP_VENDOR_IMPL_ID, "mfxImplDescription.VendorImplID" },
+        { MFX_CFG_PROP_SURFACE_POOL_MODE, "mfxImplDescription.mfxSurfacePoolMode" },
+        { MFX_CFG_PROP_DEVICE_ID, "mfxImplDescription.mfxDeviceDescription.DeviceID" },
+        { MFX_CFG_PROP_MEDIA_ADAPTER_TYPE, "mfxImplDescription.mfxDeviceDescription.MediaAdapterType" },
+        { MFX_CFG_PROP_DEC_CODEC_ID, "mfxImplDescription.mfxDecoderDescription.decoder.CodecID" },
+        { MFX_CFG_PROP_DEC_MAX_CODEC_LEVEL, "mfxImplDescription.mfxDecoderDescription.decoder.MaxcodecLevel" },
+        { MFX_CFG_PROP_DEC_PROFILE, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.Profile" },
+        { MFX_CFG_PROP_DEC_MEM_HANDLE_TYPE, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.MemHandleType" },
+        { MFX_CFG_PROP_DEC_WIDTH, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.Width" },
+        { MFX_CFG_PROP_DEC_HEIGHT, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.Height" },
+        { MFX_CFG_PROP_DEC_COLOR_FORMAT, "mfxImplDescription.mfxDecoderDescription.decoder.decprofile.decmemdesc.ColorFormats" },
+        { MFX_CFG_PROP_ENC_CODEC_ID, "mfxImplDescription.mfxEncoderDescription.encoder.CodecID" },
+        { MFX_CFG_PROP_ENC_MAX_CODEC_LEVEL, "mfxImplDescription.mfxEncoderDescription.encoder.MaxcodecLevel" },
+        { MFX_CFG_PROP_ENC_BIDIRECTIONAL_PREDICTION, "mfxImplDescription.mfxEncoderDescription.encoder.BiDirectionalPrediction" },
+        { MFX_CFG_PROP_ENC_PROFILE, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.Profile" },
+        { MFX_CFG_PROP_ENC_MEM_HANDLE_TYPE, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.MemHandleType" },
+        { MFX_CFG_PROP_ENC_WIDTH, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.Width" },
+        { MFX_CFG_PROP_ENC_HEIGHT, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.Height" },
+        { MFX_CFG_PROP_ENC_COLOR_FORMAT, "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.ColorFormats" },
+        { MFX_CFG_PROP_VPP_FILTER_FOURCC, "mfxImplDescription.mfxVPPDescription.filter.FilterFourCC" },
+        { MFX_CFG_PROP_VPP_MAX_DELAY_IN_FRAMES, "mfxImplDescription.mfxVPPDescription.filter.MaxDelayInFrames" },
+        { MFX_CFG_PROP_VPP_MEM_HANDLE_TYPE, "mfxImplDescription.mfxVPPDescription.filter.memdesc.MemHandleType" },
+        { MFX_CFG_PROP_VPP_WIDTH, "mfxImplDescription.mfxVPPDescription.filter.memdesc.Width" },
+        { MFX_CFG_PROP_VPP_HEIGHT, "mfxImplDescription.mfxVPPDescription.filter.memdesc.Height" },
+        { MFX_CFG_PROP_VPP_IN_FORMAT, "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.InFormat" },
+        { MFX_CFG_PROP_VPP_OUT_FORMAT, "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.OutFormat" },
+        { MFX_CFG_PROP_EXTDEV_VENDOR_ID, "mfxExtendedDeviceId.VendorID" },
+        { MFX_CFG_PROP_EXTDEV_DEVICE_ID, "mfxExtendedDeviceId.DeviceID" },
+        { MFX_CFG_PROP_EXTDEV_PCI_DOMAIN, "mfxExtendedDeviceId.PCIDomain" },
+        { MFX_CFG_PROP_EXTDEV_PCI_BUS, "mfxExtendedDeviceId.PCIBus" },
+        { MFX_CFG_PROP_EXTDEV_PCI_DEVICE, "mfxExtendedDeviceId.PCIDevice" },
+        { MFX_CFG_PROP_EXTDEV_PCI_FUNCTION, "mfxExtendedDeviceId.PCIFunction" },
+        { MFX_CFG_PROP_EXTDEV_DEVICE_LUID, "mfxExtendedDeviceId.DeviceLUID" },
+        { MFX_CFG_PROP_EXTDEV_LUID_DEVICE_NODE_MASK, "mfxExtendedDeviceId.LUIDDeviceNodeMask" },
+        { MFX_CFG_PROP_EXTDEV_DRM_RENDER_NODE_NUM, "mfxExtendedDeviceId.DRMRenderNodeNum" },
+        { MFX_CFG_PROP_EXTDEV_DRM_PRIMARY_NODE_NUM, "mfxExtendedDeviceId.DRMPrimaryNodeNum" },
+        { MFX_CFG_PROP_EXTDEV_REVISION_ID, "mfxExtendedDeviceId.RevisionID" },
+        { MFX_CFG_PROP_EXTDEV_DEVICE_NAME, "mfxExtendedDeviceId.DeviceName" },
+        { MFX_CFG_PROP_SURFACE_TYPE, "mfxSurfaceTypesSupported.surftype.SurfaceType" },
+        { MFX_CFG_PROP_SURFACE_COMPONENT, "mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceComponent" },
+        { MFX_CFG_PROP_SURFACE_FLAGS, "mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceFlags" },
+        { MFX_CFG_PROP_HANDLE_TYPE, "mfxHandleType" },
+        { MFX_CFG_PROP_HANDLE, "mfxHDL" },
+        { MFX_CFG_PROP_NUM_THREAD, "NumThread" },
+        { MFX_CFG_PROP_DEVICE_COPY, "DeviceCopy" },
+        { MFX_CFG_PROP_EXT_BUFFER, "ExtBuffer" },
+    #if defined(_WIN32) || defined(_WIN64)
+        // this property is only valid on Windows
+        { MFX_CFG_PROP_DXGI_ADAPTER_INDEX, "DXGIAdapterIndex" },
+    #endif
+        { MFX_CFG_PROP_FUNCTION_NAME, "mfxImplementedFunctions.FunctionsName" },
+        { MFX_CFG_PROP_QUERY_IMPL, "mfxImplDescription" },
+        { MFX_CFG_PROP_QUERY_DEC, "mfxImplDescription.mfxDecoderDescription" },
+        { MFX_CFG_PROP_QUERY_ENC, "mfxImplDescription.mfxEncoderDescription" },
+        { MFX_CFG_PROP_QUERY_VPP, "mfxImplDescription.mfxVPPDescription" },
+    };
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfgName = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfgName == nullptr);
+
+    mfxConfig cfgId = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfgId == nullptr);
+
+    // the status for each value type depends on the type of the property, so it
+    //   must be the same whether the property is set by name or by ID
+    mfxVariantType varTypes[] = { MFX_VARIANT_TYPE_U16, MFX_VARIANT_TYPE_U32 };
+
+    for (auto &prop : propTab) {
+        for (auto varType : varTypes) {
+            mfxVariant var;
+            var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+            var.Type            = varType;
+            var.Data.U64        = 0;
+
+            mfxStatus stsName = MFXSetConfigFilterProperty(cfgName, (const mfxU8 *)prop.name, var);
+            mfxStatus stsId   = MFXSetConfigFilterPropertyById(cfgId, prop.propId, var);
+
+            EXPECT_NE(stsName, MFX_ERR_NOT_FOUND) << prop.name;
+            EXPECT_EQ(stsName, stsId) << prop.name;
+        }
+    }
+
+    // free internal resources
+    MFXUnload(loader);
+}
+#endif
+
+TEST(Dispatcher_Common_SetConfigFilterProperty, ExtraTrailingComponentsIgnored) {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxStatus sts;
+    mfxVariant ImplValue;
+
+    ImplValue.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    ImplValue.Type            = MFX_VARIANT_TYPE_U32;
+    ImplValue.Data.U32        = MFX_IMPL_TYPE_SOFTWARE;
+
+    // anything after the name of a property is ignored, as in earlier releases
+    sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.Impl.Foo", ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    ImplValue.Data.U32 = MFX_CODEC_AVC;
+
+    sts = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDecoderDescription.decoder.CodecID.Foo.Bar",
+        ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // a trailing component does not turn an incomplete name into a valid one
+    sts = MFXSetConfigFilterProperty(cfg,
+                                     (const mfxU8 *)"mfxImplDescription.ApiVersion.Foo",
+                                     ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    sts = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDecoderDescription.decoder.Foo",
+        ImplValue);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // free internal resources
+    MFXUnload(loader);
+}
+
 TEST(Dispatcher_Common_SetConfigFilterProperty, OutOfRangeValueReturnsErrNone) {
     mfxLoader loader = MFXLoad();
     EXPECT_FALSE(loader == nullptr);
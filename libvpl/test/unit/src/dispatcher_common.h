@@ -48,11 +48,28 @@ typedef enum {
     CAPTURE_LOG_DISPATCHER = 1, // capture the dispatcher log output (enables ONEVPL_DISPATCHER_LOG)
     CAPTURE_LOG_FILE       = 2, // capture log output which is sent to a file
     CAPTURE_LOG_COUT       = 3, // capture log output which is sent to std::cout
+    CAPTURE_LOG_TRACE      = 4, // capture the dispatcher trace (ONEVPL_DISPATCHER_LOG=TRACE)
 } CaptureLogType;
 
 // helper functions for dispatcher tests
 mfxStatus SetConfigImpl(mfxLoader loader, mfxU32 implType, bool bRequire2xGPU = false);
 
+// create loader filtered to the stub RT (MFX_IMPL_TYPE_STUB)
+mfxLoader LoadStub();
+
+// enumerate the first implementation and check that it is the stub RT
+// returns status of MFXEnumImplementations()
+mfxStatus EnumStub(mfxLoader loader);
+
+// create session with the first implementation, which the caller must close
+mfxSession CreateStubSession(mfxLoader loader);
+
+// create and close session with the first implementation, returns status of MFXCreateSession()
+mfxStatus CreateAndCloseStubSession(mfxLoader loader);
+
+// load the stub RT, enumerate it, create and close a session, then unload
+void RunStubSession();
+
 // start capturing log output, behavior determined by CaptureLogType
 void CaptureOutputLog(CaptureLogType type);
 
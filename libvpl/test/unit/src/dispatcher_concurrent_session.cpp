@@ -0,0 +1,236 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for concurrent enumeration and session creation on a single loader.
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "src/dispatcher_common.h"
+
+#define NUM_TEST_THREADS 8
+
+// start all threads at the same time, to maximize contention on first use of the loader
+class StartGate {
+public:
+    StartGate() : m_bOpen(false) {}
+
+    void Wait() {
+        while (!m_bOpen)
+            std::this_thread::yield();
+    }
+
+    void Open() {
+        m_bOpen = true;
+    }
+
+private:
+    std::atomic<bool> m_bOpen;
+};
+
+// create and close one session, return true on success
+static bool CreateAndCloseSession(mfxLoader loader) {
+    mfxSession session = nullptr;
+    mfxStatus sts      = MFXCreateSession(loader, 0, &session);
+    if (sts != MFX_ERR_NONE || !session)
+        return false;
+
+    mfxVersion version = {};
+    sts                = MFXQueryVersion(session, &version);
+
+    return (MFXClose(session) == MFX_ERR_NONE && sts == MFX_ERR_NONE);
+}
+
+static bool EnumAndReleaseImpl(mfxLoader loader) {
+    mfxImplDescription *implDesc = nullptr;
+    mfxStatus sts =
+        MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    if (sts != MFX_ERR_NONE || !implDesc)
+        return false;
+
+    bool bStubImpl = (std::string(implDesc->ImplName) == "Stub Implementation");
+
+    return (MFXDispReleaseImplDescription(loader, implDesc) == MFX_ERR_NONE && bStubImpl);
+}
+
+// count occurrences of str in the captured dispatcher log
+static size_t CountInOutputLog(const char *str) {
+    std::ifstream logFile(CAPTURE_LOG_DEF_FILENAME);
+    std::stringstream ss;
+    ss << logFile.rdbuf();
+    std::string outputLog = ss.str();
+
+    size_t count = 0;
+    for (size_t pos = outputLog.find(str); pos != std::string::npos;
+         pos        = outputLog.find(str, pos + 1))
+        count++;
+
+    return count;
+}
+
+TEST(Dispatcher_ConcurrentSession, FirstCallFromManyThreadsLoadsOnce) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    StartGate gate;
+    std::atomic<mfxU32> numFailed(0);
+
+    std::vector<std::thread> threads;
+    for (mfxU32 i = 0; i < NUM_TEST_THREADS; i++) {
+        threads.emplace_back([&, i]() {
+            gate.Wait();
+
+            // half of the threads enumerate first, the others create a session directly
+            if ((i & 1) && !EnumAndReleaseImpl(loader))
+                numFailed++;
+
+            if (!CreateAndCloseSession(loader))
+                numFailed++;
+        });
+    }
+
+    gate.Open();
+    for (auto &t : threads)
+        t.join();
+
+    MFXUnload(loader);
+
+    EXPECT_EQ(numFailed, 0u);
+
+    // libraries are only loaded and queried by the first thread to take the writer lock
+    // (one function enter and one return message)
+    EXPECT_EQ(CountInOutputLog("LoaderCtxVPL::CheckValidLibraries"), 2u);
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_ConcurrentSession, StressEnumCreateAndFilterUpdates) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // repeatedly set a filter which does not change the result, forcing readers
+    //   to wait while the list of valid implementations is rebuilt
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxVariant implValue;
+    implValue.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    implValue.Type            = MFX_VARIANT_TYPE_PTR;
+    implValue.Data.Ptr        = (mfxHDL) "Stub Implementation";
+
+    StartGate gate;
+    std::atomic<bool> bDone(false);
+    std::atomic<mfxU32> numFailed(0);
+
+    std::thread filterThread([&]() {
+        gate.Wait();
+        while (!bDone) {
+            if (MFXSetConfigFilterProperty(
+                    cfg,
+                    reinterpret_cast<const mfxU8 *>("mfxImplDescription.ImplName"),
+                    implValue) != MFX_ERR_NONE)
+                numFailed++;
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<std::thread> threads;
+    for (mfxU32 i = 0; i < NUM_TEST_THREADS; i++) {
+        threads.emplace_back([&]() {
+            gate.Wait();
+            for (mfxU32 j = 0; j < 50; j++) {
+                if (!EnumAndReleaseImpl(loader))
+                    numFailed++;
+                if (!CreateAndCloseSession(loader))
+                    numFailed++;
+            }
+        });
+    }
+
+    gate.Open();
+    for (auto &t : threads)
+        t.join();
+
+    bDone = true;
+    filterThread.join();
+
+    MFXUnload(loader);
+
+    EXPECT_EQ(numFailed, 0u);
+}
+
+// return sessions created per second with numThreads threads sharing one loader
+static double MeasureSessionThroughput(mfxLoader loader, mfxU32 numThreads, mfxU32 numSessions) {
+    StartGate gate;
+    std::atomic<mfxU32> numFailed(0);
+
+    std::vector<std::thread> threads;
+    for (mfxU32 i = 0; i < numThreads; i++) {
+        threads.emplace_back([&]() {
+            gate.Wait();
+            for (mfxU32 j = 0; j < numSessions / numThreads; j++) {
+                if (!CreateAndCloseSession(loader))
+                    numFailed++;
+            }
+        });
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    gate.Open();
+    for (auto &t : threads)
+        t.join();
+    auto endTime = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(numFailed, 0u);
+
+    double elapsedSec = std::chrono::duration<double>(endTime - startTime).count();
+
+    return (elapsedSec > 0 ? (numSessions / elapsedSec) : 0);
+}
+
+TEST(Dispatcher_ConcurrentSession, SessionThroughput) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // first session loads and queries the runtime
+    EXPECT_TRUE(CreateAndCloseSession(loader));
+
+    const mfxU32 numSessions = 4000;
+
+    double rate1 = MeasureSessionThroughput(loader, 1, numSessions);
+    double rateN = MeasureSessionThroughput(loader, NUM_TEST_THREADS, numSessions);
+
+    // report only, results depend on the test machine
+    fprintf(stderr,
+            "Info: session throughput -- 1 thread = %.0f/sec, %d threads = %.0f/sec\n",
+            rate1,
+            NUM_TEST_THREADS,
+            rateN);
+
+    MFXUnload(loader);
+}
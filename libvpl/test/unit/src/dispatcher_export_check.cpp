@@ -0,0 +1,114 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for checking library exports before loading (Linux only).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+    #include <dlfcn.h>
+    #include <stdlib.h>
+    #include <unistd.h>
+
+// temporary search directory containing libraries which are not valid runtimes
+class DispatcherExportCheck : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const char *searchPath = getenv("ONEVPL_SEARCH_PATH");
+        if (!searchPath)
+            GTEST_SKIP();
+        m_origSearchPath = searchPath;
+
+        ASSERT_FALSE(mkdtemp(m_tmpDir) == nullptr);
+
+        // search temporary directory first, then the stub runtime directory
+        std::string newSearchPath = std::string(m_tmpDir) + ":" + m_origSearchPath;
+        setenv("ONEVPL_SEARCH_PATH", newSearchPath.c_str(), 1);
+    }
+
+    void TearDown() override {
+        if (m_origSearchPath.empty())
+            return;
+
+        setenv("ONEVPL_SEARCH_PATH", m_origSearchPath.c_str(), 1);
+
+        for (auto &fileName : m_tmpFiles)
+            std::remove(fileName.c_str());
+        rmdir(m_tmpDir);
+    }
+
+    // copy srcFile into the temporary directory and return the new path
+    std::string AddFile(const std::string &srcFile, const std::string &dstName) {
+        std::string dstFile = std::string(m_tmpDir) + PATH_SEPARATOR + dstName;
+
+        std::ifstream src(srcFile, std::ios::binary);
+        std::ofstream dst(dstFile, std::ios::binary);
+        EXPECT_TRUE(src.is_open() && dst.is_open());
+        dst << src.rdbuf();
+
+        m_tmpFiles.push_back(dstFile);
+        return dstFile;
+    }
+
+    std::string AddFileContents(const std::string &contents, const std::string &dstName) {
+        std::string dstFile = std::string(m_tmpDir) + PATH_SEPARATOR + dstName;
+
+        std::ofstream dst(dstFile, std::ios::binary);
+        EXPECT_TRUE(dst.is_open());
+        dst << contents;
+
+        m_tmpFiles.push_back(dstFile);
+        return dstFile;
+    }
+
+    std::string m_origSearchPath;
+    char m_tmpDir[32] = "/tmp/utestExportCheckXXXXXX";
+    std::vector<std::string> m_tmpFiles;
+};
+
+TEST_F(DispatcherExportCheck, NonRuntimeLibrarySkipped) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    // the dispatcher is a valid ELF shared library which exports MFXInitEx and MFXClose,
+    //   but not MFXInitialize, so a renamed copy can never be a valid runtime
+    Dl_info dlInfo = {};
+    ASSERT_NE(dladdr(reinterpret_cast<void *>(&MFXLoad), &dlInfo), 0);
+    ASSERT_FALSE(dlInfo.dli_fname == nullptr);
+
+    std::string fakeLib = AddFile(dlInfo.dli_fname, "libvplfakert.so");
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    RunStubSession();
+
+    std::string expectedLog = "message:  skipped library without required exports -- " + fakeLib;
+    CheckOutputLog(expectedLog.c_str());
+    expectedLog = "message:  skipped library without required exports -- " + m_origSearchPath;
+    CheckOutputLog(expectedLog.c_str(), false);
+    CleanupOutputLog();
+}
+
+TEST_F(DispatcherExportCheck, InvalidFileFallsBackToLoad) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    // not an ELF file - cannot be checked, so dlopen() is attempted and fails
+    AddFileContents("this is not a shared library", "libvplgarbage.so");
+
+    // truncated ELF header
+    AddFileContents(std::string("\x7f" "ELF", 4), "libvpltruncated.so");
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    RunStubSession();
+    CheckOutputLog("skipped library without required exports", false);
+    CleanupOutputLog();
+}
+
+#endif
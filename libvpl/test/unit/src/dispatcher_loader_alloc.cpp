@@ -0,0 +1,251 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for heap usage of the loader (Linux only).
+///
+/// Built as a separate executable (vpl-alloc-tests), since it replaces global operator new.
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+    #include <stdlib.h>
+    #include <unistd.h>
+
+    #include <new>
+
+// replace global new/delete to count allocations made by the dispatcher (and runtime)
+// libvpl.so uses the same libstdc++, so its calls are routed here too
+// only allocations from the thread which enabled counting are included
+static thread_local bool t_bCountAllocs = false;
+static thread_local size_t t_numAllocs  = 0;
+static thread_local size_t t_numBytes   = 0;
+
+void *operator new(size_t size) {
+    if (t_bCountAllocs) {
+        t_numAllocs++;
+        t_numBytes += size;
+    }
+
+    void *p = malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+struct AllocReport {
+    size_t numAllocs;
+    size_t numBytes;
+};
+
+static void StartAllocCount() {
+    t_numAllocs    = 0;
+    t_numBytes     = 0;
+    t_bCountAllocs = true;
+}
+
+static AllocReport StopAllocCount() {
+    t_bCountAllocs = false;
+    return { t_numAllocs, t_numBytes };
+}
+
+// search only a directory with a link to the stub RT, so the counts do not depend on which
+//   runtimes are installed
+// the link resolves to the same file as in the original search path, so libraries found next
+//   to the test executable are skipped as duplicates
+class Dispatcher_LoaderAlloc : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SKIP_IF_DISP_STUB_DISABLED();
+
+        const char *searchPath = getenv("ONEVPL_SEARCH_PATH");
+        if (!searchPath)
+            GTEST_SKIP();
+        m_origSearchPath = searchPath;
+
+        char tmpDir[] = "/tmp/utestLoaderAllocXXXXXX";
+        ASSERT_FALSE(mkdtemp(tmpDir) == nullptr);
+        m_tmpDir = tmpDir;
+
+        const char *libPath = getenv("LD_LIBRARY_PATH");
+        if (libPath) {
+            m_bHasLibPath = true;
+            m_origLibPath = libPath;
+            unsetenv("LD_LIBRARY_PATH");
+        }
+
+        std::string stubLib = m_origSearchPath + PATH_SEPARATOR + "libvplstubrt64.so";
+        char *srcLib        = realpath(stubLib.c_str(), nullptr);
+        ASSERT_FALSE(srcLib == nullptr);
+
+        m_lib   = m_tmpDir + PATH_SEPARATOR + "libvplstubrt64.so";
+        int err = symlink(srcLib, m_lib.c_str());
+        free(srcLib);
+        ASSERT_EQ(err, 0);
+
+        setenv("ONEVPL_SEARCH_PATH", m_tmpDir.c_str(), 1);
+
+        // runtimes in the system default paths are always searched
+        mfxLoader loader = MFXLoad();
+        ASSERT_FALSE(loader == nullptr);
+
+        mfxHDL implDesc = nullptr;
+        mfxStatus sts   = MFX_ERR_NONE;
+
+        sts = MFXEnumImplementations(loader, 1, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &implDesc);
+        if (sts == MFX_ERR_NONE)
+            MFXDispReleaseImplDescription(loader, implDesc);
+        MFXUnload(loader);
+
+        if (sts == MFX_ERR_NONE)
+            GTEST_SKIP() << "runtimes other than the stub RT were found";
+    }
+
+    void TearDown() override {
+        if (m_tmpDir.empty())
+            return;
+
+        setenv("ONEVPL_SEARCH_PATH", m_origSearchPath.c_str(), 1);
+        if (m_bHasLibPath)
+            setenv("LD_LIBRARY_PATH", m_origLibPath.c_str(), 1);
+
+        if (!m_lib.empty())
+            std::remove(m_lib.c_str());
+        rmdir(m_tmpDir.c_str());
+    }
+
+    std::string m_origSearchPath;
+    std::string m_origLibPath;
+    bool m_bHasLibPath = false;
+
+    std::string m_tmpDir;
+    std::string m_lib;
+};
+
+// upper limits for the stub runtime, to catch regressions in loader memory use
+// raise these only if the increase is expected
+    #define MAX_LOAD_ALLOCS 256
+    #define MAX_LOAD_BYTES  (56 * 1024)
+
+    #define MAX_REFILTER_ALLOCS 16
+    #define MAX_REFILTER_BYTES  512
+
+TEST_F(Dispatcher_LoaderAlloc, LoadQueryUnload) {
+    StartAllocCount();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // loads and queries all libraries in the search path
+    mfxImplDescription *implDesc = nullptr;
+
+    sts = MFXEnumImplementations(loader,
+                                 0,
+                                 MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                 reinterpret_cast<mfxHDL *>(&implDesc));
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXDispReleaseImplDescription(loader, implDesc);
+    MFXUnload(loader);
+
+    AllocReport report = StopAllocCount();
+
+    EXPECT_LE(report.numAllocs, (size_t)MAX_LOAD_ALLOCS);
+    EXPECT_LE(report.numBytes, (size_t)MAX_LOAD_BYTES);
+}
+
+TEST_F(Dispatcher_LoaderAlloc, ChangeFilterAndEnumerate) {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxImplDescription *implDesc = nullptr;
+
+    sts = MFXEnumImplementations(loader,
+                                 0,
+                                 MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                 reinterpret_cast<mfxHDL *>(&implDesc));
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    MFXDispReleaseImplDescription(loader, implDesc);
+
+    // libraries are already loaded, so only the list of valid implementations is updated
+    StartAllocCount();
+
+    sts = SetConfigFilterProperty<mfxU32>(loader,
+                                          cfg,
+                                          "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+                                          MFX_CODEC_HEVC);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXEnumImplementations(loader,
+                                 0,
+                                 MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                 reinterpret_cast<mfxHDL *>(&implDesc));
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    MFXDispReleaseImplDescription(loader, implDesc);
+
+    AllocReport report = StopAllocCount();
+
+    EXPECT_LE(report.numAllocs, (size_t)MAX_REFILTER_ALLOCS);
+    EXPECT_LE(report.numBytes, (size_t)MAX_REFILTER_BYTES);
+
+    MFXUnload(loader);
+}
+
+TEST_F(Dispatcher_LoaderAlloc, SetFilterPropertyDoesNotAllocate) {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxVariant var      = {};
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_U32;
+    var.Data.U32        = MFX_CODEC_HEVC;
+
+    // property names are looked up without copying or tokenizing the string
+    StartAllocCount();
+
+    mfxStatus sts = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+        var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.Unknown", var);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    AllocReport report = StopAllocCount();
+
+    EXPECT_EQ(report.numAllocs, (size_t)0);
+
+    MFXUnload(loader);
+}
+
+#endif // !defined(_WIN32) && !defined(_WIN64)
@@ -0,0 +1,141 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for per-phase startup timing (MFXQueryLoaderTiming).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+
+// return timing of the stub runtime, other test runtimes are in the same directory
+static const mfxLibraryTiming *FindStubLibrary(const mfxLoaderTiming *timing) {
+    for (mfxU32 i = 0; i < timing->NumLibraries; i++) {
+        std::string libPath = timing->Libraries[i].LibPath;
+        if (libPath.find("vplstubrt64") != std::string::npos)
+            return &timing->Libraries[i];
+    }
+
+    return nullptr;
+}
+
+TEST(Dispatcher_LoaderTiming, NullPtrReturnsErrNull) {
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxLoaderTiming *timing = nullptr;
+
+    mfxStatus sts = MFXQueryLoaderTiming(nullptr, &timing);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXQueryLoaderTiming(loader, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXReleaseLoaderTiming(loader, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_LoaderTiming, PhasesRecordedForStubSession) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = LoadStub();
+    EXPECT_EQ(CreateAndCloseStubSession(loader), MFX_ERR_NONE);
+
+    mfxLoaderTiming *timing = nullptr;
+    mfxStatus sts           = MFXQueryLoaderTiming(loader, &timing);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_FALSE(timing == nullptr);
+
+    EXPECT_EQ(timing->Version.Version, (mfxU16)MFX_LOADERTIMING_VERSION);
+    EXPECT_EQ(timing->PhaseCount[MFX_LOADER_PHASE_SEARCH], 1u);
+    EXPECT_EQ(timing->PhaseCount[MFX_LOADER_PHASE_LOAD], 1u);
+    EXPECT_EQ(timing->PhaseCount[MFX_LOADER_PHASE_QUERY], 1u);
+    EXPECT_GE(timing->PhaseCount[MFX_LOADER_PHASE_FILTER], 1u);
+    EXPECT_EQ(timing->PhaseCount[MFX_LOADER_PHASE_INIT], 1u);
+    EXPECT_GT(timing->PhaseTime[MFX_LOADER_PHASE_SEARCH], 0u);
+
+    const mfxLibraryTiming *stubLib = FindStubLibrary(timing);
+    ASSERT_FALSE(stubLib == nullptr);
+
+    EXPECT_NE(stubLib->Valid, 0);
+    EXPECT_GT(stubLib->StartTime, 0u);
+    EXPECT_EQ(stubLib->PhaseCount[MFX_LOADER_PHASE_LOAD], 1u);
+    EXPECT_EQ(stubLib->PhaseCount[MFX_LOADER_PHASE_INIT], 1u);
+    EXPECT_GT(stubLib->PhaseTime[MFX_LOADER_PHASE_INIT], 0u);
+    EXPECT_LE(stubLib->PhaseTime[MFX_LOADER_PHASE_INIT],
+              timing->PhaseTime[MFX_LOADER_PHASE_INIT]);
+
+    // search and filter apply to the loader as a whole
+    EXPECT_EQ(stubLib->PhaseCount[MFX_LOADER_PHASE_SEARCH], 0u);
+    EXPECT_EQ(stubLib->PhaseCount[MFX_LOADER_PHASE_FILTER], 0u);
+
+    sts = MFXReleaseLoaderTiming(loader, timing);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_LoaderTiming, SnapshotNotUpdatedByLaterSessions) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = LoadStub();
+    EXPECT_EQ(CreateAndCloseStubSession(loader), MFX_ERR_NONE);
+
+    mfxLoaderTiming *timing1 = nullptr;
+    mfxStatus sts            = MFXQueryLoaderTiming(loader, &timing1);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // libraries are already loaded, so only the init phase runs again
+    EXPECT_EQ(CreateAndCloseStubSession(loader), MFX_ERR_NONE);
+
+    mfxLoaderTiming *timing2 = nullptr;
+    sts                      = MFXQueryLoaderTiming(loader, &timing2);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_EQ(timing1->PhaseCount[MFX_LOADER_PHASE_INIT], 1u);
+    EXPECT_EQ(timing2->PhaseCount[MFX_LOADER_PHASE_INIT], 2u);
+    EXPECT_EQ(timing2->PhaseCount[MFX_LOADER_PHASE_LOAD], 1u);
+
+    sts = MFXReleaseLoaderTiming(loader, timing1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXReleaseLoaderTiming(loader, timing1);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    // MFXUnload releases timing2
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_LoaderTiming, ReleaseWithOtherLoaderReturnsInvalidHandle) {
+    mfxLoader loader1 = MFXLoad();
+    ASSERT_FALSE(loader1 == nullptr);
+
+    mfxLoader loader2 = MFXLoad();
+    ASSERT_FALSE(loader2 == nullptr);
+
+    mfxLoaderTiming *timing = nullptr;
+    mfxStatus sts           = MFXQueryLoaderTiming(loader1, &timing);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXReleaseLoaderTiming(loader2, timing);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    sts = MFXReleaseLoaderTiming(loader1, timing);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader2);
+    MFXUnload(loader1);
+}
+
+#endif // ONEVPL_EXPERIMENTAL
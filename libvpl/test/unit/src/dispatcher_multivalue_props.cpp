@@ -0,0 +1,243 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for filter properties passed as a set (MFX_VARIANT_TYPE_SET)
+/// or range (MFX_VARIANT_TYPE_RANGE) of accepted values.
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+
+static mfxStatus SetConfigFilterPropertySet(mfxConfig cfg,
+                                            const char *name,
+                                            mfxVariantType baseType,
+                                            std::vector<mfxU32> values) {
+    mfxSet32U valueSet = {};
+    valueSet.NumValues = (mfxU32)values.size();
+    valueSet.Values    = values.data();
+
+    mfxVariant var;
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = (mfxVariantType)(baseType | MFX_VARIANT_TYPE_SET);
+    var.Data.Ptr        = &valueSet;
+
+    return MFXSetConfigFilterProperty(cfg, (const mfxU8 *)name, var);
+}
+
+static mfxStatus SetConfigFilterPropertyRange(mfxConfig cfg,
+                                              const char *name,
+                                              mfxVariantType baseType,
+                                              mfxRange32U range) {
+    mfxVariant var;
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = (mfxVariantType)(baseType | MFX_VARIANT_TYPE_RANGE);
+    var.Data.Ptr        = &range;
+
+    return MFXSetConfigFilterProperty(cfg, (const mfxU8 *)name, var);
+}
+
+TEST(Dispatcher_Stub_MultiValueProps, DecCodecSetMatchesAnyValue) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // stub decodes HEVC but not AVC or VC1
+    mfxConfig cfg = MFXCreateConfig(loader);
+    sts           = SetConfigFilterPropertySet(cfg,
+                                     "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+                                     MFX_VARIANT_TYPE_U32,
+                                     { MFX_CODEC_VC1, MFX_CODEC_HEVC, MFX_CODEC_AVC });
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = CreateAndCloseStubSession(loader);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // replace with a set which matches none of the decoders
+    sts = SetConfigFilterPropertySet(cfg,
+                                     "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+                                     MFX_VARIANT_TYPE_U32,
+                                     { MFX_CODEC_VC1, MFX_CODEC_AVC });
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = CreateAndCloseStubSession(loader);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // a single value replaces the set
+    mfxVariant var;
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_U32;
+    var.Data.U32        = MFX_CODEC_HEVC;
+    sts                 = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+        var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = CreateAndCloseStubSession(loader);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_MultiValueProps, ExtDeviceIDSetAndRange) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // stub reports DeviceID 0x1595
+    mfxConfig cfg = MFXCreateConfig(loader);
+    sts           = SetConfigFilterPropertySet(cfg,
+                                     "mfxExtendedDeviceId.DeviceID",
+                                     MFX_VARIANT_TYPE_U16,
+                                     { 0x1595, 0x4680 });
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = CreateAndCloseStubSession(loader);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = SetConfigFilterPropertyRange(cfg,
+                                       "mfxExtendedDeviceId.DeviceID",
+                                       MFX_VARIANT_TYPE_U16,
+                                       { 0x1500, 0x15FF, 0 });
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = CreateAndCloseStubSession(loader);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = SetConfigFilterPropertyRange(cfg,
+                                       "mfxExtendedDeviceId.DeviceID",
+                                       MFX_VARIANT_TYPE_U16,
+                                       { 0x1600, 0x16FF, 0 });
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = CreateAndCloseStubSession(loader);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_MultiValueProps, SetIsCopied) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxU32 codecs[]    = { MFX_CODEC_AVC, MFX_CODEC_AV1 };
+    mfxSet32U valueSet = {};
+    valueSet.NumValues = 2;
+    valueSet.Values    = codecs;
+
+    mfxVariant var;
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = (mfxVariantType)(MFX_VARIANT_TYPE_U32 | MFX_VARIANT_TYPE_SET);
+    var.Data.Ptr        = &valueSet;
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    sts           = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+        var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // app may reuse its array after the call returns
+    codecs[0] = MFX_CODEC_VC1;
+    codecs[1] = MFX_CODEC_VC1;
+
+    sts = CreateAndCloseStubSession(loader);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_MultiValueProps, InvalidSetsAreRejected) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    ASSERT_FALSE(cfg == nullptr);
+
+    // base type must match the property
+    mfxStatus sts = SetConfigFilterPropertySet(cfg,
+                                               "mfxExtendedDeviceId.DeviceID",
+                                               MFX_VARIANT_TYPE_U32,
+                                               { 0x1595 });
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    // values must fit in the property type
+    sts = SetConfigFilterPropertySet(cfg,
+                                     "mfxExtendedDeviceId.DeviceID",
+                                     MFX_VARIANT_TYPE_U16,
+                                     { 0x1595, 0x10000 });
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    // set may not be empty
+    sts = SetConfigFilterPropertySet(cfg, "mfxImplDescription.VendorID", MFX_VARIANT_TYPE_U32, {});
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    // only integer props compared for equality may be passed as a set
+    sts = SetConfigFilterPropertySet(cfg,
+                                     "mfxImplDescription.AccelerationMode",
+                                     MFX_VARIANT_TYPE_U32,
+                                     { MFX_ACCEL_MODE_NA });
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    sts = SetConfigFilterPropertySet(cfg, "NumThread", MFX_VARIANT_TYPE_U32, { 1, 2 });
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    // range must have Min <= Max
+    sts = SetConfigFilterPropertyRange(cfg,
+                                       "mfxImplDescription.VendorID",
+                                       MFX_VARIANT_TYPE_U32,
+                                       { 0x8086, 0x1000, 0 });
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    // SET and RANGE may not be combined with each other or with QUERY
+    mfxRange32U range = { 0, 0xFFFF, 0 };
+    mfxVariant var;
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type =
+        (mfxVariantType)(MFX_VARIANT_TYPE_U32 | MFX_VARIANT_TYPE_SET | MFX_VARIANT_TYPE_RANGE);
+    var.Data.Ptr = &range;
+    sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.VendorID", var);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    var.Type = (mfxVariantType)(MFX_VARIANT_TYPE_U32 | MFX_VARIANT_TYPE_RANGE |
+                                MFX_VARIANT_TYPE_QUERY);
+    sts      = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+        var);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    var.Type     = (mfxVariantType)(MFX_VARIANT_TYPE_U32 | MFX_VARIANT_TYPE_RANGE);
+    var.Data.Ptr = nullptr;
+    sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.VendorID", var);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    MFXUnload(loader);
+}
+
+#endif // ONEVPL_EXPERIMENTAL
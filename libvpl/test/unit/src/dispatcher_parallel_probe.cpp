@@ -0,0 +1,109 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for parallel querying of runtime libraries (ONEVPL_PROBE_THREADS).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+static void SetProbeThreads(const char *probeThreads) {
+#if defined(_WIN32) || defined(_WIN64)
+    SetEnvironmentVariable("ONEVPL_PROBE_THREADS", probeThreads);
+#else
+    if (probeThreads)
+        setenv("ONEVPL_PROBE_THREADS", probeThreads, 1);
+    else
+        unsetenv("ONEVPL_PROBE_THREADS");
+#endif
+}
+
+// return path and name of every implementation, in the order reported by the dispatcher
+static std::vector<std::string> EnumAllImpls(const char *probeThreads) {
+    std::vector<std::string> implList;
+
+    SetProbeThreads(probeThreads);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    for (mfxU32 idx = 0;; idx++) {
+        mfxHDL hImplPath             = nullptr;
+        mfxImplDescription *implDesc = nullptr;
+
+        mfxStatus sts = MFXEnumImplementations(loader, idx, MFX_IMPLCAPS_IMPLPATH, &hImplPath);
+        if (sts != MFX_ERR_NONE)
+            break;
+
+        sts = MFXEnumImplementations(loader,
+                                     idx,
+                                     MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                     reinterpret_cast<mfxHDL *>(&implDesc));
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+
+        std::string implStr = reinterpret_cast<mfxChar *>(hImplPath);
+        if (implDesc)
+            implStr += std::string(" : ") + implDesc->ImplName;
+        implList.push_back(implStr);
+
+        MFXDispReleaseImplDescription(loader, hImplPath);
+        if (implDesc)
+            MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    MFXUnload(loader);
+
+    SetProbeThreads(nullptr);
+
+    return implList;
+}
+
+TEST(Dispatcher_ParallelProbe, ImplOrderMatchesSerial) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::vector<std::string> implListSerial = EnumAllImpls(nullptr);
+    EXPECT_FALSE(implListSerial.empty());
+
+    EXPECT_EQ(EnumAllImpls("4"), implListSerial);
+    EXPECT_EQ(EnumAllImpls("ON"), implListSerial);
+
+    // 0 or 1 thread uses the serial path
+    EXPECT_EQ(EnumAllImpls("1"), implListSerial);
+}
+
+TEST(Dispatcher_ParallelProbe, CreateSessionSucceeds) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetProbeThreads("4");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    SetProbeThreads(nullptr);
+}
+
+TEST(Dispatcher_ParallelProbe, InvalidValueIgnored) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::vector<std::string> implListSerial = EnumAllImpls(nullptr);
+
+    EXPECT_EQ(EnumAllImpls("abc"), implListSerial);
+}
@@ -0,0 +1,269 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for load-aware session placement (MFXCreateSessionPlaced).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+
+TEST(Dispatcher_Placement, NullPtrReturnsErrNull) {
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxSession session = nullptr;
+    mfxU32 numActive   = 0;
+
+    EXPECT_EQ(MFXSetPlacementPolicy(nullptr, MFX_PLACEMENT_POLICY_ROUND_ROBIN, nullptr, 0),
+              MFX_ERR_NULL_PTR);
+    EXPECT_EQ(MFXSetPlacementPolicy(loader, MFX_PLACEMENT_POLICY_WEIGHTED, nullptr, 0),
+              MFX_ERR_NULL_PTR);
+    EXPECT_EQ(MFXCreateSessionPlaced(nullptr, &session, nullptr), MFX_ERR_NULL_PTR);
+    EXPECT_EQ(MFXCreateSessionPlaced(loader, nullptr, nullptr), MFX_ERR_NULL_PTR);
+    EXPECT_EQ(MFXQueryImplSessionCount(nullptr, 0, &numActive), MFX_ERR_NULL_PTR);
+    EXPECT_EQ(MFXQueryImplSessionCount(loader, 0, nullptr), MFX_ERR_NULL_PTR);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Placement, InvalidPolicyReturnsUnsupported) {
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = MFXSetPlacementPolicy(loader, (mfxPlacementPolicy)100, nullptr, 0);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    MFXUnload(loader);
+}
+
+    #if !defined(_WIN32) && !defined(_WIN64)
+
+        #include <stdlib.h>
+        #include <sys/stat.h>
+        #include <unistd.h>
+
+// place two copies of the stub RT in separate directories, so the loader sees two
+//   implementations which keep independent state
+class Dispatcher_PlacementTwoStubs : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SKIP_IF_DISP_STUB_DISABLED();
+
+        const char *searchPath = getenv("ONEVPL_SEARCH_PATH");
+        if (!searchPath)
+            GTEST_SKIP();
+        m_origSearchPath = searchPath;
+
+        char tmpDir[] = "/tmp/utestPlacementXXXXXX";
+        ASSERT_FALSE(mkdtemp(tmpDir) == nullptr);
+        m_tmpDir = tmpDir;
+
+        std::string srcLib = m_origSearchPath + PATH_SEPARATOR + "libvplstubrt64.so";
+        std::string newSearchPath;
+
+        for (const char *subDir : { "a", "b" }) {
+            std::string dir = m_tmpDir + PATH_SEPARATOR + subDir;
+            ASSERT_EQ(mkdir(dir.c_str(), 0700), 0);
+            m_dirs.push_back(dir);
+
+            std::string dstLib = dir + PATH_SEPARATOR + "libvplstubrt64.so";
+            std::ifstream src(srcLib, std::ios::binary);
+            std::ofstream dst(dstLib, std::ios::binary);
+            ASSERT_TRUE(src.is_open() && dst.is_open());
+            dst << src.rdbuf();
+            m_libs.push_back(dstLib);
+
+            newSearchPath += (newSearchPath.empty() ? "" : ":") + dir;
+        }
+
+        setenv("ONEVPL_SEARCH_PATH", newSearchPath.c_str(), 1);
+
+        m_loader = MFXLoad();
+        ASSERT_FALSE(m_loader == nullptr);
+
+        mfxStatus sts = SetConfigImpl(m_loader, MFX_IMPL_TYPE_STUB);
+        ASSERT_EQ(sts, MFX_ERR_NONE);
+
+        // both copies must be valid
+        mfxHDL implDesc = nullptr;
+        sts = MFXEnumImplementations(m_loader, 1, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &implDesc);
+        ASSERT_EQ(sts, MFX_ERR_NONE);
+        MFXDispReleaseImplDescription(m_loader, implDesc);
+    }
+
+    void TearDown() override {
+        for (mfxSession session : m_sessions)
+            MFXClose(session);
+
+        if (m_loader)
+            MFXUnload(m_loader);
+
+        if (m_tmpDir.empty())
+            return;
+
+        setenv("ONEVPL_SEARCH_PATH", m_origSearchPath.c_str(), 1);
+
+        for (const std::string &lib : m_libs)
+            std::remove(lib.c_str());
+        for (const std::string &dir : m_dirs)
+            rmdir(dir.c_str());
+        rmdir(m_tmpDir.c_str());
+    }
+
+    // create a session with the placement policy and return the selected implementation
+    mfxU32 CreatePlaced() {
+        mfxSession session = nullptr;
+        mfxU32 implIdx     = 0xFFFFFFFF;
+
+        mfxStatus sts = MFXCreateSessionPlaced(m_loader, &session, &implIdx);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+
+        if (session)
+            m_sessions.push_back(session);
+
+        return implIdx;
+    }
+
+    mfxU32 GetSessionCount(mfxU32 implIdx) {
+        mfxU32 numActive = 0xFFFFFFFF;
+
+        mfxStatus sts = MFXQueryImplSessionCount(m_loader, implIdx, &numActive);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+
+        return numActive;
+    }
+
+    void CloseSession(size_t n) {
+        MFXClose(m_sessions[n]);
+        m_sessions.erase(m_sessions.begin() + n);
+    }
+
+    mfxLoader m_loader = nullptr;
+    std::vector<mfxSession> m_sessions;
+
+    std::string m_origSearchPath;
+    std::string m_tmpDir;
+    std::vector<std::string> m_dirs;
+    std::vector<std::string> m_libs;
+};
+
+TEST_F(Dispatcher_PlacementTwoStubs, DefaultPolicyUsesFirstImpl) {
+    EXPECT_EQ(CreatePlaced(), 0u);
+    EXPECT_EQ(CreatePlaced(), 0u);
+
+    EXPECT_EQ(GetSessionCount(0), 2u);
+    EXPECT_EQ(GetSessionCount(1), 0u);
+}
+
+TEST_F(Dispatcher_PlacementTwoStubs, RoundRobinAlternates) {
+    mfxStatus sts = MFXSetPlacementPolicy(m_loader, MFX_PLACEMENT_POLICY_ROUND_ROBIN, nullptr, 0);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_EQ(CreatePlaced(), 0u);
+    EXPECT_EQ(CreatePlaced(), 1u);
+    EXPECT_EQ(CreatePlaced(), 0u);
+    EXPECT_EQ(CreatePlaced(), 1u);
+
+    EXPECT_EQ(GetSessionCount(0), 2u);
+    EXPECT_EQ(GetSessionCount(1), 2u);
+}
+
+TEST_F(Dispatcher_PlacementTwoStubs, LeastActiveCountsAllSessions) {
+    mfxStatus sts = MFXSetPlacementPolicy(m_loader, MFX_PLACEMENT_POLICY_LEAST_ACTIVE, nullptr, 0);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // sessions created with MFXCreateSession are counted too
+    for (int n = 0; n < 2; n++) {
+        mfxSession session = nullptr;
+        sts                = MFXCreateSession(m_loader, 0, &session);
+        ASSERT_EQ(sts, MFX_ERR_NONE);
+        m_sessions.push_back(session);
+    }
+
+    EXPECT_EQ(CreatePlaced(), 1u);
+    EXPECT_EQ(CreatePlaced(), 1u);
+    EXPECT_EQ(CreatePlaced(), 0u);
+
+    EXPECT_EQ(GetSessionCount(0), 3u);
+    EXPECT_EQ(GetSessionCount(1), 2u);
+
+    // closing sessions on implementation 0 moves placement there
+    CloseSession(0);
+    CloseSession(0);
+    EXPECT_EQ(GetSessionCount(0), 1u);
+
+    EXPECT_EQ(CreatePlaced(), 0u);
+}
+
+TEST_F(Dispatcher_PlacementTwoStubs, SessionsNotCountedUntilPlacementUsed) {
+    mfxSession session = nullptr;
+    mfxStatus sts      = MFXCreateSession(m_loader, 0, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    m_sessions.push_back(session);
+
+    EXPECT_EQ(GetSessionCount(0), 0u);
+
+    EXPECT_EQ(CreatePlaced(), 0u);
+    EXPECT_EQ(GetSessionCount(0), 1u);
+
+    // closing the untracked session leaves the count unchanged
+    CloseSession(0);
+    EXPECT_EQ(GetSessionCount(0), 1u);
+}
+
+TEST_F(Dispatcher_PlacementTwoStubs, WeightedSplitsByShare) {
+    const mfxU32 weights[] = { 1, 3 };
+
+    mfxStatus sts = MFXSetPlacementPolicy(m_loader, MFX_PLACEMENT_POLICY_WEIGHTED, weights, 2);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    for (int n = 0; n < 8; n++)
+        CreatePlaced();
+
+    EXPECT_EQ(GetSessionCount(0), 2u);
+    EXPECT_EQ(GetSessionCount(1), 6u);
+}
+
+TEST_F(Dispatcher_PlacementTwoStubs, ZeroWeightIsNeverSelected) {
+    const mfxU32 weights[] = { 0 };
+
+    mfxStatus sts = MFXSetPlacementPolicy(m_loader, MFX_PLACEMENT_POLICY_WEIGHTED, weights, 1);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // implementation 1 has the default weight
+    EXPECT_EQ(CreatePlaced(), 1u);
+    EXPECT_EQ(CreatePlaced(), 1u);
+
+    const mfxU32 zeroWeights[] = { 0, 0 };
+
+    sts = MFXSetPlacementPolicy(m_loader, MFX_PLACEMENT_POLICY_WEIGHTED, zeroWeights, 2);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSessionPlaced(m_loader, &session, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+}
+
+TEST_F(Dispatcher_PlacementTwoStubs, SessionClosedAfterUnload) {
+    EXPECT_EQ(CreatePlaced(), 0u);
+
+    // session remains valid and is closed by TearDown
+    MFXUnload(m_loader);
+    m_loader = nullptr;
+}
+
+    #endif // !defined(_WIN32) && !defined(_WIN64)
+
+#endif // ONEVPL_EXPERIMENTAL
@@ -0,0 +1,100 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for direct runtime calls (MFXGetRuntimeFunctions).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+
+TEST(Dispatcher_RuntimeFunctions, NullPtrReturnsErr) {
+    mfxRuntimeFunctions functions = {};
+    functions.Version.Version     = MFX_RUNTIMEFUNCTIONS_VERSION;
+
+    mfxStatus sts = MFXGetRuntimeFunctions(nullptr, &functions);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+}
+
+    #if !defined(_WIN32) && !defined(_WIN64)
+TEST(Dispatcher_RuntimeFunctions, DirectCallsMatchDispatcher) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader   = LoadStub();
+    mfxSession session = CreateStubSession(loader);
+    ASSERT_FALSE(session == nullptr);
+
+    mfxStatus sts = MFXGetRuntimeFunctions(session, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    mfxRuntimeFunctions functions = {};
+    functions.Version.Version     = MFX_RUNTIMEFUNCTIONS_VERSION;
+
+    sts = MFXGetRuntimeFunctions(session, &functions);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_EQ(functions.Version.Version, (mfxU16)MFX_RUNTIMEFUNCTIONS_VERSION);
+    EXPECT_FALSE(functions.RuntimeSession == nullptr);
+    EXPECT_NE(functions.RuntimeSession, session);
+
+    // the stub runtime exports all of them
+    ASSERT_FALSE(functions.SyncOperation == nullptr);
+    ASSERT_FALSE(functions.DecodeFrameAsync == nullptr);
+    ASSERT_FALSE(functions.EncodeFrameAsync == nullptr);
+    ASSERT_FALSE(functions.RunFrameVPPAsync == nullptr);
+    ASSERT_FALSE(functions.ProcessFrameAsync == nullptr);
+    ASSERT_FALSE(functions.DecodeVPPFrameAsync == nullptr);
+    ASSERT_FALSE(functions.GetSurfaceForVPP == nullptr);
+    ASSERT_FALSE(functions.GetSurfaceForVPPOut == nullptr);
+    ASSERT_FALSE(functions.GetSurfaceForEncode == nullptr);
+    ASSERT_FALSE(functions.GetSurfaceForDecode == nullptr);
+
+    EXPECT_EQ(functions.SyncOperation(functions.RuntimeSession, nullptr, 0),
+              MFXVideoCORE_SyncOperation(session, nullptr, 0));
+
+    mfxFrameSurface1 *surface = nullptr;
+    EXPECT_EQ(functions.GetSurfaceForDecode(functions.RuntimeSession, &surface),
+              MFXMemory_GetSurfaceForDecode(session, &surface));
+
+    sts = MFXClose(session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_RuntimeFunctions, UnsupportedVersionReturnsErr) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader   = LoadStub();
+    mfxSession session = CreateStubSession(loader);
+    ASSERT_FALSE(session == nullptr);
+
+    mfxRuntimeFunctions functions = {};
+
+    // version not set
+    mfxStatus sts = MFXGetRuntimeFunctions(session, &functions);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    functions.Version.Version = MFX_STRUCT_VERSION(2, 0);
+    sts                       = MFXGetRuntimeFunctions(session, &functions);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    // newer minor version is accepted
+    functions.Version.Version = MFX_STRUCT_VERSION(1, 5);
+    sts                       = MFXGetRuntimeFunctions(session, &functions);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(functions.Version.Version, MFX_STRUCT_VERSION(1, 5));
+
+    MFXClose(session);
+    MFXUnload(loader);
+}
+    #endif
+
+#endif // ONEVPL_EXPERIMENTAL
@@ -0,0 +1,150 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for process-wide runtime registry (ONEVPL_RUNTIME_REGISTRY).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "src/dispatcher_common.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+    #include <stdlib.h>
+
+static void EnableRuntimeRegistry() {
+    setenv("ONEVPL_RUNTIME_REGISTRY", "ON", 1);
+}
+
+static void DisableRuntimeRegistry() {
+    unsetenv("ONEVPL_RUNTIME_REGISTRY");
+}
+
+TEST(Dispatcher_RuntimeRegistry, SecondLoaderUsesRegistry) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableRuntimeRegistry();
+
+    // first loader queries the RT and adds it to the registry
+    mfxLoader loader1 = LoadStub();
+    EXPECT_EQ(EnumStub(loader1), MFX_ERR_NONE);
+
+    // second loader uses the registry without loading or querying the RT
+    // log file is closed by MFXUnload, so check it after the second loader is destroyed
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    mfxLoader loader2  = LoadStub();
+    EXPECT_EQ(EnumStub(loader2), MFX_ERR_NONE);
+    mfxSession session = CreateStubSession(loader2);
+    MFXUnload(loader2);
+
+    CheckOutputLog("message:  runtime registry hit");
+    CheckOutputLog("message:  runtime registry miss", false);
+    CheckOutputLog("message:  runtime registry stored", false);
+    CleanupOutputLog();
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader1);
+
+    DisableRuntimeRegistry();
+}
+
+TEST(Dispatcher_RuntimeRegistry, ReleasedWithLastLoader) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableRuntimeRegistry();
+
+    mfxLoader loader = LoadStub();
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+    MFXUnload(loader);
+
+    // registry was destroyed by the last MFXUnload, so RT is queried again
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    loader = LoadStub();
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  runtime registry hit", false);
+    CheckOutputLog("message:  runtime registry miss");
+    CheckOutputLog("message:  runtime registry stored");
+    CleanupOutputLog();
+
+    DisableRuntimeRegistry();
+}
+
+TEST(Dispatcher_RuntimeRegistry, SessionOutlivesAllLoaders) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableRuntimeRegistry();
+
+    mfxLoader loader1  = LoadStub();
+    EXPECT_EQ(EnumStub(loader1), MFX_ERR_NONE);
+    mfxLoader loader2  = LoadStub();
+    EXPECT_EQ(EnumStub(loader2), MFX_ERR_NONE);
+    mfxSession session = CreateStubSession(loader2);
+
+    MFXUnload(loader1);
+    MFXUnload(loader2);
+
+    ASSERT_FALSE(session == nullptr);
+
+    mfxVersion version = {};
+    mfxStatus sts      = MFXQueryVersion(session, &version);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_GE(version.Major, 2);
+
+    sts = MFXClose(session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    DisableRuntimeRegistry();
+}
+
+TEST(Dispatcher_RuntimeRegistry, ConcurrentLoadersCreateSessions) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    EnableRuntimeRegistry();
+
+    // keep one loader open so that most threads use the registry
+    mfxLoader loader = LoadStub();
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+
+    std::vector<std::thread> threads;
+    for (mfxU32 i = 0; i < 8; i++) {
+        threads.emplace_back([]() {
+            for (mfxU32 j = 0; j < 10; j++) {
+                mfxLoader threadLoader = LoadStub();
+                EXPECT_EQ(EnumStub(threadLoader), MFX_ERR_NONE);
+                mfxSession session     = CreateStubSession(threadLoader);
+                if (session)
+                    MFXClose(session);
+                MFXUnload(threadLoader);
+            }
+        });
+    }
+
+    for (auto &t : threads)
+        t.join();
+
+    MFXUnload(loader);
+
+    DisableRuntimeRegistry();
+}
+
+TEST(Dispatcher_RuntimeRegistry, DisabledByDefault) {
+    SKIP_IF_DISP_STUB_DISABLED();
+    DisableRuntimeRegistry();
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    mfxLoader loader = LoadStub();
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  runtime registry", false);
+    CleanupOutputLog();
+}
+
+#endif
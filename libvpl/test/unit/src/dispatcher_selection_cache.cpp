@@ -0,0 +1,132 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for reuse of the list of valid implementations when a loader
+/// applies the same set of filter props again.
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+static void SetDecoderFilter(mfxConfig cfg, mfxU32 codecID) {
+    mfxVariant var;
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_U32;
+    var.Data.U32        = codecID;
+
+    mfxStatus sts = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+        var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+}
+
+TEST(Dispatcher_Stub_SelectionCache, SameFiltersReuseSelection) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    // log is only enabled for loaders created after it is captured
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    ASSERT_FALSE(cfg == nullptr);
+
+    // stub decodes HEVC but not AVC
+    SetDecoderFilter(cfg, MFX_CODEC_HEVC);
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+
+    SetDecoderFilter(cfg, MFX_CODEC_AVC);
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NOT_FOUND);
+
+    // both sets of filters were already applied, so neither is validated again
+    SetDecoderFilter(cfg, MFX_CODEC_HEVC);
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+
+    SetDecoderFilter(cfg, MFX_CODEC_AVC);
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NOT_FOUND);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    SetDecoderFilter(cfg, MFX_CODEC_HEVC);
+    sts = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  selection reused from loader");
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_Stub_SelectionCache, ConfigOrderDoesNotMatter) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    // log is only enabled for loaders created after it is captured
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg1 = MFXCreateConfig(loader);
+    mfxConfig cfg2 = MFXCreateConfig(loader);
+    ASSERT_FALSE(cfg1 == nullptr || cfg2 == nullptr);
+
+    SetDecoderFilter(cfg1, MFX_CODEC_HEVC);
+    SetDecoderFilter(cfg2, MFX_CODEC_AV1);
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+
+    // same filters, set on the other config objects
+    SetDecoderFilter(cfg1, MFX_CODEC_AV1);
+    SetDecoderFilter(cfg2, MFX_CODEC_HEVC);
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  selection reused from loader");
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_Stub_SelectionCache, NewFiltersAreValidated) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    // log is only enabled for loaders created after it is captured
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    ASSERT_FALSE(cfg == nullptr);
+
+    SetDecoderFilter(cfg, MFX_CODEC_HEVC);
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NONE);
+
+    SetDecoderFilter(cfg, MFX_CODEC_AVC);
+    EXPECT_EQ(EnumStub(loader), MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  selection reused", false);
+    CleanupOutputLog();
+}
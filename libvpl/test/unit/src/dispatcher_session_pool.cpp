@@ -0,0 +1,413 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for pre-initialized session pools (MFXCreateSessionPool).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+
+static void CheckStubSession(mfxSession session) {
+    ASSERT_FALSE(session == nullptr);
+
+    mfxVersion version = {};
+    mfxStatus sts      = MFXQueryVersion(session, &version);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_GE(version.Major, 2);
+}
+
+TEST(Dispatcher_SessionPool, AcquireFromWarmPool) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, 4, 8, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_FALSE(pool == nullptr);
+
+    // all sessions come from the pool, none are created on demand
+    mfxSession sessions[4] = {};
+    for (auto &session : sessions) {
+        sts = MFXSessionPoolAcquire(pool, &session);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+        CheckStubSession(session);
+    }
+
+    for (auto &session : sessions) {
+        sts = MFXSessionPoolRelease(pool, session);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+    }
+
+    sts = MFXDestroySessionPool(pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  session pool for implementation 0, min = 4, max = 8");
+    CheckOutputLog("message:  session pool empty", false);
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_SessionPool, ReleasedSessionIsReused) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    // no background refill, so the next session must be the one just released
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, 0, 1, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session1 = nullptr;
+    sts                 = MFXSessionPoolAcquire(pool, &session1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    CheckStubSession(session1);
+
+    sts = MFXSessionPoolRelease(pool, session1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session2 = nullptr;
+    sts                 = MFXSessionPoolAcquire(pool, &session2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(session1, session2);
+    CheckStubSession(session2);
+
+    // session may also be closed directly instead of returning it to the pool
+    sts = MFXClose(session2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXDestroySessionPool(pool);
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_SessionPool, PoolRefilledInBackground) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, 2, 2, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // take more sessions than the pool holds, refill runs concurrently
+    std::vector<mfxSession> sessions(16, nullptr);
+    for (auto &session : sessions) {
+        sts = MFXSessionPoolAcquire(pool, &session);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+        CheckStubSession(session);
+    }
+
+    // only up to maxSessions are kept, the others are closed
+    for (auto &session : sessions) {
+        sts = MFXSessionPoolRelease(pool, session);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+    }
+
+    sts = MFXDestroySessionPool(pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_SessionPool, ReleaseForeignSessionFails) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, 1, 1, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXSessionPoolRelease(pool, session);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    // released twice
+    mfxSession poolSession = nullptr;
+    sts                    = MFXSessionPoolAcquire(pool, &poolSession);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXSessionPoolRelease(pool, poolSession);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    sts = MFXSessionPoolRelease(pool, poolSession);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    MFXClose(session);
+    MFXDestroySessionPool(pool);
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_SessionPool, ClosedSessionIsForgotten) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, 0, 1, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession poolSession = nullptr;
+    sts                    = MFXSessionPoolAcquire(pool, &poolSession);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // closed by the application instead of released
+    sts = MFXClose(poolSession);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXSessionPoolRelease(pool, poolSession);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    // new session may reuse the address of the closed one
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXSessionPoolRelease(pool, session);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    MFXClose(session);
+    MFXDestroySessionPool(pool);
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_SessionPool, JoinedParentIsNotReused) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, 0, 1, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession parent = nullptr;
+    sts               = MFXSessionPoolAcquire(pool, &parent);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession child = nullptr;
+    sts              = MFXCreateSession(loader, 0, &child);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXJoinSession(parent, child);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // pool closes the parent instead of keeping it, which fails while the child is joined
+    sts = MFXSessionPoolRelease(pool, parent);
+    EXPECT_EQ(sts, MFX_ERR_UNDEFINED_BEHAVIOR);
+
+    mfxSession session = nullptr;
+    sts                = MFXSessionPoolAcquire(pool, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_NE(session, parent);
+    CheckStubSession(session);
+
+    sts = MFXDisjoinSession(child);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    sts = MFXClose(child);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    sts = MFXClose(parent);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXSessionPoolRelease(pool, session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXDestroySessionPool(pool);
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  session pool closing released session");
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_SessionPool, JoinedChildIsReused) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, 0, 1, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession parent = nullptr;
+    sts               = MFXCreateSession(loader, 0, &parent);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession child = nullptr;
+    sts              = MFXSessionPoolAcquire(pool, &child);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXJoinSession(parent, child);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // pool disjoins the child, so it may be handed out again
+    sts = MFXSessionPoolRelease(pool, child);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXSessionPoolAcquire(pool, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(session, child);
+
+    // parent has no children left
+    sts = MFXClose(parent);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXClose(session);
+    MFXDestroySessionPool(pool);
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_SessionPool, InvalidParamsFail) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(nullptr, 0, 1, 1, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXCreateSessionPool(loader, 0, 1, 1, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXCreateSessionPool(loader, 0, 2, 1, &pool);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_VIDEO_PARAM);
+
+    sts = MFXCreateSessionPool(loader, 0, 0, 0, &pool);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_VIDEO_PARAM);
+
+    // only one implementation passes the filter
+    sts = MFXCreateSessionPool(loader, 1, 1, 1, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    mfxSession session = nullptr;
+    EXPECT_EQ(MFXSessionPoolAcquire(nullptr, &session), MFX_ERR_NULL_PTR);
+    EXPECT_EQ(MFXSessionPoolRelease(nullptr, session), MFX_ERR_NULL_PTR);
+    EXPECT_EQ(MFXDestroySessionPool(nullptr), MFX_ERR_NULL_PTR);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_SessionPool, SessionsOutlivePoolAndLoader) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, 2, 4, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXSessionPoolAcquire(pool, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // pool is destroyed by MFXUnload
+    MFXUnload(loader);
+
+    CheckStubSession(session);
+
+    sts = MFXClose(session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+}
+
+TEST(Dispatcher_SessionPool, ConcurrentAcquireRelease) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, 4, 8, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    std::atomic<mfxU32> numFailed(0);
+
+    std::vector<std::thread> threads;
+    for (mfxU32 i = 0; i < 8; i++) {
+        threads.emplace_back([&]() {
+            for (mfxU32 j = 0; j < 50; j++) {
+                mfxSession session = nullptr;
+                if (MFXSessionPoolAcquire(pool, &session) != MFX_ERR_NONE) {
+                    numFailed++;
+                    continue;
+                }
+
+                mfxVersion version = {};
+                if (MFXQueryVersion(session, &version) != MFX_ERR_NONE)
+                    numFailed++;
+
+                if (MFXSessionPoolRelease(pool, session) != MFX_ERR_NONE)
+                    numFailed++;
+            }
+        });
+    }
+
+    for (auto &t : threads)
+        t.join();
+
+    EXPECT_EQ(numFailed, 0u);
+
+    sts = MFXDestroySessionPool(pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+}
+
+// compare time to get a session from the pool vs creating one directly
+TEST(Dispatcher_SessionPool, AcquireLatency) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader    = LoadStub();
+    mfxSessionPool pool = nullptr;
+
+    const mfxU32 numSessions = 64;
+
+    mfxStatus sts = MFXCreateSessionPool(loader, 0, numSessions, numSessions, &pool);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    std::vector<mfxSession> sessions(numSessions, nullptr);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (auto &session : sessions)
+        MFXCreateSession(loader, 0, &session);
+    auto createTime = std::chrono::steady_clock::now() - startTime;
+
+    for (auto &session : sessions)
+        MFXClose(session);
+
+    startTime = std::chrono::steady_clock::now();
+    for (auto &session : sessions)
+        MFXSessionPoolAcquire(pool, &session);
+    auto acquireTime = std::chrono::steady_clock::now() - startTime;
+
+    for (auto &session : sessions)
+        MFXSessionPoolRelease(pool, session);
+
+    // report only, results depend on the test machine
+    fprintf(stderr,
+            "Info: %d sessions -- MFXCreateSession = %.1f us, MFXSessionPoolAcquire = %.1f us\n",
+            numSessions,
+            std::chrono::duration<double, std::micro>(createTime).count(),
+            std::chrono::duration<double, std::micro>(acquireTime).count());
+
+    MFXDestroySessionPool(pool);
+    MFXUnload(loader);
+}
+
+#endif // ONEVPL_EXPERIMENTAL
@@ -0,0 +1,162 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for per-function session call stats (MFXQuerySessionCallStats).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+
+#define NUM_STATS_CALLS 10
+
+static void SetSessionStatsEnv(const char *statsEnabled, const char *statsFile) {
+    #if defined(_WIN32) || defined(_WIN64)
+    SetEnvironmentVariable("ONEVPL_SESSION_STATS", statsEnabled);
+    SetEnvironmentVariable("ONEVPL_SESSION_STATS_FILE", statsFile);
+    #else
+    if (statsEnabled)
+        setenv("ONEVPL_SESSION_STATS", statsEnabled, 1);
+    else
+        unsetenv("ONEVPL_SESSION_STATS");
+
+    if (statsFile)
+        setenv("ONEVPL_SESSION_STATS_FILE", statsFile, 1);
+    else
+        unsetenv("ONEVPL_SESSION_STATS_FILE");
+    #endif
+}
+
+static void CallSessionFunctions(mfxSession session) {
+    for (mfxU32 i = 0; i < NUM_STATS_CALLS; i++) {
+        MFXVideoCORE_SyncOperation(session, nullptr, 0);
+
+        mfxFrameSurface1 *surface = nullptr;
+        MFXMemory_GetSurfaceForDecode(session, &surface);
+    }
+}
+
+static const mfxFunctionCallStats *FindFunction(const mfxSessionCallStats *stats,
+                                                const char *functionName) {
+    for (mfxU32 i = 0; i < stats->NumFunctions; i++) {
+        if (std::string(stats->Functions[i].FunctionName) == functionName)
+            return &stats->Functions[i];
+    }
+
+    return nullptr;
+}
+
+TEST(Dispatcher_SessionStats, NullPtrReturnsErr) {
+    mfxSessionCallStats *stats = nullptr;
+
+    mfxStatus sts = MFXQuerySessionCallStats(nullptr, &stats);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    sts = MFXReleaseSessionCallStats(nullptr, stats);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+}
+
+TEST(Dispatcher_SessionStats, DisabledByDefault) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetSessionStatsEnv(nullptr, nullptr);
+
+    mfxLoader loader   = LoadStub();
+    mfxSession session = CreateStubSession(loader);
+    ASSERT_FALSE(session == nullptr);
+
+    mfxSessionCallStats *stats = nullptr;
+    mfxStatus sts              = MFXQuerySessionCallStats(session, &stats);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    MFXClose(session);
+    MFXUnload(loader);
+}
+
+    #if !defined(_WIN32) && !defined(_WIN64)
+TEST(Dispatcher_SessionStats, CallsAreCountedPerFunction) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetSessionStatsEnv("ON", nullptr);
+
+    mfxLoader loader   = LoadStub();
+    mfxSession session = CreateStubSession(loader);
+    ASSERT_FALSE(session == nullptr);
+
+    SetSessionStatsEnv(nullptr, nullptr);
+
+    CallSessionFunctions(session);
+
+    mfxSessionCallStats *stats = nullptr;
+    mfxStatus sts              = MFXQuerySessionCallStats(session, &stats);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_FALSE(stats == nullptr);
+
+    EXPECT_EQ(stats->Version.Version, (mfxU16)MFX_SESSIONCALLSTATS_VERSION);
+
+    const char *functionNames[] = { "MFXVideoCORE_SyncOperation", "MFXMemory_GetSurfaceForDecode" };
+    for (const char *functionName : functionNames) {
+        const mfxFunctionCallStats *functionStats = FindFunction(stats, functionName);
+        ASSERT_FALSE(functionStats == nullptr);
+
+        EXPECT_EQ(functionStats->NumCalls, (mfxU64)NUM_STATS_CALLS);
+        EXPECT_LE(functionStats->MaxTime, functionStats->TotalTime);
+
+        mfxU64 histogramCalls = 0;
+        for (mfxU32 bucket = 0; bucket < MFX_CALLSTATS_NUM_BUCKETS; bucket++)
+            histogramCalls += functionStats->Histogram[bucket];
+        EXPECT_EQ(histogramCalls, (mfxU64)NUM_STATS_CALLS);
+    }
+
+    // functions which were not called are not reported
+    EXPECT_TRUE(FindFunction(stats, "MFXVideoENCODE_EncodeFrameAsync") == nullptr);
+
+    sts = MFXReleaseSessionCallStats(session, stats);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXReleaseSessionCallStats(session, stats);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    MFXClose(session);
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_SessionStats, DumpedAtClose) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CaptureOutputLog(CAPTURE_LOG_FILE);
+    SetSessionStatsEnv("ON", CAPTURE_LOG_DEF_FILENAME);
+
+    mfxLoader loader   = LoadStub();
+    mfxSession session = CreateStubSession(loader);
+    ASSERT_FALSE(session == nullptr);
+
+    SetSessionStatsEnv(nullptr, nullptr);
+
+    CallSessionFunctions(session);
+
+    // snapshot which is not released is freed by MFXClose
+    mfxSessionCallStats *stats = nullptr;
+    mfxStatus sts              = MFXQuerySessionCallStats(session, &stats);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXClose(session);
+    MFXUnload(loader);
+
+    CheckOutputLog("MFXVideoCORE_SyncOperation");
+    CheckOutputLog("MFXMemory_GetSurfaceForDecode");
+    CheckOutputLog("MFXVideoENCODE_EncodeFrameAsync", false);
+    CleanupOutputLog();
+}
+    #endif
+
+#endif // ONEVPL_EXPERIMENTAL
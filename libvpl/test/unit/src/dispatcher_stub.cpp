@@ -678,6 +678,130 @@ TEST(Dispatcher_Stub_CreateSession, ExtDeviceID_EnumImpl_InvalidStub) {
     MFXUnload(loader);
 }
 
+// filter results are updated when a property in an existing mfxConfig is changed
+TEST(Dispatcher_Stub_CreateSession, ChangedFilterPropertyIsRevalidated) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxImplDescription *implDesc = nullptr;
+
+    // stub RT supports HEVC decode
+    sts = SetConfigFilterProperty<mfxU32>(loader,
+                                          cfg,
+                                          "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+                                          MFX_CODEC_HEVC);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXEnumImplementations(loader,
+                                 0,
+                                 MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                 reinterpret_cast<mfxHDL *>(&implDesc));
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    MFXDispReleaseImplDescription(loader, implDesc);
+
+    // narrow - stub RT does not support VP8 decode
+    sts = SetConfigFilterProperty<mfxU32>(loader,
+                                          cfg,
+                                          "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+                                          MFX_CODEC_VP8);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXEnumImplementations(loader,
+                                 0,
+                                 MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                 reinterpret_cast<mfxHDL *>(&implDesc));
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // changing a property in another config does not make the implementation valid again
+    mfxConfig cfg2 = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg2 == nullptr);
+
+    sts = SetConfigFilterProperty<mfxU32>(loader,
+                                          cfg2,
+                                          "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+                                          MFX_CODEC_AV1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXEnumImplementations(loader,
+                                 0,
+                                 MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                 reinterpret_cast<mfxHDL *>(&implDesc));
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // relax - implementation which was filtered out is valid again
+    sts = SetConfigFilterProperty<mfxU32>(loader,
+                                          cfg,
+                                          "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+                                          MFX_CODEC_MPEG2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXClose(session);
+    MFXUnload(loader);
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+TEST(Dispatcher_Stub_CreateSession, FilterPropertyByIdCanCreateSession) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    // for stub library, filter by ImplName
+    mfxVariant var;
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_PTR;
+    var.Data.Ptr        = (mfxHDL) "Stub Implementation";
+
+    mfxStatus sts = MFXSetConfigFilterPropertyById(cfg, MFX_CFG_PROP_IMPL_NAME, var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // stub RT does not support VP8 decode
+    var.Type     = MFX_VARIANT_TYPE_U32;
+    var.Data.U32 = MFX_CODEC_VP8;
+    sts          = MFXSetConfigFilterPropertyById(cfg, MFX_CFG_PROP_DEC_CODEC_ID, var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // property set by ID is replaced when set by name, and vice versa
+    sts = SetConfigFilterProperty<mfxU32>(loader,
+                                          cfg,
+                                          "mfxImplDescription.mfxDecoderDescription.decoder.CodecID",
+                                          MFX_CODEC_HEVC);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    MFXClose(session);
+
+    var.Data.U32 = MFX_CODEC_VP8;
+    sts          = MFXSetConfigFilterPropertyById(cfg, MFX_CFG_PROP_DEC_CODEC_ID, var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+}
+#endif
+
 TEST(Dispatcher_Stub_CloneSession, Basic_Clone_Succeeds) {
     SKIP_IF_DISP_STUB_DISABLED();
 
@@ -742,6 +866,88 @@ TEST(Dispatcher_Stub_CloneSession, Basic_Clone_Succeeds1x) {
     MFXUnload(loader);
 }
 
+#if !defined(_WIN32) && !defined(_WIN64)
+// cloned session uses the function table of the parent, including functions added in API 2.x
+TEST(Dispatcher_Stub_CloneSession, Clone_Has2xFunctions) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession cloneSession = nullptr;
+    sts                     = MFXCloneSession(session, &cloneSession);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    mfxVersion version = {};
+    sts                = MFXQueryVersion(cloneSession, &version);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(version.Major, 2);
+
+    // stub RT returns MFX_ERR_NOT_IMPLEMENTED, dispatcher returns MFX_ERR_INVALID_HANDLE
+    //   if the function was not resolved
+    mfxFrameSurface1 *surface = nullptr;
+    sts                       = MFXMemory_GetSurfaceForDecode(cloneSession, &surface);
+    EXPECT_EQ(sts, MFX_ERR_NOT_IMPLEMENTED);
+
+    sts = MFXDisjoinSession(cloneSession);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXClose(cloneSession);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXClose(session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+}
+#endif
+
+// sessions created from one library share the handle and function table of the loader
+static void CreateMultipleSessions(mfxU32 implType) {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, implType);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session[4] = {};
+    for (mfxU32 i = 0; i < 4; i++) {
+        sts = MFXCreateSession(loader, 0, &session[i]);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+    }
+
+    // sessions remain valid after the loader is destroyed
+    MFXUnload(loader);
+
+    for (mfxU32 i = 0; i < 4; i++) {
+        mfxVersion version = {};
+        sts                = MFXQueryVersion(session[i], &version);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+
+        sts = MFXClose(session[i]);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+    }
+}
+
+TEST(Dispatcher_Stub_CreateSession, MultipleSessionsOutliveLoader) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CreateMultipleSessions(MFX_IMPL_TYPE_STUB);
+}
+
+TEST(Dispatcher_Stub_CreateSession, MultipleSessionsOutliveLoader1x) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CreateMultipleSessions(MFX_IMPL_TYPE_STUB_1X);
+}
+
 #ifdef ONEVPL_EXPERIMENTAL
 
 TEST(Dispatcher_Stub_CreateSession, DeviceCopySetOn) {
@@ -0,0 +1,108 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for the binary dispatcher trace (ONEVPL_DISPATCHER_LOG=TRACE).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "src/dispatcher_common.h"
+
+#define NUM_TRACE_THREADS 4
+
+TEST(Dispatcher_Trace, WritesChromeTraceAtUnload) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CaptureOutputLog(CAPTURE_LOG_TRACE);
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_EQ(CreateAndCloseStubSession(loader), MFX_ERR_NONE);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("{\"traceEvents\":[");
+    CheckOutputLog("\"ph\":\"B\",\"name\":");
+    CheckOutputLog("\"ph\":\"E\",\"name\":");
+    CheckOutputLog("CreateSession");
+
+    // key arguments are saved with the enter event
+    CheckOutputLog("\"args\":{\"i\":0}");
+    CheckOutputLog("\"args\":{\"idx\":0}");
+    CheckOutputLog("\"name\":\"message\",\"args\":{\"msg\":\"message:  ");
+
+    // text log is not written in trace mode
+    CheckOutputLog("function: ", false);
+
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_Trace, EventsFromEachThreadAreKept) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CaptureOutputLog(CAPTURE_LOG_TRACE);
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // thread 0 is the main thread
+    EXPECT_EQ(CreateAndCloseStubSession(loader), MFX_ERR_NONE);
+
+    std::vector<std::thread> threads;
+    for (mfxU32 i = 0; i < NUM_TRACE_THREADS; i++)
+        threads.emplace_back([loader]() {
+            EXPECT_EQ(CreateAndCloseStubSession(loader), MFX_ERR_NONE);
+        });
+
+    for (auto &t : threads)
+        t.join();
+
+    MFXUnload(loader);
+
+    CheckOutputLog("\"tid\":0,\"ts\":");
+    CheckOutputLog("\"tid\":4,\"ts\":");
+    CheckOutputLog("\"args\":{\"name\":\"thread 4 (0 events dropped)\"}");
+    CheckOutputLog("\"tid\":5,\"ts\":", false);
+
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_Trace, OldestEventsAreDropped) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CaptureOutputLog(CAPTURE_LOG_TRACE);
+
+    mfxLoader loader = MFXLoad();
+    ASSERT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // each call adds at least an enter and a return event
+    for (mfxU32 i = 0; i < 4096; i++) {
+        mfxConfig cfg = MFXCreateConfig(loader);
+        EXPECT_FALSE(cfg == nullptr);
+    }
+
+    MFXUnload(loader);
+
+    CheckOutputLog("\"args\":{\"name\":\"thread 0 (0 events dropped)\"}", false);
+    CheckOutputLog("events dropped)\"}");
+
+    CleanupOutputLog();
+}
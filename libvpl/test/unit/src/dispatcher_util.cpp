@@ -17,16 +17,17 @@ void CaptureOutputLog(CaptureLogType type) {
     if (g_captureLogType != CAPTURE_LOG_DISABLED)
         return; // error - someone has already started capture
 
-    if (type == CAPTURE_LOG_DISPATCHER) {
+    if (type == CAPTURE_LOG_DISPATCHER || type == CAPTURE_LOG_TRACE) {
         // delete any existing log file and set env vars for dispatcher log
         // dispatcher will open and write to the new log file
         std::remove(CAPTURE_LOG_DEF_FILENAME);
 
+        const char *logMode = (type == CAPTURE_LOG_TRACE) ? "TRACE" : "ON";
 #if defined(_WIN32) || defined(_WIN64)
-        SetEnvironmentVariable("ONEVPL_DISPATCHER_LOG", "ON");
+        SetEnvironmentVariable("ONEVPL_DISPATCHER_LOG", logMode);
         SetEnvironmentVariable("ONEVPL_DISPATCHER_LOG_FILE", CAPTURE_LOG_DEF_FILENAME);
 #else
-        setenv("ONEVPL_DISPATCHER_LOG", "ON", 1);
+        setenv("ONEVPL_DISPATCHER_LOG", logMode, 1);
         setenv("ONEVPL_DISPATCHER_LOG_FILE", CAPTURE_LOG_DEF_FILENAME, 1);
 #endif
     }
@@ -53,7 +54,8 @@ void CaptureOutputLog(CaptureLogType type) {
 void CheckOutputLog(const char *expectedString, bool expectMatch) {
     std::string outputLog;
 
-    if (g_captureLogType == CAPTURE_LOG_DISPATCHER || g_captureLogType == CAPTURE_LOG_FILE) {
+    if (g_captureLogType == CAPTURE_LOG_DISPATCHER || g_captureLogType == CAPTURE_LOG_TRACE ||
+        g_captureLogType == CAPTURE_LOG_FILE) {
         std::ifstream logFile(CAPTURE_LOG_DEF_FILENAME);
         if (!logFile) {
             fprintf(stderr, "Error: failed to open log file %s\n", CAPTURE_LOG_DEF_FILENAME);
@@ -86,7 +88,7 @@ void CheckOutputLog(const char *expectedString, bool expectMatch) {
 
 // call after MFXUnload() to ensure that log file (if any) has been closed
 void CleanupOutputLog(void) {
-    if (g_captureLogType == CAPTURE_LOG_DISPATCHER) {
+    if (g_captureLogType == CAPTURE_LOG_DISPATCHER || g_captureLogType == CAPTURE_LOG_TRACE) {
 #if defined(_WIN32) || defined(_WIN64)
         SetEnvironmentVariable("ONEVPL_DISPATCHER_LOG", NULL);
         SetEnvironmentVariable("ONEVPL_DISPATCHER_LOG_FILE", NULL);
@@ -457,6 +459,8 @@ mfxStatus SetSingleProperty(mfxLoader loader,
         case MFX_VARIANT_TYPE_FP16:
 #ifdef ONEVPL_EXPERIMENTAL
         case MFX_VARIANT_TYPE_QUERY:
+        case MFX_VARIANT_TYPE_SET:
+        case MFX_VARIANT_TYPE_RANGE:
 #endif // ONEVPL_EXPERIMENTAL
         case MFX_VARIANT_TYPE_UNSET:
             return MFX_ERR_UNSUPPORTED;
@@ -494,6 +498,8 @@ mfxStatus SetSingleProperty(mfxLoader loader,
         case MFX_VARIANT_TYPE_FP16:
 #ifdef ONEVPL_EXPERIMENTAL
         case MFX_VARIANT_TYPE_QUERY:
+        case MFX_VARIANT_TYPE_SET:
+        case MFX_VARIANT_TYPE_RANGE:
 #endif // ONEVPL_EXPERIMENTAL
         case MFX_VARIANT_TYPE_UNSET:
             return MFX_ERR_UNSUPPORTED;
@@ -533,6 +539,8 @@ mfxStatus SetSingleProperty(mfxLoader loader,
         case MFX_VARIANT_TYPE_FP16:
 #ifdef ONEVPL_EXPERIMENTAL
         case MFX_VARIANT_TYPE_QUERY:
+        case MFX_VARIANT_TYPE_SET:
+        case MFX_VARIANT_TYPE_RANGE:
 #endif // ONEVPL_EXPERIMENTAL
         case MFX_VARIANT_TYPE_UNSET:
             return MFX_ERR_UNSUPPORTED;
@@ -571,6 +579,8 @@ mfxStatus SetSingleProperty(mfxLoader loader,
         case MFX_VARIANT_TYPE_FP16:
 #ifdef ONEVPL_EXPERIMENTAL
         case MFX_VARIANT_TYPE_QUERY:
+        case MFX_VARIANT_TYPE_SET:
+        case MFX_VARIANT_TYPE_RANGE:
 #endif // ONEVPL_EXPERIMENTAL
         case MFX_VARIANT_TYPE_UNSET:
             return MFX_ERR_UNSUPPORTED;